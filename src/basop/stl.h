@@ -1,6 +1,6 @@
 /*
   ===========================================================================
-   File: STL.H                                           v.2.3 - 30.Nov.2009
+   File: STL.H                                           v.2.4 - 16.Oct.2026
   ===========================================================================
 
             ITU-T STL  BASIC OPERATORS
@@ -14,6 +14,10 @@
                         TD 11 document and subsequent discussions on the
                         wp3audio@yahoogroups.com email reflector.
    March 06   v2.1      Changed to improve portability.                        
+   16 Oct 26   v2.4     BASOP_THREADSAFE selects the thread-safe basic
+                        operators of basop32_threadsafe.h; to be used with
+                        NO_BASOPS_OVERFLOW_GLOBAL_VAR and
+                        NO_BASOPS_CARRY_GLOBAL_VAR (no global flags).
 
   ============================================================================
 */
@@ -24,7 +28,11 @@
 
 #include "patch.h"
 #include "typedef.h"
+#ifdef BASOP_THREADSAFE
+#include "basop32_threadsafe.h"
+#else
 #include "basop32.h"
+#endif
 #include "count.h"
 #include "move.h"
 #include "control.h"
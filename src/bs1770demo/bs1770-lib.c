@@ -0,0 +1,256 @@
+/*
+    Implementation of BS.1770-4 as defined in Recommendation ITU-R BS.1770-4
+
+    K-weighting filter and streaming loudness meter
+
+    See LICENSE.md for terms.
+
+    Author: erik.norvell@ericsson.com
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+
+#include "bs1770-lib.h"
+
+/* R - REC - BS.1770 - 2 - 201103.pdf, Table 1, Filter coefficients for stage 1 of the pre - filter to model a spherical head */
+const double B1[3] = { 1.53512485958697, -2.69169618940638, 1.19839281085285 };
+const double A1[3] = { 1.0,              -1.69065929318241, 0.73248077421585 };
+
+/* R - REC - BS.1770 - 2 - 201103.pdf, Table 2, Filter coefficients for the RLB weighting curve */
+const double B2[3] = { 1.0,              -2.0,              1.0              };
+const double A2[3] = { 1.0,              -1.99004745483398, 0.99007225036621 };
+
+/*-------------------------------------------------
+ * Sum of squares of input signal
+ *-------------------------------------------------*/
+double sumsq(             /* o: Sum of squared signal */
+    const double *input,  /* i: Input signal          */
+    const long length     /* i: Length of signal      */
+)
+{
+    long i;
+    double result;
+    result = 0;
+    for( i = 0; i < length; i++ )
+    {
+        result = result + input[i] * input[i];
+    }
+
+    return result;
+}
+
+/*-------------------------------------------------
+ * 2nd order iir filter
+ * y(n) = b[0] * x(n) + b[1] * x(n-1) + b[2] * x(n-2)
+                      - a[1] * y(n-1) - a[2] * y(n-2)
+
+   a[0] assumed to be 1.0
+
+ *-------------------------------------------------*/
+void iir2(
+    const double *input,  /* i  : Input signal         */
+          double *output, /* o  : Output signal        */
+    const long length,    /* i  : Length of signal     */
+    const double *B,      /* i  : B coefficients       */
+    const double *A,      /* i  : A coefficients       */
+          double *Bmem,   /* i/o: B memory (3 samples) */
+          double *Amem    /* i/o: A memory (3 samples) */
+    )
+{
+    long i;
+
+    for (i = 0; i < length; i++ )
+    {
+        Bmem[2] = Bmem[1];
+        Bmem[1] = Bmem[0];
+        Bmem[0] = input[i];
+
+        Amem[2] = Amem[1];
+        Amem[1] = Amem[0];
+        Amem[0] = B[0] * Bmem[0] + B[1] * Bmem[1] + B[2] * Bmem[2]
+                                 - A[1] * Amem[1] - A[2] * Amem[2];
+        output[i] = Amem[0];
+    }
+
+    return;
+}
+
+/*-------------------------------------------------
+ * Loudness of a mean square energy
+ *-------------------------------------------------*/
+static double loudness(   /* o: Loudness, LKFS        */
+    const double energy   /* i: Mean square energy    */
+)
+{
+    return LKFS_OFFSET + 10 * log10( energy );
+}
+
+/*-------------------------------------------------
+ * Initialize streaming meter
+ *-------------------------------------------------*/
+void bs1770_meter_init(
+          BS1770_METER *meter,  /* o: Meter state          */
+    const long nchan,           /* i: Number of channels   */
+    const double *G             /* i: Channel weights      */
+)
+{
+    memset( meter, 0, sizeof( BS1770_METER ) );
+    meter->nchan = nchan;
+    memcpy( meter->G, G, sizeof( double ) * nchan );
+    meter->momentary = -HUGE_VAL;
+    meter->short_term = -HUGE_VAL;
+
+    return;
+}
+
+/*-------------------------------------------------
+ * Feed samples to the streaming meter.
+ *
+ * The input is filtered with the K-weighting stages
+ * and its energy accumulated per 100 ms sub-block.
+ * Each complete sub-block closes a 400 ms gating
+ * block (75% overlap) from the 4-entry circular buffer
+ * e_tmp, giving the momentary loudness, which is also
+ * added to the histogram for the integrated loudness,
+ * and updates the 3 s short-term loudness. Gating block
+ * energies are computed in the same order as in the
+ * two-pass (file) mode of bs1770demo.
+ *-------------------------------------------------*/
+long bs1770_meter_process(      /* o: Number of 100 ms sub-blocks completed */
+          BS1770_METER *meter,  /* i/o: Meter state                         */
+    const short *input,         /* i  : Interleaved 16 bit PCM, 48 kHz      */
+    const long length           /* i  : Number of samples per channel       */
+)
+{
+    long i, k, n, done, bin;
+    long completed;
+    double e, block_energy, lev;
+    const short *p;
+
+    completed = 0;
+    done = 0;
+    while( done < length )
+    {
+        /* Process up to the end of the current sub-block */
+        n = STEP_SIZE - meter->fill;
+        if( n > length - done )
+        {
+            n = length - done;
+        }
+
+        for( i = 0; i < meter->nchan; i++ )
+        {
+            p = input + done * meter->nchan + i;
+            for( k = 0; k < n; k++, p += meter->nchan )
+            {
+                meter->buf[k] = ((double)(*p)) / 32768.0;
+            }
+            iir2( meter->buf, meter->buf, n, B1, A1, meter->Bmem1 + 3 * i, meter->Amem1 + 3 * i );
+            iir2( meter->buf, meter->buf, n, B2, A2, meter->Bmem2 + 3 * i, meter->Amem2 + 3 * i );
+            for( k = 0; k < n; k++ )
+            {
+                meter->ch_energy[i] = meter->ch_energy[i] + meter->buf[k] * meter->buf[k];
+            }
+        }
+        meter->fill += n;
+        done += n;
+
+        if( meter->fill < STEP_SIZE )
+        {
+            break;
+        }
+
+        /* Sub-block complete: store energy in circular buffers */
+        e = 0;
+        for( i = 0; i < meter->nchan; i++ )
+        {
+            e += meter->G[i] * meter->ch_energy[i];
+            meter->ch_energy[i] = 0;
+        }
+        meter->e_tmp[meter->n_sub % 4] = e;
+        meter->e_short[meter->n_sub % SHORT_TERM_STEPS] = e;
+        meter->n_sub++;
+        meter->fill = 0;
+        completed++;
+
+        /* Momentary loudness and gating histogram, excluding incomplete blocks */
+        if( meter->n_sub >= 4 )
+        {
+            block_energy = ( meter->e_tmp[0] + meter->e_tmp[1] + meter->e_tmp[2] + meter->e_tmp[3] ) / ((double)BLOCK_SIZE);
+            lev = loudness( block_energy );
+            meter->momentary = lev;
+            if( lev > ABSOLUTE_THRESHOLD )
+            {
+                bin = (long) ((lev - ABSOLUTE_THRESHOLD) / HIST_STEP);
+                if( bin >= HIST_BINS )
+                {
+                    bin = HIST_BINS - 1;
+                }
+                meter->hist_count[bin]++;
+                meter->hist_energy[bin] += block_energy;
+            }
+        }
+
+        /* Short-term loudness */
+        if( meter->n_sub >= SHORT_TERM_STEPS )
+        {
+            e = 0;
+            for( k = 0; k < SHORT_TERM_STEPS; k++ )
+            {
+                e += meter->e_short[k];
+            }
+            meter->short_term = loudness( e / ((double)(SHORT_TERM_STEPS * STEP_SIZE)) );
+        }
+    }
+
+    return completed;
+}
+
+/*-------------------------------------------------
+ * Integrated loudness of all input so far.
+ *
+ * The absolute gate was applied when the blocks were
+ * added to the histogram; the relative gate is applied
+ * per bin, i.e. with a resolution of HIST_STEP LKFS. A
+ * bin is kept when its lower edge is above the gate.
+ *-------------------------------------------------*/
+double bs1770_meter_integrated( /* o: Integrated (gated) loudness, -Inf if none */
+    const BS1770_METER *meter   /* i: Meter state                               */
+)
+{
+    long b, count;
+    double energy, relative_threshold;
+
+    /* Loudness above absolute threshold */
+    count = 0;
+    energy = 0.0;
+    for( b = 0; b < HIST_BINS; b++ )
+    {
+        count += meter->hist_count[b];
+        energy += meter->hist_energy[b];
+    }
+    if( count == 0 )
+    {
+        return -HUGE_VAL;
+    }
+
+    relative_threshold = loudness( energy / count ) + RELATIVE_THRESHOLD_OFFSET;
+    if( ABSOLUTE_THRESHOLD > relative_threshold )
+    {
+        relative_threshold = ABSOLUTE_THRESHOLD;
+    }
+
+    /* Loudness above relative threshold */
+    count = 0;
+    energy = 0.0;
+    for( b = HIST_BINS - 1; b >= 0 && ABSOLUTE_THRESHOLD + b * HIST_STEP >= relative_threshold; b-- )
+    {
+        count += meter->hist_count[b];
+        energy += meter->hist_energy[b];
+    }
+
+    return loudness( energy / count );
+}
@@ -0,0 +1,94 @@
+/*
+    Implementation of BS.1770-4 as defined in Recommendation ITU-R BS.1770-4
+
+    K-weighting filter and streaming loudness meter
+
+    See LICENSE.md for terms.
+
+    Author: erik.norvell@ericsson.com
+*/
+
+#ifndef BS1770_LIB_H
+#define BS1770_LIB_H
+
+#define BLOCK_SIZE                19200      /* 400 ms in 48000 Hz sample rate */
+#define STEP_SIZE                 4800       /* 100 ms in 48000 Hz sample rate (75% overlap of 400 ms gating blocks) */
+#define SHORT_TERM_STEPS          30         /* 3 s short-term loudness window, in 100 ms sub-blocks */
+#define LKFS_OFFSET               (-0.691)
+#define ABSOLUTE_THRESHOLD        (-70.0)
+#define RELATIVE_THRESHOLD_OFFSET (-10.0)
+#define MAX_CH_NUMBER             24
+
+/* Loudness histogram of the streaming meter: gating blocks from ABSOLUTE_THRESHOLD up, in HIST_STEP LKFS bins */
+#define HIST_STEP                 0.01
+#define HIST_BINS                 10000      /* -70 .. +30 LKFS */
+
+/* K-weighting filter coefficients, stage 1 (pre-filter) and stage 2 (RLB weighting) */
+extern const double B1[3];
+extern const double A1[3];
+extern const double B2[3];
+extern const double A2[3];
+
+/*-------------------------------------------------
+ * Streaming loudness meter state.
+ *
+ * Memory is bounded: the gating blocks are kept in a
+ * loudness histogram (count and energy per bin) instead
+ * of a list, so the integrated loudness can be read at
+ * any time over an input of any length.
+ *-------------------------------------------------*/
+typedef struct
+{
+    long nchan;                          /* Number of channels                             */
+    double G[MAX_CH_NUMBER];             /* Channel weights                                */
+    double Bmem1[3 * MAX_CH_NUMBER];     /* K-weighting filter memories, per channel       */
+    double Amem1[3 * MAX_CH_NUMBER];
+    double Bmem2[3 * MAX_CH_NUMBER];
+    double Amem2[3 * MAX_CH_NUMBER];
+    double ch_energy[MAX_CH_NUMBER];     /* Energy of current sub-block, per channel       */
+    double buf[STEP_SIZE];               /* Scratch buffer for one channel                 */
+    long fill;                           /* Samples of current sub-block received          */
+    long n_sub;                          /* Number of complete 100 ms sub-blocks           */
+    double e_tmp[4];                     /* Circular buffer of last 4 sub-block energies   */
+    double e_short[SHORT_TERM_STEPS];    /* Circular buffer of last 30 sub-block energies  */
+    long hist_count[HIST_BINS];          /* Gating blocks per loudness bin                 */
+    double hist_energy[HIST_BINS];       /* Sum of energies of gating blocks per bin       */
+    double momentary;                    /* Loudness of last 400 ms block                  */
+    double short_term;                   /* Loudness of last 3 s                           */
+} BS1770_METER;
+
+/* 2nd order iir filter */
+void iir2(
+    const double *input,  /* i  : Input signal         */
+          double *output, /* o  : Output signal        */
+    const long length,    /* i  : Length of signal     */
+    const double *B,      /* i  : B coefficients       */
+    const double *A,      /* i  : A coefficients       */
+          double *Bmem,   /* i/o: B memory (3 samples) */
+          double *Amem    /* i/o: A memory (3 samples) */
+);
+
+/* Sum of squares of input signal */
+double sumsq(             /* o: Sum of squared signal */
+    const double *input,  /* i: Input signal          */
+    const long length     /* i: Length of signal      */
+);
+
+/* Streaming meter */
+void bs1770_meter_init(
+          BS1770_METER *meter,  /* o: Meter state          */
+    const long nchan,           /* i: Number of channels   */
+    const double *G             /* i: Channel weights      */
+);
+
+long bs1770_meter_process(      /* o: Number of 100 ms sub-blocks completed */
+          BS1770_METER *meter,  /* i/o: Meter state                         */
+    const short *input,         /* i  : Interleaved 16 bit PCM, 48 kHz      */
+    const long length           /* i  : Number of samples per channel       */
+);
+
+double bs1770_meter_integrated( /* o: Integrated (gated) loudness, -Inf if none */
+    const BS1770_METER *meter   /* i: Meter state                               */
+);
+
+#endif /* BS1770_LIB_H */
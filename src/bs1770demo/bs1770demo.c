@@ -10,15 +10,14 @@
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
+#if defined(_WIN32)
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+#include "bs1770-lib.h"
 
-#define BLOCK_SIZE                19200      /* 400 ms in 48000 Hz sample rate */
-#define STEP_SIZE                 4800       /* 100 ms in 48000 Hz sample rate (75% overlap of 400 ms gating blocks) */   
-#define LKFS_OFFSET               (-0.691)
-#define ABSOLUTE_THRESHOLD        (-70.0)
-#define RELATIVE_THRESHOLD_OFFSET (-10.0)
 #define MAX_ITERATIONS            10
-#define RELATIVE_DIFF             0.0001
-#define MAX_CH_NUMBER             24
 
 /*
     Channel weights for default channel ordering. Assumes channels are ordered as in 22.2 WAVE files:
@@ -82,24 +81,18 @@ static const char default_conf_24[25] = "000L11000L11000000000000";
 static const char default_conf_18[19] = "000L1100011000000";
 
 
-/* R - REC - BS.1770 - 2 - 201103.pdf, Table 1, Filter coefficients for stage 1 of the pre - filter to model a spherical head */
-static const double B1[3] = { 1.53512485958697, -2.69169618940638, 1.19839281085285 };
-static const double A1[3] = { 1.0,              -1.69065929318241, 0.73248077421585 };
-
-/* R - REC - BS.1770 - 2 - 201103.pdf, Table 2, Filter coefficients for the RLB weighting curve */
-static const double B2[3] = { 1.0,              -2.0,              1.0              };
-static const double A2[3] = { 1.0,              -1.99004745483398, 0.99007225036621 };
-
 void usage()
 {
     fprintf( stdout, "bs1770demo.exe [options] <input file> [<output file>]\n" );
     fprintf( stdout, "\n" );
-    fprintf( stdout, "<input file>      Input file,  16 bit PCM, 48 kHz\n" );
+    fprintf( stdout, "<input file>      Input file,  16 bit PCM, 48 kHz ('-' for stdin with -stream)\n" );
     fprintf( stdout, "[<output file>]   Output file, 16 bit PCM, 48 kHz (Optional)\n" );
     fprintf( stdout, "\n" );
     fprintf( stdout, "Options:\n" );
     fprintf( stdout, "-nchan N          Number of channels [1..24] (Default: 1)\n" );
     fprintf( stdout, "-lev L            Target level LKFS (Default: -26)\n" );
+    fprintf( stdout, "-stream           Single pass meter: momentary, short-term and integrated\n" );
+    fprintf( stdout, "                  loudness every 100 ms, with bounded memory (no output file)\n" );
     fprintf( stdout, "-conf xxxx        Configuration string:\n") ;
     fprintf( stdout, "                      '1' ldspk pos within |elev| < 30 deg, 60 deg <= |azim| <= 120 deg\n" );
     fprintf( stdout, "                      'L' LFE channel (weight zero)\n" );
@@ -127,61 +120,6 @@ void scale(
     return;
 }
 
-/*-------------------------------------------------
- * Sum of squares of input signal
- *-------------------------------------------------*/
-double sumsq(             /* o: Sum of squared signal */
-    const double *input,  /* i: Input signal          */
-    const long length     /* i: Length of signal      */
-)
-{
-    long i;
-    double result;
-    result = 0;
-    for( i = 0; i < length; i++ )
-    {
-        result = result + input[i] * input[i];
-    }
-
-    return result;
-}
-
-/*------------------------------------------------- 
- * 2nd order iir filter
- * y(n) = b[0] * x(n) + b[1] * x(n-1) + b[2] * x(n-2)
-                      - a[1] * y(n-1) - a[2] * y(n-2)
-    
-   a[0] assumed to be 1.0
-
- *-------------------------------------------------*/
-void iir2(
-    const double *input,  /* i  : Input signal         */
-          double *output, /* o  : Output signal        */
-    const long length,    /* i  : Length of signal     */
-    const double *B,      /* i  : B coefficients       */
-    const double *A,      /* i  : A coefficients       */
-          double *Bmem,   /* i/o: B memory (3 samples) */
-          double *Amem    /* i/o: A memory (3 samples) */
-    )
-{
-    long i;
-
-    for (i = 0; i < length; i++ )
-    {
-        Bmem[2] = Bmem[1];
-        Bmem[1] = Bmem[0];
-        Bmem[0] = input[i];
-
-        Amem[2] = Amem[1];
-        Amem[1] = Amem[0];
-        Amem[0] = B[0] * Bmem[0] + B[1] * Bmem[1] + B[2] * Bmem[2]
-                                 - A[1] * Amem[1] - A[2] * Amem[2];
-        output[i] = Amem[0];
-    }
-
-    return;
-}
-
 void deinterleave_short2double(
     short *input_short,  /* i: Input short signal     */
     double *input,       /* i: Input signal in double */
@@ -267,51 +205,123 @@ long interleave_double2short( /* returns number of clipped samples */
     return clip;
 }
 
-double gated_loudness(                  /* o: gated loudness                 */
-    const double *gating_block_energy,  /* i: gating_block_energy            */
-    const double fac,                   /* i: Scaling factor                 */
-    const long n_gating_blocks,         /* i: Number of gating blocks        */
-    const double threshold              /* i: LKFS threshold                 */
+/*-------------------------------------------------
+ * Sort the gating block energies in ascending order
+ * and compute their suffix sums, so that the energy
+ * and count of the blocks above any gate are found
+ * by a bisection instead of a pass over all blocks
+ *-------------------------------------------------*/
+static int compare_energy( const void *a, const void *b )
+{
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+void sort_gating_blocks(
+          double *gating_block_energy,  /* i/o: gating_block_energy, sorted on output    */
+          double *suffix_sum,           /* o  : sum of blocks i..n-1 (n+1 values)        */
+    const long n_gating_blocks          /* i  : Number of gating blocks                  */
 )
 {
     long i;
-    long count;
-    double energy = 0.0;
-    count = 0;
-    for( i = 0; i < n_gating_blocks; i++ )
+
+    qsort( gating_block_energy, n_gating_blocks, sizeof( double ), compare_energy );
+    suffix_sum[n_gating_blocks] = 0.0;
+    for( i = n_gating_blocks - 1; i >= 0; i-- )
+    {
+        suffix_sum[i] = suffix_sum[i + 1] + gating_block_energy[i];
+    }
+
+    return;
+}
+
+/*-------------------------------------------------
+ * Index of the first (sorted) gating block whose
+ * loudness after scaling is above the threshold;
+ * the blocks above the gate are i..n-1
+ *-------------------------------------------------*/
+long first_gated_block(                 /* o: index of first block above threshold */
+    const double *gating_block_energy,  /* i: gating_block_energy, sorted          */
+    const double fac,                   /* i: Scaling factor                       */
+    const long n_gating_blocks,         /* i: Number of gating blocks              */
+    const double threshold              /* i: LKFS threshold                       */
+)
+{
+    long lo, hi, mid;
+
+    lo = 0;
+    hi = n_gating_blocks;
+    while( lo < hi )
     {
-        if( (LKFS_OFFSET + 10 * log10( gating_block_energy[i] * fac * fac )) > threshold )
+        mid = lo + (hi - lo) / 2;
+        if( (LKFS_OFFSET + 10 * log10( gating_block_energy[mid] * fac * fac )) > threshold )
+        {
+            hi = mid;
+        }
+        else
         {
-            energy += gating_block_energy[i] * fac * fac;
-            count++;
+            lo = mid + 1;
         }
     }
 
+    return lo;
+}
+
+double gated_loudness(                  /* o: gated loudness                 */
+    const double *gating_block_energy,  /* i: gating_block_energy, sorted    */
+    const double *suffix_sum,           /* i: Suffix sums of energies        */
+    const double fac,                   /* i: Scaling factor                 */
+    const long n_gating_blocks,         /* i: Number of gating blocks        */
+    const double threshold,             /* i: LKFS threshold                 */
+          long *first                   /* o: First block above threshold    */
+)
+{
+    long count;
+    double energy;
+
+    *first = first_gated_block( gating_block_energy, fac, n_gating_blocks, threshold );
+    count = n_gating_blocks - *first;
+    energy = suffix_sum[*first] * fac * fac;
+
     return LKFS_OFFSET + 10 * log10( energy / count );
 }
 
 double gated_loudness_adaptive(         /* o: gated loudness, using adaptive threshold  */
-    const double *gating_block_energy,  /* i: gating_block_energy                       */
+    const double *gating_block_energy,  /* i: gating_block_energy, sorted               */
+    const double *suffix_sum,           /* i: Suffix sums of energies                   */
     const double fac,                   /* i: Scaling factor                            */
-    const long n_gating_blocks          /* i: Number of gating blocks                   */
+    const long n_gating_blocks,         /* i: Number of gating blocks                   */
+          long *first                   /* o: First block above final threshold         */
 )
 {
     double relative_threshold;
     double gated_loudness_final;
 
     /* Find scaling factor */
-    relative_threshold = gated_loudness( gating_block_energy, fac, n_gating_blocks, ABSOLUTE_THRESHOLD ) + RELATIVE_THRESHOLD_OFFSET;
+    relative_threshold = gated_loudness( gating_block_energy, suffix_sum, fac, n_gating_blocks, ABSOLUTE_THRESHOLD, first ) + RELATIVE_THRESHOLD_OFFSET;
     if( ABSOLUTE_THRESHOLD > relative_threshold )
     {
         relative_threshold = ABSOLUTE_THRESHOLD;
     }
-    gated_loudness_final = gated_loudness( gating_block_energy, fac, n_gating_blocks, relative_threshold );
+    gated_loudness_final = gated_loudness( gating_block_energy, suffix_sum, fac, n_gating_blocks, relative_threshold, first );
     return gated_loudness_final;
 }
 
 
+/*-------------------------------------------------
+ * The gated loudness at a scaling factor fac is
+ * LKFS_OFFSET + 10*log10( fac^2 * E/N ), where E and N are
+ * the energy and number of blocks above the gate. The relative
+ * gate follows the scaled blocks, so fac only changes the set of
+ * gated blocks where the absolute gate crosses a block. For a
+ * given set, the factor reaching the target is found in closed
+ * form, and the set is updated until it no longer changes, at
+ * which point the factor is exact.
+ *-------------------------------------------------*/
 double find_scaling_factor(            /* o: scaling factor                 */
-    const double *gating_block_energy, /* i: gating_block_energy            */
+    const double *gating_block_energy, /* i: gating_block_energy, sorted    */
+    const double *suffix_sum,          /* i: Suffix sums of energies        */
     const long n_gating_blocks,        /* i: Number of gating blocks        */
     const double lev,                  /* i: Target level                   */
           double *lev_input,           /* o: Input level                    */
@@ -319,27 +329,28 @@ double find_scaling_factor(            /* o: scaling factor                 */
 )
 {
     long itr;
-    double last_fac;
+    long first, last_first;
     double fac;
     double gated_loudness_final;
 
-    last_fac = 100.0; /* Dummy init to trigger first iteration */
     fac = 1.0;
-    itr = 0;
-    while( (fabs( 1.0 - fac / last_fac ) > RELATIVE_DIFF) && (itr < MAX_ITERATIONS) )
+    last_first = -1;
+    for( itr = 0; itr < MAX_ITERATIONS; itr++ )
     {
-        /* Find scaling factor */
-        gated_loudness_final = gated_loudness_adaptive( gating_block_energy, fac, n_gating_blocks );
-        last_fac = fac;
-        fac *= pow( 10.0, (lev - gated_loudness_final) / 20.0 );
+        gated_loudness_final = gated_loudness_adaptive( gating_block_energy, suffix_sum, fac, n_gating_blocks, &first );
         if (itr == 0 )
         {
             *lev_input = gated_loudness_final;
         }
-        itr++;
+        if( first == last_first )
+        {
+            break; /* Same gated blocks as for the previous factor: fac is the solution */
+        }
+        last_first = first;
+        fac *= pow( 10.0, (lev - gated_loudness_final) / 20.0 );
     }
 
-    *lev_obtained = gated_loudness_final;
+    *lev_obtained = gated_loudness_adaptive( gating_block_energy, suffix_sum, fac, n_gating_blocks, &first );
     return fac;
 }
 
@@ -372,6 +383,65 @@ long parse_conf(      /*  o: 0:success, -1:fail   */
     return 0;
 }
 
+/*-------------------------------------------------
+ * Single pass (streaming) loudness measurement
+ *
+ * Reads the input in 100 ms sub-blocks and reports the
+ * momentary (400 ms), short-term (3 s) and integrated
+ * loudness after each one. Memory use does not depend
+ * on the input length, so the input can be a pipe.
+ *-------------------------------------------------*/
+long stream_loudness(     /* o: Number of samples processed */
+    FILE *f_input,        /* i: Input file                  */
+    const long nchan,     /* i: Number of channels          */
+    const double *G       /* i: Channel weights             */
+)
+{
+    BS1770_METER *meter;
+    short *input_short;
+    long length;
+    long length_total;
+    long rest;
+    double lev;
+
+    meter = malloc( sizeof( BS1770_METER ) );
+    input_short = malloc( sizeof( short ) * STEP_SIZE * nchan );
+    bs1770_meter_init( meter, nchan, G );
+
+    fprintf( stdout, "\n     Time [s]   Momentary  Short-term  Integrated [LKFS]\n" );
+    length_total = 0;
+    rest = 0;
+    while( (length = (long)fread( input_short, sizeof( short ), STEP_SIZE * nchan, f_input ) ) )
+    {
+        rest = length % nchan;
+        if( bs1770_meter_process( meter, input_short, length / nchan ) )
+        {
+            fprintf( stdout, "%13.1f %11.4f %11.4f %11.4f\n", (double)meter->n_sub * STEP_SIZE / 48000.0,
+                     meter->momentary, meter->short_term, bs1770_meter_integrated( meter ) );
+        }
+        length_total += length / nchan;
+    }
+    if( rest != 0 )
+    {
+        fprintf( stderr, "*** Warning: Number of samples not divisible into number of channels\n" );
+    }
+
+    lev = bs1770_meter_integrated( meter );
+    if( lev == -HUGE_VAL )
+    {
+        fprintf( stdout, "Input level:      -Inf\n" );
+    }
+    else
+    {
+        fprintf( stdout, "Input level:      %.6f\n", lev );
+    }
+
+    free( meter );
+    free( input_short );
+
+    return length_total;
+}
+
 int main(int argc, char **argv )
 {
     FILE* f_input;
@@ -383,6 +453,7 @@ int main(int argc, char **argv )
     short *input_short;
     double *Bmem1, *Amem1, *Bmem2, *Amem2;
     double *gating_block_energy; /* Buffer for energy values of gating block j */
+    double *suffix_sum;          /* Sums of the sorted gating block energies */
     double *e_tmp;   /* Circular buffer for computing energy of each 100 ms sub-block */
     long nchan; 
     long length_total;
@@ -390,6 +461,7 @@ int main(int argc, char **argv )
     long n_gating_blocks;
     long clip;
     long n,i,j;
+    long first;
     const char *conf;
     double lev_input;
     double lev_target;
@@ -397,12 +469,14 @@ int main(int argc, char **argv )
     double fac;
     double G[MAX_CH_NUMBER];
     short zero_input_flag;
+    short stream_flag;
 
     lev_target = -26;  /* Default target level       */
     i = 1;
     conf = NULL;
     nchan = -1;
     zero_input_flag = 1;
+    stream_flag = 0;
 
     /* Command line parsing */
     if( argc == 1 )
@@ -411,7 +485,7 @@ int main(int argc, char **argv )
     }
     
     /* Process options */
-    while( argv[i][0] == '-' )
+    while( argv[i][0] == '-' && argv[i][1] != '\0' )
     {
         if( strcmp( argv[i], "-nchan" ) == 0 )
         {
@@ -436,6 +510,11 @@ int main(int argc, char **argv )
             }
             i += 2;
         }
+        else if( strcmp( argv[i], "-stream" ) == 0 )
+        {
+            stream_flag = 1;
+            i++;
+        }
         else if( strcmp( argv[i], "-conf" ) == 0 )
         {
             conf = argv[i + 1];
@@ -456,7 +535,14 @@ int main(int argc, char **argv )
     }
 
     input_filename = argv[i++];
-    if( (f_input = fopen( input_filename, "rb" )) == NULL )
+    if( stream_flag && strcmp( input_filename, "-" ) == 0 )
+    {
+        f_input = stdin;
+#if defined(_WIN32)
+        _setmode( _fileno( stdin ), _O_BINARY );
+#endif
+    }
+    else if( (f_input = fopen( input_filename, "rb" )) == NULL )
     {
         fprintf( stderr, "*** Could not open input file %s, exiting..\n\n", input_filename );
         usage();
@@ -465,6 +551,11 @@ int main(int argc, char **argv )
     {
         f_output = NULL;
     }
+    else if( stream_flag )
+    {
+        fprintf( stderr, "*** No output file can be written in -stream mode, exiting..\n\n" );
+        usage();
+    }
     else
     {
         output_filename = argv[i];
@@ -519,6 +610,14 @@ int main(int argc, char **argv )
     }
     fprintf( stdout, "nchan:            %ld\n", nchan );
 
+    if( stream_flag )
+    {
+        length_total = stream_loudness( f_input, nchan, G );
+        fprintf( stdout, "\n--> Done processing %ld samples\n", length_total );
+        fclose( f_input );
+        return 0;
+    }
+
     /* Find length of input file */
     fseek( f_input, 0L, SEEK_END );
     length_total = ftell( f_input ) / (2*nchan); /* 2 bytes per sample (16 bits), nchan channels */
@@ -545,6 +644,7 @@ int main(int argc, char **argv )
     Amem2 = calloc( sizeof( double ), 3 * nchan );
     /* Allocate energy array to allow two passes */
     gating_block_energy = malloc( sizeof( double ) * n_gating_blocks);
+    suffix_sum = malloc( sizeof( double ) * (n_gating_blocks + 1) );
     e_tmp = malloc( sizeof( double ) * 4 );
 
     /* Obtain filtering and compute energy of gating blocks */
@@ -576,14 +676,17 @@ int main(int argc, char **argv )
 
     if( !zero_input_flag )
     { 
+        /* Sort the blocks once; gating for any factor is then a lookup */
+        sort_gating_blocks( gating_block_energy, suffix_sum, n_gating_blocks );
+
 
         if( f_output != NULL )
         { 
             /* Output file is specified -- find the scaling factor to reach the target level and apply scaling */
 
             /* Find scaling factor */
-            /* Since a rescaling affects the relative gating threshold the factor is found through an iterative function */
-            fac = find_scaling_factor( gating_block_energy, n_gating_blocks, lev_target, &lev_input, &lev_obtained );
+            /* Since a rescaling affects the set of gated blocks the factor is found through an iterative function */
+            fac = find_scaling_factor( gating_block_energy, suffix_sum, n_gating_blocks, lev_target, &lev_input, &lev_obtained );
 
             /* Apply scaling */
             rewind( f_input ); 
@@ -613,7 +716,7 @@ int main(int argc, char **argv )
         else
         {
             /* No output file is specified -- find the input level */
-            lev_input = gated_loudness_adaptive( gating_block_energy, 1.0, n_gating_blocks );
+            lev_input = gated_loudness_adaptive( gating_block_energy, suffix_sum, 1.0, n_gating_blocks, &first );
             fprintf( stdout, "Input level:      %.6f\n", lev_input );
             fprintf( stdout, "\n--> Done processing %ld samples\n", length_total );
         }
@@ -644,6 +747,7 @@ int main(int argc, char **argv )
     free( Bmem2 );
     free( Amem2 );
     free( gating_block_energy );
+    free( suffix_sum );
     free( e_tmp );
 
 }
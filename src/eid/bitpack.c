@@ -0,0 +1,581 @@
+/*                                                        V.1.0 - 16.Oct.2026
+  ===========================================================================
+   Packed-bit representation of G.192 bitstreams and error patterns.
+
+   G.192 bitstreams carry one bit per 16-bit softbit word (or per byte,
+   in the byte-oriented format). For hard-bit streams, this module keeps
+   the bits packed 64 per word (see bitpack.h for the layout), and
+   converts losslessly between the packed and the softbit formats. The
+   conversion of 16 softbits at a time uses SSE2 or NEON when available.
+
+   Functions:
+   ~~~~~~~~~~
+   g192_to_packed(), packed_to_g192() .. headerless G.192 <-> packed
+   byte_to_packed(), packed_to_byte() .. headerless byte <-> packed
+   open_packed_bs(), reset_packed_bs(), close_packed_bs(),
+   packed_bs_add_frame(), packed_bs_add_g192(), packed_bs_add_byte(),
+   packed_bs_get_g192(), packed_bs_get_byte() .. packed bitstreams with
+                                                 a frame index
+
+   History:
+   ~~~~~~~~
+   16.Oct.2026 v1.0 Created.
+  ===========================================================================
+*/
+/* ..... Generic include files ..... */
+#include <stdlib.h>
+#include <string.h>             /* memset */
+
+/* Specific includes */
+#include "bitpack.h"
+
+/* SIMD conversion kernels */
+#if defined(__SSE2__) || defined(_M_X64)
+#define BITPACK_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define BITPACK_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+/* Byte-oriented softbits */
+#define PBS_BYTE_ZERO 0x7F
+#define PBS_BYTE_ONE  0x81
+
+
+/*
+  ---------------------------------------------------------------------------
+  Number of bits set in a 16-bit mask; used to count unexpected softbits.
+  ---------------------------------------------------------------------------
+*/
+static long count16 (unsigned m) {
+  long k;
+
+  for (k = 0; m; k++)
+    m &= m - 1;
+  return k;
+}
+
+
+/*
+  ---------------------------------------------------------------------------
+  unsigned g192_mask16 (short *soft, long *bad);
+  unsigned byte_mask16 (char *soft, long *bad);
+
+  Return a 16-bit mask with bit i set if soft[i] is a '1', and add to
+  *bad the number of the 16 softbits which are neither '0' nor '1'.
+  ---------------------------------------------------------------------------
+*/
+static unsigned g192_mask16 (short *soft, long *bad) {
+  unsigned ones, hard;
+
+#if defined(BITPACK_SIMD_SSE2)
+  __m128i a = _mm_loadu_si128 ((__m128i *) soft), b = _mm_loadu_si128 ((__m128i *) (soft + 8));
+  __m128i o = _mm_packs_epi16 (_mm_cmpeq_epi16 (a, _mm_set1_epi16 (G192_ONE)), _mm_cmpeq_epi16 (b, _mm_set1_epi16 (G192_ONE)));
+  __m128i z = _mm_packs_epi16 (_mm_cmpeq_epi16 (a, _mm_set1_epi16 (G192_ZERO)), _mm_cmpeq_epi16 (b, _mm_set1_epi16 (G192_ZERO)));
+
+  ones = (unsigned) _mm_movemask_epi8 (o);
+  hard = (unsigned) _mm_movemask_epi8 (_mm_or_si128 (o, z));
+#elif defined(BITPACK_SIMD_NEON)
+  static const uint16_t w[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+  uint16x8_t wv = vld1q_u16 (w), a = vld1q_u16 ((uint16_t *) soft), b = vld1q_u16 ((uint16_t *) (soft + 8));
+  uint16x8_t oa = vceqq_u16 (a, vdupq_n_u16 (G192_ONE)), ob = vceqq_u16 (b, vdupq_n_u16 (G192_ONE));
+  uint16x8_t ha = vorrq_u16 (oa, vceqq_u16 (a, vdupq_n_u16 (G192_ZERO)));
+  uint16x8_t hb = vorrq_u16 (ob, vceqq_u16 (b, vdupq_n_u16 (G192_ZERO)));
+
+  ones = vaddvq_u16 (vandq_u16 (oa, wv)) | (vaddvq_u16 (vandq_u16 (ob, wv)) << 8);
+  hard = vaddvq_u16 (vandq_u16 (ha, wv)) | (vaddvq_u16 (vandq_u16 (hb, wv)) << 8);
+#else
+  long i;
+
+  for (ones = hard = 0, i = 0; i < 16; i++) {
+    ones |= (unsigned) (soft[i] == G192_ONE) << i;
+    hard |= (unsigned) (soft[i] == G192_ONE || soft[i] == G192_ZERO) << i;
+  }
+#endif
+  if (hard != 0xFFFF)
+    *bad += count16 (~hard & 0xFFFF);
+  return ones;
+}
+
+static unsigned byte_mask16 (char *soft, long *bad) {
+  unsigned ones, hard;
+
+#if defined(BITPACK_SIMD_SSE2)
+  __m128i a = _mm_loadu_si128 ((__m128i *) soft);
+  __m128i o = _mm_cmpeq_epi8 (a, _mm_set1_epi8 ((char) PBS_BYTE_ONE));
+  __m128i z = _mm_cmpeq_epi8 (a, _mm_set1_epi8 ((char) PBS_BYTE_ZERO));
+
+  ones = (unsigned) _mm_movemask_epi8 (o);
+  hard = (unsigned) _mm_movemask_epi8 (_mm_or_si128 (o, z));
+#elif defined(BITPACK_SIMD_NEON)
+  static const uint8_t w[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+  uint8x16_t wv = vld1q_u8 (w), a = vld1q_u8 ((uint8_t *) soft);
+  uint8x16_t o = vandq_u8 (vceqq_u8 (a, vdupq_n_u8 (PBS_BYTE_ONE)), wv);
+  uint8x16_t h = vandq_u8 (vorrq_u8 (vceqq_u8 (a, vdupq_n_u8 (PBS_BYTE_ONE)), vceqq_u8 (a, vdupq_n_u8 (PBS_BYTE_ZERO))), wv);
+
+  ones = vaddv_u8 (vget_low_u8 (o)) | ((unsigned) vaddv_u8 (vget_high_u8 (o)) << 8);
+  hard = vaddv_u8 (vget_low_u8 (h)) | ((unsigned) vaddv_u8 (vget_high_u8 (h)) << 8);
+#else
+  long i;
+
+  for (ones = hard = 0, i = 0; i < 16; i++) {
+    ones |= (unsigned) ((unsigned char) soft[i] == PBS_BYTE_ONE) << i;
+    hard |= (unsigned) ((unsigned char) soft[i] == PBS_BYTE_ONE || (unsigned char) soft[i] == PBS_BYTE_ZERO) << i;
+  }
+#endif
+  if (hard != 0xFFFF)
+    *bad += count16 (~hard & 0xFFFF);
+  return ones;
+}
+
+
+/*
+  ---------------------------------------------------------------------------
+  void g192_expand8 (unsigned b, short *soft);
+  void byte_expand16 (unsigned b, char *soft);
+
+  Expand the 8 (16) LSbs of b into G.192 (byte) softbits, LSb first.
+  ---------------------------------------------------------------------------
+*/
+static void g192_expand8 (unsigned b, short *soft) {
+#if defined(BITPACK_SIMD_SSE2)
+  __m128i w = _mm_setr_epi16 (1, 2, 4, 8, 16, 32, 64, 128);
+  __m128i m = _mm_cmpeq_epi16 (_mm_and_si128 (_mm_set1_epi16 ((short) b), w), w);
+
+  /* 0x7F + 2 is 0x81 */
+  _mm_storeu_si128 ((__m128i *) soft, _mm_add_epi16 (_mm_set1_epi16 (G192_ZERO), _mm_and_si128 (m, _mm_set1_epi16 (2))));
+#elif defined(BITPACK_SIMD_NEON)
+  static const uint16_t w[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+  uint16x8_t m = vtstq_u16 (vdupq_n_u16 ((uint16_t) b), vld1q_u16 (w));
+
+  vst1q_u16 ((uint16_t *) soft, vaddq_u16 (vdupq_n_u16 (G192_ZERO), vandq_u16 (m, vdupq_n_u16 (2))));
+#else
+  long i;
+
+  for (i = 0; i < 8; i++)
+    soft[i] = (b >> i) & 1 ? G192_ONE : G192_ZERO;
+#endif
+}
+
+static void byte_expand16 (unsigned b, char *soft) {
+#if defined(BITPACK_SIMD_SSE2)
+  __m128i w = _mm_setr_epi8 (1, 2, 4, 8, 16, 32, 64, (char) 128, 1, 2, 4, 8, 16, 32, 64, (char) 128);
+  __m128i v = _mm_unpacklo_epi64 (_mm_set1_epi8 ((char) (b & 0xFF)), _mm_set1_epi8 ((char) (b >> 8)));
+  __m128i m = _mm_cmpeq_epi8 (_mm_and_si128 (v, w), w);
+
+  _mm_storeu_si128 ((__m128i *) soft, _mm_add_epi8 (_mm_set1_epi8 (PBS_BYTE_ZERO), _mm_and_si128 (m, _mm_set1_epi8 (2))));
+#elif defined(BITPACK_SIMD_NEON)
+  static const uint8_t w[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+  uint8x16_t v = vcombine_u8 (vdup_n_u8 ((uint8_t) (b & 0xFF)), vdup_n_u8 ((uint8_t) (b >> 8)));
+  uint8x16_t m = vtstq_u8 (v, vld1q_u8 (w));
+
+  vst1q_u8 ((uint8_t *) soft, vaddq_u8 (vdupq_n_u8 (PBS_BYTE_ZERO), vandq_u8 (m, vdupq_n_u8 (2))));
+#else
+  long i;
+
+  for (i = 0; i < 16; i++)
+    soft[i] = (char) ((b >> i) & 1 ? PBS_BYTE_ONE : PBS_BYTE_ZERO);
+#endif
+}
+
+
+/*
+   -------------------------------------------------------------------------
+   long g192_to_packed (short *soft, PBS_WORD *bits, long n);
+   ~~~~~~~~~~~~~~~~~~~
+
+   Pack n headerless G.192 softbits into PBS_WORDS(n) words, LSb first.
+   Softbits other than '1' (0x0081) are packed as '0'; unused bits of
+   the last word are cleared.
+
+   Parameter:
+   ~~~~~~~~~~
+   soft .... headerless G.192 array with n softbits
+   bits .... returned packed bits
+   n ....... number of softbits
+
+   Return value:
+   ~~~~~~~~~~~~~
+   Returns the number of softbits which are neither 0x007F nor 0x0081;
+   the conversion is lossless if it is 0.
+
+   History:
+   ~~~~~~~~
+   16.Oct.26  v.1.0  Created.
+   -------------------------------------------------------------------------
+ */
+long g192_to_packed (short *soft, PBS_WORD * bits, long n) {
+  long i, k, bad = 0;
+  PBS_WORD w;
+
+  for (i = 0; i + PBS_BITS <= n; i += PBS_BITS, soft += PBS_BITS) {
+    w = 0;
+    for (k = 0; k < PBS_BITS; k += 16)
+      w |= (PBS_WORD) g192_mask16 (soft + k, &bad) << k;
+    *bits++ = w;
+  }
+
+  /* Last, incomplete word */
+  if (i < n) {
+    for (w = 0, k = 0; i < n; i++, k++) {
+      if (soft[k] == G192_ONE)
+        w |= (PBS_WORD) 1 << k;
+      else if (soft[k] != G192_ZERO)
+        bad++;
+    }
+    *bits = w;
+  }
+  return bad;
+}
+
+/* ....................... End of g192_to_packed() ....................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   void packed_to_g192 (PBS_WORD *bits, short *soft, long n);
+   ~~~~~~~~~~~~~~~~~~~
+
+   Expand n packed bits into headerless G.192 softbits (0x007F/0x0081).
+   -------------------------------------------------------------------------
+ */
+void packed_to_g192 (PBS_WORD * bits, short *soft, long n) {
+  long i, k;
+  PBS_WORD w;
+
+  for (i = 0; i + PBS_BITS <= n; i += PBS_BITS, soft += PBS_BITS) {
+    w = *bits++;
+    for (k = 0; k < PBS_BITS; k += 8)
+      g192_expand8 ((unsigned) (w >> k) & 0xFF, soft + k);
+  }
+
+  /* Last, incomplete word */
+  if (i < n)
+    for (w = *bits, k = 0; i < n; i++, k++)
+      soft[k] = (w >> k) & 1 ? G192_ONE : G192_ZERO;
+}
+
+/* ....................... End of packed_to_g192() ....................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   long byte_to_packed (char *soft, PBS_WORD *bits, long n);
+   ~~~~~~~~~~~~~~~~~~~
+
+   Pack n headerless byte-oriented softbits (0x7F/0x81) into
+   PBS_WORDS(n) words, LSb first. Returns the number of softbits that
+   are neither 0x7F nor 0x81, as g192_to_packed().
+   -------------------------------------------------------------------------
+ */
+long byte_to_packed (char *soft, PBS_WORD * bits, long n) {
+  long i, k, bad = 0;
+  PBS_WORD w;
+
+  for (i = 0; i + PBS_BITS <= n; i += PBS_BITS, soft += PBS_BITS) {
+    w = 0;
+    for (k = 0; k < PBS_BITS; k += 16)
+      w |= (PBS_WORD) byte_mask16 (soft + k, &bad) << k;
+    *bits++ = w;
+  }
+
+  /* Last, incomplete word */
+  if (i < n) {
+    for (w = 0, k = 0; i < n; i++, k++) {
+      if ((unsigned char) soft[k] == PBS_BYTE_ONE)
+        w |= (PBS_WORD) 1 << k;
+      else if ((unsigned char) soft[k] != PBS_BYTE_ZERO)
+        bad++;
+    }
+    *bits = w;
+  }
+  return bad;
+}
+
+/* ....................... End of byte_to_packed() ....................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   void packed_to_byte (PBS_WORD *bits, char *soft, long n);
+   ~~~~~~~~~~~~~~~~~~~
+
+   Expand n packed bits into headerless byte-oriented softbits.
+   -------------------------------------------------------------------------
+ */
+void packed_to_byte (PBS_WORD * bits, char *soft, long n) {
+  long i, k;
+  PBS_WORD w;
+
+  for (i = 0; i + PBS_BITS <= n; i += PBS_BITS, soft += PBS_BITS) {
+    w = *bits++;
+    for (k = 0; k < PBS_BITS; k += 16)
+      byte_expand16 ((unsigned) (w >> k) & 0xFFFF, soft + k);
+  }
+
+  /* Last, incomplete word */
+  if (i < n)
+    for (w = *bits, k = 0; i < n; i++, k++)
+      soft[k] = (char) ((w >> k) & 1 ? PBS_BYTE_ONE : PBS_BYTE_ZERO);
+}
+
+/* ....................... End of packed_to_byte() ....................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   PACKED_BS *open_packed_bs (long nframes, long nbits);
+   ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+   Allocate an empty packed bitstream, with room for nframes frames and
+   nbits data bits; it grows as needed when frames are added.
+
+   Return value:
+   ~~~~~~~~~~~~~
+   Returns a pointer to the new PACKED_BS, or NULL on lack of memory.
+   -------------------------------------------------------------------------
+ */
+PACKED_BS *open_packed_bs (long nframes, long nbits) {
+  PACKED_BS *bs;
+
+  if ((bs = (PACKED_BS *) calloc (1, sizeof (PACKED_BS))) == NULL)
+    return NULL;
+  bs->maxframes = nframes > 0 ? nframes : 1;
+  bs->maxwords = PBS_WORDS (nbits) + bs->maxframes;
+  bs->bits = (PBS_WORD *) malloc (bs->maxwords * sizeof (PBS_WORD));
+  bs->offset = (long *) malloc (bs->maxframes * sizeof (long));
+  bs->sync = (short *) malloc (bs->maxframes * sizeof (short));
+  bs->len = (short *) malloc (bs->maxframes * sizeof (short));
+  bs->erased = (char *) malloc (bs->maxframes * sizeof (char));
+  if (!bs->bits || !bs->offset || !bs->sync || !bs->len || !bs->erased) {
+    close_packed_bs (bs);
+    return NULL;
+  }
+  return bs;
+}
+
+/* ....................... End of open_packed_bs() ....................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   Empty a packed bitstream, keeping its memory.
+   -------------------------------------------------------------------------
+ */
+void reset_packed_bs (PACKED_BS * bs) {
+  bs->nwords = bs->nframes = 0;
+}
+
+/* ....................... End of reset_packed_bs() ....................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   Release the memory of a packed bitstream.
+   -------------------------------------------------------------------------
+ */
+void close_packed_bs (PACKED_BS * bs) {
+  free (bs->bits);
+  free (bs->offset);
+  free (bs->sync);
+  free (bs->len);
+  free (bs->erased);
+  free (bs);
+}
+
+/* ....................... End of close_packed_bs() ....................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   PBS_WORD *packed_bs_add_frame (PACKED_BS *bs, short sync, long len);
+   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+   Append a frame of len data bits with sync word `sync' to a packed
+   bitstream. The frame bits are cleared and can be filled in through
+   the returned pointer.
+
+   Return value:
+   ~~~~~~~~~~~~~
+   Returns a pointer to the PBS_WORDS(len) words of the new frame, or
+   NULL on lack of memory or invalid length.
+   -------------------------------------------------------------------------
+ */
+PBS_WORD *packed_bs_add_frame (PACKED_BS * bs, short sync, long len) {
+  long nw = PBS_WORDS (len), n;
+  void *p;
+
+  if (len < 0 || len > 32767)
+    return NULL;
+
+  /* Grow frame index and bit buffer, doubling their sizes */
+  if (bs->nframes == bs->maxframes) {
+    n = 2 * bs->maxframes;
+    if ((p = realloc (bs->offset, n * sizeof (long))) == NULL)
+      return NULL;
+    bs->offset = (long *) p;
+    if ((p = realloc (bs->sync, n * sizeof (short))) == NULL)
+      return NULL;
+    bs->sync = (short *) p;
+    if ((p = realloc (bs->len, n * sizeof (short))) == NULL)
+      return NULL;
+    bs->len = (short *) p;
+    if ((p = realloc (bs->erased, n * sizeof (char))) == NULL)
+      return NULL;
+    bs->erased = (char *) p;
+    bs->maxframes = n;
+  }
+  if (bs->nwords + nw > bs->maxwords) {
+    n = 2 * bs->maxwords > bs->nwords + nw ? 2 * bs->maxwords : bs->nwords + nw;
+    if ((p = realloc (bs->bits, n * sizeof (PBS_WORD))) == NULL)
+      return NULL;
+    bs->bits = (PBS_WORD *) p;
+    bs->maxwords = n;
+  }
+
+  /* Index the new frame */
+  bs->offset[bs->nframes] = bs->nwords;
+  bs->sync[bs->nframes] = sync;
+  bs->len[bs->nframes] = (short) len;
+  bs->erased[bs->nframes] = 0;
+  memset (bs->bits + bs->nwords, 0, nw * sizeof (PBS_WORD));
+  bs->nframes++;
+  bs->nwords += nw;
+  return bs->bits + bs->nwords - nw;
+}
+
+/* ..................... End of packed_bs_add_frame() ..................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   long packed_bs_add_g192 (PACKED_BS *bs, short *frame);
+   ~~~~~~~~~~~~~~~~~~~~~~~~
+
+   Append a G.192 frame with sync header (sync word, length and length
+   softbits) to a packed bitstream. A frame whose softbits are all
+   0x0000 is flagged as erased.
+
+   Return value:
+   ~~~~~~~~~~~~~
+   Returns the index of the new frame, or -1 if the frame has soft
+   values that can not be packed losslessly, or on lack of memory (no
+   frame is then added).
+   -------------------------------------------------------------------------
+ */
+long packed_bs_add_g192 (PACKED_BS * bs, short *frame) {
+  PBS_WORD *bits;
+  long i, len = frame[1];
+
+  if ((bits = packed_bs_add_frame (bs, frame[0], len)) == NULL)
+    return -1;
+
+  if (g192_to_packed (frame + 2, bits, len) != 0) {
+    /* Either an erased frame, or one with soft values */
+    for (i = 0; i < len && frame[i + 2] == 0; i++);
+    if (i < len) {
+      bs->nframes--;
+      bs->nwords -= PBS_WORDS (len);
+      return -1;
+    }
+    memset (bits, 0, PBS_WORDS (len) * sizeof (PBS_WORD));
+    bs->erased[bs->nframes - 1] = 1;
+  }
+  return bs->nframes - 1;
+}
+
+/* ..................... End of packed_bs_add_g192() ..................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   long packed_bs_add_byte (PACKED_BS *bs, char *frame);
+   ~~~~~~~~~~~~~~~~~~~~~~~~
+
+   Append a byte-oriented G.192 frame with sync header (0x21/0x20,
+   length byte and softbits) to a packed bitstream, as
+   packed_bs_add_g192(). The sync byte is stored as the 16-bit G.192
+   sync word.
+   -------------------------------------------------------------------------
+ */
+long packed_bs_add_byte (PACKED_BS * bs, char *frame) {
+  PBS_WORD *bits;
+  long i, len = (unsigned char) frame[1];
+
+  if ((bits = packed_bs_add_frame (bs, (short) (0x6B00 | (unsigned char) frame[0]), len)) == NULL)
+    return -1;
+
+  if (byte_to_packed (frame + 2, bits, len) != 0) {
+    for (i = 0; i < len && frame[i + 2] == 0; i++);
+    if (i < len) {
+      bs->nframes--;
+      bs->nwords -= PBS_WORDS (len);
+      return -1;
+    }
+    memset (bits, 0, PBS_WORDS (len) * sizeof (PBS_WORD));
+    bs->erased[bs->nframes - 1] = 1;
+  }
+  return bs->nframes - 1;
+}
+
+/* ..................... End of packed_bs_add_byte() ..................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   long packed_bs_get_g192 (PACKED_BS *bs, long f, short *frame);
+   ~~~~~~~~~~~~~~~~~~~~~~~~
+
+   Convert frame f of a packed bitstream into a G.192 frame with sync
+   header. Erased frames have all softbits set to 0x0000.
+
+   Return value:
+   ~~~~~~~~~~~~~
+   Returns the number of words in frame[] (length + 2).
+   -------------------------------------------------------------------------
+ */
+long packed_bs_get_g192 (PACKED_BS * bs, long f, short *frame) {
+  long len = bs->len[f];
+
+  frame[0] = bs->sync[f];
+  frame[1] = (short) len;
+  if (bs->erased[f])
+    memset (frame + 2, 0, len * sizeof (short));
+  else
+    packed_to_g192 (packed_bs_frame (bs, f), frame + 2, len);
+  return len + 2;
+}
+
+/* ..................... End of packed_bs_get_g192() ..................... */
+
+
+/*
+   -------------------------------------------------------------------------
+   long packed_bs_get_byte (PACKED_BS *bs, long f, char *frame);
+   ~~~~~~~~~~~~~~~~~~~~~~~~
+
+   Convert frame f of a packed bitstream into a byte-oriented G.192
+   frame with sync header, as packed_bs_get_g192().
+
+   Return value:
+   ~~~~~~~~~~~~~
+   Returns the number of bytes in frame[] (length + 2), or -1 if the
+   frame is too long for a byte-oriented header.
+   -------------------------------------------------------------------------
+ */
+long packed_bs_get_byte (PACKED_BS * bs, long f, char *frame) {
+  long len = bs->len[f];
+
+  if (len > 255)
+    return -1;
+  frame[0] = (char) (bs->sync[f] & 0x00FF);
+  frame[1] = (char) len;
+  if (bs->erased[f])
+    memset (frame + 2, 0, len);
+  else
+    packed_to_byte (packed_bs_frame (bs, f), frame + 2, len);
+  return len + 2;
+}
+
+/* ..................... End of packed_bs_get_byte() ..................... */
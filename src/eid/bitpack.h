@@ -0,0 +1,89 @@
+/*
+  ============================================================================
+   File: BITPACK.H                                                   16.OCT.26
+  ============================================================================
+
+			  UGST/ITU-T UTILITY MODULE
+
+	      PACKED-BIT REPRESENTATION OF G.192 BITSTREAMS
+
+   A packed bitstream (PACKED_BS) keeps the data bits of a G.192
+   bitstream as hard bits, 64 per word, with a frame index holding the
+   sync word and the length of each frame. Bit i of a frame is bit
+   (i % 64) of word (i / 64) of that frame, i.e. the LSb is the bit
+   that occurs first in time, as in the compact (bit) format. Each
+   frame starts at a word boundary, so that a frame can be used in
+   place (zero-copy) and combined with error patterns word by word.
+   Unused bits of the last word of a frame are zero.
+
+   Only hard bits (0x007F/0x0081) can be packed. Frames whose softbits
+   are all 0x0000 (erased by the FER module) are flagged as erased
+   and have no data bits set. Other soft values can not be packed
+   losslessly and are rejected by the converters.
+
+   History:
+   16.Oct.26     1.00   Created
+  ============================================================================
+*/
+#ifndef BITPACK_DEFINED
+#define BITPACK_DEFINED 100
+
+/* ......... Smart prototypes .......... */
+#ifndef ARGS
+#if (defined(__STDC__) || defined(VMS) || defined(__DECC)  || defined(MSDOS) || defined(__MSDOS__))
+#define ARGS(x) x
+#else
+#define ARGS(x) ()
+#endif
+#endif
+
+/* Definitions for G.192 mode */
+#ifndef G192_ZERO
+#define G192_ZERO       (short)0X007F
+#define G192_ONE	(short)0X0081
+#define G192_SYNC	(short)0x6B21
+#define G192_FER	(short)0x6B20
+#endif
+
+/* Word of a packed bitstream */
+typedef unsigned long long PBS_WORD;
+#define PBS_BITS 64
+#define PBS_WORDS(n) (((n) + PBS_BITS - 1) / PBS_BITS)
+
+/*
+ * ......... Packed bitstream: data bits plus frame index .........
+ */
+typedef struct {
+  PBS_WORD *bits;               /* packed data bits of all frames */
+  long nwords;                  /* number of words used in bits[] */
+  long maxwords;                /* number of words allocated */
+  long nframes;                 /* number of frames */
+  long maxframes;               /* number of frames allocated */
+  long *offset;                 /* index in bits[] of each frame */
+  short *sync;                  /* sync word of each frame */
+  short *len;                   /* number of data bits of each frame */
+  char *erased;                 /* 1 if all softbits of frame are 0x0000 */
+} PACKED_BS;
+
+/* Access to the words of frame f (valid until the next frame is added) */
+#define packed_bs_frame(bs, f) ((bs)->bits + (bs)->offset[f])
+
+/* bitpack.c: conversion of headerless softbit arrays */
+long g192_to_packed ARGS ((short *soft, PBS_WORD * bits, long n));
+void packed_to_g192 ARGS ((PBS_WORD * bits, short *soft, long n));
+long byte_to_packed ARGS ((char *soft, PBS_WORD * bits, long n));
+void packed_to_byte ARGS ((PBS_WORD * bits, char *soft, long n));
+
+/* bitpack.c: packed bitstream with frame index */
+PACKED_BS *open_packed_bs ARGS ((long nframes, long nbits));
+void reset_packed_bs ARGS ((PACKED_BS * bs));
+void close_packed_bs ARGS ((PACKED_BS * bs));
+PBS_WORD *packed_bs_add_frame ARGS ((PACKED_BS * bs, short sync, long len));
+long packed_bs_add_g192 ARGS ((PACKED_BS * bs, short *frame));
+long packed_bs_add_byte ARGS ((PACKED_BS * bs, char *frame));
+long packed_bs_get_g192 ARGS ((PACKED_BS * bs, long f, short *frame));
+long packed_bs_get_byte ARGS ((PACKED_BS * bs, long f, char *frame));
+
+#endif /* BITPACK_DEFINED */
+
+/* ************************* END OF BITPACK.H ************************* */
@@ -1,4 +1,4 @@
-/*                                                         02.Feb.2010 v.1.1
+/*                                                         16.Oct.2026 v.1.2
    =========================================================================
 
    bs-stats.c
@@ -79,6 +79,8 @@
    02.Feb.2000 v.1.0 Created based on eid-xor.c <simao>
    02.Feb.2010 v.1.1 Modified maximum string length for filenames to
                      avoid buffer overruns (y.hiwasaki)
+  16.Oct.2026 v.1.2 Bitstream is memory-mapped; frame sizes are taken
+                    from the frame index built by bs_map_open()
 
    ========================================================================= */
 
@@ -129,7 +131,7 @@
   --------------------------------------------------------------------------
 */
 void display_usage (int level) {
-  printf ("bs-stats.c - Version 1.1 of 02.Feb.2010\n");
+  printf ("bs-stats.c - Version 1.2 of 16.Oct.2026\n");
 
   if (level) {
     printf ("\nThis example program reports in ASCII format the frame sizes\n");
@@ -222,7 +224,7 @@ int main (int argc, char *argv[]) {
   char sync_header = 1;         /* Flag for input BS */
 
   /* File I/O parameter */
-  FILE *Fibs;                   /* Pointer to input encoded bitstream file */
+  BS_MAP *Mibs;                 /* Mapped input encoded bitstream file */
   FILE *Fout = 0;               /* Pointer to ASCII file with frame sizes */
 #ifdef DEBUG
   FILE *F;
@@ -235,23 +237,16 @@ int main (int argc, char *argv[]) {
   /* Aux. variables */
   long no_sizes = -1;           /* No. of diff. frame sizes found in BS */
   long distr[MAX_FRAME];        /* Array with distrib. of frame sizes */
-  short offset = 0;             /* Where is next frame leng.val. in the BS */
+  long offset;                  /* Length of the current frame */
   long max_fr = 0;              /* Max. frame length found in bitstream */
   long min_fr = 100000;         /* Min. frame length found in bitstream */
   double frame_no = 0;          /* Total # of frames in BS */
-  char vbr = 1;                 /* Flag for variable bit rate mode */
-  long ibs_sample_len;          /* Size (bytes) of samples in the BS */
-  char tmp_type;
-  long i;
-  long items;                   /* Number of output elements */
+  long i, f;
 #if defined(VMS)
   char mrs[15] = "mrs=512";
 #endif
   char quiet = 0;
 
-  /* Pointer to a function */
-  long (*read_data) () = read_g192;     /* To read input bitstream */
-
   /* ......... GET PARAMETERS ......... */
 
   /* Check options */
@@ -317,7 +312,7 @@ int main (int argc, char *argv[]) {
   start_frame--;
 
   /* Open files */
-  if ((Fibs = fopen (ibs_file, RB)) == NULL)
+  if ((Mibs = bs_map_open (ibs_file)) == NULL)
     error_terminate ("Could not open input bitstream file\n", 1);
   if (strcmp (out_file, "-") == 0)
     Fout = stdout;
@@ -332,8 +327,8 @@ int main (int argc, char *argv[]) {
 
   /* *** CHECK CONSISTENCY *** */
 
-  /* Do preliminary inspection in the INPUT BITSTREAM FILE to check its format (byte, bit, g192) */
-  i = check_eid_format (Fibs, ibs_file, &tmp_type);
+  /* The format (byte, bit, g192) of the INPUT BITSTREAM FILE was found when mapping it */
+  i = Mibs->format;
 
   /* Check whether the specified BS format matches with the one in the file */
   if (i != bs_format) {
@@ -342,55 +337,10 @@ int main (int argc, char *argv[]) {
     bs_format = i;
   }
 
-  /* Check whether the BS has a sync header */
-  if (tmp_type == FER) {
-    /* The input BS may have a G.192 synchronism header - verify */
-    if (bs_format == g192) {
-      short tmp[2];
-
-      /* Get presumed first G.192 sync header */
-      fread (tmp, sizeof (short), 2, Fibs);
-      /* tmp[1] should have the frame length */
-      i = tmp[1];
-      /* advance file to the (presumed) next G.192 sync header */
-      fseek (Fibs, (long) (tmp[1]) * sizeof (short), SEEK_CUR);
-      /* get (presumed) next G.192 sync header */
-      fread (tmp, sizeof (short), 2, Fibs);
-      /* Verify */
-      /* if (((tmp[0] & 0xFFF0) == 0x6B20) && (i == tmp[1])) */
-      if ((tmp[0] & 0xFFF0) == 0x6B20) {
-        fr_len = i;
-        sync_header = 1;
-        if (i != tmp[1])
-          vbr = 1;
-      } else
-        sync_header = 0;
-    } else if (bs_format == byte) {
-      char tmp[2];
-
-      /* Get presumed first byte-wise G.192 sync header */
-      fread (tmp, sizeof (char), 2, Fibs);
-      /* tmp[1] should have the frame length */
-      i = tmp[1];
-      /* advance file to the (presumed) next byte-wise G.192 sync header */
-      fseek (Fibs, (long) tmp[1], SEEK_CUR);
-      /* get (presumed) next G.192 sync header */
-      fread (tmp, sizeof (char), 2, Fibs);
-      /* Verify */
-      /* if (((tmp[0] & 0xF0) == 0x20) && (i == tmp[1])) */
-      if ((tmp[0] & 0xF0) == 0x20) {
-        fr_len = i;
-        sync_header = 1;
-        if (i != tmp[1])
-          vbr = 1;
-      } else
-        sync_header = 0;
-    } else
-      sync_header = 0;
-
-    /* Rewind file */
-    fseek (Fibs, 0l, SEEK_SET);
-  }
+  /* Check whether the BS has a sync header (i.e. has a frame index) */
+  sync_header = Mibs->sync_header;
+  if (sync_header && Mibs->nframes > 0)
+    fr_len = Mibs->len[0];
 
   /* Can't work with compact or headerless bitstreams: abort */
   if (bs_format == compact)
@@ -401,20 +351,9 @@ int main (int argc, char *argv[]) {
 
   /* *** FINAL INITIALIZATIONS *** */
 
-  /* Use the proper data I/O functions */
-  read_data = bs_format == byte ? read_byte : (bs_format == g192 ? read_g192 : read_bit_ber);
-
-  /* Define BS sample size, in bytes */
-  ibs_sample_len = bs_format == byte ? 1 : (bs_format == g192 ? 2 : 0);
-
-  /* Inspect the bitstream file for variable frame sizes */
-  while (!feof (Fibs)) {
-    /* Move to position where next frame length value is expected */
-    fseek (Fibs, (long) (ibs_sample_len + offset), SEEK_CUR);
-
-    /* Get (presumed) next G.192 sync header */
-    if ((items = read_data (&offset, 1l, Fibs)) != 1)
-      break;
+  /* Inspect the frame index of the bitstream file for variable frame sizes */
+  for (f = 0; f < Mibs->nframes; f++) {
+    offset = Mibs->len[f];
 
     /* Increment conters in histogram */
     distr[offset]++;
@@ -431,20 +370,14 @@ int main (int argc, char *argv[]) {
 
     /* Write frame length to file, if enabled (default) */
     if (log) {
-      if (fprintf (Fout, "%d\n", offset) <= 0)
+      if (fprintf (Fout, "%ld\n", offset) <= 0)
         error_terminate ("Error writing to output ASCII file\n", 5);
     }
 
     /* Increment frame counter */
     frame_no++;
-
-    /* Convert offset number read to no.of bytes */
-    offset *= ibs_sample_len;
   }
 
-  /* Rewind file */
-  fseek (Fibs, 0l, SEEK_SET);
-
   /* Set the frame length to the maximum possible value */
   fr_len = max_fr;
 
@@ -499,7 +432,7 @@ int main (int argc, char *argv[]) {
   free (bs);
 
   /* Close the output file and quit *** */
-  fclose (Fibs);
+  bs_map_close (Mibs);
   if (log)
     fclose (Fout);
 #ifdef DEBUG
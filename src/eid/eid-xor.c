@@ -1,4 +1,4 @@
-/*                                                          02.Feb.2010 v1.2
+/*                                                          16.Oct.2026 v1.3
    =========================================================================
 
    eid-xor.c
@@ -105,6 +105,9 @@
    09.Jun.05 v.1.1 Bug correction during EP file reading. <Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com>
    02.Feb.10 v.1.2 Modified maximum string length for filenames to avoid
                    buffer overruns (y.hiwasaki)
+   16.Oct.26 v.1.3 Input bitstream and error pattern are memory-mapped;
+                   sync header detection and the VBR scan use the frame
+                   index built by bs_map_open()
 
    ========================================================================= */
 
@@ -192,7 +195,7 @@ long insert_errors (short *a, short *b, short *c, long n) {
    --------------------------------------------------------------------------
  */
 void display_usage (int level) {
-  printf ("eid-xor.c - Version 1.2 of 02/Feb/2010 \n\n");
+  printf ("eid-xor.c - Version 1.3 of 16/Oct/2026 \n\n");
 
   if (level) {
     printf ("Program Description:\n");
@@ -317,9 +320,10 @@ int main (int argc, char *argv[]) {
   long wraps = 0;               /* Count how many times wraps the EP file */
 
   /* File I/O parameter */
-  FILE *Fibs;                   /* Pointer to input encoded bitstream file */
+  BS_MAP *Mibs;                 /* Mapped input encoded bitstream file */
   FILE *Fobs;                   /* Pointer to input encoded bitstream file */
-  FILE *Fep;                    /* Pointer to error pattern file */
+  BS_MAP *Mep;                  /* Mapped error pattern file */
+  long ibs_pos = 0, ep_pos = 0; /* Position of next item in BS/EP files */
 #ifdef DEBUG
   FILE *F;
 #endif
@@ -334,7 +338,6 @@ int main (int argc, char *argv[]) {
   double disturbed = 0;         /* # of distorted bits/frames */
   double processed = 0;         /* # of processed bits/frames */
   char vbr = 0;                 /* Flag for variable bit rate mode */
-  long ibs_sample_len;          /* Size (bytes) of samples in the BS */
   char tmp_type;
   long i, k;
   long items;                   /* Number of output elements */
@@ -344,8 +347,6 @@ int main (int argc, char *argv[]) {
   char quiet = 0;
 
   /* Pointer to a function */
-  long (*read_data) () = read_g192;     /* To read input bitstream */
-  long (*read_patt) () = read_g192;     /* To read error pattern */
   long (*save_data) () = save_g192;     /* To save output bitstream */
 
   /* ......... GET PARAMETERS ......... */
@@ -446,9 +447,9 @@ int main (int argc, char *argv[]) {
   start_frame--;
 
   /* Open files */
-  if ((Fibs = fopen (ibs_file, RB)) == NULL)
+  if ((Mibs = bs_map_open (ibs_file)) == NULL)
     error_terminate ("Could not open input bitstream file\n", 1);
-  if ((Fep = fopen (ep_file, RB)) == NULL)
+  if ((Mep = bs_map_open (ep_file)) == NULL)
     error_terminate ("Could not open error pattern file\n", 1);
   if ((Fobs = fopen (obs_file, WB)) == NULL)
     error_terminate ("Could not create output file\n", 1);
@@ -459,8 +460,9 @@ int main (int argc, char *argv[]) {
 
   /* *** CHECK CONSISTENCY *** */
 
-  /* Do preliminary inspection in the INPUT BITSTREAM FILE to check its format (byte, bit, g192) */
-  i = check_eid_format (Fibs, ibs_file, &tmp_type);
+  /* The format (byte, bit, g192) of the INPUT BITSTREAM FILE was found when mapping it */
+  i = Mibs->format;
+  tmp_type = Mibs->type;
 
   /* Check whether the specified BS format matches with the one in the file */
   if (i != bs_format) {
@@ -469,54 +471,14 @@ int main (int argc, char *argv[]) {
     bs_format = i;
   }
 
-  /* Check whether the BS has a sync header */
+  /* Check whether the BS has a sync header (i.e. has a frame index) */
   if (tmp_type == FER) {
-    /* The input BS may have a G.192 synchronism header - verify */
-    if (bs_format == g192) {
-      short tmp[2];
-
-      /* Get presumed first G.192 sync header */
-      fread (tmp, sizeof (short), 2, Fibs);
-      /* tmp[1] should have the frame length */
-      i = tmp[1];
-      /* advance file to the (presumed) next G.192 sync header */
-      fseek (Fibs, (long) (tmp[1]) * sizeof (short), SEEK_CUR);
-      /* get (presumed) next G.192 sync header */
-      fread (tmp, sizeof (short), 2, Fibs);
-      /* Verify */
-      /* if (((tmp[0] & 0xFFF0) == 0x6B20) && (i == tmp[1])) */
-      if ((tmp[0] & 0xFFF0) == 0x6B20) {
-        fr_len = i;
-        sync_header = 1;
-        if (i != tmp[1])
-          vbr = 1;
-      } else
-        sync_header = 0;
-    } else if (bs_format == byte) {
-      char tmp[2];
-
-      /* Get presumed first byte-wise G.192 sync header */
-      fread (tmp, sizeof (char), 2, Fibs);
-      /* tmp[1] should have the frame length */
-      i = tmp[1];
-      /* advance file to the (presumed) next byte-wise G.192 sync header */
-      fseek (Fibs, (long) tmp[1], SEEK_CUR);
-      /* get (presumed) next G.192 sync header */
-      fread (tmp, sizeof (char), 2, Fibs);
-      /* Verify */
-      /* if (((tmp[0] & 0xF0) == 0x20) && (i == tmp[1])) */
-      if ((tmp[0] & 0xF0) == 0x20) {
-        fr_len = i;
-        sync_header = 1;
-        if (i != tmp[1])
-          vbr = 1;
-      } else
-        sync_header = 0;
-    } else
-      sync_header = 0;
-
-    /* Rewind file */
-    fseek (Fibs, 0l, SEEK_SET);
+    sync_header = Mibs->sync_header;
+    if (sync_header && Mibs->nframes > 0) {
+      fr_len = Mibs->len[0];
+      if (Mibs->nframes > 1 && Mibs->len[1] != fr_len)
+        vbr = 1;
+    }
   }
 
   /* If input BS is headerless, any frame size will do; using default */
@@ -524,8 +486,9 @@ int main (int argc, char *argv[]) {
     fr_len = blk;
 
 
-  /* Do preliminary inspection in the ERROR PATTERN FILE to check its format (byte, bit, g192) */
-  i = check_eid_format (Fep, ep_file, &tmp_type);
+  /* The format (byte, bit, g192) of the ERROR PATTERN FILE was found when mapping it */
+  i = Mep->format;
+  tmp_type = Mep->type;
 
   /* Check whether the specified EP format matches with the one in the file */
   if (i != ep_format) {
@@ -569,43 +532,17 @@ int main (int argc, char *argv[]) {
 
   /* *** FINAL INITIALIZATIONS *** */
 
+  /* Softbit values used when expanding compact bitstreams & patterns */
+  if (bs_format == compact)
+    Mibs->type = BER;
+  Mep->type = ep_type;
+
   /* Use the proper data I/O functions */
-  read_data = bs_format == byte ? read_byte : (bs_format == g192 ? read_g192 : read_bit_ber);
-  read_patt = ep_format == byte ? read_byte : (ep_format == g192 ? read_g192 : (ep_type == BER ? read_bit_ber : read_bit_fer));
   save_data = obs_format == byte ? save_byte : (obs_format == g192 ? save_g192 : save_bit);
 
-  /* Define BS sample size, in bytes */
-  ibs_sample_len = bs_format == byte ? 1 : (bs_format == g192 ? 2 : 0);
-
-  /* Inspect the bitstream file for variable frame sizes (i.e. variable bit rate operation of the codec), if the option vbr is set (NOT the default). NOTE: VBR operation is not possible for compact bitstreams! */
-  if (vbr) {
-    /* Two local variables */
-    short offset = 0;           /* Where is next frame leng.val. in the BS */
-    long max_fr_len = fr_len;   /* Maximum frame length found in file */
-
-    /* Scan file for largest frame size */
-    while (!feof (Fibs)) {
-      /* Move to position where next frame length value is expected */
-      fseek (Fibs, (long) (ibs_sample_len + offset), SEEK_CUR);
-
-      /* get (presumed) next G.192 sync header */
-      if ((items = read_data (&offset, 1l, Fibs)) != 1)
-        break;
-
-      /* We have a different frame length here! */
-      if (offset > max_fr_len)
-        max_fr_len = offset;
-
-      /* Convert offset number read to no.of bytes */
-      offset *= ibs_sample_len;
-    }
-
-    /* Rewind file */
-    fseek (Fibs, 0l, SEEK_SET);
-
-    /* Set the frame length to the maximum possible value */
-    fr_len = max_fr_len;
-  }
+  /* Use the frame index of the bitstream file to find the largest frame size (i.e. variable bit rate operation of the codec), if the option vbr is set (NOT the default). NOTE: VBR operation is not possible for compact bitstreams! */
+  if (vbr && Mibs->max_len > fr_len)
+    fr_len = Mibs->max_len;
 
   /* Define how many samples are read for each frame */
   /* Bitstream may have sync headers, which are 2 samples-long */
@@ -649,50 +586,45 @@ int main (int argc, char *argv[]) {
       /* Read one frame from BS: two steps for VBR mode, one otherwise */
       if (vbr) {
         /* Get sync header to see how many samples are in this frame */
-        if ((items = read_data (bs, 2l, Fibs)) != 2)
+        if ((items = bs_map_read (Mibs, ibs_pos, 2l, bs)) != 2)
           break;
         fr_len = bs[1];
         bs_len = sync_header ? fr_len + 2 : fr_len;
 
         /* ... and read payload, if not an empty frame */
         if (fr_len != 0)
-          items += read_data (payload, fr_len, Fibs);
+          items += bs_map_read (Mibs, ibs_pos + 2, fr_len, payload);
       } else
         /* Read one whole frame from bitstream */
-        items = read_data (bs, bs_len, Fibs);
+        items = bs_map_read (Mibs, ibs_pos, bs_len, bs);
+      ibs_pos += items;
 
       /* Stop when reaches end-of-file */
       if (items == 0)
         break;
 
-      /* Aborts on error */
-      if (items < 0)
-        KILL (ibs_file, 7);
-
       /* Check if read all expected samples; if not, take a special action */
       if (items < bs_len) {
         if (sync_header) {
           /* If the bitstream has sync header, this situation should not occur, since the length of the input bitstream file should be a multiple of the frame size! The file is either invalid otr corrupt. Execution is aborted at this point */
           fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this bitstream file is not multiple  ***", "*** of the given frame length. Check that the correct  ***", "*** frame size was used (is this a variable-frame size ***", "*** file?) and that the bitstream is not corrupted.***");
           exit (9);
-        } else if (feof (Fibs)) {
+        } else {
           /* EOF reached. Since the input bitstream is headerless, this maybe a corrupt file, or the user simply specified the wrong frame size. Warn the user and continue */
           fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this HEADERLESS bitstream is not ***", "*** multiple of the given frame length. Check that ***", "*** the correct frame size was selected & that the ***", "*** bitstream file is not corrupted.***");
           bs_len = fr_len = items;
-        } else                  /* An unknown error happened! */
-          KILL (ibs_file, 7);
+        }
       }
       /* Read a number of erasure flags from file */
       while (k == 0) {
         /* No EP flags in buffer; read a number of them */
-        ep_true_len = k = read_patt (ep, ep_len, Fep);
+        ep_true_len = k = bs_map_read (Mep, ep_pos, ep_len, ep);
+        ep_pos += k;
 
-        /* No flags read - either error or EOF */
+        /* No flags read - EOF */
         /* Go back to beginning of EP & fill up EP buffer */
-        if (k <= 0) {
-          if (k < 0)
-            KILL (ep_file, 7);  /* Error: abort */
-          fseek (Fep, 0l, SEEK_SET);    /* EOF: Rewind */
+        if (k == 0) {
+          ep_pos = 0;           /* EOF: Rewind */
           wraps++;              /* Count how many times wrapped EP */
         }
       }
@@ -726,54 +658,48 @@ int main (int argc, char *argv[]) {
       /* Read one frame from BS: two steps for VBR mode, one otherwise */
       if (vbr) {
         /* Get sync header to see how many samples are in this frame */
-        if ((items = read_data (bs, 2l, Fibs)) != 2)
+        if ((items = bs_map_read (Mibs, ibs_pos, 2l, bs)) != 2)
           break;
         fr_len = bs[1];
         bs_len = sync_header ? fr_len + 2 : fr_len;
 
         /* ... and read payload, if not an empty frame */
         if (fr_len != 0)
-          items += read_data (payload, fr_len, Fibs);
+          items += bs_map_read (Mibs, ibs_pos + 2, fr_len, payload);
       } else
         /* Read one whole frame from bitstream */
-        items = read_data (bs, bs_len, Fibs);
+        items = bs_map_read (Mibs, ibs_pos, bs_len, bs);
+      ibs_pos += items;
 
       /* Stop when reaches end-of-file */
       if (items == 0)
         break;
 
-      /* Aborts on error */
-      if (items < 0)
-        KILL (ibs_file, 7);
-
       /* Check if read all expected samples; if not, probably hit EOF */
       if (items < bs_len) {
         if (sync_header) {
           /* This situation should not occur in a headed BS - Abort */
           fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this bitstream file is not multiple  ***", "*** of the given frame length. Check that the correct  ***", "*** frame size was used (is this a variable-frame size ***", "*** file?) and that the bitstream is not corrupted.***");
           exit (9);
-        } else if (feof (Fibs)) {
+        } else {
           /* Headerless BS is corrupted or wrong frame size was used */
           /* This is not important for BER, so the msg is not printed */
 #ifdef DEBUG
           fprintf (stderr, "%s\n%s\n%s\n%s\n", "*** File size for this HEADERLESS bitstream is not ***", "*** multiple of the given frame length. Check that ***", "*** the correct frame size was selected & that the ***", "*** bitstream file is not corrupted.***");
 #endif
           bs_len = fr_len = items;
-        } else                  /* An unknown error happened! */
-          KILL (ibs_file, 7);
+        }
       }
 
       /* Read one error pattern frame from file */
-      items = read_patt (ep, ep_len, Fep);
+      items = bs_map_read (Mep, ep_pos, ep_len, ep);
+      ep_pos += items;
 
       /* Treat case when EP finishes before BS: */
       /* Go back to beginning of EP & fill up EP buffer */
       if (items < ep_len) {
-        if (items < 0)
-          KILL (ep_file, 7);
         k = ep_len - items;     /* Number of missing EP samples */
-        fseek (Fep, 0l, SEEK_SET);      /* Rewind */
-        items = read_patt (&ep[items], k, Fep); /* Fill-up EP buffer */
+        ep_pos = bs_map_read (Mep, 0l, k, &ep[items]);  /* Rewind & fill-up EP buffer */
 
         /* Count how many times wrapped the EP file */
         wraps++;
@@ -828,8 +754,8 @@ int main (int argc, char *argv[]) {
   free (bs);
 
   /* Close the output file and quit *** */
-  fclose (Fibs);
-  fclose (Fep);
+  bs_map_close (Mibs);
+  bs_map_close (Mep);
   fclose (Fobs);
 #ifdef DEBUG
   fclose (F);
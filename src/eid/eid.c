@@ -1,4 +1,4 @@
-/*                                                            02.Feb.2010  v2.7
+/*                                                            16.Oct.2026  v2.8
   =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -80,6 +80,14 @@ FUNCTIONS       : - open_eid (double ber, double gamma)
                                       in one call.
                      Output: EPbuff = array, containing the error pattern
 
+                  - BER_generator_packed (SCD_EID *EID, long lseg,
+                                          PBS_WORD *mask, int mode)
+                     Same as BER_generator, with the error pattern as
+                     packed bits. In mode EID_BER_COMPAT the same
+                     sequence as BER_generator is produced; in mode
+                     EID_BER_FAST the pattern is produced 64 bits at a
+                     time (statistically equivalent, different sequence).
+
                   - BER_insertion (long lseg, short *ibuff,
                                               short *obuff, short *EPbuff)
                      Disturbes the input data bits according the error
@@ -119,11 +127,25 @@ FUNCTIONS       : - open_eid (double ber, double gamma)
                      Frees memmory allocated to the EID state variables'
                      buffer.
 
+                  - copy_eid (SCD_EID *EID)
+                     Creates an independent copy of an EID struct.
+
+                  - EID_random_skip (unsigned long *seed, unsigned long n)
+                     Advances a seed of the EID random number generator
+                     by n numbers, in O(log n) operations.
+
 		   - open_burst_eid(long index);
 
 		   - FER_generator_burst(BURST_EID *state);
                    - reset_burst_eid(BURST_EID *burst_eid);
 
+                  - BER_insertion_packed (long nbits, PBS_WORD *xbits,
+                                          PBS_WORD *ybits, PBS_WORD *ep)
+                  - FER_module_packed (SCD_EID *EID, PACKED_BS *bs,
+                                       long frame)
+                     Same as BER_insertion and FER_module, on packed
+                     (hard-bit) bitstreams; see bitpack.h.
+
  HISTORY:
   28.Feb.92 v1.0 1st UGST version
   20.Apr.92 v2.0 Modifications on the RNG
@@ -142,6 +164,15 @@ FUNCTIONS       : - open_eid (double ber, double gamma)
                  to extend Bellcore burst model resolution and operating
                  range to [0.5-30%]. <J.Sv. Ericsson>
   02.Feb.10 v2.7 Modified maximum string lenght for filenames (y.hiwasaki)
+  16.Oct.26 v2.8 Added BER_insertion_packed() and FER_module_packed(),
+                 operating in place on packed bitstreams.
+  16.Oct.26 v2.9 BER_generator() compares the seed against integer
+                 thresholds instead of computing doubles (same
+                 sequence); added BER_generator_packed() with a fast
+                 word-parallel mode; EID_random() no longer calls pow()
+                 on every call.
+  16.Oct.26 v2.10 Added EID_random_skip() and copy_eid(), for the
+                 generation of patterns in independent chunks.
   =============================================================================
 */
 
@@ -467,6 +498,8 @@ int PORTABILITY_TEST_OPERATION = 1;
 #include <stdlib.h>
 #include <ctype.h>
 #include <stdio.h>
+#include <string.h>             /* memset */
+#include <limits.h>             /* ULONG_MAX */
 
 /* ......... Include of EID prototypes and definitions .........*/
 #include "eid.h"
@@ -476,6 +509,9 @@ double EID_random ARGS ((unsigned long *seed));
 void update_EID_random ARGS ((long len_register, long *shift_register));
 long GEC_init ARGS ((SCD_EID * EID, double ber, double gamma));
 double bfer_comp (long index);
+static double EID_scale ARGS ((void));
+static EID_TABLES *EID_tables ARGS ((SCD_EID * EID));
+static void free_EID_tables ARGS ((EID_TABLES * tab));
 /* ......... Global variable: Bellcore Model Transition probability vector ......... */
 /* ......... prob[0]=P0 updated from command line, using function bfer_comp......... */
 double prob[MODEL_SIZE] = { 0.0023, 0.85, 0.825, 0.8, 0.775, 0.75, 0.725, 0.7, 0.6, 0.45, 0.0 };
@@ -533,6 +569,9 @@ SCD_EID *open_eid (double ber, double gamma) {
   EID->seed = (unsigned long) t1;
 
 
+  /* Tables for the generators are built on first use */
+  EID->tab = (EID_TABLES *) 0;
+
   /* Initialize Gilbert-Elliot Channel model */
   if (GEC_init (EID, ber, gamma) == 0L)
     return ((SCD_EID *) 0);
@@ -594,6 +633,9 @@ void close_eid (EID)
   /* Free memory of bit error array */
   free ((char *) EID->ber);
 
+  /* Free generator tables */
+  free_EID_tables (EID->tab);
+
   /* Free EID structure */
   free ((char *) EID);
 }
@@ -601,6 +643,68 @@ void close_eid (EID)
 /* ....................... End of close_eid() ....................... */
 
 
+/*
+  ============================================================================
+
+        SCD_EID *copy_eid (SCD_EID *EID);
+        ~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Allocate a new EID struct with the same channel model and state
+        (seed, current state, matrix and bit error rates) as EID. The
+        copy shares no memory with EID, so that both can be used at the
+        same time (e.g. on different threads). Release with close_eid().
+
+        Parameters:
+        ~~~~~~~~~~~
+        EID: ..... (In) pointer to struct SCD_EID
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns a pointer to the new struct SCD_EID, or a null pointer
+        if memory could not be allocated.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+SCD_EID *copy_eid (EID)
+     SCD_EID *EID;
+{
+  SCD_EID *cp;
+  long i, j;
+
+
+  /* Allocate EID structure; a channel model with the right number of states */
+  if ((cp = (SCD_EID *) malloc (sizeof (SCD_EID))) == 0L)
+    return ((SCD_EID *) 0);
+  cp->tab = (EID_TABLES *) 0;
+  if (GEC_init (cp, EID->usrber, EID->usrgamma) == 0L || cp->nstates != EID->nstates) {
+    free (cp);
+    return ((SCD_EID *) 0);
+  }
+
+  /* Copy state and model */
+  cp->seed = EID->seed;
+  cp->current_state = EID->current_state;
+  cp->usrber = EID->usrber;
+  cp->usrgamma = EID->usrgamma;
+  for (i = 0; i < EID->nstates; i++) {
+    cp->ber[i] = EID->ber[i];
+    for (j = 0; j < EID->nstates; j++)
+      cp->matrix[i][j] = EID->matrix[i][j];
+  }
+
+  return (cp);
+}
+
+/* ....................... End of copy_eid() ....................... */
+
+
 
 /*
   ============================================================================
@@ -640,12 +744,46 @@ double BER_generator (EID, lseg, EPbuff)
 {
   long i, n;                    /* value of random generator */
   double RAN, ber;              /* aux. for computing bit error rate */
+  EID_TABLES *tab;
+  unsigned long seed, *lim;
+  long ns, cur;
+  char *any;
 
 
   /* Return if no samples are to be processed */
   if (lseg == (long) 0)
     return (0.0);
 
+  /* Use the integer thresholds, if available: RAN < thr is the same as seed <= lim */
+  if ((tab = EID_tables (EID)) != (EID_TABLES *) 0) {
+    ns = EID->nstates;
+    cur = EID->current_state;
+    seed = EID->seed;
+    lim = tab->lim;
+    any = tab->any;
+    ber = 0.0;
+    for (i = 0; i < lseg; i++) {
+      /* Check the new channel state */
+      seed = (unsigned long) 69069L *seed + 1L;
+      for (n = 0; n < ns; n++)
+        if (any[cur * ns + n] && seed <= lim[cur * ns + n]) {
+          cur = n;
+          break;
+        }
+
+      /* Compute bit error in current state */
+      seed = (unsigned long) 69069L *seed + 1L;
+      if (any[ns * ns + cur] && seed <= lim[ns * ns + cur]) {
+        EPbuff[i] = (short) 0x0081;
+        ber += 1.0;
+      } else
+        EPbuff[i] = (short) 0x007F;
+    }
+    EID->current_state = cur;
+    EID->seed = seed;
+    return (ber);
+  }
+
   /* Generate random bits */
   ber = 0.0;
   for (i = 0; i < lseg; i++) {
@@ -684,6 +822,231 @@ double BER_generator (EID, lseg, EPbuff)
 /* ....................... End of BER_generator() ....................... */
 
 
+/*
+  ============================================================================
+
+        double BER_generator_packed (SCD_EID *EID, long lseg,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~  PBS_WORD *mask, int mode);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Generates a bit error pattern as packed bits (bit i of the
+        pattern is bit i%64 of mask[i/64], '1' meaning a bit error),
+        according to the selected channel model. Unused bits of the
+        last word are cleared, so that the mask can be used directly
+        with BER_insertion_packed().
+
+        In mode EID_BER_COMPAT, the random numbers and the channel
+        state are updated exactly as by BER_generator(), and the same
+        pattern is produced.
+
+        In mode EID_BER_FAST, the pattern has the same statistics but
+        a different sequence. The time spent in each channel state is
+        drawn at once as a geometric run length, so that long stretches
+        of the GOOD state (no errors) cost a single random number.
+        Inside a run, errors are placed by geometric skipping when the
+        bit error rate is low, or drawn 64 bits at a time otherwise
+        (one random word per binary digit of the bit error rate; a
+        single word for the usual BAD state rate of 0.5). This mode
+        uses its own 64-bit generator, seeded from and saved back to
+        EID->seed.
+
+        Parameters:
+        ~~~~~~~~~~~
+        EID: ...... (In/Out) struct with channel model
+        lseg: ..... (In)     number of bits
+        mask: ..... (Out)    bit error pattern, PBS_WORDS(lseg) words
+        mode: ..... (In)     EID_BER_COMPAT or EID_BER_FAST
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of bit errors as a double.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+
+/* Next value of the 64-bit generator of the fast mode (splitmix64) */
+static PBS_WORD EID_rng64 (PBS_WORD * s) {
+  PBS_WORD z = (*s += (PBS_WORD) 0x9E3779B97F4A7C15ULL);
+
+  z = (z ^ (z >> 30)) * (PBS_WORD) 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * (PBS_WORD) 0x94D049BB133111EBULL;
+  return (z ^ (z >> 31));
+}
+
+/* Number of failures before the first success, for log(1-p) = lq; capped at max */
+static long EID_geometric (PBS_WORD * s, double lq, long max) {
+  double u, g;
+
+  if (lq == 0.0)
+    return (max);
+  u = ((double) (EID_rng64 (s) >> 11) + 1.0) * (1.0 / 9007199254740992.0);
+  g = floor (log (u) / lq);
+  return (g >= (double) max ? max : (long) g);
+}
+
+/* Number of bits kept in state s, capped at max: short runs are drawn bit by bit, long ones as a geometric number */
+static long EID_run (EID_TABLES * tab, long s, long max) {
+  long k;
+
+  if (tab->fstay[s] >= 0xC0000000UL)
+    return (EID_geometric (&tab->rng, tab->lstay[s], max));
+  for (k = 0; k < max && (unsigned long) (EID_rng64 (&tab->rng) >> 32) < tab->fstay[s]; k++);
+  return (k);
+}
+
+/* Number of bits set */
+static long EID_popcount (PBS_WORD w) {
+  w = w - ((w >> 1) & (PBS_WORD) 0x5555555555555555ULL);
+  w = (w & (PBS_WORD) 0x3333333333333333ULL) + ((w >> 2) & (PBS_WORD) 0x3333333333333333ULL);
+  w = (w + (w >> 4)) & (PBS_WORD) 0x0F0F0F0F0F0F0F0FULL;
+  return ((long) ((w * (PBS_WORD) 0x0101010101010101ULL) >> 56));
+}
+
+/* Set bits [pos, pos+len) of mask with probability given by the tables of state s; return the number of bits set */
+static long EID_errors (EID_TABLES * tab, long s, PBS_WORD * mask, long pos, long len) {
+  long end = pos + len, cnt = 0, w, i, first;
+  unsigned long f = tab->fber[s];
+  PBS_WORD m, r, keep;
+
+  if (len <= 0 || f == 0)
+    return (0);
+
+  /* Low error rate: skip to the next error */
+  if (f < 0x04000000UL) {
+    pos += EID_geometric (&tab->rng, tab->lber[s], len);
+    while (pos < end) {
+      mask[pos / PBS_BITS] |= (PBS_WORD) 1 << (pos % PBS_BITS);
+      cnt++;
+      pos += 1 + EID_geometric (&tab->rng, tab->lber[s], end - pos);
+    }
+    return (cnt);
+  }
+
+  /* Otherwise draw a word at a time, one binary digit of the rate per random word, from the least significant non-zero digit up */
+  for (first = 0; !((f >> first) & 1); first++);
+  for (w = pos / PBS_BITS; w * PBS_BITS < end; w++) {
+    if (tab->src[tab->nstates * tab->nstates + s] >= 1.0)
+      m = ~(PBS_WORD) 0;
+    else
+      for (m = 0, i = first; i < 32; i++) {
+        r = EID_rng64 (&tab->rng);
+        m = ((f >> i) & 1) ? (m | r) : (m & r);
+      }
+    keep = ~(PBS_WORD) 0;
+    if (w * PBS_BITS < pos)
+      keep <<= pos % PBS_BITS;
+    if ((w + 1) * PBS_BITS > end)
+      keep &= ~(PBS_WORD) 0 >> (PBS_BITS - end % PBS_BITS);
+    mask[w] |= m & keep;
+    cnt += EID_popcount (m & keep);
+  }
+  return (cnt);
+}
+
+double BER_generator_packed (EID, lseg, mask, mode)
+     SCD_EID *EID;
+     long lseg;
+     PBS_WORD *mask;
+     int mode;
+{
+  EID_TABLES *tab;
+  long i, n, ns, cur, pos, run;
+  unsigned long seed, *lim;
+  char *any;
+  double ber, u, *trans;
+  short ep[PBS_BITS];
+
+
+  /* Clear the mask */
+  memset (mask, 0, PBS_WORDS (lseg) * sizeof (PBS_WORD));
+
+  /* Return if no samples are to be processed */
+  if (lseg <= 0)
+    return (0.0);
+
+  /* Without tables, go through the softbit generator */
+  if ((tab = EID_tables (EID)) == (EID_TABLES *) 0) {
+    ber = 0.0;
+    for (pos = 0; pos < lseg; pos += PBS_BITS) {
+      n = lseg - pos < PBS_BITS ? lseg - pos : PBS_BITS;
+      ber += BER_generator (EID, n, ep);
+      g192_to_packed (ep, mask + pos / PBS_BITS, n);
+    }
+    return (ber);
+  }
+
+  ns = EID->nstates;
+  cur = EID->current_state;
+  ber = 0.0;
+
+  if (mode != EID_BER_FAST) {
+    /* Same sequence as BER_generator() */
+    seed = EID->seed;
+    lim = tab->lim;
+    any = tab->any;
+    for (i = 0; i < lseg; i++) {
+      seed = (unsigned long) 69069L *seed + 1L;
+      for (n = 0; n < ns; n++)
+        if (any[cur * ns + n] && seed <= lim[cur * ns + n]) {
+          cur = n;
+          break;
+        }
+      seed = (unsigned long) 69069L *seed + 1L;
+      if (any[ns * ns + cur] && seed <= lim[ns * ns + cur]) {
+        mask[i / PBS_BITS] |= (PBS_WORD) 1 << (i % PBS_BITS);
+        ber += 1.0;
+      }
+    }
+    EID->seed = seed;
+    EID->current_state = cur;
+    return (ber);
+  }
+
+  /* Fast mode: resync the generator if the seed was changed from outside */
+  if (EID->seed != tab->rng_seed)
+    tab->rng = (PBS_WORD) EID->seed;
+  trans = tab->trans;
+
+  /* The first bit may leave the current state; each later run starts with the bit that entered the state. Geometric run lengths are memoryless, so no run is carried over between calls. */
+  run = EID_run (tab, cur, lseg);
+  ber += EID_errors (tab, cur, mask, 0, run);
+  for (pos = run; pos < lseg; pos += run) {
+    /* Select the next state among the ones != cur */
+    if (ns == 2)
+      cur = 1 - cur;
+    else {
+      u = (double) (EID_rng64 (&tab->rng) >> 11) * (1.0 / 9007199254740992.0);
+      u *= 1.0 - trans[cur * ns + cur];
+      for (i = cur, n = 0; n < ns; n++) {
+        if (n == cur || trans[cur * ns + n] <= 0.0)
+          continue;
+        i = n;
+        if (u < trans[cur * ns + n])
+          break;
+        u -= trans[cur * ns + n];
+      }
+      cur = i;
+    }
+
+    run = 1 + EID_run (tab, cur, lseg - pos - 1);
+    ber += EID_errors (tab, cur, mask, pos, run);
+  }
+
+  EID->current_state = cur;
+  EID->seed = (unsigned long) tab->rng;
+  tab->rng_seed = EID->seed;
+  return (ber);
+}
+
+/* ..................... End of BER_generator_packed() ..................... */
+
+
 /*
   ============================================================================
 
@@ -1212,6 +1575,127 @@ double FER_module_stl96 (EID, lseg, xbuff, ybuff)
 /* ....................... End of FER_module_stl96() ....................... */
 
 
+/*
+  ============================================================================
+
+        void BER_insertion_packed (long nbits, PBS_WORD *xbits,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~  PBS_WORD *ybits, PBS_WORD *ep);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Disturbing a packed bitstream according to a packed error
+        pattern (see bitpack.h), 64 bits at a time. A '1' in the
+        error pattern flips the corresponding bit. For hard bits and
+        a hard-bit error pattern, this is the same operation as
+        BER_insertion_stl96() on the data bits of a frame. The input
+        must not be an erased frame. ybits may be the same as xbits.
+
+        Parameters:
+        ~~~~~~~~~~~
+        nbits: ... number of data bits
+        xbits: ... packed input (undisturbed) bits
+        ybits: ... packed output (disturbed) bits
+        ep: ...... packed error pattern
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+void BER_insertion_packed (nbits, xbits, ybits, ep)
+     long nbits;
+     PBS_WORD *xbits;
+     PBS_WORD *ybits;
+     PBS_WORD *ep;
+{
+  long i, nw = PBS_WORDS (nbits);
+
+  for (i = 0; i < nw; i++)
+    ybits[i] = xbits[i] ^ ep[i];
+
+  /* Keep the unused bits of the last word cleared */
+  if (nbits % PBS_BITS)
+    ybits[nw - 1] &= ((PBS_WORD) 1 << (nbits % PBS_BITS)) - 1;
+}
+
+/* ..................... End of BER_insertion_packed() ..................... */
+
+
+/*
+  ============================================================================
+
+        double FER_module_packed (SCD_EID *EID, PACKED_BS *bs,
+        ~~~~~~~~~~~~~~~~~~~~~~~~  long frame);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Frame erasure on frame `frame' of a packed bitstream, in
+        place. The same random numbers as in FER_module_stl96() are
+        drawn, so that the same EID state erases the same frames. An
+        erased frame gets its sync word modified as in
+        FER_module_stl96() and is flagged as erased, which converts
+        back to G.192 softbits of 0x0000.
+
+        Parameters:
+        ~~~~~~~~~~~
+        EID: ..... pointer to EID struct.
+        bs: ...... packed bitstream
+        frame: ... index of the frame in bs
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns (double)1 if the frame has been erased, and (double)0
+        otherwise.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+double FER_module_packed (EID, bs, frame)
+     SCD_EID *EID;
+     PACKED_BS *bs;
+     long frame;
+{
+  long n;
+  double RAN;
+
+
+  /* Get next random number */
+  RAN = EID_random (&(EID->seed));
+
+  /* See if another channel state has to be entered */
+  for (n = 0; n < EID->nstates; n++) {
+    if (RAN < EID->matrix[EID->current_state][n]) {
+      EID->current_state = n;   /* go to the selected state */
+      n = EID->nstates;         /* -> aborts loop */
+    }
+  }
+
+  /* Get next random number */
+  RAN = EID_random (&(EID->seed));
+
+  /* Erase the frame if below the threshold of the current state */
+  if (RAN < EID->ber[EID->current_state]) {
+    bs->sync[frame] &= 0x0000FFF0;
+    bs->erased[frame] = 1;
+    memset (packed_bs_frame (bs, frame), 0, PBS_WORDS (bs->len[frame]) * sizeof (PBS_WORD));
+    return (1.0);
+  }
+  return (0.0);
+}
+
+/* ...................... End of FER_module_packed() ...................... */
+
+
 /*
   ============================================================================
 
@@ -1252,9 +1736,6 @@ double FER_module_stl96 (EID, lseg, xbuff, ybuff)
 double EID_random (seed)
      unsigned long *seed;
 {
-  /* Size in bits (=size in bytes * 8) for long variables */
-  static double bits_in_long = sizeof (long) * 8;
-
   /* Update RNG */
   *seed = ((unsigned long) 69069L * (*seed) + 1L);
 
@@ -1262,13 +1743,264 @@ double EID_random (seed)
 #ifdef WAS
   return (pow ((double) 2.0, (double) -32.0) * (double) (*seed));
 #else
-  return (pow ((double) 2.0, -bits_in_long) * (double) (*seed));
+  return (EID_scale () * (double) (*seed));
 #endif
 }
 
 /* ....................... End of EID_random() ....................... */
 
 
+/*
+  ============================================================================
+
+        void EID_random_skip (unsigned long *seed, unsigned long n);
+        ~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Advances the seed of the LCG of EID_random() (and of
+        FER_generator_burst()) as if n random numbers had been drawn.
+        n steps of seed = a*seed + c amount to seed = A*seed + C, with
+        A = a^n and C = c*(a^(n-1) + ... + a + 1); both are computed by
+        squaring, in O(log n) multiplications. All arithmetic is modulo
+        2^(bits in a long), as in EID_random(), so the result is exact.
+
+        Parameters:
+        ~~~~~~~~~~~
+        seed: ... (In/Out) seed of the generator
+        n: ...... (In) number of random numbers to skip
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+void EID_random_skip (seed, n)
+     unsigned long *seed;
+     unsigned long n;
+{
+  unsigned long A = 1, C = 0;   /* accumulated step */
+  unsigned long a = 69069L, c = 1L;     /* step for 2^k numbers */
+
+  while (n) {
+    if (n & 1) {
+      A = a * A;
+      C = a * C + c;
+    }
+    c = (a + 1) * c;
+    a = a * a;
+    n >>= 1;
+  }
+  *seed = A * (*seed) + C;
+}
+
+/* ....................... End of EID_random_skip() ....................... */
+
+
+/*
+  ============================================================================
+
+        static double EID_scale (void);
+        ~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Returns 2^-(bits in a long), the factor that maps the seed of
+        EID_random() onto [0..1]. No state, hence safe on concurrent
+        threads.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created, out of EID_random().
+
+ ============================================================================
+*/
+static double EID_scale () {
+  /* 2^-(size in bits (=size in bytes * 8) of long variables) */
+  return (ldexp (1.0, -(int) (sizeof (long) * 8)));
+}
+
+/* ....................... End of EID_scale() ....................... */
+
+
+/*
+  ============================================================================
+
+        static EID_TABLES *EID_tables (SCD_EID *EID);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Returns the generator tables of an EID struct, (re)building
+        them if the transition matrix or the bit error rates changed
+        since they were last built (e.g. by set_GEC_matrix()).
+
+        For each threshold thr, the largest seed `lim' for which
+        EID_random() returns a value below thr is found by bisection,
+        evaluating the same double expression as EID_random(). Since
+        that expression never decreases with the seed, `RAN < thr' is
+        then exactly `seed <= lim' (or never true, when `any' is 0).
+
+        For the fast mode, the transition probabilities implied by the
+        (cumulative) thresholds are stored, together with the log of
+        the probability of staying in each state, log(1-ber), and the
+        probability of staying and the bit error rate as 32-bit binary
+        fractions.
+
+        Parameters:
+        ~~~~~~~~~~~
+        EID: ..... pointer to EID struct
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Pointer to the tables, or a null pointer if memory could not
+        be allocated.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static EID_TABLES *EID_tables (EID)
+     SCD_EID *EID;
+{
+  EID_TABLES *tab = EID->tab;
+  long ns = EID->nstates, nt = ns * ns + ns, i, j;
+  unsigned long lo, hi, mid;
+  double thr, scale = EID_scale (), covered, leave, b;
+
+  /* Check if the tables are up to date */
+  if (tab != (EID_TABLES *) 0 && tab->nstates == ns) {
+    for (i = 0; i < ns; i++)
+      for (j = 0; j < ns; j++)
+        if (tab->src[i * ns + j] != EID->matrix[i][j])
+          goto rebuild;
+    for (i = 0; i < ns; i++)
+      if (tab->src[ns * ns + i] != EID->ber[i])
+        goto rebuild;
+    return (tab);
+  }
+
+rebuild:
+  if (tab == (EID_TABLES *) 0 || tab->nstates != ns) {
+    free_EID_tables (tab);
+    EID->tab = (EID_TABLES *) 0;
+    if ((tab = (EID_TABLES *) calloc (1, sizeof (EID_TABLES))) == (EID_TABLES *) 0)
+      return ((EID_TABLES *) 0);
+    tab->nstates = ns;
+    tab->src = (double *) malloc (nt * sizeof (double));
+    tab->lim = (unsigned long *) malloc (nt * sizeof (unsigned long));
+    tab->any = (char *) malloc (nt * sizeof (char));
+    tab->trans = (double *) malloc (ns * ns * sizeof (double));
+    tab->lstay = (double *) malloc (ns * sizeof (double));
+    tab->lber = (double *) malloc (ns * sizeof (double));
+    tab->fber = (unsigned long *) malloc (ns * sizeof (unsigned long));
+    tab->fstay = (unsigned long *) malloc (ns * sizeof (unsigned long));
+    if (!tab->src || !tab->lim || !tab->any || !tab->trans || !tab->lstay || !tab->lber || !tab->fber || !tab->fstay) {
+      free_EID_tables (tab);
+      return ((EID_TABLES *) 0);
+    }
+    /* Force a resync of the fast generator */
+    tab->rng_seed = ~EID->seed;
+    EID->tab = tab;
+  }
+
+  /* Thresholds for the compatible mode */
+  for (i = 0; i < ns; i++)
+    for (j = 0; j < ns; j++)
+      tab->src[i * ns + j] = EID->matrix[i][j];
+  for (i = 0; i < ns; i++)
+    tab->src[ns * ns + i] = EID->ber[i];
+  for (i = 0; i < nt; i++) {
+    thr = tab->src[i];
+    if ((tab->any[i] = (char) (scale * 0.0 < thr)) == 0)
+      continue;
+    lo = 0;
+    hi = ULONG_MAX;
+    if (scale * (double) hi < thr)
+      lo = hi;
+    while (hi - lo > 1) {
+      mid = lo + (hi - lo) / 2;
+      if (scale * (double) mid < thr)
+        lo = mid;
+      else
+        hi = mid;
+    }
+    tab->lim[i] = lo;
+  }
+
+  /* Probabilities for the fast mode: the first threshold above RAN selects the next state, and the state is kept if there is none */
+  for (i = 0; i < ns; i++) {
+    covered = 0.0;
+    for (j = 0; j < ns; j++) {
+      thr = EID->matrix[i][j] > 1.0 ? 1.0 : EID->matrix[i][j];
+      tab->trans[i * ns + j] = thr > covered ? thr - covered : 0.0;
+      if (thr > covered)
+        covered = thr;
+    }
+    tab->trans[i * ns + i] += 1.0 - covered;
+    leave = 1.0 - tab->trans[i * ns + i];
+    tab->lstay[i] = leave <= 0.0 ? 0.0 : (leave >= 1.0 ? -HUGE_VAL : log (1.0 - leave));
+    tab->fstay[i] = leave >= 1.0 ? 0 : (unsigned long) ((1.0 - leave) * 4294967296.0);
+
+    b = EID->ber[i] < 0.0 ? 0.0 : (EID->ber[i] > 1.0 ? 1.0 : EID->ber[i]);
+    tab->lber[i] = b >= 1.0 ? -HUGE_VAL : log (1.0 - b);
+    tab->fber[i] = b >= 1.0 ? 0xFFFFFFFFUL : (unsigned long) (b * 4294967296.0);
+    if (tab->fber[i] == 0 && b > 0.0)
+      tab->fber[i] = 1;
+  }
+
+  return (tab);
+}
+
+/* ....................... End of EID_tables() ....................... */
+
+
+/*
+  ============================================================================
+
+        static void free_EID_tables (EID_TABLES *tab);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Release the memory of the generator tables (if any).
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static void free_EID_tables (tab)
+     EID_TABLES *tab;
+{
+  if (tab == (EID_TABLES *) 0)
+    return;
+  free (tab->src);
+  free (tab->lim);
+  free (tab->any);
+  free (tab->trans);
+  free (tab->lstay);
+  free (tab->lber);
+  free (tab->fber);
+  free (tab->fstay);
+  free (tab);
+}
+
+/* ....................... End of free_EID_tables() ....................... */
+
+
 /*
   ============================================================================
 
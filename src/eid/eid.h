@@ -1,6 +1,6 @@
 /*
   ============================================================================
-   File: EID.H                                                      11.AUG.97
+   File: EID.H                                                      16.OCT.26
   ============================================================================
 
                       UGST/ITU-T ERROR INSERTION MODULE
@@ -16,11 +16,15 @@
                         <Morgan.Lindqvist@era-t.ericsson.se> comments for the
 		        cc compiler in a DEC Alpha Unix machine.
    10.Oct.97    v2.4    Added prototype for reset_burst_eid() <simao>   
+   16.Oct.26    v2.5    Added prototypes for packed bitstreams
+   16.Oct.26    v2.6    Added EID_TABLES and BER_generator_packed()
+   16.Oct.26    v2.7    Added copy_eid(), EID_random_skip(); prototype of close_eid()
   ============================================================================
 */
 
 #include <math.h>               /* RTL Math Function Declarations */
 #include <stdlib.h>             /* General utility definitions */
+#include "bitpack.h"            /* Packed bitstreams */
 
 #ifndef EID_defined
 #define EID_defined 300
@@ -43,6 +47,30 @@
 #define CONST static
 #endif
 
+/* 
+ * ......... Tables derived from the channel model, built on demand ......... 
+ */
+typedef struct {
+  long nstates;                 /* number of states of the channel */
+  double *src;                  /* matrix[][] and ber[] the tables */
+  /* were built from */
+  unsigned long *lim;           /* RAN < thr <=> any && seed <= lim; */
+  char *any;                    /* matrix[i][j] at i*nstates+j, */
+  /* ber[i] at nstates*nstates+i */
+  double *trans;                /* probability of going from state */
+  /* i to state j, at i*nstates+j */
+  double *lstay;                /* log(prob. of staying in state) */
+  double *lber;                 /* log(1 - bit error rate) */
+  unsigned long *fber;          /* bit error rate as 32-bit fraction */
+  unsigned long *fstay;         /* prob. of staying, 32-bit fraction */
+  PBS_WORD rng;                 /* state of the fast generator */
+  unsigned long rng_seed;       /* seed when rng was last synced */
+} EID_TABLES;
+
+/* Modes for BER_generator_packed() */
+#define EID_BER_COMPAT 0        /* same sequence as BER_generator */
+#define EID_BER_FAST   1        /* 64 bits at a time, own RNG */
+
 /* 
  * ......... Structure for the channel model ......... 
  */
@@ -57,6 +85,7 @@ typedef struct {
   /* another one */
   double usrber;                /* user defined bit error rate */
   double usrgamma;              /* user defined correlation factor */
+  EID_TABLES *tab;              /* tables for the generators, or 0 */
 } SCD_EID;
 
 typedef struct {
@@ -82,6 +111,9 @@ typedef struct {
  * ......... Global function prototypes ......... 
  */
 SCD_EID *open_eid ARGS ((double ber, double gamma));
+SCD_EID *copy_eid ARGS ((SCD_EID * EID));
+void close_eid ARGS ((SCD_EID * EID));
+void EID_random_skip ARGS ((unsigned long *seed, unsigned long n));
 BURST_EID *open_burst_eid ARGS ((long index));
 void set_RAN_seed ARGS ((SCD_EID * EID, unsigned long seed));
 unsigned long get_RAN_seed ARGS ((SCD_EID * EID));
@@ -92,10 +124,13 @@ void set_GEC_current_state ARGS ((SCD_EID * EID, int /* char */ current_state));
 char get_GEC_current_state ARGS ((SCD_EID * EID));
 void BER_insertion ARGS ((long lseg, short *xbuff, short *ybuff, short *error_pattern));
 double BER_generator ARGS ((SCD_EID * EID, long lseg, short *EPbuff));
+double BER_generator_packed ARGS ((SCD_EID * EID, long lseg, PBS_WORD * mask, int mode));
 double FER_generator_random ARGS ((SCD_EID * EID));
 double FER_generator_burst ARGS ((BURST_EID * state));
 double FER_module ARGS ((SCD_EID * EID, long lseg, short *xbuff, short *ybuff));
 double FER_generator_burst ARGS ((BURST_EID * state));
 BURST_EID *reset_burst_eid ARGS ((BURST_EID * burst_eid));
+void BER_insertion_packed ARGS ((long nbits, PBS_WORD * xbits, PBS_WORD * ybits, PBS_WORD * ep));
+double FER_module_packed ARGS ((SCD_EID * EID, PACKED_BS * bs, long frame));
 #endif
 /* ........................... End of EID.H ........................... */
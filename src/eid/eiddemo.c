@@ -1,4 +1,4 @@
-/*                                                           02.Feb.2010 v3.3
+/*                                                           16.Oct.2026 v3.4
   ============================================================================
 
   EIDDEMO.C
@@ -45,6 +45,12 @@
   The program detects automatically the number of bits per frame
   by simply counting the bits between the first two SYNC headers.
 
+  With option -packed, each frame is converted to a packed bitstream
+  (see bitpack.h) and disturbed with BER_generator_packed(),
+  BER_insertion_packed() and FER_module_packed(), which give the same
+  output as the softbit routines for hard-bit inputs. Inputs with
+  soft bits are rejected in this mode.
+
   This program has been modified from the pre-STL96 version in
   order to handle G.192-compatible bitstreams. The pre-STL96
   sync headers consisted only of the sync word, what has been
@@ -140,6 +146,7 @@
                     mode <simao.campos@labs.comsat.com>
   02.Feb.2010  3.3  Modified maximum string length for filename to avoid
                     buffer overruns (y.hiwasaki)
+  16.Oct.2026  3.4  Added option -packed, processing packed bitstreams
   ============================================================================
 */
 
@@ -193,6 +200,9 @@ int main (int argc, char *argv[]) {
 
   short *xbuff, *ybuff;         /* pointer to bit-buffer */
   short *EPbuff;                /* pointer to bit-buffer */
+  PACKED_BS *bs = NULL;         /* packed frame (option -packed) */
+  PBS_WORD *EPmask = NULL;      /* packed error pattern */
+  char packed = 0;
   short SYNCword, i;
 
   long smpno;                   /* samples read from file */
@@ -217,7 +227,7 @@ int main (int argc, char *argv[]) {
 
 
   /* ......... DISPLAY INFOS ......... */
-  printf ("\n ** Error Insertion Device Demo Program - 02/Feb/2010 v3.3 **\n");
+  printf ("\n ** Error Insertion Device Demo Program - 16/Oct/2026 v3.4 **\n");
 
 
   /* ......... GET PARAMETERS ......... */
@@ -231,6 +241,13 @@ int main (int argc, char *argv[]) {
         /* Define resolution */
         quiet = 1;
 
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-packed") == 0) {
+        /* Process packed bitstreams */
+        packed = 1;
+
         /* Move arg{c,v} over the option to the next argument */
         argc--;
         argv++;
@@ -335,6 +352,14 @@ int main (int argc, char *argv[]) {
   if ((EPbuff = (short *) malloc ((lseg) * sizeof (short))) == (short *) 0)
     error_terminate ("    Could not allocate memory for error pattern buffer", 1);
 
+  /* Packed frame and error pattern */
+  if (packed) {
+    bs = open_packed_bs (1, lseg);
+    EPmask = (PBS_WORD *) malloc (PBS_WORDS (lseg) * sizeof (PBS_WORD));
+    if (bs == (PACKED_BS *) 0 || EPmask == (PBS_WORD *) 0)
+      error_terminate ("    Could not allocate memory for packed bitstream", 1);
+  }
+
 
 /*
   * ......... Now process input file .........
@@ -353,24 +378,48 @@ int main (int argc, char *argv[]) {
       /* Start measuring CPU-time for this round */
       t1 = clock ();
 
-      /* Generate error pattern ('hard'-bits) */
-      ber1 = BER_generator (BEReid, lseg, EPbuff);
-      dstbits += ber1;          /* count number of disturbed bits */
-      prcbits += (double) lseg; /* count number of processed bits */
-
-      /* Modify input bitstream according to the stored error pattern */
-      BER_insertion (lseg + OVERHEAD, xbuff, ybuff, EPbuff);
-
-      /* Apply frame erasure module if requested */
-      if (FER != 0.0) {
-        /* Subject bitstream to frame erasure ... */
-        fer1 = FER_module (FEReid, lseg + OVERHEAD, ybuff, xbuff);
-        ersfrms += fer1;        /* count number of erased frames */
-        prcfrms += (double) 1;  /* count number of processed frames */
+      if (packed) {
+        /* Pack frame; erased input frames are left as they are */
+        reset_packed_bs (bs);
+        if (packed_bs_add_g192 (bs, xbuff) < 0)
+          error_terminate ("    Input frame with soft bits can not be packed", 1);
+
+        /* Generate packed error pattern and disturb the frame in place */
+        ber1 = BER_generator_packed (BEReid, lseg, EPmask, EID_BER_COMPAT);
+        dstbits += ber1;        /* count number of disturbed bits */
+        prcbits += (double) lseg;       /* count number of processed bits */
+        if (!bs->erased[0])
+          BER_insertion_packed (lseg, packed_bs_frame (bs, 0), packed_bs_frame (bs, 0), EPmask);
+
+        /* Apply frame erasure module if requested */
+        if (FER != 0.0) {
+          fer1 = FER_module_packed (FEReid, bs, 0);
+          ersfrms += fer1;      /* count number of erased frames */
+          prcfrms += (double) 1;        /* count number of processed frames */
+        }
+
+        /* Back to softbits */
+        packed_bs_get_g192 (bs, 0, xbuff);
       } else {
-        /* Copy processed bitstream without subjecting to frame erasure ... */
-        for (i = 0; i < lseg + OVERHEAD; i++)
-          xbuff[i] = ybuff[i];
+        /* Generate error pattern ('hard'-bits) */
+        ber1 = BER_generator (BEReid, lseg, EPbuff);
+        dstbits += ber1;        /* count number of disturbed bits */
+        prcbits += (double) lseg;       /* count number of processed bits */
+
+        /* Modify input bitstream according to the stored error pattern */
+        BER_insertion (lseg + OVERHEAD, xbuff, ybuff, EPbuff);
+
+        /* Apply frame erasure module if requested */
+        if (FER != 0.0) {
+          /* Subject bitstream to frame erasure ... */
+          fer1 = FER_module (FEReid, lseg + OVERHEAD, ybuff, xbuff);
+          ersfrms += fer1;      /* count number of erased frames */
+          prcfrms += (double) 1;        /* count number of processed frames */
+        } else {
+          /* Copy processed bitstream without subjecting to frame erasure ... */
+          for (i = 0; i < lseg + OVERHEAD; i++)
+            xbuff[i] = ybuff[i];
+        }
       }
 
       /* Get partial timimg */
@@ -463,9 +512,12 @@ void display_usage () {
   prompt = '#';
 #endif
 
-  printf ("eiddemo.c Version 3.3 of 02.Feb.2010\n");
+  printf ("eiddemo.c Version 3.4 of 16.Oct.2026\n");
+
+  printf ("  Usage: %c %s%s", prompt, "EID [-q] [-packed] ifile ofile BERfile FERfile ", "[ BER BER_gamma FER FER_gamma]\n\n");
 
-  printf ("  Usage: %c %s%s", prompt, "EID ifile ofile BERfile FERfile ", "[ BER BER_gamma FER FER_gamma]\n\n");
+  printf ("\t-q         : quiet operation\n");
+  printf ("\t-packed    : process packed (hard-bit) bitstream frames\n");
 
   printf ("\tifile      : binary file with  input bitstream\n");
   printf ("\tofile      : binary file with output bitstream\n");
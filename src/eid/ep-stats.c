@@ -1,4 +1,4 @@
-/*                                                         02.Feb.2010 v.2.2
+/*                                                         16.Oct.2026 v.2.3
    =========================================================================
 
    ep-stats.c
@@ -70,6 +70,9 @@
                      <Ericsson>
     2.Feb.2010 v.2.2 Modified maximum string length for filename to avoid
                      buffer overruns (y.hiwasaki)
+   16.Oct.2026 v.2.3 Error pattern is memory-mapped, so that -start
+                     seeks directly to the first item (which no longer
+                     needs to be byte-aligned for compact patterns)
    ========================================================================= */
 
 /* ..... Generic include files ..... */
@@ -117,7 +120,7 @@
    --------------------------------------------------------------------------
  */
 void display_usage (int level) {
-  printf ("ep-stats.c - Version 2.2 of 02.Feb.2010 \n\n");
+  printf ("ep-stats.c - Version 2.3 of 16.Oct.2026 \n\n");
 
   if (level) {
     printf ("Program Description:\n");
@@ -189,9 +192,9 @@ int main (int argc, char *argv[]) {
   long ep_len;                  /* EP lengths */
   long burst_len = 10;          /* Max burst length to count */
   long start_item = 1;          /* Start analyzing errors from 1st one */
-  long preamble_items = 0;
+  long ep_pos;                  /* Position of next item in EP file */
   /* File I/O parameter */
-  FILE *Fep;                    /* Pointer to error pattern file */
+  BS_MAP *Mep;                  /* Mapped error pattern file */
 
   /* Data arrays and structures */
   short *ep;                    /* Error pattern buffer */
@@ -207,9 +210,6 @@ int main (int argc, char *argv[]) {
   char quiet = 0;
   float ftmp;
 
-  /* Pointer to a function */
-  long (*read_patt) () = read_g192;     /* To read error pattern */
-
 
   /* ......... GET PARAMETERS ......... */
 
@@ -298,14 +298,15 @@ int main (int argc, char *argv[]) {
 
 
   /* Open files */
-  if ((Fep = fopen (ep_file, RB)) == NULL)
+  if ((Mep = bs_map_open (ep_file)) == NULL)
     error_terminate ("Could not open error pattern file\n", 1);
 
 
   /* *** CHECK TYPE OF ERROR PATTERN *** */
 
-  /* Do preliminary inspection in the ERROR PATTERN FILE to check its format (byte, bit, g192) */
-  i = check_eid_format (Fep, ep_file, &tmp_type);
+  /* The format (byte, bit, g192) of the ERROR PATTERN FILE was found when mapping it */
+  i = Mep->format;
+  tmp_type = Mep->type;
 
   /* Check whether the specified EP format matches with the one in the file */
   if (i != ep_format) {
@@ -329,8 +330,8 @@ int main (int argc, char *argv[]) {
 
   /* *** FINAL INITIALIZATIONS *** */
 
-  /* Use the proper data I/O functions */
-  read_patt = ep_format == byte ? read_byte : (ep_format == g192 ? read_g192 : (ep_type == BER ? read_bit_ber : read_bit_fer));
+  /* Softbit values used when expanding a compact pattern */
+  Mep->type = ep_type;
 
   /* Define how many samples are read for each frame */
   /* Bitstream may have sync headers, which are 2 samples-long */
@@ -349,41 +350,22 @@ int main (int argc, char *argv[]) {
   start_item--;
 
   /* Define maximum no. of items to process */
-  max_items = get_max_items (ep_file, ep_format, start_item, fr_no);
+  max_items = Mep->items - start_item;
+  if (max_items < 0)
+    max_items = 0;
+  if (fr_no > 0 && max_items > fr_no)
+    max_items = fr_no;
 
   /* *** START ACTUAL WORK *** */
 
   /* first skip the part [0-start_item] */
-  /* Read preamble from EP file */
-  preamble_items = 0;
-  while (preamble_items < start_item) {
-    if ((ep_format == byte) || (ep_format == g192)) {
-      items = read_patt (ep, 1, Fep);   /* one item at a time consumed, for g.192 and byte */
-    } else if (ep_format == compact) {
-      if ((start_item % 8) == 0) {
-        items = read_patt (ep, 8, Fep); /* 8 items time consumed, for bit/compact packed fer */
-      } else {
-        fprintf (stderr, "Error: the start/preamble segment must be byte-aligned (divisble by 8), start=%ld, ( %ld%%8 != 0)\n", start_item + 1, start_item);
-        KILL (ep_file, 7);
-      }
-    }
-
-
-    /* Aborts on error */
-    if (items < 0) {
-      KILL (ep_file, 7);
-    }
-    preamble_items += items;
-  }
+  ep_pos = start_item > 0 ? start_item : 0;
 
   /* now finaly analyze target part */
   while (1) {
     /* Read a block from EP file */
-    items = read_patt (ep, ep_len, Fep);
-
-    /* Aborts on error */
-    if (items < 0)
-      KILL (ep_file, 7);
+    items = bs_map_read (Mep, ep_pos, ep_len, ep);
+    ep_pos += items;
 
     /* Adjusts no of items if number of processed items exceed user limit */
     if (eps.processed + items > max_items) {
@@ -440,7 +422,7 @@ int main (int argc, char *argv[]) {
   free (ep);
 
   /* Close the output file and quit *** */
-  fclose (Fep);
+  bs_map_close (Mep);
 
 #ifndef VMS                     /* return value to OS if not VMS */
   return 0;
@@ -1,4 +1,4 @@
-/*                                                          02.Feb.2010 v1.7
+/*                                                          16.Oct.2026 v1.9
    =========================================================================
 
    gen-patt.c
@@ -107,6 +107,17 @@
    -bit ..... Save error pattern in compact binary format (same as -compact)
    -compact . Save error pattern in compact binary format (same as -bit)
    -reset ... Reset EID state in between iteractions
+   -fast .... BER mode only: generate the pattern 64 bits at a time
+              (same statistics, but not the same sequence as without
+              this option, for a given state file)
+   -threads # Generate the pattern in chunks on # threads; the pattern
+              is identical to the one generated without this option
+   -npatt # . Generate # statistically independent patterns, saved in
+              files named as err_pat_bs with "-0001", "-0002", ...
+              inserted before the extension. Pattern k uses the part of
+              the random number sequence that starts (k-1)/# of the
+              period of the generator after the seed in the state file,
+              and the state file keeps the state after the last pattern
    -max # ... Maximum number of iteractions
    -tol # ... Max deviation of specified BER/FER/BFER
    -q ....... Quiet operation mode
@@ -152,6 +163,8 @@
                        (preamble part may now be excluded for teh iteration target) <Ericsson>
    02.Feb.2010,v1.7  Modified maximum string length for filenames to avoid
                      buffer overruns (y.hiwasaki)
+   16.Oct.2026,v1.8  Added option -fast for BER patterns
+   16.Oct.2026,v1.9  Added options -threads and -npatt
 
   ========================================================================= */
 
@@ -162,11 +175,13 @@
 #include <stdlib.h>
 #include <string.h>             /* memset */
 #include <ctype.h>              /* toupper */
+#include <limits.h>             /* ULONG_MAX */
 
 /* ..... Module definition files ..... */
 #include "eid.h"                /* EID functions */
 #include "eid_io.h"             /* EID state variable I/O functions */
 #include "softbit.h"            /* Soft bit definitions */
+#include "ugst-thread.h"        /* Worker threads */
 
 
 #define FER_FIX
@@ -181,6 +196,7 @@ char *mode_str ARGS ((int mode));
 char check_bellcore ARGS ((long index));
 long run_FER_generator_random ARGS ((short *patt, SCD_EID * state, long n));
 long run_FER_generator_burst ARGS ((short *patt, BURST_EID * state, long n));
+double run_generator_parallel ARGS ((char mode, SCD_EID * eid, BURST_EID * burst, long n, int nthreads, long (*save_data) (), FILE * F, double *saved));
 void display_usage ARGS ((void));
 
 
@@ -310,6 +326,246 @@ long run_FER_generator_burst (short *patt, BURST_EID * state, long n) {
 /* .................. End of run_FER_generator_burst() .................. */
 
 
+/*
+   -------------------------------------------------------------------------
+   Parallel generation of the disturbed segment of a pattern (-threads)
+   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+   The segment is cut into chunks of PAR_CHUNK bits|frames, generated as
+   independent jobs. The seed at the start of a chunk is found with
+   EID_random_skip(), since every bit|frame draws a fixed number of
+   random numbers (2 for the Gilbert model, 1 for the Bellcore model).
+   The channel state at the start of a chunk is not known until the
+   previous chunks are done, so each job runs the model from all the
+   possible states at once, with the same random numbers, until they
+   coincide (which, for gamma<1, happens after a few bits|frames). Only
+   this prefix depends on the starting state. The chunks are then
+   stitched together in order, each with the prefix that corresponds to
+   the state left by the previous chunk, producing exactly the same
+   pattern and final state as the serial generation.
+
+   <16.Oct.2026>
+   -------------------------------------------------------------------------
+ */
+#define PAR_CHUNK (256 * EID_BUFFER_LENGTH)
+
+typedef struct {
+  char mode;                    /* R, F or B */
+  SCD_EID *eid;                 /* Gilbert model, at start of round */
+  BURST_EID *burst;             /* Bellcore model, at start of round */
+  long nstates;                 /* number of possible states */
+  long n;                       /* bits|frames in the round */
+  short *patt;                  /* pattern of the round */
+  short *prefix;                /* per chunk & state: PAR_CHUNK items */
+  long *plen;                   /* per chunk: length of the prefix */
+  long *count;                  /* per chunk & state: disturbed items */
+  long *final;                  /* per chunk & state: state at the end */
+  long *internal;               /* per chunk & state: Bellcore counters */
+  int failed;                   /* set if a job could not allocate memory */
+} PAR_ROUND;
+
+/* Run one bit|frame of the Gilbert (e) or Bellcore (b) model */
+static short par_step (char mode, SCD_EID * e, BURST_EID * b) {
+  if (mode == 'B')
+    return (FER_generator_burst (b) ? G192_FER : G192_SYNC);
+  if (mode == 'F')
+    return (FER_generator_random (e) ? G192_FER : G192_SYNC);
+  return (FER_generator_random (e) ? G192_ONE : G192_ZERO);
+}
+
+/* Job: generate chunk k of the round, from all possible states */
+static void par_chunk (void *ctx, long k) {
+  PAR_ROUND *r = (PAR_ROUND *) ctx;
+  long ns = r->nstates, start = k * PAR_CHUNK;
+  long len = r->n - start < PAR_CHUNK ? r->n - start : PAR_CHUNK;
+  short *prefix = r->prefix + k * ns * PAR_CHUNK, *p;
+  long *count = r->count + k * ns;
+  long i, s, m, same, cc;
+  SCD_EID **e = 0;
+  BURST_EID *b = 0;
+  unsigned long seed;
+
+  /* One copy of the model per possible state, at the seed of the chunk */
+  if (r->mode == 'B') {
+    if ((b = (BURST_EID *) malloc (ns * sizeof (BURST_EID))) == 0) {
+      r->failed = 1;
+      return;
+    }
+    seed = r->burst->seedptr;
+    EID_random_skip (&seed, (unsigned long) start);
+    for (s = 0; s < ns; s++) {
+      b[s] = *r->burst;
+      b[s].seedptr = seed;
+      b[s].s_new = s;
+      for (m = 0; m < MODEL_SIZE; m++)
+        b[s].internal[m] = 0;
+    }
+  } else {
+    if ((e = (SCD_EID **) calloc (ns, sizeof (SCD_EID *))) == 0) {
+      r->failed = 1;
+      return;
+    }
+    seed = r->eid->seed;
+    EID_random_skip (&seed, 2 * (unsigned long) start);
+    for (s = 0; s < ns; s++) {
+      if ((e[s] = copy_eid (r->eid)) == 0) {
+        r->failed = 1;
+        break;
+      }
+      e[s]->seed = seed;
+      e[s]->current_state = s;
+    }
+  }
+
+  /* Run all states until they coincide */
+  for (s = 0; s < ns; s++)
+    count[s] = 0;
+  for (i = same = 0; !r->failed && i < len && !same;) {
+    for (s = 0; s < ns; s++) {
+      p = prefix + s * PAR_CHUNK + i;
+      *p = par_step (r->mode, e ? e[s] : 0, b ? b + s : 0);
+      if (*p == G192_FER || *p == G192_ONE)
+        count[s]++;
+    }
+    i++;
+    for (same = 1, s = 1; s < ns; s++)
+      if (r->mode == 'B' ? b[s].s_new != b[0].s_new : e[s]->current_state != e[0]->current_state)
+        same = 0;
+  }
+  r->plen[k] = i;
+
+  /* Bellcore counters of each state relative to state 0 */
+  if (b)
+    for (s = 0; s < ns; s++)
+      for (m = 0; m < MODEL_SIZE; m++)
+        r->internal[(k * ns + s) * MODEL_SIZE + m] = b[s].internal[m] - b[0].internal[m];
+
+  /* The rest of the chunk does not depend on the initial state */
+  p = r->patt + start;
+  if (r->failed)
+    cc = 0;
+  else if (r->mode == 'R')
+    cc = (long) BER_generator (e[0], len - i, p + i);
+  else if (r->mode == 'F')
+    cc = run_FER_generator_random (p + i, e[0], len - i);
+  else
+    cc = run_FER_generator_burst (p + i, b, len - i);
+
+  for (s = 0; s < ns; s++) {
+    count[s] += cc;
+    if (b) {
+      r->final[k * ns + s] = same ? b[0].s_new : b[s].s_new;
+      for (m = 0; m < MODEL_SIZE; m++)
+        r->internal[(k * ns + s) * MODEL_SIZE + m] += b[0].internal[m];
+    } else if (!r->failed)
+      r->final[k * ns + s] = same ? e[0]->current_state : e[s]->current_state;
+  }
+
+  /* Release copies */
+  if (e) {
+    for (s = 0; s < ns; s++)
+      if (e[s])
+        close_eid (e[s]);
+    free (e);
+  }
+  free (b);
+}
+
+/*
+   -------------------------------------------------------------------------
+   double run_generator_parallel (char mode, SCD_EID *eid,
+   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  BURST_EID *burst, long n, int nthreads,
+                                  long (*save_data) (), FILE *F,
+                                  double *saved);
+
+   Generate n bits|frames of a pattern on nthreads threads and save
+   them to F, in the same blocks of EID_BUFFER_LENGTH as the serial
+   generation. On return, eid (for modes R and F) or burst (mode B) is
+   in the same state as after the serial generation.
+
+   Return value:
+   ~~~~~~~~~~~~~
+   The number of disturbed bits|frames; the number of items saved is
+   added to *saved. Returns -1 if memory could not be allocated or the
+   data could not be saved.
+
+   History:
+   ~~~~~~~~
+   16.Oct.2026  v.1.0  Created.
+   -------------------------------------------------------------------------
+ */
+double run_generator_parallel (char mode, SCD_EID * eid, BURST_EID * burst, long n, int nthreads, long (*save_data) (), FILE * F, double *saved) {
+  PAR_ROUND r;
+  long nchunks, k, s, m, i, items, cur;
+  double disturbed = 0;
+
+  r.mode = mode;
+  r.eid = eid;
+  r.burst = burst;
+  r.nstates = mode == 'B' ? MODEL_SIZE : eid->nstates;
+  r.failed = 0;
+
+  /* Each round runs one chunk per thread */
+  nchunks = nthreads;
+  r.patt = (short *) malloc (nchunks * PAR_CHUNK * sizeof (short));
+  r.prefix = (short *) malloc (nchunks * r.nstates * PAR_CHUNK * sizeof (short));
+  r.plen = (long *) malloc (nchunks * sizeof (long));
+  r.count = (long *) malloc (nchunks * r.nstates * sizeof (long));
+  r.final = (long *) malloc (nchunks * r.nstates * sizeof (long));
+  r.internal = (long *) malloc (nchunks * r.nstates * MODEL_SIZE * sizeof (long));
+  if (!r.patt || !r.prefix || !r.plen || !r.count || !r.final || !r.internal)
+    r.failed = 1;
+
+  cur = mode == 'B' ? burst->s_new : eid->current_state;
+  while (n > 0 && !r.failed) {
+    r.n = n < nchunks * PAR_CHUNK ? n : nchunks * PAR_CHUNK;
+    ugst_parallel_for ((r.n + PAR_CHUNK - 1) / PAR_CHUNK, nthreads, par_chunk, &r);
+    if (r.failed)
+      break;
+
+    /* Stitch the chunks, following the state left by each one */
+    for (k = 0; k * PAR_CHUNK < r.n; k++) {
+      memcpy (r.patt + k * PAR_CHUNK, r.prefix + (k * r.nstates + cur) * PAR_CHUNK, r.plen[k] * sizeof (short));
+      disturbed += r.count[k * r.nstates + cur];
+      if (mode == 'B')
+        for (m = 0; m < MODEL_SIZE; m++)
+          burst->internal[m] += r.internal[(k * r.nstates + cur) * MODEL_SIZE + m];
+      cur = r.final[k * r.nstates + cur];
+    }
+
+    /* Leave the model as after the serial generation */
+    if (mode == 'B') {
+      EID_random_skip (&burst->seedptr, (unsigned long) r.n);
+      burst->s_new = cur;
+    } else {
+      EID_random_skip (&eid->seed, 2 * (unsigned long) r.n);
+      eid->current_state = cur;
+    }
+
+    /* Save data to file */
+    for (i = 0; i < r.n; i += EID_BUFFER_LENGTH) {
+      s = r.n - i < EID_BUFFER_LENGTH ? r.n - i : EID_BUFFER_LENGTH;
+      if ((items = save_data (r.patt + i, s, F)) < 0) {
+        r.failed = 1;
+        break;
+      }
+      *saved += items;
+    }
+    n -= r.n;
+  }
+
+  free (r.patt);
+  free (r.prefix);
+  free (r.plen);
+  free (r.count);
+  free (r.final);
+  free (r.internal);
+  return (r.failed ? -1 : disturbed);
+}
+
+/* .................. End of run_generator_parallel() .................. */
+
+
 /*
    --------------------------------------------------------------------------
    display_usage()
@@ -361,6 +617,9 @@ void display_usage () {
   printf ("   -bit ..... Save error pattern in compact binary format (same as -compact)\n");
   printf ("   -compact . Save error pattern in compact binary format (same as -bit)\n");
   printf ("   -reset ... Reset EID state in between iteractions\n");
+  printf ("   -fast .... BER mode: generate 64 bits at a time (other sequence)\n");
+  printf ("   -threads # Generate in chunks on # threads (same pattern)\n");
+  printf ("   -npatt # . Generate # independent patterns, in files err_pat-0001 ...\n");
   printf ("   -max # ... Maximum number of iteractions\n");
   printf ("   -tol # ... Max deviation of specified BER/FER/BFER\n");
   printf ("   -q ....... Quiet operation mode\n");
@@ -389,8 +648,8 @@ int main (int argc, char *argv[]) {
   int out;
 
   /* EID parameter, Gilbert model */
-  SCD_EID *BEReid,              /* Pointer to BER EID structure */
-   *FEReid;                     /* Pointer to FER EID structure */
+  SCD_EID *BEReid = 0,          /* Pointer to BER EID structure */
+   *FEReid = 0;                 /* Pointer to FER EID structure */
 
   /* EID parameter, Bellcore model */
   BURST_EID *burst_eid;         /* Pointer to FER burst EID structure */
@@ -399,6 +658,7 @@ int main (int argc, char *argv[]) {
   short frame_erased[EID_BUFFER_LENGTH];
   short frame_okay[EID_BUFFER_LENGTH];
   short *error_pat;             /* Bit error buffer */
+  PBS_WORD error_mask[PBS_WORDS (EID_BUFFER_LENGTH)];   /* Packed bit errors */
 
   /* Aux. variables */
   double FER;                   /* frame erasure rate */
@@ -420,7 +680,13 @@ int main (int argc, char *argv[]) {
   char mrs[15] = "mrs=512";
 #endif
   long max_iteraction = 100;
-  char quiet = 0, reset = 0, save_format = byte, tailstat = 0;
+  char quiet = 0, reset = 0, save_format = byte, tailstat = 0, fast = 0;
+  int nthreads = 1;             /* worker threads */
+  long npatt = 1, patt;         /* number of patterns */
+  unsigned long stride = 0;     /* random numbers between patterns */
+  char patt_file_name[MAX_STRLEN + 8], *ext;
+  SCD_EID *eid0 = 0;            /* Gilbert model at start of pattern 1 */
+  BURST_EID burst0;             /* Bellcore model at start of pattern 1 */
   long (*save_data) () = save_byte;     /* Pointer to a function */
 
 #ifdef PORT_TEST
@@ -506,6 +772,27 @@ int main (int argc, char *argv[]) {
         /* Move arg{c,v} over the option to the next argument */
         argc--;
         argv++;
+      } else if (strcmp (argv[1], "-fast") == 0) {
+        /* Use the word-parallel bit error generator */
+        fast = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-threads") == 0) {
+        /* Number of worker threads */
+        nthreads = atoi (argv[2]);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-npatt") == 0) {
+        /* Number of independent patterns */
+        npatt = atol (argv[2]);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
       } else if (strcmp (argv[1], "-g192") == 0) {
         /* Save bitstream as a G.192-compliant serial bitstream */
         save_format = g192;
@@ -625,13 +912,6 @@ int main (int argc, char *argv[]) {
     fprintf (stderr, "Warning !! Error statistics counted on [1...%ld], this includes preamble segment [1..%ld],\n even though no errors are applied in this segment.\n", number_of_frames, start_frame);
   }
 
-  /*
-   **  Open output file
-   */
-  if ((out_file_ptr = fopen (data_file_name, WB)) == NULL)
-    error_terminate ("Could not create output file\n", 1);
-  out = fileno (out_file_ptr);
-
   /*
    **  Select mode
    */
@@ -710,130 +990,208 @@ int main (int argc, char *argv[]) {
 
 
   /*
-   ** Try obtaining a pattern within the given error/erasure rate
+   ** Check options for multiple threads|patterns
    */
-  do {
+  if (fast && nthreads > 1) {
+    fprintf (stderr, "Warning!! Option -threads is ignored with -fast\n");
+    nthreads = 1;
+  }
+  if (npatt < 1)
+    npatt = 1;
+  if (npatt > 1) {
+    /* Split the period of the generator (2^bits in a long) among the patterns */
+    stride = ULONG_MAX / npatt + 1;
+    if ((mode == 'B' ? 1.0 : 2.0) * (number_of_frames - start_frame) * (tolerance >= 0 ? max_iteraction : 1) > (double) stride)
+      fprintf (stderr, "Warning!! Patterns too long to be independent\n");
+
+    /* Keep the state at the start of the first pattern */
+    if (mode == 'B')
+      burst0 = *burst_eid;
+    else if ((eid0 = copy_eid (mode == 'R' ? BEReid : FEReid)) == (SCD_EID *) 0)
+      error_terminate ("Couldn't copy EID\n", 1);
+  }
 
+  for (patt = 0; patt < npatt; patt++) {
     /*
-     **  Initializations necessary for each iteraction **
+     ** Each pattern starts from the initial state, on its own part of the random number sequence
      */
+    if (patt > 0) {
+      fclose (out_file_ptr);
+      if (mode == 'B') {
+        *burst_eid = burst0;
+        EID_random_skip (&burst_eid->seedptr, patt * stride);
+      } else {
+        SCD_EID *e = mode == 'R' ? BEReid : FEReid;
 
-    /* Increase counter */
-    iteraction++;
-
-    /* Rewind file */
-    fseek (out_file_ptr, 0l, 0);
+        e->seed = eid0->seed;
+        e->current_state = eid0->current_state;
+        EID_random_skip (&e->seed, patt * stride);
+      }
+    }
 
-    /* Reset variables */
-    ber1 = 0.0;
-    processed = 0.0;
-    generated = 0.0;
-    disturbed = 0.0;
+    /*
+     **  Open output file
+     */
+    strcpy (patt_file_name, data_file_name);
+    if (npatt > 1) {
+      /* Insert the pattern number before the extension, if any */
+      ext = strrchr (data_file_name, '.');
+      if (ext == 0 || strchr (ext, '/') || strchr (ext, '\\'))
+        ext = data_file_name + strlen (data_file_name);
+      sprintf (patt_file_name + (ext - data_file_name), "-%04ld%s", patt + 1, ext);
+    }
+    if ((out_file_ptr = fopen (patt_file_name, WB)) == NULL)
+      error_terminate ("Could not create output file\n", 1);
+    out = fileno (out_file_ptr);
+    iteraction = 0;
 
     /*
-     **  Generate the bit streams
+     ** Try obtaining a pattern within the given error/erasure rate
      */
-    switch (mode) {
-    case 'R':                  /* random BER */
-      {
-        /* Initialize frame buffer with OK samples */
-        /* memcpy (error_pat, frame_okay, EID_BUFFER_LENGTH); */
-        for (i = 0; i < EID_BUFFER_LENGTH; i++)
-          error_pat[i] = frame_okay[i];
-
-        /* Skip initial samples, saving undisturbed bits */
-        for (i = 0; i < start_frame; i += EID_BUFFER_LENGTH) {
-          /* Use EID_BUFFER_LENGTH for start_frame/EID_BUFFER_LENGTH iteractions and start_frame % EID_BUFFER_LENGTH for the last iteraction */
-          k = i + EID_BUFFER_LENGTH > start_frame
-            /* ? start_frame % EID_BUFFER_LENGTH +1 */
-            ? start_frame % EID_BUFFER_LENGTH : EID_BUFFER_LENGTH;
-
-          items = save_data (error_pat, k, out_file_ptr);
-          if (items < 0)
-            error_terminate ("Error saving data to file\n", 8);
-          generated += items;
+    do {
+
+      /*
+       **  Initializations necessary for each iteraction **
+       */
+
+      /* Increase counter */
+      iteraction++;
+
+      /* Rewind file */
+      fseek (out_file_ptr, 0l, 0);
+
+      /* Reset variables */
+      ber1 = 0.0;
+      processed = 0.0;
+      generated = 0.0;
+      disturbed = 0.0;
+
+      /*
+       **  Generate the bit streams
+       */
+      switch (mode) {
+      case 'R':                  /* random BER */
+        {
+          /* Initialize frame buffer with OK samples */
+          /* memcpy (error_pat, frame_okay, EID_BUFFER_LENGTH); */
+          for (i = 0; i < EID_BUFFER_LENGTH; i++)
+            error_pat[i] = frame_okay[i];
+
+          /* Skip initial samples, saving undisturbed bits */
+          for (i = 0; i < start_frame; i += EID_BUFFER_LENGTH) {
+            /* Use EID_BUFFER_LENGTH for start_frame/EID_BUFFER_LENGTH iteractions and start_frame % EID_BUFFER_LENGTH for the last iteraction */
+            k = i + EID_BUFFER_LENGTH > start_frame
+              /* ? start_frame % EID_BUFFER_LENGTH +1 */
+              ? start_frame % EID_BUFFER_LENGTH : EID_BUFFER_LENGTH;
+
+            items = save_data (error_pat, k, out_file_ptr);
+            if (items < 0)
+              error_terminate ("Error saving data to file\n", 8);
+            generated += items;
+          }
+
+          /* Generate bits subject to disturbance */
+          if (nthreads > 1) {
+            disturbed = run_generator_parallel (mode, BEReid, 0, number_of_frames - start_frame, nthreads, save_data, out_file_ptr, &processed);
+            if (disturbed < 0)
+              error_terminate ("Error generating|saving data\n", 8);
+            generated += processed;
+          } else {
+            for (i = start_frame; i < number_of_frames; i += EID_BUFFER_LENGTH) {
+              /* Checks how many frame erasures are necessary here. If this is not the last round of collections, then get EID_BUFFER_LENGTH frame erasure indications. If this is the last iteraction in the loop, get only the remainder of samples not all EID_BUFFER_LENGTH samples */
+              k = i + EID_BUFFER_LENGTH > number_of_frames ? number_of_frames - (long) generated : EID_BUFFER_LENGTH;
+
+              /* Run bit error generator */
+              if (fast) {
+                ber1 = BER_generator_packed (BEReid, k, error_mask, EID_BER_FAST);
+                packed_to_g192 (error_mask, error_pat, k);
+              } else
+                ber1 = BER_generator (BEReid, k, error_pat);
+
+              /* Save data to file according to the defined format */
+              items = save_data (error_pat, k, out_file_ptr);
+              if (items < 0)
+                error_terminate ("Error saving data to file\n", 8);
+
+              /* Update counters */
+              disturbed += ber1;
+              processed += items;
+              generated += items;
+            }
+          }
+          break;
         }
 
-        /* Generate bits subject to disturbance */
-        for (i = start_frame; i < number_of_frames; i += EID_BUFFER_LENGTH) {
-          /* Checks how many frame erasures are necessary here. If this is not the last round of collections, then get EID_BUFFER_LENGTH frame erasure indications. If this is the last iteraction in the loop, get only the remainder of samples not all EID_BUFFER_LENGTH samples */
-          k = i + EID_BUFFER_LENGTH > number_of_frames ? number_of_frames - (long) generated : EID_BUFFER_LENGTH;
-
-          /* Run bit error generator */
-          ber1 = BER_generator (BEReid, k, error_pat);
-
-          /* Save data to file according to the defined format */
-          items = save_data (error_pat, k, out_file_ptr);
-          if (items < 0)
-            error_terminate ("Error saving data to file\n", 8);
-
-          /* Update counters */
-          disturbed += ber1;
-          processed += items;
-          generated += items;
+      case 'F':
+      case 'B':
+        {
+          /* Reset burst EID generator, if required */
+          if (mode == 'B' && reset)
+            reset_burst_eid (burst_eid);
+
+          /* Skip initial frames */
+          for (i = 0; i < start_frame; i += EID_BUFFER_LENGTH) {
+            /* Use EID_BUFFER_LENGTH for start_frame/EID_BUFFER_LENGTH iteractions and start_frame % EID_BUFFER_LENGTH for the last iteraction */
+            k = i + EID_BUFFER_LENGTH > start_frame
+              /* ? start_frame % EID_BUFFER_LENGTH +1 */
+              ? start_frame % EID_BUFFER_LENGTH : EID_BUFFER_LENGTH;
+
+            items = save_data (frame_okay, k, out_file_ptr);
+            generated += items;
+          }
+
+          /* Generate frame subject to disturbance */
+          if (nthreads > 1) {
+            disturbed = run_generator_parallel (mode, mode == 'F' ? FEReid : 0, burst_eid, number_of_frames - start_frame, nthreads, save_data, out_file_ptr, &processed);
+            if (disturbed < 0)
+              error_terminate ("Error generating|saving data\n", 8);
+            generated += processed;
+          } else {
+            for (i = start_frame; i < number_of_frames; i += EID_BUFFER_LENGTH) {
+              /* Checks how many frame erasures are necessary here. If this is not the last round of collections, then get EID_BUFFER_LENGTH frame erasure indications. If this is the last iteraction in the loop, get only the remainder of samples not all EID_BUFFER_LENGTH samples */
+              k = i + EID_BUFFER_LENGTH > number_of_frames ? number_of_frames - (long) generated : EID_BUFFER_LENGTH;
+              /*
+                 k = i + EID_BUFFER_LENGTH > number_of_frames ? number_of_frames % EID_BUFFER_LENGTH : EID_BUFFER_LENGTH; */
+
+              /* Run either Gilbert or Bellcore frame erasure model */
+              ber1 = mode == 'F' ? run_FER_generator_random (error_pat, FEReid, k)
+                : run_FER_generator_burst (error_pat, burst_eid, k);
+
+              /* Save intermediate data in buffer */
+              items = save_data (error_pat, k, out_file_ptr);
+              if (items < 0)
+                error_terminate ("Error saving data to file\n", 8);
+
+              /* Update counters */
+              disturbed += ber1;
+              processed += items;   /* does not include preamble frames */
+              generated += items;   /* includes preamble frames */
+            }
+          }
+
+          break;
         }
-        break;
       }
 
-    case 'F':
-    case 'B':
-      {
-        /* Reset burst EID generator, if required */
-        if (mode == 'B' && reset)
-          reset_burst_eid (burst_eid);
-
-        /* Skip initial frames */
-        for (i = 0; i < start_frame; i += EID_BUFFER_LENGTH) {
-          /* Use EID_BUFFER_LENGTH for start_frame/EID_BUFFER_LENGTH iteractions and start_frame % EID_BUFFER_LENGTH for the last iteraction */
-          k = i + EID_BUFFER_LENGTH > start_frame
-            /* ? start_frame % EID_BUFFER_LENGTH +1 */
-            ? start_frame % EID_BUFFER_LENGTH : EID_BUFFER_LENGTH;
-
-          items = save_data (frame_okay, k, out_file_ptr);
-          generated += items;
-        }
-
-        /* Generate frame subject to disturbance */
-        for (i = start_frame; i < number_of_frames; i += EID_BUFFER_LENGTH) {
-          /* Checks how many frame erasures are necessary here. If this is not the last round of collections, then get EID_BUFFER_LENGTH frame erasure indications. If this is the last iteraction in the loop, get only the remainder of samples not all EID_BUFFER_LENGTH samples */
-          k = i + EID_BUFFER_LENGTH > number_of_frames ? number_of_frames - (long) generated : EID_BUFFER_LENGTH;
-          /*
-             k = i + EID_BUFFER_LENGTH > number_of_frames ? number_of_frames % EID_BUFFER_LENGTH : EID_BUFFER_LENGTH; */
-
-          /* Run either Gilbert or Bellcore frame erasure model */
-          ber1 = mode == 'F' ? run_FER_generator_random (error_pat, FEReid, k)
-            : run_FER_generator_burst (error_pat, burst_eid, k);
-
-          /* Save intermediate data in buffer */
-          items = save_data (error_pat, k, out_file_ptr);
-          if (items < 0)
-            error_terminate ("Error saving data to file\n", 8);
-
-          /* Update counters */
-          disturbed += ber1;
-          processed += items;   /* does not include preamble frames */
-          generated += items;   /* includes preamble frames */
-        }
+      /* Calculate Bit/Frame error rate */
+      percentage_gen = disturbed / generated;     /* overall percentage */
+      percentage_proc = disturbed / processed;    /* tail percentage */
 
-        break;
+      if (tailstat) {
+        percentage_used = percentage_proc;        /* evaluate percentage on tail, excluding preamble */
+      } else {
+        percentage_used = percentage_gen; /* evaluate percentage over the whole file */
       }
-    }
-
-    /* Calculate Bit/Frame error rate */
-    percentage_gen = disturbed / generated;     /* overall percentage */
-    percentage_proc = disturbed / processed;    /* tail percentage */
 
-    if (tailstat) {
-      percentage_used = percentage_proc;        /* evaluate percentage on tail, excluding preamble */
-    } else {
-      percentage_used = percentage_gen; /* evaluate percentage over the whole file */
+      if (!quiet)
+        fprintf (stderr, "Iteraction %ld, whole(dev.%f\t(%.4f%%)), tail(dev. %f\t(%.4f%%))\n", iteraction, ber_rate - percentage_gen, 100 * percentage_gen, ber_rate - percentage_proc, 100 * percentage_proc);
     }
 
-    if (!quiet)
-      fprintf (stderr, "Iteraction %ld, whole(dev.%f\t(%.4f%%)), tail(dev. %f\t(%.4f%%))\n", iteraction, ber_rate - percentage_gen, 100 * percentage_gen, ber_rate - percentage_proc, 100 * percentage_proc);
-  }
+    while (tolerance >= 0 && fabs (ber_rate - percentage_used) > tolerance && iteraction < max_iteraction);
 
-  while (tolerance >= 0 && fabs (ber_rate - percentage_used) > tolerance && iteraction < max_iteraction);
+    if (npatt > 1)
+      fprintf (stderr, "Pattern %s: %.0f of %.0f %s disturbed (%f %%)\n", patt_file_name, disturbed, generated, mode == 'R' ? "bits" : "frames", 100 * percentage_gen);
+  }
 
   /*
    ** .. Print some statistics ...
@@ -847,7 +1205,7 @@ int main (int argc, char *argv[]) {
   /*
    **  Print summary of options on screen
    */
-  fprintf (stderr, "Pattern file:   %s\n", data_file_name);
+  fprintf (stderr, "Pattern file:   %s\n", patt_file_name);
   fprintf (stderr, "Pattern format: %s\n", format_str (save_format));
   fprintf (stderr, "Operating mode: %s ", mode_str (mode));
   switch (mode) {
@@ -1,4 +1,4 @@
-/*                                                        V.3.1 - 05.feb.2010
+/*                                                        V.3.2 - 16.oct.2026
   ===========================================================================
    The file containing an encoded speech bitstream can be in a compact
    binary format, in the G.192 serial bitstream format (which uses
@@ -83,6 +83,19 @@
 #endif
 #endif
 
+/* ..... Memory-mapped file access (see bs_map_open()) ..... */
+#if defined(_WIN32)
+#define BS_MAP_WIN32
+#include <windows.h>
+#elif (defined(unix) || defined(__unix__) || defined(__APPLE__)) && !defined(MSDOS)
+#define BS_MAP_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
 /* Specific includes */
 #include "softbit.h"
 
@@ -602,35 +615,20 @@ char *type_str (int type) {
 
 /*
   --------------------------------------------------------------------------
-  char check_eid_format (FILE *F, char *file, char *type);
-  ~~~~~~~~~~~~~~~~~~~~~
-
-  Function that checks the format (g192, byte, bit) in a given
-  bitstream, and tries to guess the type of data (bit stream or frame
-  erasure pattern)
-
-  Parameter:
-  ~~~~~~~~~~
-  F ...... FILE * structure to file to be checked
-  file ... name of file to be checked
-  type ... pointer to guessed data type (FER or BER) in file
+  static char eid_format_of (short word, char *file, char *type);
+  ~~~~~~~~~~~~~~~~~~~~~~~~~
 
-  Returned value:
-  ~~~~~~~~~~~~~~~
-  Returns the data format (g192, byte, bit) found in file.
-
-  Original author: <simao.campos@comsat.com>
-  ~~~~~~~~~~~~~~~~
+  Heuristics shared by check_eid_format() and bs_map_open(): guesses
+  the data format (g192, byte, bit) and type (FER or BER) of a
+  bitstream file from its first 16-bit word, as read in the native
+  byte order. Aborts if the file is a byte-swapped G.192 file.
 
   History:
   ~~~~~~~~
-  15.Aug.97  v.1.0  Created.
-  01.Jun.05  v.1.1  Bug correction: switch is made on the "unsigned short" value
-					(v.1.0: "unsigned" only). <Cyril Guillaume & Stephane Ragot -- stephane.ragot@rd.francetelecom.com>
+  16.Oct.26  v.1.0  Split out of check_eid_format().
   --------------------------------------------------------------------------
 */
-char check_eid_format (FILE * F, char *file, char *type) {
-  short word;
+static char eid_format_of (short word, char *file, char *type) {
   char ret_val;
   unsigned long tmp = 0x41424344;       /* Hex version of the string ABCD */
   int little_endian;
@@ -638,9 +636,6 @@ char check_eid_format (FILE * F, char *file, char *type) {
   /* Find whether the OS is big- or little-endian */
   little_endian = strncmp ("ABCD", (char *) &tmp, 4);
 
-  /* Get a 16-bit word from the file */
-  fread (&word, sizeof (short), 1, F);
-
   /* Use some heuristics to determine what type of file is this */
   switch ((unsigned short) word) {
   case 0x7F7F:
@@ -701,6 +696,53 @@ char check_eid_format (FILE * F, char *file, char *type) {
     ret_val = byte;
   }
 
+  return (ret_val);
+}
+
+/* ........................ End of eid_format_of() ........................ */
+
+
+/*
+  --------------------------------------------------------------------------
+  char check_eid_format (FILE *F, char *file, char *type);
+  ~~~~~~~~~~~~~~~~~~~~~
+
+  Function that checks the format (g192, byte, bit) in a given
+  bitstream, and tries to guess the type of data (bit stream or frame
+  erasure pattern)
+
+  Parameter:
+  ~~~~~~~~~~
+  F ...... FILE * structure to file to be checked
+  file ... name of file to be checked
+  type ... pointer to guessed data type (FER or BER) in file
+
+  Returned value:
+  ~~~~~~~~~~~~~~~
+  Returns the data format (g192, byte, bit) found in file.
+
+  Original author: <simao.campos@comsat.com>
+  ~~~~~~~~~~~~~~~~
+
+  History:
+  ~~~~~~~~
+  15.Aug.97  v.1.0  Created.
+  01.Jun.05  v.1.1  Bug correction: switch is made on the "unsigned short" value
+					(v.1.0: "unsigned" only). <Cyril Guillaume & Stephane Ragot -- stephane.ragot@rd.francetelecom.com>
+  16.Oct.26  v.1.2  Heuristics moved to eid_format_of(), shared with
+                    bs_map_open().
+  --------------------------------------------------------------------------
+*/
+char check_eid_format (FILE * F, char *file, char *type) {
+  short word = 0;
+  char ret_val;
+
+  /* Get a 16-bit word from the file */
+  fread (&word, sizeof (short), 1, F);
+
+  /* Use some heuristics to determine what type of file is this */
+  ret_val = eid_format_of (word, file, type);
+
   /* Rewind file & and return format identifier */
   fseek (F, 0l, SEEK_SET);
   return (ret_val);
@@ -754,3 +796,305 @@ long soft2hard (short *soft, short *hard, long n, char type) {
 }
 
 /* ...................... End of soft2hard() ...................... */
+
+
+/*
+  ---------------------------------------------------------------------------
+  static int bs_map_file (BS_MAP *map, char *file);
+  ~~~~~~~~~~~~~~~~~~~~~~
+
+  Maps the whole file read-only in memory: mmap() on unix-like systems,
+  MapViewOfFile() on Win32, and plain fread() of the whole file into a
+  malloc'ed buffer elsewhere or when the mapping fails. Empty files have
+  no data. Returns 0 on success, -1 if the file cannot be read.
+
+  History:
+  ~~~~~~~~
+  16.Oct.26  v1.00 created
+  ---------------------------------------------------------------------------
+*/
+static int bs_map_file (BS_MAP * map, char *file) {
+  FILE *F;
+
+  map->data = NULL;
+  map->size = 0;
+  map->mapped = 0;
+
+#if defined(BS_MAP_MMAP)
+  {
+    struct stat st;
+    int fd;
+    void *p;
+
+    if ((fd = open (file, O_RDONLY)) < 0)
+      return (-1);
+    if (fstat (fd, &st) == 0 && S_ISREG (st.st_mode)) {
+      map->size = (size_t) st.st_size;
+      if (map->size == 0) {
+        close (fd);
+        return (0);
+      }
+      p = mmap (NULL, map->size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED) {
+#if defined(MADV_SEQUENTIAL)
+        madvise (p, map->size, MADV_SEQUENTIAL);
+#endif
+        close (fd);
+        map->data = (char *) p;
+        map->mapped = 1;
+        return (0);
+      }
+    }
+    close (fd);
+  }
+#elif defined(BS_MAP_WIN32)
+  {
+    HANDLE hf, hm;
+    LARGE_INTEGER sz;
+    void *p = NULL;
+
+    hf = CreateFileA (file, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hf == INVALID_HANDLE_VALUE)
+      return (-1);
+    if (GetFileSizeEx (hf, &sz)) {
+      map->size = (size_t) sz.QuadPart;
+      if (map->size == 0) {
+        CloseHandle (hf);
+        return (0);
+      }
+      if ((hm = CreateFileMappingA (hf, NULL, PAGE_READONLY, 0, 0, NULL)) != NULL) {
+        p = MapViewOfFile (hm, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle (hm);
+      }
+    }
+    CloseHandle (hf);
+    if (p != NULL) {
+      map->data = (char *) p;
+      map->mapped = 1;
+      return (0);
+    }
+  }
+#endif
+
+  /* No mapping available: read the whole file into memory */
+  if ((F = fopen (file, RB)) == NULL)
+    return (-1);
+  fseek (F, 0l, SEEK_END);
+  map->size = (size_t) ftell (F);
+  fseek (F, 0l, SEEK_SET);
+  if (map->size > 0) {
+    if ((map->data = (char *) malloc (map->size)) == NULL)
+      error_terminate ("Cannot allocate memory to read bitstream file\n", 6);
+    map->size = fread (map->data, 1, map->size, F);
+  }
+  fclose (F);
+  return (0);
+}
+
+/* ....................... End of bs_map_file() ....................... */
+
+
+/*
+  ---------------------------------------------------------------------------
+  static long bs_map_word (BS_MAP *map, long item);
+  ~~~~~~~~~~~~~~~~~~~~~~~
+
+  Returns the raw value of softbit number item of a G.192 or
+  byte-oriented file (in the latter case, as an unsigned byte).
+  ---------------------------------------------------------------------------
+*/
+static long bs_map_word (BS_MAP * map, long item) {
+  if (map->format == g192)
+    return ((short *) map->data)[item];
+  return ((unsigned char *) map->data)[item];
+}
+
+/* ....................... End of bs_map_word() ....................... */
+
+
+/*
+  ---------------------------------------------------------------------------
+  BS_MAP *bs_map_open (char *file);
+  ~~~~~~~~~~~~~~~~~~~
+
+  Opens a bitstream or error pattern file for random access. The file
+  is memory-mapped (or read into memory at once, where mapping is not
+  available), its format (g192, byte, bit) and type (FER or BER) are
+  guessed once with the same heuristics as check_eid_format(), and,
+  for files that start with a G.192 synchronism header, a frame index
+  is built by jumping from header to header. As in the tools that
+  used to do this check on the FILE, the file is taken as having
+  sync headers when the word after the first frame is also a sync
+  word (or when the file has a single frame).
+
+  Softbits can then be read at any position with bs_map_read(), and
+  frames accessed in place with bs_map_frame(), so that seeking to
+  frame (or softbit) N costs O(1).
+
+  Parameters:
+  ~~~~~~~~~~~
+  file ... name of file to be opened
+
+  Returned value:
+  ~~~~~~~~~~~~~~~
+  Returns a pointer to the BS_MAP, or a NULL pointer if the file could
+  not be opened. Like check_eid_format(), aborts if the file is a
+  byte-swapped G.192 file.
+
+  History:
+  ~~~~~~~~
+  16.Oct.26  v1.00 created
+  ---------------------------------------------------------------------------
+*/
+BS_MAP *bs_map_open (char *file) {
+  BS_MAP *map;
+  short word = 0;
+  long pos, len, maxframes;
+
+  if ((map = (BS_MAP *) calloc (1, sizeof (BS_MAP))) == NULL)
+    error_terminate ("Cannot allocate memory for bitstream map\n", 6);
+  if (bs_map_file (map, file) < 0) {
+    free (map);
+    return (NULL);
+  }
+
+  /* Detect format & type from the first word, in the native byte order */
+  memcpy (&word, map->data ? map->data : (char *) &word, map->size < sizeof (short) ? map->size : sizeof (short));
+  map->format = eid_format_of (word, file, &map->type);
+  map->sample_len = map->format == byte ? 1 : (map->format == g192 ? 2 : 0);
+  map->items = map->sample_len ? (long) (map->size / map->sample_len) : (long) map->size * 8;
+
+  /* Check whether the file has sync headers */
+  if (map->type == FER && map->items >= 2) {
+    pos = 2 + bs_map_word (map, 1);
+    if (pos < 2 || pos >= map->items)
+      map->sync_header = 1;     /* Single frame in the file */
+    else if (map->format == g192)
+      map->sync_header = (bs_map_word (map, pos) & 0xFFF0) == 0x6B20;
+    else
+      map->sync_header = (bs_map_word (map, pos) & 0xF0) == 0x20;
+  }
+  if (!map->sync_header)
+    return (map);
+
+  /* Build the frame index: a frame is counted when its length is present */
+  maxframes = 0;
+  for (pos = 0; pos + 1 < map->items; pos += len + 2) {
+    if ((len = bs_map_word (map, pos + 1)) < 0)
+      break;
+    if (map->nframes == maxframes) {
+      maxframes = maxframes ? 2 * maxframes : 1024;
+      map->frame = (long *) realloc (map->frame, maxframes * sizeof (long));
+      map->len = (long *) realloc (map->len, maxframes * sizeof (long));
+      if (map->frame == NULL || map->len == NULL)
+        error_terminate ("Cannot allocate memory for bitstream frame index\n", 6);
+    }
+    map->frame[map->nframes] = pos;
+    map->len[map->nframes] = len;
+    if (len > map->max_len)
+      map->max_len = len;
+    map->nframes++;
+  }
+
+  /* Without any complete header, the file is taken as headerless */
+  if (map->nframes == 0)
+    map->sync_header = 0;
+
+  return (map);
+}
+
+/* ....................... End of bs_map_open() ....................... */
+
+
+/*
+  ---------------------------------------------------------------------------
+  long bs_map_read (BS_MAP *map, long item, long n, short *patt);
+  ~~~~~~~~~~~~~~~~
+
+  Reads n softbits starting at softbit number item (counted from 0)
+  of a mapped file into a G.192 array. Byte-oriented data is
+  converted as in read_byte(), and compact data as in read_bit() for
+  the type in map->type, which the caller must set (BER or FER) when
+  the format detection could not infer it. Unlike read_bit(), item
+  and n need not be byte-aligned in the compact format.
+
+  Returned value:
+  ~~~~~~~~~~~~~~~
+  Returns the number of softbits read, less than n (possibly 0) when
+  the end of the file is reached.
+
+  History:
+  ~~~~~~~~
+  16.Oct.26  v1.00 created
+  ---------------------------------------------------------------------------
+*/
+long bs_map_read (BS_MAP * map, long item, long n, short *patt) {
+  unsigned char *p;
+  long i;
+
+  /* Clip to the end of the file */
+  if (item < 0 || item >= map->items)
+    return (0);
+  if (n > map->items - item)
+    n = map->items - item;
+
+  switch (map->format) {
+  case g192:
+    memcpy (patt, (short *) map->data + item, n * sizeof (short));
+    break;
+
+  case byte:
+    for (p = (unsigned char *) map->data + item, i = 0; i < n; i++, p++)
+      patt[i] = (*p == 0x20 || *p == 0x21) ? 0x6B00 | *p : *p;
+    break;
+
+  case compact:
+    for (p = (unsigned char *) map->data, i = 0; i < n; i++, item++) {
+      if ((p[item >> 3] >> (item & 7)) & 1)
+        patt[i] = map->type == FER ? G192_FER : G192_ONE;
+      else
+        patt[i] = map->type == FER ? G192_SYNC : G192_ZERO;
+    }
+    break;
+  }
+
+  return (n);
+}
+
+/* ....................... End of bs_map_read() ....................... */
+
+
+/*
+  ---------------------------------------------------------------------------
+  void bs_map_close (BS_MAP *map);
+  ~~~~~~~~~~~~~~~~~
+
+  Releases the file mapping (or memory) and the frame index of a
+  BS_MAP opened by bs_map_open().
+
+  History:
+  ~~~~~~~~
+  16.Oct.26  v1.00 created
+  ---------------------------------------------------------------------------
+*/
+void bs_map_close (BS_MAP * map) {
+  if (map == NULL)
+    return;
+  if (map->data != NULL) {
+#if defined(BS_MAP_MMAP)
+    if (map->mapped)
+      munmap (map->data, map->size);
+    else
+#elif defined(BS_MAP_WIN32)
+    if (map->mapped)
+      UnmapViewOfFile (map->data);
+    else
+#endif
+      free (map->data);
+  }
+  free (map->frame);
+  free (map->len);
+  free (map);
+}
+
+/* ....................... End of bs_map_close() ....................... */
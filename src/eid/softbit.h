@@ -1,6 +1,6 @@
 /*
   ============================================================================
-   File: SOFTBIT.H                                                   10.OCT.97
+   File: SOFTBIT.H                                                   16.OCT.26
   ============================================================================
 
 			  UGST/ITU-T UTILITY MODULE
@@ -9,10 +9,11 @@
 
    History:
    10.Oct.97     1.00   Created
+   16.Oct.26     1.10   Added memory-mapped reader with frame index (BS_MAP)
   ============================================================================
 */
 #ifndef SOFTBIT_DEFINED
-#define SOFTBIT_DEFINED 100
+#define SOFTBIT_DEFINED 110
 
 /* ......... Smart prototypes .......... */
 #ifndef ARGS
@@ -43,6 +44,31 @@ enum EP_types { BER, FER };
 #define G192_SYNC	(short)0x6B21
 #define G192_FER	(short)0x6B20
 
+/*
+ * ......... Memory-mapped bitstream/error pattern file .........
+ * Softbit number i of a G.192 or byte file is at data + i*sample_len;
+ * frame f (when sync_header is set) starts with its sync header at
+ * softbit frame[f] and has len[f] softbits of payload.
+ */
+typedef struct {
+  char *data;                   /* file contents (read-only) */
+  size_t size;                  /* file size, in bytes */
+  char format;                  /* g192, byte or compact */
+  char type;                    /* BER or FER; nil if unknown (compact) */
+  char sync_header;             /* 1 if the file has G.192 sync headers */
+  char mapped;                  /* 1 if data is a file mapping */
+  long sample_len;              /* bytes per softbit (0 for compact) */
+  long items;                   /* number of softbits (bits, if compact) */
+  long nframes;                 /* number of frames in the index */
+  long *frame;                  /* softbit position of each frame header */
+  long *len;                    /* payload length of each frame */
+  long max_len;                 /* largest payload length in the file */
+} BS_MAP;
+
+/* Zero-copy view of softbit i / of frame f (G.192 or byte files only) */
+#define bs_map_ptr(map, i) ((map)->data + (i) * (map)->sample_len)
+#define bs_map_frame(map, f) bs_map_ptr (map, (map)->frame[f])
+
 /* softbit.c */
 long read_g192 ARGS ((short *patt, long n, FILE * F));
 long read_bit_ber ARGS ((short *patt, long n, FILE * F));
@@ -56,6 +82,9 @@ char *format_str ARGS ((int fmt));
 char *type_str ARGS ((int type));
 char check_eid_format ARGS ((FILE * F, char *file, char *type));
 long soft2hard ARGS ((short *soft, short *hard, long n, char type));
+BS_MAP *bs_map_open ARGS ((char *file));
+long bs_map_read ARGS ((BS_MAP * map, long item, long n, short *patt));
+void bs_map_close ARGS ((BS_MAP * map));
 
 #endif /* SOFTBIT_DEFINED */
 
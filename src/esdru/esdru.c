@@ -11,6 +11,20 @@
 #include "ugst-utl.h"           /* for ran16_32c */
 
 #define LOCAL_PI       3.14159265358979323846
+#define BLOCK_LEN      4800     /* Processing block, in stereo samples */
+
+/*-------------------------------------------------
+ * State of the modulation curve generator
+ *-------------------------------------------------*/
+typedef struct
+{
+    long step;         /* Length of transition in samples          */
+    double e_step;     /* Energy step in high energy segments      */
+    float *fseed;      /* Random number generator seed/state       */
+    long j;            /* Position in current transition           */
+    double m_prev;     /* Modulation at start of current transition */
+    double m_new;      /* Modulation at end of current transition   */
+} MOD_STATE;
 
 void usage()
 {
@@ -67,19 +81,25 @@ void energy(
 /*------------------------------------------------- 
  * First order one - pole iir filter of the form
  * y( n ) = fac * x( n ) + (1 - fac) * y( n - 1 )
+ *
+ * The memory is carried between calls, so that a
+ * signal can be filtered block by block: in time
+ * order for dir = 1, and from the last block to the
+ * first for dir = -1. Start with *mem = 0.0.
  *-------------------------------------------------*/
 void ar1(
-    const double fac,     /* i: filter coefficient */
-    const double *input,  /* i: Input signal       */
-          double *output, /* i: Output signal      */
-    const long length,    /* i: Length of signal   */
-    const long dir        /* i: Direction (1, -1)  */
+    const double fac,     /*  i: filter coefficient */
+    const double *input,  /*  i: Input signal       */
+          double *output, /*  i: Output signal      */
+    const long length,    /*  i: Length of signal   */
+    const long dir,       /*  i: Direction (1, -1)  */
+          double *mem_ptr /* i/o: Filter memory     */
 )
 {
     long i;
     double mem;
 
-    mem = 0.0;
+    mem = *mem_ptr;
 
     if( dir == 1 )
     { 
@@ -101,6 +121,7 @@ void ar1(
         }
     }
 
+    *mem_ptr = mem;
 
     return;
 }
@@ -160,88 +181,160 @@ long convert_double2short( /* returns number of clipped samples */
     return clip;
 }
 
+/*-------------------------------------------------
+ * Modulation curve of one block. Every step samples,
+ * a new modulation target is drawn with probability
+ * 0.2, limited to a step of e_step where the short
+ * term energy es exceeds the long term energy el.
+ *-------------------------------------------------*/
 void g_mod_nrg(
-    const double *input,       /*  i: Stereo input signal                 */
-    const long length,         /*  i: Length of input signal in samples   */
-    const long step,           /*  i: Length of transition in samples     */
-    const double e_step,       /*  i: Energy step in high energy segments */
-    const short energy_input,  /*  i: Flag for energy input               */
-    const short energy_output, /*  i: Flag for energy output              */
-    FILE* f_energy,            /*i/o: Energy file pointer                 */
-          float *fseed,        /*i/o: Random number generator seed/state  */
+    const double *es,          /*  i: Short term energy                   */
+    const double *el,          /*  i: Long term energy                    */
+    const long length,         /*  i: Length of block in samples          */
+          MOD_STATE *st,       /*i/o: Modulation curve generator state    */
           double *m            /*  o: Modulation curve                    */
 )
 {
-    long i, j, M;
-    double *e,*es,*el;
-    double m_prev, m_delta, m_new;
+    long i;
+    double m_delta;
     double xf_win;
-    
-    e = malloc( sizeof( double )*length );
-    es = malloc( sizeof( double )*length );
-    el = malloc( sizeof( double )*length );
-
-    M = length / step + ((length % step) > 0); /* M = ceil(length/step) */
-
-    energy( input, e, length );
 
-    ar1( 0.001, e, es, length, -1 );
-    ar1( 0.001, es, es, length, 1 );
-    ar1( 0.0001, es, el, length, -1 );
-    ar1( 0.0001, el, el, length, 1 );
-    scale_double( el, 0.77813, el, length );
-
-    if( energy_input == 1 )
-    {
-        fread( es, sizeof( double ), length, f_energy );
-        fread( el, sizeof( double ), length, f_energy );
-    }
-    if( energy_output == 1 )
-    {
-        fwrite( es, sizeof( double ), length, f_energy );
-        fwrite( el, sizeof( double ), length, f_energy );
-    }
-
-    i = 0;
-    m_prev = 1.0;
-    while( i < length )    
+    for( i = 0; i < length; i++ )
     {
-        if( (ran16_32c( fseed ) / ((double)RAN16_32C_MAX)) < 0.2 )
-        { 
-            if( es[i] < el[i] )
-            {
-                m_delta = 1.0;
+        if( st->j == 0 )
+        {
+            if( (ran16_32c( st->fseed ) / ((double)RAN16_32C_MAX)) < 0.2 )
+            { 
+                if( es[i] < el[i] )
+                {
+                    m_delta = 1.0;
+                }
+                else
+                {
+                    m_delta = st->e_step;
+                }
+                st->m_new = ran16_32c( st->fseed ) / ((double)RAN16_32C_MAX) * m_delta + st->m_prev * (1.0 - m_delta);
             }
             else
             {
-                m_delta = e_step;
+                st->m_new = st->m_prev;
             }
-            m_new = ran16_32c( fseed ) / ((double)RAN16_32C_MAX) * m_delta + m_prev * (1.0 - m_delta);
         }
-        else
+
+        xf_win = 0.5 * (1.0 - cos( LOCAL_PI * st->j / st->step ));
+        m[i] = st->m_new * xf_win + st->m_prev * (1.0 - xf_win);
+
+        if( ++st->j == st->step )
         {
-            m_new = m_prev;
+            st->j = 0;
+            st->m_prev = st->m_new;
         }
+    }
+
+    return;
+}
+
+/*-------------------------------------------------
+ * Block positions for the backward (dir = -1) passes:
+ * blocks are taken from the end of the signal
+ *-------------------------------------------------*/
+static long prev_block(    /* o: Length of block, 0 at start of signal */
+    long *start            /* i/o: Start of next block / of this block */
+)
+{
+    long end;
+
+    end = *start;
+    *start = end > BLOCK_LEN ? end - BLOCK_LEN : 0;
+
+    return end - *start;
+}
+
+/*-------------------------------------------------
+ * Read/write a block of doubles at a sample position
+ *-------------------------------------------------*/
+static long read_block(
+    FILE *fp, const long pos, double *x, const long length )
+{
+    fseek( fp, pos * (long) sizeof( double ), SEEK_SET );
+    return (long) fread( x, sizeof( double ), length, fp );
+}
+
+static void write_block(
+    FILE *fp, const long pos, const double *x, const long length )
+{
+    fseek( fp, pos * (long) sizeof( double ), SEEK_SET );
+    fwrite( x, sizeof( double ), length, fp );
+}
 
-        for(j = 0; j < step && i < length; i++,j++ )
+/*-------------------------------------------------
+ * Short and long term energy of the stereo input.
+ *
+ * The smoothing filters run backward and forward over
+ * the whole signal, so they are computed in passes
+ * over blocks of BLOCK_LEN samples, with the results
+ * kept in the temporary files f_es and f_el instead
+ * of in memory:
+ *   pass 1 (backward): es = ar1( 0.001, e, -1 )
+ *   pass 2 (forward) : es = ar1( 0.001, es, 1 )
+ *   pass 3 (backward): el = ar1( 0.0001, es, -1 )
+ * The last forward pass over el is done by the caller,
+ * together with the modulation. Each sample is computed
+ * with the same operations, in the same order, as over
+ * the whole signal at once.
+ *-------------------------------------------------*/
+void energy_passes(
+          FILE *f_input,       /*  i: Stereo input file                   */
+    const long length,         /*  i: Length of input signal in samples   */
+    const short energy_output, /*  i: Flag for energy output              */
+          FILE *f_energy,      /*i/o: Energy file pointer                 */
+          FILE *f_es,          /*i/o: Temporary file for es               */
+          FILE *f_el,          /*  o: Temporary file for el               */
+          short *buf_short,    /*  -: Scratch, 2*BLOCK_LEN samples        */
+          double *buf,         /*  -: Scratch, 2*BLOCK_LEN samples        */
+          double *e            /*  -: Scratch, BLOCK_LEN samples          */
+)
+{
+    long start, n;
+    double mem;
+
+    /* Pass 1 */
+    mem = 0.0;
+    start = length;
+    while( (n = prev_block( &start )) > 0 )
+    {
+        fseek( f_input, start * 4L, SEEK_SET );
+        fread( buf_short, sizeof( short ), n * 2, f_input );
+        convert_short2double( buf_short, buf, n * 2 );
+        energy( buf, e, n );
+        ar1( 0.001, e, e, n, -1, &mem );
+        write_block( f_es, start, e, n );
+    }
+
+    /* Pass 2 */
+    mem = 0.0;
+    for( start = 0; start < length; start += n )
+    {
+        n = length - start < BLOCK_LEN ? length - start : BLOCK_LEN;
+        read_block( f_es, start, e, n );
+        ar1( 0.001, e, e, n, 1, &mem );
+        write_block( f_es, start, e, n );
+        if( energy_output == 1 )
         {
-            xf_win = 0.5 * (1.0 - cos( LOCAL_PI * j / step ));
-            m[i] = m_new * xf_win + m_prev * (1.0 - xf_win);
+            fwrite( e, sizeof( double ), n, f_energy );
         }
-        m_prev = m_new;
     }
 
+    /* Pass 3 */
+    mem = 0.0;
+    start = length;
+    while( (n = prev_block( &start )) > 0 )
     {
-    FILE *fp;
-    fp = fopen("mc.double","wb");
-    fwrite(m,sizeof(double),length,fp);
-    fclose(fp);
+        read_block( f_es, start, e, n );
+        ar1( 0.0001, e, e, n, -1, &mem );
+        write_block( f_el, start, e, n );
     }
 
-    free( e );
-    free( es );
-    free( el );
-
     return;
 }
 
@@ -274,6 +367,9 @@ int main(int argc, char **argv )
     FILE* f_input;
     FILE* f_output;
     FILE* f_energy;
+    FILE* f_es;
+    FILE* f_el;
+    FILE* f_mc;
     char *input_filename;
     char *output_filename;
     double *input;
@@ -281,10 +377,16 @@ int main(int argc, char **argv )
     unsigned int intseed;
     float fseed; /* float seed for ran16_32c */
     double *m;
+    double *es;
+    double *el;
+    double mem;
+    MOD_STATE mod;
     double alpha;
     double e_step;
     long step;
     long length;
+    long start;
+    long n;
     long fs;
     long clip;
     long i;
@@ -420,24 +522,72 @@ int main(int argc, char **argv )
     /* Set random seed */
     fseed = (float) intseed;
 
-    /* Load input file */
+    /* Process input file block by block */
     fseek( f_input, 0L, SEEK_END );
     length = ftell( f_input ) / 4; /* 2 bytes per sample, 2 channels */
     rewind( f_input );
-    input = malloc(sizeof(double) * length * 2);
-    input_short = malloc( sizeof( short ) * length * 2 );
-    m = malloc( sizeof( double ) * length );
-    fread( input_short, sizeof(short), length * 2, f_input);
-    convert_short2double( input_short, input, length * 2);
+    input = malloc( sizeof( double ) * BLOCK_LEN * 2 );
+    input_short = malloc( sizeof( short ) * BLOCK_LEN * 2 );
+    m = malloc( sizeof( double ) * BLOCK_LEN );
+    es = malloc( sizeof( double ) * BLOCK_LEN );
+    el = malloc( sizeof( double ) * BLOCK_LEN );
+    if( (f_es = tmpfile()) == NULL || (f_el = tmpfile()) == NULL )
+    {
+        fprintf( stderr, "Could not open temporary files, exiting..\n\n" );
+        exit( -1 );
+    }
+    if( (f_mc = fopen( "mc.double", "wb" )) == NULL )
+    {
+        fprintf( stderr, "Could not open mc.double, exiting..\n\n" );
+        exit( -1 );
+    }
+
+    energy_passes( f_input, length, energy_output, f_energy, f_es, f_el, input_short, input, es );
 
     step = (long) (1.5 * fs / 50.0);
-    g_mod_nrg( input, length, step, e_step, energy_input, energy_output, f_energy, &fseed, m );
+    mod.step = step;
+    mod.e_step = e_step;
+    mod.fseed = &fseed;
+    mod.j = 0;
+    mod.m_prev = 1.0;
+    mod.m_new = 1.0;
+
+    clip = 0;
+    mem = 0.0;
+    fseek( f_input, 0L, SEEK_SET );
+    for( start = 0; start < length; start += n )
+    {
+        n = length - start < BLOCK_LEN ? length - start : BLOCK_LEN;
 
-    apply_spatial_dist( input, length, m, alpha );
+        /* Last pass of the long term energy: el = 0.77813 * ar1( 0.0001, el, 1 ) */
+        read_block( f_es, start, es, n );
+        read_block( f_el, start, el, n );
+        ar1( 0.0001, el, el, n, 1, &mem );
+        scale_double( el, 0.77813, el, n );
 
-    clip = convert_double2short(input, input_short, length * 2);
+        if( energy_input == 1 )
+        {
+            /* Energies found in the energy file replace the computed ones */
+            read_block( f_energy, start, es, n );
+            read_block( f_energy, length + start, el, n );
+        }
+        if( energy_output == 1 )
+        {
+            write_block( f_energy, length + start, el, n );
+        }
+
+        g_mod_nrg( es, el, n, &mod, m );
+        fwrite( m, sizeof( double ), n, f_mc );
+
+        fread( input_short, sizeof( short ), n * 2, f_input );
+        convert_short2double( input_short, input, n * 2 );
 
-    fwrite( input_short, sizeof( short ), length * 2, f_output );
+        apply_spatial_dist( input, n, m, alpha );
+
+        clip += convert_double2short( input, input_short, n * 2 );
+
+        fwrite( input_short, sizeof( short ), n * 2, f_output );
+    }
 
     fprintf( stdout, "--> Done processing %ld samples\n", length );
     if (clip > 0)
@@ -451,9 +601,14 @@ int main(int argc, char **argv )
     }
     fclose( f_input );
     fclose( f_output );
+    fclose( f_es );
+    fclose( f_el );
+    fclose( f_mc );
     free( input );
     free( input_short );
     free( m );
+    free( es );
+    free( el );
 
 }
 
@@ -1,4 +1,4 @@
-/*                                                           02.Feb.2010 v3.5
+/*                                                           16.Oct.2026 v3.7
   ===========================================================================
 
   FILTER.C
@@ -40,6 +40,12 @@
                   asynchronous tandeming simulation. For d>0, null
                   samples are inserted in the begining of the file,
                   d<0 causes samples to be dropped. Default is d=0.
+  -fast ......... allow reassociated (faster) dot-products in the FIR
+                  filters; output may differ in the last bit from the
+                  bit-exact default
+  -nch n ........ number of interleaved channels in the input file
+                  (IFLAT only); BlockSize is then in samples per channel.
+                  Default is 1.
   -q ............ quiet processing (no progress flag)
 
   Valid filter specifications:
@@ -152,6 +158,10 @@
 
    02.Feb.2010 v3.5 - Modified maximum string length for filenames to avoid
                       buffer overruns (y.hiwasaki)
+   16.Oct.2026 v3.6 - Added option -fast to select the reassociated
+                      (non bit-exact) FIR dot-product kernels.
+   16.Oct.2026 v3.7 - Added option -nch to filter interleaved multichannel
+                      files with the cascade-form IIR (IFLAT) in one pass.
   ===========================================================================
 */
 
@@ -254,6 +264,9 @@ void display_usage () {
   printf ("               asynchronous tandeming simulation. For d>0, null\n");
   printf ("               samples are inserted in the begining of the file,\n");
   printf ("               d<0 causes samples to be dropped. Default is d=0.\n");
+  printf ("  -fast ...... reassociated (faster, not bit-exact) FIR dot-products\n");
+  printf ("  -nch n ..... number of interleaved channels in the files (IFLAT\n");
+  printf ("               only); BlockSize is then per channel. Default is 1.\n");
   printf ("  -q ......... quiet processing (no progress flag)\n");
   printf ("\n");
   printf (" Valid filter specifications:\n");
@@ -315,8 +328,8 @@ int main (int argc, char *argv[]) {
   short *TmpBuff;
   char F_type[MAX_STRLEN], async = 0, upsample = 0;
   long cur_blk, satur = 0, total = 0, k, N, N1, N2;
-  char modified_IRS = 0, quiet = 0;
-  long inp_size, out_size, factor, smpno;
+  char modified_IRS = 0, quiet = 0, fast = 0;
+  long inp_size, out_size, factor, smpno, nch = 1;
   double fs = 8000;
   char kernel_type = 0;
   static char funny[9] = "|/-\\|/-\\";
@@ -362,6 +375,20 @@ int main (int argc, char *argv[]) {
         /* Move arg{c,v} over the option to the next argument */
         argc--;
         argv++;
+      } else if (strcmp (argv[1], "-fast") == 0) {
+        /* Allow reassociated FIR dot-products */
+        fast = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-nch") == 0) {
+        /* Number of interleaved channels */
+        nch = atol (argv[2]);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
       } else if (strcmp (argv[1], "-down") == 0) {
         /* Filtering is for downsampling */
         upsample = async = 0;
@@ -421,6 +448,12 @@ int main (int argc, char *argv[]) {
     exit (2);
   }
 
+  /* Multichannel files only for the cascade-form IIR filter */
+  if (nch < 1)
+    error_terminate ("\nInvalid number of channels! Aborted.\n", 5);
+  if (nch > 1 && !(strncmp (F_type, "iflat", 5) == 0 || strncmp (F_type, "IFLAT", 5) == 0))
+    error_terminate ("\nMultichannel (-nch) filtering only available for IFLAT! Aborted.\n", 5);
+
   /* The delay option is only available with asynchronous filtering */
   if (delay != 0 && !async)
     error_terminate ("\nDelay option only available for ASYNC filtering! Aborted.\n", 5);
@@ -429,7 +462,7 @@ int main (int argc, char *argv[]) {
   /* ......... STARTING ......... */
 
   /* Find starting byte in file */
-  start_byte = sizeof (short) * (long) (--N1) * (long) N;
+  start_byte = sizeof (short) * (long) (--N1) * (long) N * nch;
 
 #ifdef SKIP_APPROACH_1
   /* If samples are to be skipped in output file, does it here */
@@ -443,17 +476,17 @@ int main (int argc, char *argv[]) {
 
     /* ... find the input file size ... */
     stat (FileIn, &st);
-    N2 = ceil ((st.st_size - start_byte) / (double) (N * sizeof (short)));
+    N2 = ceil ((st.st_size - start_byte) / (double) (N * nch * sizeof (short)));
   }
   inp_size = N;                 /* samples */
 
 
   /* Allocate memory for delay buffer & initialize it */
   if (delay > 0) {
-    if ((zero = (short *) calloc (delay, sizeof (short))) == NULL) {
+    if ((zero = (short *) calloc (delay * nch, sizeof (short))) == NULL) {
       error_terminate ("Error allocating memory for delay buffer\n", 5);
     } else
-      memset (zero, 0, delay * sizeof (short));
+      memset (zero, 0, delay * nch * sizeof (short));
   }
 
   /* Set flag to filter type: IIR or FIR; default is FIR */
@@ -676,6 +709,8 @@ int main (int argc, char *argv[]) {
   else if (strncmp (F_type, "iflat", 5) == 0 || strncmp (F_type, "IFLAT", 5) == 0) {
     cascade_iir_state = upsample ? iir_casc_lp_1_to_3_init ()   /* It is up-sampling! */
       : iir_casc_lp_3_to_1_init ();     /* It is down-sampling! */
+    if (nch > 1 && cascade_iir_set_channels (cascade_iir_state, nch) != 0)
+      error_terminate ("Can't allocate memory for multichannel filter state\n", 10);
   }
 
 /*
@@ -692,6 +727,8 @@ int main (int argc, char *argv[]) {
   /* Calculate Output buffer size and rate change factor */
   switch (kernel_type) {
   case FIR:
+    if (fast)
+      hq_set_mode (fir_state, HQ_MODE_FAST);
     factor = fir_state->dwn_up;
     out_size = (fir_state->hswitch == 'U')
       ? inp_size * factor : ceil (inp_size / (double) factor);
@@ -716,6 +753,10 @@ int main (int argc, char *argv[]) {
   if (async && factor == 1)
     error_terminate ("INCONSISTENCY: async operation requires non-unity upsampling factor; aborting\n", 10);
 
+  /* Buffers hold interleaved samples of all channels */
+  inp_size *= nch;
+  out_size *= nch;
+
   /* Allocate memory for float input buffer */
   if ((InpBuff = (float *) calloc (inp_size, sizeof (float))) == NULL)
     error_terminate ("Can't allocate memory for input data buffer\n", 10);
@@ -740,6 +781,8 @@ int main (int argc, char *argv[]) {
   }
   if (modified_IRS)
     fprintf (stderr, "Using modified IRS\n");
+  if (nch > 1)
+    fprintf (stderr, "Filtering %ld interleaved channels\n", nch);
 
   if (delay > 0)
     fprintf (stderr, "Delaying output file by %ld samples\n", delay);
@@ -775,9 +818,12 @@ int main (int argc, char *argv[]) {
 
   /* One-time delay of output signal, if appropriate */
   if (async && delay > 0)
-    if ((smpno = fwrite (zero, sizeof (short), delay, Fo)) == 0 && ferror (Fo))
+    if ((smpno = fwrite (zero, sizeof (short), delay * nch, Fo)) == 0 && ferror (Fo))
       KILL (FileOut, 6);
 
+  /* Skipping is done over the interleaved samples */
+  skip *= nch;
+
   /* Process regular frames */
   for (cur_blk = 0; cur_blk < N2; cur_blk++) {
     /* Print progress info */
@@ -788,11 +834,11 @@ int main (int argc, char *argv[]) {
     memset (OutBuff, '\0', out_size * sizeof (float));
 
     /* Read a block of samples */
-    if ((smpno = fread (TmpBuff, sizeof (short), N, Fi)) == 0)
+    if ((smpno = fread (TmpBuff, sizeof (short), N * nch, Fi) / nch) == 0)
       KILL (FileIn, 5);
 
     /* ... and convert short to float, normalizing */
-    sh2fl_16bit (smpno, TmpBuff, InpBuff, 1);
+    sh2fl_16bit (smpno * nch, TmpBuff, InpBuff, 1);
 
     /* Call the filtering routine */
     switch (kernel_type) {
@@ -812,17 +858,19 @@ int main (int argc, char *argv[]) {
 
     /* Decimates to implement asynchronization process */
     if (async) {
-      long k;
+      long k, c;
 
       /* Decrease output vector by `factor' */
       smpno /= factor;
 
       /* Shift samples implementing decimation process */
       for (k = 0; k < smpno; k++)
-        OutBuff[k] = OutBuff[k * factor];
+        for (c = 0; c < nch; c++)
+          OutBuff[k * nch + c] = OutBuff[k * factor * nch + c];
     }
 
     /* Convert the filtered data back to short */
+    smpno *= nch;
     satur += fl2sh_16bit (smpno, OutBuff, TmpBuff, (int) 1);
 
     /* Save to file, skipping any samples if necessary */
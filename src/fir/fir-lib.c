@@ -1,4 +1,4 @@
-/*                                                          v2.3 - 03/Dec/2004
+/*                                                          v2.5 - 16/Oct/2026
   =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -46,6 +46,8 @@ FUNCTIONS:
                                     (needed only if another signal should
                                     be processed with the same filter)
          = hq_free(...)          :  deallocate FIR-filter memory
+         = hq_set_mode(...)      :  select strict (bit-exact) or fast
+                                    (reassociated) dot-products
 
   Local (Used by other sub-units of this module, should not be needed by
          the user's program. Prototypes here and in the sub-units that use
@@ -57,6 +59,11 @@ FUNCTIONS:
                                    up-sampling procedures;
          = fir_downsampling_kernel(...) : kernel function for all FIR
                                    down-sampling procedures;
+         = fir_polyphase_init(...) : split the FIR-coefficients into
+                                   contiguous polyphase sub-filters;
+         = fir_polyphase_kernel(...) : polyphase kernel function for all
+                                   FIR up- and down-sampling procedures,
+                                   using a linear history buffer;
 
 HISTORY:
     16.Dec.91 v0.1 First beta-version <hf@pkinbg.uucp>
@@ -71,6 +78,12 @@ HISTORY:
 				   OpenVMS/AXP <simao@ctd.comsat.com>
     03.Dec.04 v2.3 Added correction in fir_downsampling_kernel() for sample-based
 				   operation.	<Cyril Guillaume & Stephane Ragot - stephane.ragot@francetelecom.com>
+    16.Oct.26 v2.4 Added polyphase back end, used by hq_kernel() unless
+                   compiled with FIR_LEGACY_KERNEL defined. Output is
+                   bit-identical to the original kernels, since the
+                   dot-products are accumulated in the same order.
+    16.Oct.26 v2.5 Polyphase kernel uses the vectorized dot-products of
+                   fir-simd.c; added hq_set_mode().
 
   =============================================================================
 */
@@ -81,10 +94,19 @@ HISTORY:
  */
 #include <stdio.h>
 #include <stdlib.h>             /* General utility definitions */
+#include <string.h>             /* memcpy(), memmove() */
 
 #include "firflt.h"             /* Global definitions for FIR-FIR filter */
 
 
+/*
+ * ......... Local definitions .........
+ */
+
+/* Number of input samples processed per pass of the polyphase kernel; the history buffer holds this many samples after the lenp-1 past ones */
+#define FIR_PP_BLOCK 1024
+
+
 /*
  * ......... Local function prototypes .........
  */
@@ -94,6 +116,15 @@ SCD_FIR *fir_initialization ARGS ((long lenh0, float h0[], double gain, long idw
 
 static long fir_upsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr, long lenh0, float *h0_ptr, float *T_ptr, long iupfac));
 static long fir_downsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr, long lenh0, float *h0_ptr, float *T_ptr, long downfac, long *k0_ptr));
+static int fir_polyphase_init ARGS ((SCD_FIR * fir_ptr));
+static long fir_polyphase_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr, SCD_FIR * fir_ptr));
+
+
+/*
+ * ..... Private function prototypes defined in other sub-unit .....
+ */
+extern void fir_dot_strict ARGS ((float *x, long xstride, float *h, long lenh, long nout, float *y, long ystride));
+extern void fir_dot_fast ARGS ((float *x, long xstride, float *hr, long lenh, long nout, float *y, long ystride));
 
 
 /*
@@ -140,11 +171,20 @@ static long fir_downsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr
         History:
         ~~~~~~~~
         28.Feb.92 v1.0 Release of 1st version <hf@pkinbg.uucp>
+        16.Oct.26 v1.1 Dispatch to the polyphase kernel when the
+                       sub-filters were set up at initialization.
 
  ============================================================================
 */
 long hq_kernel (long lseg, float *x_ptr, SCD_FIR * fir_ptr, float *y_ptr) {
-  if (fir_ptr->hswitch == 'U')  /* call up-sampling procedure */
+  if (fir_ptr->hp != (float *) NULL)    /* call polyphase procedure */
+    return fir_polyphase_kernel (       /* returns number of output samples */
+                                  lseg, /* In : length of input signal */
+                                  x_ptr,        /* In : array with input samples */
+                                  y_ptr,        /* Out : array with output samples */
+                                  fir_ptr       /* InOut: sub-filters and history */
+      );
+  else if (fir_ptr->hswitch == 'U')  /* call up-sampling procedure */
     return fir_upsampling_kernel (      /* returns number of output samples */
                                    lseg,        /* In : length of input signal */
                                    x_ptr,       /* In : array with input samples */
@@ -203,6 +243,9 @@ long hq_kernel (long lseg, float *x_ptr, SCD_FIR * fir_ptr, float *y_ptr) {
 */
 void hq_free (SCD_FIR * fir_ptr) {
 
+  free (fir_ptr->X);            /* free history buffer */
+  free (fir_ptr->hp);           /* free polyphase sub-filters */
+  free (fir_ptr->hr);           /* free reversed sub-filters */
   free (fir_ptr->T);            /* free state variables */
   free (fir_ptr->h0);           /* free state impulse response */
   free (fir_ptr);               /* free allocated struct */
@@ -245,12 +288,58 @@ void hq_reset (SCD_FIR * fir_ptr) {
   long k;
   for (k = 0; k < fir_ptr->lenh0 - 1; k++)      /* clear delay line */
     fir_ptr->T[k] = 0.0;        /* (= state variables) */
+  if (fir_ptr->X != (float *) NULL)
+    for (k = 0; k < fir_ptr->lenp - 1; k++)     /* clear history buffer */
+      fir_ptr->X[k] = 0.0;
   fir_ptr->k0 = 0;              /* default starting index in x-array */
 }
 
 /* .......................... End of hq_reset() .......................... */
 
 
+/*
+  ============================================================================
+
+        void hq_set_mode (SCD_FIR *fir_ptr, int mode);
+        ~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Select how the dot-products of the FIR-filter are computed:
+
+        HQ_MODE_STRICT: (default) products are summed in the original
+                        order; the output is bit-identical to the
+                        original scalar kernels.
+        HQ_MODE_FAST:   products are summed in an order suitable for
+                        vectorization over the taps; the output may
+                        differ in the last bits of the float samples.
+
+        Both modes use SIMD kernels when supported by the CPU. The mode
+        has no effect if the module was compiled with FIR_LEGACY_KERNEL.
+
+        Parameters:
+        ~~~~~~~~~~~
+        fir_ptr: (InOut) pointer to struct SCD_FIR;
+        mode: .. (In)    HQ_MODE_STRICT or HQ_MODE_FAST
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+void hq_set_mode (SCD_FIR * fir_ptr, int mode) {
+  fir_ptr->mode = (mode == HQ_MODE_FAST) ? HQ_MODE_FAST : HQ_MODE_STRICT;
+}
+
+/* ......................... End of hq_set_mode() ......................... */
+
+
 
 /*
   ============================================================================
@@ -283,6 +372,7 @@ void hq_reset (SCD_FIR * fir_ptr) {
         ~~~~~~~~
         28.Feb.92 v1.0 Release of 1st version <hf@pkinbg.uucp>
         12.Mar.92 v1.1 Corrected casting of malloc.
+        16.Oct.26 v1.2 Set up polyphase sub-filters.
 
  ============================================================================
 */
@@ -339,6 +429,20 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
   /* NOTE: for down-sampling: if the number of input samples is not a multiple of the down-sampling factor, k0 points to the first sample in the next input segment to be processed */
   ptrFIR->k0 = 0;
 
+  /* Split coefficients into polyphase sub-filters; leaving ptrFIR->hp NULL selects the original kernels */
+  ptrFIR->nphase = 1;
+  ptrFIR->lenp = lenh0;
+  ptrFIR->hp = (float *) NULL;
+  ptrFIR->hr = (float *) NULL;
+  ptrFIR->X = (float *) NULL;
+  ptrFIR->mode = HQ_MODE_STRICT;
+#ifndef FIR_LEGACY_KERNEL
+  if (fir_polyphase_init (ptrFIR) != 0) {
+    hq_free (ptrFIR);
+    return 0;
+  }
+#endif
+
   /* Return pointer to struct */
   return (ptrFIR);
 }
@@ -588,4 +692,169 @@ static long fir_upsampling_kernel (lenx, x, y, lenh0, h0, T, iupfac)
 /* ................. End of fir_upsampling_kernel() .................. */
 
 
+/*
+  ============================================================================
+
+        int fir_polyphase_init (SCD_FIR *fir_ptr);
+        ~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Split the FIR-coefficients of an already initialized SCD_FIR
+        struct into contiguous polyphase sub-filters and allocate the
+        linear history buffer used by fir_polyphase_kernel().
+
+        For up-sampling by a factor iupfac, sub-filter `iup' holds the
+        coefficients h0[iup + kappa*iupfac], kappa=0..lenh0/iupfac-1,
+        i.e. the coefficients the up-sampling kernel visits for output
+        phase `iup'. For down-sampling (including factor 1) there is a
+        single sub-filter equal to h0[], since the original kernel
+        accumulates over all coefficients in natural order. A copy of
+        each sub-filter in reversed order is kept for the fast
+        dot-product mode.
+
+        Parameters:
+        ~~~~~~~~~~~
+        fir_ptr: (InOut) pointer to struct SCD_FIR;
+
+        Return value:
+        ~~~~~~~~~~~~~
+        0 on success, -1 if memory could not be allocated (in which
+        case fir_ptr->hp, fir_ptr->hr and fir_ptr->X are left NULL).
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static int fir_polyphase_init (SCD_FIR * fir_ptr) {
+  long iup, kappa;
+
+  if (fir_ptr->hswitch == 'U') {
+    fir_ptr->nphase = fir_ptr->dwn_up;
+    fir_ptr->lenp = fir_ptr->lenh0 / fir_ptr->dwn_up;
+  } else {
+    fir_ptr->nphase = 1;
+    fir_ptr->lenp = fir_ptr->lenh0;
+  }
+
+  /* Allocate memory for the sub-filters */
+  if ((fir_ptr->hp = (float *) malloc (fir_ptr->nphase * fir_ptr->lenp * sizeof (float))) == (float *) NULL)
+    return -1;
+
+  /* Allocate memory for the reversed sub-filters */
+  if ((fir_ptr->hr = (float *) malloc (fir_ptr->nphase * fir_ptr->lenp * sizeof (float))) == (float *) NULL) {
+    free (fir_ptr->hp);
+    fir_ptr->hp = (float *) NULL;
+    return -1;
+  }
+
+  /* Allocate memory for history (lenp-1 samples) plus one block of input */
+  if ((fir_ptr->X = (float *) calloc (fir_ptr->lenp - 1 + FIR_PP_BLOCK, sizeof (float))) == (float *) NULL) {
+    free (fir_ptr->hr);
+    free (fir_ptr->hp);
+    fir_ptr->hp = fir_ptr->hr = (float *) NULL;
+    return -1;
+  }
+
+  /* Sub-filter iup is stored at hp[iup*lenp ... (iup+1)*lenp-1] */
+  for (iup = 0; iup < fir_ptr->nphase; iup++)
+    for (kappa = 0; kappa < fir_ptr->lenp; kappa++) {
+      fir_ptr->hp[iup * fir_ptr->lenp + kappa] = fir_ptr->h0[iup + kappa * fir_ptr->nphase];
+      fir_ptr->hr[(iup + 1) * fir_ptr->lenp - 1 - kappa] = fir_ptr->h0[iup + kappa * fir_ptr->nphase];
+    }
+
+  return 0;
+}
+
+/* ..................... End of fir_polyphase_init() ..................... */
+
+
+/*
+  ============================================================================
+
+        long fir_polyphase_kernel (long lenx, float *x_ptr, float *y_ptr,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~  SCD_FIR *fir_ptr);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        FIR-Filter (kernel) for up- and down-sampling, using the polyphase
+        sub-filters set up by fir_polyphase_init().
+
+        The input is copied block-wise behind the last lenp-1 input
+        samples in the linear history buffer X[], so that every
+        dot-product is computed over contiguous memory without the
+        transition between the x- and the T-array needed by the original
+        kernels. For down-sampling, only every downfac-th output is
+        computed, starting at offset k0 as in fir_downsampling_kernel().
+
+        The dot-products are computed by fir_dot_strict() or, if
+        HQ_MODE_FAST was selected by hq_set_mode(), by fir_dot_fast().
+        In strict mode the products are accumulated in the same order as
+        in fir_upsampling_kernel() and fir_downsampling_kernel(), hence
+        the output is bit-identical to these.
+
+        Parameters:
+        ~~~~~~~~~~~
+        lenx: .... (In)    length of input signal
+        x: ....... (In)    array with input samples
+        y: ....... (Out)   array with output samples
+        fir_ptr: . (InOut) pointer to struct SCD_FIR
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Number of filtered samples.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static long fir_polyphase_kernel (long lenx, float *x, float *y, SCD_FIR * fir_ptr) {
+  long lenp = fir_ptr->lenp;
+  long nphase = fir_ptr->nphase;
+  long downfac = fir_ptr->dwn_up;
+  float *X = fir_ptr->X;
+  float *h = (fir_ptr->mode == HQ_MODE_FAST) ? fir_ptr->hr : fir_ptr->hp;
+  void (*dot) ARGS ((float *, long, float *, long, long, float *, long));
+  long kx, nblk, nout, iup, ky;
+
+  dot = (fir_ptr->mode == HQ_MODE_FAST) ? fir_dot_fast : fir_dot_strict;
+  ky = 0;                       /* starting index in output array (y) */
+
+  for (kx = 0; kx < lenx; kx += nblk) {
+    /* Append next block of input to the history */
+    nblk = (lenx - kx > FIR_PP_BLOCK) ? FIR_PP_BLOCK : lenx - kx;
+    memcpy (X + lenp - 1, x + kx, nblk * sizeof (float));
+
+    if (fir_ptr->hswitch == 'U') {
+      /* Up-sampling: one output per sub-filter for every input sample; outputs of sub-filter iup go to y[ky+iup], y[ky+iup+nphase], ... */
+      for (iup = 0; iup < nphase; iup++)
+        dot (X + lenp - 1, 1, h + iup * lenp, lenp, nblk, y + ky + iup, nphase);
+      ky += nblk * nphase;
+    } else {
+      /* Down-sampling: one output every downfac input samples, starting at k0 */
+      nout = (fir_ptr->k0 < nblk) ? (nblk - fir_ptr->k0 + downfac - 1) / downfac : 0;
+      dot (X + lenp - 1 + fir_ptr->k0, downfac, h, lenp, nout, y + ky, 1);
+      ky += nout;
+
+      /* Offset of the next sample to be processed, relative to next block */
+      fir_ptr->k0 += nout * downfac - nblk;
+    }
+
+    /* Keep the last lenp-1 samples as history for the next block */
+    memmove (X, X + nblk, (lenp - 1) * sizeof (float));
+  }
+
+  /* Return number of output samples */
+  return ky;
+}
+
+/* ................. End of fir_polyphase_kernel() .................. */
+
+
 /* **************************** END OF FIR-LIB.C ************************** */
@@ -0,0 +1,483 @@
+/*                                                            16.Oct.2026 v1.0
+  =============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+MODULE:         FIRFLT, HIGH QUALITY FIR UP/DOWN-SAMPLING FILTER
+                Sub-unit: Vectorized dot-product kernels
+
+DESCRIPTION:
+        This file contains the dot-product kernels used by the polyphase
+        kernel in fir-lib.c. Each kernel computes `nout' outputs of one
+        polyphase sub-filter; the implementation (scalar, SSE, AVX2 or
+        NEON) is chosen at run time from the CPU features on the first
+        call.
+
+        Two flavours are provided:
+
+        - strict: the products of each output are accumulated in the
+          original order (tap 0 first), without fused multiply-add.
+          Consecutive outputs are computed in parallel SIMD lanes, hence
+          the results are bit-identical to the scalar kernels and to the
+          test_data/ *.ref files.
+
+        - fast: the dot-product of each output is vectorized over the
+          taps with several partial sums (and FMA when available). The
+          summation order differs from the strict flavour, hence
+          results may differ in the last bits of the float output.
+
+FUNCTIONS:
+  Local (Used by other sub-units of this module, should not be needed by
+         the user's program. Prototypes here and in the sub-units that use
+	 it, but not in firflt.h)
+         = fir_dot_strict(...) : dot-products in original summation order
+         = fir_dot_fast(...)   : reassociated dot-products
+
+  Local (should be used only here -- prototypes only in this file)
+         = fir_simd_select(...) : run-time selection of the kernels
+         = fir_dot_*_c(), fir_dot_*_sse(), fir_dot_*_avx2(),
+           fir_dot_*_neon() : the kernel implementations
+
+HISTORY:
+    16.Oct.2026 v1.0 Created.
+
+  =============================================================================
+*/
+
+
+/*
+ * ......... INCLUDES .........
+ */
+#include <stdio.h>
+#include <stdlib.h>             /* General utility definitions */
+
+#include "firflt.h"             /* Global definitions for FIR-FIR filter */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FIR_SIMD_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+/* NEON in AArch64 is IEEE-754 compliant (no flush-to-zero) */
+#define FIR_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+
+/*
+ * ......... Local definitions .........
+ */
+
+/* Kernel signature: x points to the newest sample of the first output;
+   output j uses x[j*xstride - k], k=0..lenh-1, and is stored into y[j*ystride] */
+typedef void (*fir_dot_fn) ARGS ((float *x, long xstride, float *h, long lenh, long nout, float *y, long ystride));
+
+
+/*
+ * ......... Local function prototypes .........
+ */
+void fir_dot_strict ARGS ((float *x, long xstride, float *h, long lenh, long nout, float *y, long ystride));
+void fir_dot_fast ARGS ((float *x, long xstride, float *hr, long lenh, long nout, float *y, long ystride));
+static void fir_simd_select ARGS ((void));
+
+
+/*
+ * ......... Local variables .........
+ */
+static fir_dot_fn fir_dot_strict_ptr = NULL;
+static fir_dot_fn fir_dot_fast_ptr = NULL;
+
+
+/*
+ * ...................... BEGIN OF FUNCTIONS .........................
+ */
+
+/*
+ * ......... Scalar (portable) kernels .........
+ */
+
+static void fir_dot_strict_c (float *x, long xstride, float *h, long lenh, long nout, float *y, long ystride) {
+  float *xn, acc;
+  long j, kappa;
+
+  for (j = 0; j < nout; j++) {
+    xn = x + j * xstride;
+    acc = xn[0] * h[0];
+    for (kappa = 1; kappa < lenh; kappa++)
+      acc += xn[-kappa] * h[kappa];
+    y[j * ystride] = acc;
+  }
+}
+
+static void fir_dot_fast_c (float *x, long xstride, float *hr, long lenh, long nout, float *y, long ystride) {
+  float *w, acc0, acc1, acc2, acc3;
+  long j, k;
+
+  for (j = 0; j < nout; j++) {
+    w = x + j * xstride - (lenh - 1);   /* oldest sample in the window */
+    acc0 = acc1 = acc2 = acc3 = 0;
+    for (k = 0; k + 4 <= lenh; k += 4) {
+      acc0 += w[k] * hr[k];
+      acc1 += w[k + 1] * hr[k + 1];
+      acc2 += w[k + 2] * hr[k + 2];
+      acc3 += w[k + 3] * hr[k + 3];
+    }
+    for (; k < lenh; k++)
+      acc0 += w[k] * hr[k];
+    y[j * ystride] = (acc0 + acc1) + (acc2 + acc3);
+  }
+}
+
+
+#if defined(FIR_SIMD_X86)
+
+/*
+ * ......... SSE kernels (4 lanes) .........
+ */
+
+__attribute__ ((target ("sse")))
+static __m128 fir_load4_sse (float *p, long xstride) {
+  if (xstride == 1)
+    return _mm_loadu_ps (p);
+  return _mm_setr_ps (p[0], p[xstride], p[2 * xstride], p[3 * xstride]);
+}
+
+__attribute__ ((target ("sse")))
+static void fir_dot_strict_sse (float *x, long xstride, float *h, long lenh, long nout, float *y, long ystride) {
+  __m128 acc0, acc1, hk;
+  float tmp[8];
+  long j, l, kappa;
+
+  /* Two groups of 4 consecutive outputs, one output per lane */
+  for (j = 0; j + 8 <= nout; j += 8) {
+    float *xn = x + j * xstride;
+    hk = _mm_set1_ps (h[0]);
+    acc0 = _mm_mul_ps (fir_load4_sse (xn, xstride), hk);
+    acc1 = _mm_mul_ps (fir_load4_sse (xn + 4 * xstride, xstride), hk);
+    for (kappa = 1; kappa < lenh; kappa++) {
+      hk = _mm_set1_ps (h[kappa]);
+      acc0 = _mm_add_ps (acc0, _mm_mul_ps (fir_load4_sse (xn - kappa, xstride), hk));
+      acc1 = _mm_add_ps (acc1, _mm_mul_ps (fir_load4_sse (xn + 4 * xstride - kappa, xstride), hk));
+    }
+    _mm_storeu_ps (tmp, acc0);
+    _mm_storeu_ps (tmp + 4, acc1);
+    for (l = 0; l < 8; l++)
+      y[(j + l) * ystride] = tmp[l];
+  }
+
+  /* Remaining outputs */
+  fir_dot_strict_c (x + j * xstride, xstride, h, lenh, nout - j, y + j * ystride, ystride);
+}
+
+__attribute__ ((target ("sse")))
+static void fir_dot_fast_sse (float *x, long xstride, float *hr, long lenh, long nout, float *y, long ystride) {
+  __m128 acc0, acc1;
+  float *w, tmp[4], acc;
+  long j, k;
+
+  for (j = 0; j < nout; j++) {
+    w = x + j * xstride - (lenh - 1);
+    acc0 = acc1 = _mm_setzero_ps ();
+    for (k = 0; k + 8 <= lenh; k += 8) {
+      acc0 = _mm_add_ps (acc0, _mm_mul_ps (_mm_loadu_ps (w + k), _mm_loadu_ps (hr + k)));
+      acc1 = _mm_add_ps (acc1, _mm_mul_ps (_mm_loadu_ps (w + k + 4), _mm_loadu_ps (hr + k + 4)));
+    }
+    _mm_storeu_ps (tmp, _mm_add_ps (acc0, acc1));
+    acc = (tmp[0] + tmp[1]) + (tmp[2] + tmp[3]);
+    for (; k < lenh; k++)
+      acc += w[k] * hr[k];
+    y[j * ystride] = acc;
+  }
+}
+
+
+/*
+ * ......... AVX2 kernels (8 lanes) .........
+ */
+
+__attribute__ ((target ("avx2")))
+static __m256 fir_load8_avx2 (float *p, __m256i idx, long xstride) {
+  if (xstride == 1)
+    return _mm256_loadu_ps (p);
+  return _mm256_i32gather_ps (p, idx, 4);
+}
+
+/* NOTE: compiled without "fma" on purpose, so that mul+add is never contracted */
+__attribute__ ((target ("avx2")))
+static void fir_dot_strict_avx2 (float *x, long xstride, float *h, long lenh, long nout, float *y, long ystride) {
+  __m256 acc0, acc1, hk;
+  __m256i idx;
+  float tmp[16];
+  long j, l, kappa;
+
+  idx = _mm256_setr_epi32 (0, (int) xstride, (int) (2 * xstride), (int) (3 * xstride), (int) (4 * xstride), (int) (5 * xstride), (int) (6 * xstride), (int) (7 * xstride));
+
+  /* Two groups of 8 consecutive outputs, one output per lane */
+  for (j = 0; j + 16 <= nout; j += 16) {
+    float *xn = x + j * xstride;
+    hk = _mm256_set1_ps (h[0]);
+    acc0 = _mm256_mul_ps (fir_load8_avx2 (xn, idx, xstride), hk);
+    acc1 = _mm256_mul_ps (fir_load8_avx2 (xn + 8 * xstride, idx, xstride), hk);
+    for (kappa = 1; kappa < lenh; kappa++) {
+      hk = _mm256_set1_ps (h[kappa]);
+      acc0 = _mm256_add_ps (acc0, _mm256_mul_ps (fir_load8_avx2 (xn - kappa, idx, xstride), hk));
+      acc1 = _mm256_add_ps (acc1, _mm256_mul_ps (fir_load8_avx2 (xn + 8 * xstride - kappa, idx, xstride), hk));
+    }
+    _mm256_storeu_ps (tmp, acc0);
+    _mm256_storeu_ps (tmp + 8, acc1);
+    for (l = 0; l < 16; l++)
+      y[(j + l) * ystride] = tmp[l];
+  }
+
+  /* Remaining outputs */
+  fir_dot_strict_sse (x + j * xstride, xstride, h, lenh, nout - j, y + j * ystride, ystride);
+}
+
+__attribute__ ((target ("avx2,fma")))
+static void fir_dot_fast_avx2 (float *x, long xstride, float *hr, long lenh, long nout, float *y, long ystride) {
+  __m256 acc0, acc1;
+  __m128 s;
+  float *w, acc;
+  long j, k;
+
+  for (j = 0; j < nout; j++) {
+    w = x + j * xstride - (lenh - 1);
+    acc0 = acc1 = _mm256_setzero_ps ();
+    for (k = 0; k + 16 <= lenh; k += 16) {
+      acc0 = _mm256_fmadd_ps (_mm256_loadu_ps (w + k), _mm256_loadu_ps (hr + k), acc0);
+      acc1 = _mm256_fmadd_ps (_mm256_loadu_ps (w + k + 8), _mm256_loadu_ps (hr + k + 8), acc1);
+    }
+    acc0 = _mm256_add_ps (acc0, acc1);
+    s = _mm_add_ps (_mm256_castps256_ps128 (acc0), _mm256_extractf128_ps (acc0, 1));
+    s = _mm_add_ps (s, _mm_movehl_ps (s, s));
+    s = _mm_add_ss (s, _mm_shuffle_ps (s, s, 1));
+    acc = _mm_cvtss_f32 (s);
+    for (; k < lenh; k++)
+      acc += w[k] * hr[k];
+    y[j * ystride] = acc;
+  }
+}
+
+#endif /* FIR_SIMD_X86 */
+
+
+#if defined(FIR_SIMD_NEON)
+
+/*
+ * ......... NEON kernels (4 lanes) .........
+ */
+
+static float32x4_t fir_load4_neon (float *p, long xstride) {
+  float32x4_t v;
+
+  if (xstride == 1)
+    return vld1q_f32 (p);
+  v = vdupq_n_f32 (p[0]);
+  v = vsetq_lane_f32 (p[xstride], v, 1);
+  v = vsetq_lane_f32 (p[2 * xstride], v, 2);
+  return vsetq_lane_f32 (p[3 * xstride], v, 3);
+}
+
+static void fir_dot_strict_neon (float *x, long xstride, float *h, long lenh, long nout, float *y, long ystride) {
+  float32x4_t acc0, acc1, hk;
+  float tmp[8];
+  long j, l, kappa;
+
+  /* Two groups of 4 consecutive outputs, one output per lane; vmulq+vaddq (not vfmaq) keeps the rounding of the scalar code */
+  for (j = 0; j + 8 <= nout; j += 8) {
+    float *xn = x + j * xstride;
+    hk = vdupq_n_f32 (h[0]);
+    acc0 = vmulq_f32 (fir_load4_neon (xn, xstride), hk);
+    acc1 = vmulq_f32 (fir_load4_neon (xn + 4 * xstride, xstride), hk);
+    for (kappa = 1; kappa < lenh; kappa++) {
+      hk = vdupq_n_f32 (h[kappa]);
+      acc0 = vaddq_f32 (acc0, vmulq_f32 (fir_load4_neon (xn - kappa, xstride), hk));
+      acc1 = vaddq_f32 (acc1, vmulq_f32 (fir_load4_neon (xn + 4 * xstride - kappa, xstride), hk));
+    }
+    vst1q_f32 (tmp, acc0);
+    vst1q_f32 (tmp + 4, acc1);
+    for (l = 0; l < 8; l++)
+      y[(j + l) * ystride] = tmp[l];
+  }
+
+  /* Remaining outputs */
+  fir_dot_strict_c (x + j * xstride, xstride, h, lenh, nout - j, y + j * ystride, ystride);
+}
+
+static void fir_dot_fast_neon (float *x, long xstride, float *hr, long lenh, long nout, float *y, long ystride) {
+  float32x4_t acc0, acc1;
+  float *w, acc;
+  long j, k;
+
+  for (j = 0; j < nout; j++) {
+    w = x + j * xstride - (lenh - 1);
+    acc0 = acc1 = vdupq_n_f32 (0);
+    for (k = 0; k + 8 <= lenh; k += 8) {
+      acc0 = vfmaq_f32 (acc0, vld1q_f32 (w + k), vld1q_f32 (hr + k));
+      acc1 = vfmaq_f32 (acc1, vld1q_f32 (w + k + 4), vld1q_f32 (hr + k + 4));
+    }
+    acc = vaddvq_f32 (vaddq_f32 (acc0, acc1));
+    for (; k < lenh; k++)
+      acc += w[k] * hr[k];
+    y[j * ystride] = acc;
+  }
+}
+
+#endif /* FIR_SIMD_NEON */
+
+
+/*
+  ============================================================================
+
+        void fir_simd_select (void);
+        ~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Select the best kernels supported by the CPU. Called once, on the
+        first use of fir_dot_strict() or fir_dot_fast().
+
+        Parameters:
+        ~~~~~~~~~~~
+        None.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static void fir_simd_select (void) {
+  fir_dot_fn strict = fir_dot_strict_c, fast = fir_dot_fast_c;
+
+#if defined(FIR_SIMD_X86)
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("sse")) {
+    strict = fir_dot_strict_sse;
+    fast = fir_dot_fast_sse;
+  }
+  if (__builtin_cpu_supports ("avx2")) {
+    strict = fir_dot_strict_avx2;
+    if (__builtin_cpu_supports ("fma"))
+      fast = fir_dot_fast_avx2;
+  }
+#elif defined(FIR_SIMD_NEON)
+  strict = fir_dot_strict_neon;
+  fast = fir_dot_fast_neon;
+#endif
+
+  fir_dot_fast_ptr = fast;
+  fir_dot_strict_ptr = strict;
+}
+
+/* ...................... End of fir_simd_select() ...................... */
+
+
+/*
+  ============================================================================
+
+        void fir_dot_strict (float *x, long xstride, float *h, long lenh,
+        ~~~~~~~~~~~~~~~~~~~  long nout, float *y, long ystride);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Compute `nout' FIR outputs
+
+           y[j*ystride] = sum(kappa=0..lenh-1) x[j*xstride-kappa]*h[kappa]
+
+        accumulating the products in order of increasing kappa, as the
+        original up-/down-sampling kernels do. Results are bit-identical
+        to those kernels.
+
+        Parameters:
+        ~~~~~~~~~~~
+        x: ......... (In)  newest input sample for the first output; the
+                           lenh-1 samples before it must be valid
+        xstride: ... (In)  input advance between outputs (down-sampling
+                           factor)
+        h: ......... (In)  FIR-coefficients
+        lenh: ...... (In)  number of FIR-coefficients
+        nout: ...... (In)  number of outputs
+        y: ......... (Out) first output sample
+        ystride: ... (In)  distance between outputs in y[] (number of
+                           polyphase sub-filters)
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+void fir_dot_strict (float *x, long xstride, float *h, long lenh, long nout, float *y, long ystride) {
+  if (fir_dot_strict_ptr == NULL)
+    fir_simd_select ();
+  fir_dot_strict_ptr (x, xstride, h, lenh, nout, y, ystride);
+}
+
+/* ...................... End of fir_dot_strict() ...................... */
+
+
+/*
+  ============================================================================
+
+        void fir_dot_fast (float *x, long xstride, float *hr, long lenh,
+        ~~~~~~~~~~~~~~~~~  long nout, float *y, long ystride);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Same as fir_dot_strict(), but the summation order is not
+        preserved: the dot-products are vectorized over the taps, with
+        the coefficients given in reversed order (hr[k] = h[lenh-1-k]) so
+        that both operands are read forward. Results differ from the
+        strict kernels in the last bits.
+
+        Parameters:
+        ~~~~~~~~~~~
+        As in fir_dot_strict(), with hr[] the reversed FIR-coefficients.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+void fir_dot_fast (float *x, long xstride, float *hr, long lenh, long nout, float *y, long ystride) {
+  if (fir_dot_fast_ptr == NULL)
+    fir_simd_select ();
+  fir_dot_fast_ptr (x, xstride, hr, lenh, nout, y, ystride);
+}
+
+/* ....................... End of fir_dot_fast() ....................... */
+
+
+/* *************************** END OF FIR-SIMD.C ************************* */
@@ -1,6 +1,6 @@
 /*
   ============================================================================
-   File: FIRFLT.H                                           v.2.5 -  31.Dec.2008
+   File: FIRFLT.H                                           v.2.7 -  16.Oct.2026
   ============================================================================
 
 	    ITU-T STL HIGH QUALITY FIR UP/DOWN-SAMPLING FILTER
@@ -18,6 +18,9 @@
    15.May.07	v2.4+	Added protoype for the [20Hz-20kHz] filter 
 						and the 1.5kHz, 14kHz. 20kHz LP filters	<Ericsson>
    31.Dec.2008  v2.5    Added LP filters (12kHz) for fs=48kHz < huawei >
+   16.Oct.2026  v2.6    Added polyphase sub-filters and linear history
+                        buffer to SCD_FIR.
+   16.Oct.2026  v2.7    Added dot-product mode and hq_set_mode().
 
   ============================================================================
 */
@@ -35,6 +38,12 @@
 #endif
 #endif
 
+/* 
+ * ..... Dot-product modes for hq_set_mode() ..... 
+ */
+#define HQ_MODE_STRICT 0        /* original summation order (bit-exact) */
+#define HQ_MODE_FAST   1        /* reassociated summation (vectorized) */
+
 /* 
  * ..... State variable structure for FIR filtering ..... 
  */
@@ -47,6 +56,13 @@ typedef struct {
   float *h0;                    /* pointer to array with FIR coeff.  */
   float *T;                     /* pointer to delay line */
   char hswitch;                 /* switch to FIR-kernel */
+  long nphase;                  /* number of polyphase sub-filters */
+  long lenp;                    /* number of coefficients per sub-filter */
+  float *hp;                    /* polyphase sub-filters, lenp coeff. each */
+  float *hr;                    /* idem, each sub-filter in reversed order */
+  float *X;                     /* linear history buffer: lenp-1 past */
+  /* samples followed by room for one processing block */
+  char mode;                    /* dot-product mode: HQ_MODE_{STRICT,FAST} */
 } SCD_FIR;
 
 
@@ -89,6 +105,7 @@ SCD_FIR *LP12_48kHz_init ARGS ((void));
 // FILTER_12k48k_HW
 void hq_free ARGS ((SCD_FIR * fir_ptr));
 void hq_reset ARGS ((SCD_FIR * fir_ptr));
+void hq_set_mode ARGS ((SCD_FIR * fir_ptr, int mode));
 
 #endif /* FIRFLT_FIRstruct_defined */
 
@@ -1,4 +1,4 @@
-/*                                                          15.Feb.2010 v1.3 */
+/*                                                          16.Oct.2026 v1.4 */
 /*=============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -32,6 +32,11 @@
                   -nfft : indicates the number of points used in FFT.
   15.Feb.10 v1.3  Modified maximum string length for filename, and
 	                removed some macros (OVERLAP, VAR_NFFT)
+  16.Oct.26 v1.4  rdft() uses the split-radix FFT instead of a DFT; the
+                  FFT routines are always compiled. Added fft_init() to
+                  compute the twiddle tables once, before concurrent use;
+                  powSpect()/rdft() take the bit reversal work area ip,
+                  one per thread (see fft_ip_init()).
 
   AUTHORS :
 	Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
@@ -44,51 +49,45 @@
 #include "fft.h"
 
 
-#ifndef TUNED_FFT
-/* This routine computes the positive part of the spectrum, using Real Discrete Fourier Transform */
-/*		  int m,		 number of coefficients of the fourier transform 
-		  float *x1,	 input real signal 
-		  float *x2,	 output real part of the DFT
-		  float *y2		 output imaginary part of the DFT */
-void rdft (int m, float *x1, float *x2, float *y2) {
-  long i, k;
-  double arg;
-
-  for (i = 0; i < m / 2; i++) {
-    x2[i] = 0;
-    y2[i] = 0;
-    arg = -2.0 * pi * (double) i / (double) m;
-    for (k = 0; k < m; k++) {
-      x2[i] += (float) (x1[k] * cos (k * arg));
-      y2[i] += (float) (x1[k] * sin (k * arg));
-    }
-  }
-}
 
-/* This routine generate a hanning window */
-/*			
-  int n,			number of coeffients of the hanning window 
-  float* hanning	        buffer containing the coefficients of the hanning window 
-*/
-void powSpect (float *real, float *imag, float *pwSpct, int n) {
-  int i;
-  for (i = 0; i < n / 2; i++)
-    pwSpct[i] = (real[i] * real[i] + imag[i] * imag[i]) / n;
+int DFTip[FFT_IPLEN] = { 0 };
+float DFTw[NFFT_MAX >> 1] = { 0 };
+
+
+
+void actrdft (int n, int isgn, float *a, int *ip, float *w);
+void makewt (int nw, int *ip, float *w);
+void makect (int nc, int *ip, float *c);
 
+
+/* Compute the twiddle factor tables for FFTs of up to n points. After
+   this, the tables are only read. Every transform also writes the bit
+   reversal work area ip[2..], hence each thread calling powSpect()/rdft()
+   needs its own, prepared by fft_ip_init(). */
+void fft_init (int n) {
+  if (n > (DFTip[0] << 2))
+    makewt (n >> 2, DFTip, DFTw);
+  if (n > (DFTip[1] << 2))
+    makect (n >> 2, DFTip, DFTw + DFTip[0]);
 }
 
-#else
 
-int DFTip[128] = { 0 };
-float DFTw[NFFT_MAX >> 1] = { 0 };
+/* Prepare a work area ip[FFT_IPLEN] for the tables of fft_init() */
+void fft_ip_init (int *ip) {
+  int i;
 
+  ip[0] = DFTip[0];
+  ip[1] = DFTip[1];
+  for (i = 2; i < FFT_IPLEN; i++)
+    ip[i] = 0;
+}
 
 
-void powSpect (int n, float *x1, float *x2) {
+#ifdef TUNED_FFT
+void powSpect (int n, float *x1, float *x2, int *ip) {
   int i, j;
   float den = (float) (1.0 / (float) n);
-  void actrdft (int n0, int isgn, float *a, int *ip, float *w);
-  actrdft (n, 1, x1, DFTip, DFTw);
+  actrdft (n, 1, x1, ip, DFTw);
   x2[0] = (x1[0] * x1[0]) * den;
 
   for (i = 2, j = 1; i < n; i += 2, j++)
@@ -98,6 +97,37 @@ void powSpect (int n, float *x1, float *x2) {
 }
 
 
+#else
+/* This routine computes the positive part of the spectrum, using the
+   split-radix real FFT (the results are the ones of the Real Discrete
+   Fourier Transform) */
+/*		  int m,		 number of coefficients of the fourier transform 
+		  float *x1,	 input real signal (destroyed)
+		  float *x2,	 output real part of the DFT
+		  float *y2		 output imaginary part of the DFT
+		  int *ip		 work area of fft_ip_init() */
+void rdft (int m, float *x1, float *x2, float *y2, int *ip) {
+  int i;
+
+  actrdft (m, 1, x1, ip, DFTw);
+  x2[0] = x1[0];
+  y2[0] = 0;
+  for (i = 1; i < m / 2; i++) {
+    x2[i] = x1[2 * i];
+    y2[i] = -x1[2 * i + 1];
+  }
+}
+
+/* This routine compute the power spectrum of the DFT of a signal */
+void powSpect (float *real, float *imag, float *pwSpct, int n) {
+  int i;
+  for (i = 0; i < n / 2; i++)
+    pwSpct[i] = (real[i] * real[i] + imag[i] * imag[i]) / n;
+
+}
+#endif
+
+
 /* -------- initializing routines -------- */
 
 void makewt (int nw, int *ip, float *w) {
@@ -673,7 +703,6 @@ void actrdft (int n, int isgn, float *a, int *ip, float *w) {
       a[i] *= xi;
   }
 }
-#endif
 
 void genHanning (int n, float *hanning) {
   int i;
@@ -1,4 +1,4 @@
-/*                                                          15.Feb.2010 v1.3 */
+/*                                                          16.Oct.2026 v1.4 */
 /*=============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -32,6 +32,8 @@
                   -nfft : indicates the number of points used in FFT.
   15.Feb.10 v1.3  Modified maximum string length for filename, and
 	                removed some macros (OVERLAP, VAR_NFFT)
+  16.Oct.26 v1.4  Added fft_init() and fft_ip_init(); rdft() uses the
+                  split-radix FFT
 
   AUTHORS :
 	Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
@@ -44,6 +46,9 @@
 
 /* Number of points of the FFT */
 #define NFFT_MAX 8192
+
+/* Length of the FFT bit reversal work area (2+sqrt(NFFT_MAX/2) at least) */
+#define FFT_IPLEN 128
 #define pi 3.141592654
 
 /* This routine generate a hanning window */
@@ -51,12 +56,21 @@ void genHanning (int n,         /* number of coeffients of the hanning window */
                  float *hanning /* buffer containing the coefficients of the hanning window */
   );
 
+/* This routine computes the twiddle factor tables for FFTs of up to n points */
+void fft_init (int n);
+
+/* This routine prepares the bit reversal work area of powSpect()/rdft(),
+   written by every transform: one per concurrent thread */
+void fft_ip_init (int *ip         /* work area of FFT_IPLEN values */
+  );
+
 #ifndef TUNED_FFT
 /* This routine computes the positive part of the spectrum, using Real Discrete Fourier Transform */
 void rdft (int m,               /* number of coefficients of the fourier transform */
-           float *x1,           /* input real signal */
+           float *x1,           /* input real signal (destroyed) */
            float *x2,           /* output real part of the DFT */
-           float *y2            /* output imaginary part of the DFT */
+           float *y2,           /* output imaginary part of the DFT */
+           int *ip              /* work area of fft_ip_init() */
   );
 
 
@@ -68,5 +82,5 @@ void powSpect (float *real,     /* input buffer containing the real part of the
   );
 
 #else
-void powSpect (int m, float *x1, float *x2);
+void powSpect (int m, float *x1, float *x2, int *ip);
 #endif
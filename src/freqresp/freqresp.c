@@ -1,4 +1,4 @@
-/*                                                          15.Feb.2010 v1.3 */
+/*                                                          16.Oct.2026 v1.4 */
 /*=============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -32,6 +32,13 @@
                   -nfft : indicates the number of points used in FFT.
   15.Feb.10 v1.3  Modified maximum string length for filename, and
 	                removed some macros (OVERLAP, VAR_NFFT)
+  16.Oct.26 v1.4  New options:
+                  -hop     : hop size (samples) between consecutive frames,
+                             as an alternative to -ov;
+                  -threads : number of threads; the two files are
+                             processed in parallel.
+                  Files are read once, with a sliding frame buffer
+                  instead of seeking back for the overlap.
 
   AUTHORS :
 	Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
@@ -53,6 +60,7 @@
 /* UGST modules */
 #include "ugstdemo.h"
 #include "ugst-utl.c"
+#include "ugst-thread.h"
 
 #ifndef max
 #define max(a,b)    (((a) > (b)) ? (a) : (b))
@@ -67,7 +75,7 @@ static int is_little_endian () {
 }
 
 static void display_usage () {
-  printf ("FREQRESP.C - Version 1.3 of 15.Feb.2010 \n\n");
+  printf ("FREQRESP.C - Version 1.4 of 16.Oct.2026 \n\n");
 
   printf (" Frequency response measure program\n");
   printf (" This program computes the average power spectrum \n");
@@ -100,21 +108,90 @@ static void display_usage () {
   printf ("                  is 10dB);\n");
   printf ("  -ov    ov ..... ov is the overlap (%c) between two consecutive frames for\n", '%');
   printf ("                  computing the average power spectrum (default is 0%c);\n", '%');
-  printf ("  -nfft  nfft ... nfft is the number of samples in each FFT (default is 2048).\n\n");
+  printf ("  -hop   hop .... hop is the number of samples between the starts of two\n");
+  printf ("                  consecutive frames, 1..nfft (overrides -ov);\n");
+  printf ("  -nfft  nfft ... nfft is the number of samples in each FFT (default is 2048);\n");
+  printf ("  -threads n .... number of threads; the two files are processed in\n");
+  printf ("                  parallel (default is the number of CPUs).\n\n");
+}
+
+
+/* Average power spectrum of one file (Welch's method: Hanning windowed
+   frames of nfft samples, hop samples apart, averaged periodograms) */
+typedef struct {
+  FILE *fp;                     /* input file */
+  float *avgPowSp;              /* average power spectrum (nfft/2 values) */
+  long nbFrame;                 /* number of frames averaged */
+} FR_FILE;
+
+typedef struct {
+  FR_FILE file[2];              /* input and output file of the codec */
+  int nfft;                     /* number of samples in each FFT */
+  int hop;                      /* samples between consecutive frames */
+  float *hanning;               /* hanning window */
+} FR_JOB;
+
+
+/* Job for ugst_parallel_for(): average power spectrum of file k */
+static void avg_power_spectrum (void *ctx, long k) {
+  FR_JOB *job = (FR_JOB *) ctx;
+  FR_FILE *f = &job->file[k];
+  int nfft = job->nfft, hop = job->hop;
+  float frame[NFFT_MAX];        /* Frame of the input signal (float format) */
+  short frame_sh[NFFT_MAX];     /* Frame of the input signal (short format) */
+  float powSp[NFFT_MAX];        /* Power spectrum of a frame */
+#ifndef TUNED_FFT
+  float real[NFFT_MAX / 2], imag[NFFT_MAX / 2];
+#endif
+  int ip[FFT_IPLEN];            /* FFT work area of this thread */
+  int i;
+
+  fft_ip_init (ip);
+
+  /* loop over input file: the first frame is read whole, the next ones
+     by shifting the last nfft-hop samples and reading hop new ones */
+  if ((int) fread (frame_sh, sizeof (short), nfft, f->fp) < nfft)
+    return;
+  do {
+    /* increment the number of processed frames */
+    f->nbFrame++;
+
+    /* convert short format input, into 16 bit float */
+    sh2fl (nfft, frame_sh, frame, 16, 1);
+
+    /* Hanning Windowing */
+    for (i = 0; i < nfft; i++) {
+      frame[i] = frame[i] * job->hanning[i];
+    }
+
+#ifndef TUNED_FFT
+    /* Real Discret Fourier Transform */
+    rdft (nfft, frame, real, imag, ip);
+    /* Power spectrum computation */
+    powSpect (real, imag, powSp, nfft);
+#else
+    powSpect (nfft, frame, powSp, ip);
+#endif
+
+    /* average power spectrum computation */
+    for (i = 0; i < nfft / 2; i++) {
+      f->avgPowSp[i] = f->avgPowSp[i] + (powSp[i] - f->avgPowSp[i]) / f->nbFrame;
+    }
+
+    /* Slide the frame by hop samples */
+    memmove (frame_sh, frame_sh + hop, (nfft - hop) * sizeof (short));
+  } while ((int) fread (frame_sh + nfft - hop, sizeof (short), hop, f->fp) == hop);
 }
 
 int main (int argc, char *argv[]) {
   /* .... DECLARATIONS ..... */
   /* buffers */
-  float frame[NFFT_MAX];        /* Frame of the input signal (float format) */
-  short frame_sh[NFFT_MAX];     /* Frame of the input signal (short format) */
   float hanning[NFFT_MAX];      /* hanning window */
-  float powSp[NFFT_MAX];        /* Power spectrum of a frame */
   float avg1PowSp[NFFT_MAX / 2];        /* Average Power spectrum vector for the first input file */
   float avg2PowSp[NFFT_MAX / 2];        /* Average Power spectrum vector for the second input file */
 
   /* file variables */
-  FILE *fp;                     /* file pointer */
+  FR_JOB job;                   /* the two files to process */
   char in1FileName[MAX_STRLEN]; /* name of the first input file (input of the codec) */
   char in2FileName[MAX_STRLEN]; /* name of the second input file (output of the codec) */
   char asciiFileName[MAX_STRLEN];       /* name of the output ASCII file */
@@ -126,8 +203,6 @@ int main (int argc, char *argv[]) {
   long fs = 16000;              /* sampling frequency */
   int little_endian;            /* flag =1 if little-endian, else =0 */
   int i, j;
-  int nbread;
-  long nbFrame = 0;
   int bmp_mode = 0;
   int border = 40;
   int im_wdth = nfft / 2 + border;
@@ -140,6 +215,8 @@ int main (int argc, char *argv[]) {
   char *image;
   float ov = 0;
   int nb_samples_ov = 0;
+  int hop = 0;                  /* hop size, if given with -hop */
+  int nthreads = 0;             /* number of threads (0: no. of CPUs) */
 
 
 
@@ -232,6 +309,24 @@ int main (int argc, char *argv[]) {
           nb_samples_ov = (int) (ov * nfft);
         }
 
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-hop") == 0) {
+        /* Get the number of samples between consecutive frames */
+        hop = atoi (argv[2]);
+        if (hop < 1) {
+          fprintf (stderr, "ERROR! Bad hop parameter.\n\n");
+          exit (-1);
+        }
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-threads") == 0) {
+        /* Number of threads */
+        nthreads = atoi (argv[2]);
+
         /* Move arg{c,v} over the option to the next argument */
         argc -= 2;
         argv += 2;
@@ -265,101 +360,55 @@ int main (int argc, char *argv[]) {
 
 
   /* ..... INITIALIZATIONS ..... */
+  /* hop size between frames: from -hop, or from the overlap */
+  if (hop > 0) {
+    if (hop > nfft) {
+      fprintf (stderr, "ERROR! Bad hop parameter (must not exceed nfft=%d).\n\n", nfft);
+      exit (-1);
+    }
+    nb_samples_ov = nfft - hop;
+  }
+  job.nfft = nfft;
+  job.hop = nfft - nb_samples_ov;
+  job.hanning = hanning;
+
   /* initialize the average power spectrum vector */
   for (i = 0; i < nfft / 2; i++) {
     avg1PowSp[i] = 0;
     avg2PowSp[i] = 0;
   }
+  job.file[0].avgPowSp = avg1PowSp;
+  job.file[1].avgPowSp = avg2PowSp;
+  job.file[0].nbFrame = job.file[1].nbFrame = 0;
 
   /* generate a hanning window with nfft coefficients */
   genHanning (nfft, hanning);
 
+  /* compute the FFT tables once, before the threads use them (each
+     thread has its own work area, see avg_power_spectrum()) */
+  fft_init (nfft);
+
 
   /* ..... PROCESSING ..... */
 
-  /* ..... First File ..... */
-  /* open first input file */
-  fp = fopen (in1FileName, "rb");
-  if (fp == NULL) {
+  /* open input files */
+  job.file[0].fp = fopen (in1FileName, "rb");
+  if (job.file[0].fp == NULL) {
     fprintf (stderr, "Error: Can't open input file %s", in1FileName);
     exit (-1);
   }
-
-  /* loop over first input file */
-  while ((nbread = fread (frame_sh, sizeof (short), nfft, fp)) == nfft) {
-    /* increment the number of processed frames */
-    nbFrame++;
-
-    /* convert short format input, into 16 bit float */
-    sh2fl (nfft, frame_sh, frame, 16, 1);
-
-    /* Hanning Windowing */
-    for (i = 0; i < nfft; i++) {
-      frame[i] = frame[i] * hanning[i];
-    }
-
-#ifndef TUNED_FFT
-    /* Real Discret Fourier Transform */
-    rdft (nfft, frame, real, imag);
-    /* Power spectrum computation */
-    powSpect (real, imag, powSp, nfft);
-#else
-    powSpect (nfft, frame, powSp);
-#endif
-
-    /* average power spectrum computation */
-    for (i = 0; i < nfft / 2; i++) {
-      avg1PowSp[i] = avg1PowSp[i] + (powSp[i] - avg1PowSp[i]) / nbFrame;
-    }
-
-    /* For overlapping, reposition the file pointer nb_samples_ov samples before its current position */
-    fseek (fp, -nb_samples_ov * 2, SEEK_CUR);
-  }
-  /* close input file */
-  fclose (fp);
-
-
-  /* ..... Second File ..... */
-
-  /* open second input file */
-  fp = fopen (in2FileName, "rb");
-  if (fp == NULL) {
+  job.file[1].fp = fopen (in2FileName, "rb");
+  if (job.file[1].fp == NULL) {
     fprintf (stderr, "Error: Can't open input file %s", in2FileName);
     exit (-1);
   }
 
-  nbFrame = 0;
-  /* loop over first input file */
-  while ((nbread = fread (frame_sh, sizeof (short), nfft, fp)) == nfft) {
-    /* increment the number of processed frames */
-    nbFrame++;
-
-    /* convert short format input, into 16 bit float */
-    sh2fl (nfft, frame_sh, frame, 16, 1);
+  /* average power spectrum of both files, in parallel */
+  ugst_parallel_for (2, nthreads, avg_power_spectrum, &job);
 
-    /* Hanning Windowing */
-    for (i = 0; i < nfft; i++) {
-      frame[i] = frame[i] * hanning[i];
-    }
-#ifndef TUNED_FFT
-    /* Real Discret Fourier Transform */
-    rdft (nfft, frame, real, imag);
-    /* Power spectrum computation */
-    powSpect (real, imag, powSp, nfft);
-#else
-    powSpect (nfft, frame, powSp);
-#endif
-
-    /* average power spectrum computation */
-    for (i = 0; i < nfft / 2; i++) {
-      avg2PowSp[i] = avg2PowSp[i] + (powSp[i] - avg2PowSp[i]) / nbFrame;
-    }
-
-    /* For overlapping, reposition the file pointer nb_samples_ov samples before its current position */
-    fseek (fp, -nb_samples_ov * 2, SEEK_CUR);
-  }
-  /* close input file */
-  fclose (fp);
+  /* close input files */
+  fclose (job.file[0].fp);
+  fclose (job.file[1].fp);
 
 
   /* .... Save Average Power Spectrum .... */
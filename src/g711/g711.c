@@ -1,4 +1,4 @@
-/*                                                 Version 3.01 - 31.Jan.2000
+/*                                                 Version 3.10 - 16.Oct.2026
 =============================================================================
 
                           U    U   GGG    SSS  TTTTT
@@ -54,6 +54,13 @@ ulaw_expand: ..... expands 1 vector of u-law samples to linear PCM
                    use 8 Least Sig. Bits (LSBs) from input and
                    14 Most Sig.Bits (MSBs) on output.
 
+alaw_compress_fast, alaw_expand_fast, ulaw_compress_fast,
+ulaw_expand_fast: table-driven versions of the functions above,
+                   bit-exact with them for any input.
+
+g711_compress_multi, g711_expand_multi: batch conversion of N
+                   interleaved channels, each with its own law.
+
 PROTOTYPES: in g711.h
 
 HISTORY:
@@ -64,6 +71,9 @@ Apr/91       1.0   First version of the G711 module
 08/Feb/1992  3.0   Demo as separate file;
 31/Jan/2000  3.01  Updated documentation text; no change in functions
                    <simao.campos@labs.comsat.com>
+16/Oct/2026  3.10  Added table-driven (and SSE2) fast routines and the
+                   multichannel batch functions; the original routines
+                   are unchanged and remain the reference.
 =============================================================================
 */
 
@@ -74,6 +84,12 @@ Apr/91       1.0   First version of the G711 module
 /* Global prototype functions */
 #include "g711.h"
 
+/* SIMD compression kernels */
+#if defined(__SSE2__) || defined(_M_X64)
+#define G711_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
 /*
  *	.......... F U N C T I O N S ..........
  */
@@ -307,3 +323,427 @@ void ulaw_expand (long lseg, short *logbuf, short *linbuf) {
 }
 
 /* ................... End of ulaw_expand() ..................... */
+
+
+
+/*
+ *	.......... F A S T   R O U T I N E S ..........
+ */
+
+/*
+  ---------------------------------------------------------------------------
+  Number of significant bits of 0..127; gives the segment of a sample
+  without the shift loops of the reference compression routines.
+  ---------------------------------------------------------------------------
+*/
+static const char g711_nbits[128] = {
+  0, 1, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4,
+  5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7
+};
+
+/*
+  ---------------------------------------------------------------------------
+  Linear value of each log sample 0..255, as given by alaw_expand() and
+  ulaw_expand(). The expanders only use the 7 LSBs of a log sample and
+  whether it is larger than 127, hence any short input maps to one of
+  the 256 entries.
+  ---------------------------------------------------------------------------
+*/
+static const short alaw_exp_tab[256] = {
+  -5504, -5248, -6016, -5760, -4480, -4224, -4992, -4736,
+  -7552, -7296, -8064, -7808, -6528, -6272, -7040, -6784,
+  -2752, -2624, -3008, -2880, -2240, -2112, -2496, -2368,
+  -3776, -3648, -4032, -3904, -3264, -3136, -3520, -3392,
+  -22016,-20992,-24064,-23040,-17920,-16896,-19968,-18944,
+  -30208,-29184,-32256,-31232,-26112,-25088,-28160,-27136,
+  -11008,-10496,-12032,-11520, -8960, -8448, -9984, -9472,
+  -15104,-14592,-16128,-15616,-13056,-12544,-14080,-13568,
+  -344,  -328,  -376,  -360,  -280,  -264,  -312,  -296,
+  -472,  -456,  -504,  -488,  -408,  -392,  -440,  -424,
+  -88,   -72,  -120,  -104,   -24,    -8,   -56,   -40,
+  -216,  -200,  -248,  -232,  -152,  -136,  -184,  -168,
+  -1376, -1312, -1504, -1440, -1120, -1056, -1248, -1184,
+  -1888, -1824, -2016, -1952, -1632, -1568, -1760, -1696,
+  -688,  -656,  -752,  -720,  -560,  -528,  -624,  -592,
+  -944,  -912, -1008,  -976,  -816,  -784,  -880,  -848,
+  5504,  5248,  6016,  5760,  4480,  4224,  4992,  4736,
+  7552,  7296,  8064,  7808,  6528,  6272,  7040,  6784,
+  2752,  2624,  3008,  2880,  2240,  2112,  2496,  2368,
+  3776,  3648,  4032,  3904,  3264,  3136,  3520,  3392,
+  22016, 20992, 24064, 23040, 17920, 16896, 19968, 18944,
+  30208, 29184, 32256, 31232, 26112, 25088, 28160, 27136,
+  11008, 10496, 12032, 11520,  8960,  8448,  9984,  9472,
+  15104, 14592, 16128, 15616, 13056, 12544, 14080, 13568,
+  344,   328,   376,   360,   280,   264,   312,   296,
+  472,   456,   504,   488,   408,   392,   440,   424,
+  88,    72,   120,   104,    24,     8,    56,    40,
+  216,   200,   248,   232,   152,   136,   184,   168,
+  1376,  1312,  1504,  1440,  1120,  1056,  1248,  1184,
+  1888,  1824,  2016,  1952,  1632,  1568,  1760,  1696,
+  688,   656,   752,   720,   560,   528,   624,   592,
+  944,   912,  1008,   976,   816,   784,   880,   848
+};
+
+static const short ulaw_exp_tab[256] = {
+  -32124,-31100,-30076,-29052,-28028,-27004,-25980,-24956,
+  -23932,-22908,-21884,-20860,-19836,-18812,-17788,-16764,
+  -15996,-15484,-14972,-14460,-13948,-13436,-12924,-12412,
+  -11900,-11388,-10876,-10364, -9852, -9340, -8828, -8316,
+  -7932, -7676, -7420, -7164, -6908, -6652, -6396, -6140,
+  -5884, -5628, -5372, -5116, -4860, -4604, -4348, -4092,
+  -3900, -3772, -3644, -3516, -3388, -3260, -3132, -3004,
+  -2876, -2748, -2620, -2492, -2364, -2236, -2108, -1980,
+  -1884, -1820, -1756, -1692, -1628, -1564, -1500, -1436,
+  -1372, -1308, -1244, -1180, -1116, -1052,  -988,  -924,
+  -876,  -844,  -812,  -780,  -748,  -716,  -684,  -652,
+  -620,  -588,  -556,  -524,  -492,  -460,  -428,  -396,
+  -372,  -356,  -340,  -324,  -308,  -292,  -276,  -260,
+  -244,  -228,  -212,  -196,  -180,  -164,  -148,  -132,
+  -120,  -112,  -104,   -96,   -88,   -80,   -72,   -64,
+  -56,   -48,   -40,   -32,   -24,   -16,    -8,     0,
+  32124, 31100, 30076, 29052, 28028, 27004, 25980, 24956,
+  23932, 22908, 21884, 20860, 19836, 18812, 17788, 16764,
+  15996, 15484, 14972, 14460, 13948, 13436, 12924, 12412,
+  11900, 11388, 10876, 10364,  9852,  9340,  8828,  8316,
+  7932,  7676,  7420,  7164,  6908,  6652,  6396,  6140,
+  5884,  5628,  5372,  5116,  4860,  4604,  4348,  4092,
+  3900,  3772,  3644,  3516,  3388,  3260,  3132,  3004,
+  2876,  2748,  2620,  2492,  2364,  2236,  2108,  1980,
+  1884,  1820,  1756,  1692,  1628,  1564,  1500,  1436,
+  1372,  1308,  1244,  1180,  1116,  1052,   988,   924,
+  876,   844,   812,   780,   748,   716,   684,   652,
+  620,   588,   556,   524,   492,   460,   428,   396,
+  372,   356,   340,   324,   308,   292,   276,   260,
+  244,   228,   212,   196,   180,   164,   148,   132,
+  120,   112,   104,    96,    88,    80,    72,    64,
+  56,    48,    40,    32,    24,    16,     8,     0
+};
+
+#define G711_EXP_INDEX(x) ((((x) > 127) << 7) | ((x) & 0x7F))
+
+
+/*
+  ---------------------------------------------------------------------------
+  short alaw_compress1 (short lin);
+  short ulaw_compress1 (short lin);
+
+  Compress one sample; same arithmetic as alaw_compress()/ulaw_compress(),
+  with the exponent (segment) taken from g711_nbits[] instead of a loop.
+  ---------------------------------------------------------------------------
+*/
+static short alaw_compress1 (short lin) {
+  short v, s, ix, iexp;
+
+  v = lin >> 4;
+  s = v >> 15;                  /* -1 for negative samples, 0 otherwise */
+  ix = v ^ s;                   /* 0 <= ix < 2048 */
+  iexp = g711_nbits[ix >> 5];   /* exponent-1, or 0 for ix <= 31 */
+
+  return (((ix >> iexp) + (iexp << 4)) | (~s & 0x0080)) ^ 0x0055;
+}
+
+static short ulaw_compress1 (short lin) {
+  short v, s, absno, segno;
+
+  v = lin >> 2;
+  s = v >> 15;
+  absno = (v ^ s) + 33;
+  if (absno > 0x1FFF)
+    absno = 0x1FFF;
+  segno = 1 + g711_nbits[absno >> 6];
+
+  return (((0x0008 - segno) << 4) | (0x000F - ((absno >> segno) & 0x000F))) | (~s & 0x0080);
+}
+
+
+#if defined(G711_SIMD_SSE2)
+/*
+  ---------------------------------------------------------------------------
+  void alaw_compress8 (short *linbuf, short *logbuf);
+  void ulaw_compress8 (short *linbuf, short *logbuf);
+
+  Compress 8 samples with SSE2: the segment is counted with one compare
+  per segment boundary, and the mantissa shifted right by one bit for
+  each boundary passed, so that there are no per-lane variable shifts.
+  ---------------------------------------------------------------------------
+*/
+static void alaw_compress8 (short *linbuf, short *logbuf) {
+  __m128i v = _mm_srai_epi16 (_mm_loadu_si128 ((__m128i *) linbuf), 4);
+  __m128i s = _mm_srai_epi16 (v, 15);
+  __m128i ix = _mm_xor_si128 (v, s);
+  __m128i sh = ix, iexp = _mm_setzero_si128 (), m;
+  int t;
+
+  for (t = 31; t < 2047; t = 2 * t + 1) {
+    m = _mm_cmpgt_epi16 (ix, _mm_set1_epi16 ((short) t));
+    sh = _mm_or_si128 (_mm_andnot_si128 (m, sh), _mm_and_si128 (m, _mm_srli_epi16 (sh, 1)));
+    iexp = _mm_sub_epi16 (iexp, m);
+  }
+  v = _mm_add_epi16 (sh, _mm_slli_epi16 (iexp, 4));
+  v = _mm_or_si128 (v, _mm_andnot_si128 (s, _mm_set1_epi16 (0x0080)));
+  _mm_storeu_si128 ((__m128i *) logbuf, _mm_xor_si128 (v, _mm_set1_epi16 (0x0055)));
+}
+
+static void ulaw_compress8 (short *linbuf, short *logbuf) {
+  __m128i v = _mm_srai_epi16 (_mm_loadu_si128 ((__m128i *) linbuf), 2);
+  __m128i s = _mm_srai_epi16 (v, 15);
+  __m128i absno = _mm_min_epi16 (_mm_add_epi16 (_mm_xor_si128 (v, s), _mm_set1_epi16 (33)), _mm_set1_epi16 (0x1FFF));
+  __m128i sh = _mm_srli_epi16 (absno, 1), seg = _mm_setzero_si128 (), m;
+  int t;
+
+  for (t = 63; t < 8191; t = 2 * t + 1) {
+    m = _mm_cmpgt_epi16 (absno, _mm_set1_epi16 ((short) t));
+    sh = _mm_or_si128 (_mm_andnot_si128 (m, sh), _mm_and_si128 (m, _mm_srli_epi16 (sh, 1)));
+    seg = _mm_sub_epi16 (seg, m);
+  }
+  /* high nibble is 7-seg, low nibble is 15-mantissa */
+  v = _mm_xor_si128 (_mm_slli_epi16 (seg, 4), _mm_set1_epi16 (0x007F));
+  v = _mm_sub_epi16 (v, _mm_and_si128 (sh, _mm_set1_epi16 (0x000F)));
+  v = _mm_or_si128 (v, _mm_andnot_si128 (s, _mm_set1_epi16 (0x0080)));
+  _mm_storeu_si128 ((__m128i *) logbuf, v);
+}
+#endif
+
+
+/* ................... Begin of alaw_compress_fast() ..................... */
+/*
+  ==========================================================================
+
+   FUNCTION NAME: alaw_compress_fast
+
+   DESCRIPTION: ALaw encoding rule according ITU-T Rec. G.711; bit-exact
+                with alaw_compress(), without a data-dependent loop.
+
+   PROTOTYPE: void alaw_compress_fast(long lseg, short *linbuf, short *logbuf)
+
+   PARAMETERS:
+     lseg:	(In)  number of samples
+     linbuf:	(In)  buffer with linear samples (only 12 MSBits are taken
+                      into account)
+     logbuf:	(Out) buffer with compressed samples (8 bit right justified,
+                      without sign extension)
+
+   RETURN VALUE: none.
+
+   HISTORY:
+   16.Oct.26	1.0	Created
+
+  ==========================================================================
+*/
+void alaw_compress_fast (long lseg, short *linbuf, short *logbuf) {
+  long n = 0;
+
+#if defined(G711_SIMD_SSE2)
+  for (; n + 8 <= lseg; n += 8)
+    alaw_compress8 (linbuf + n, logbuf + n);
+#endif
+  for (; n < lseg; n++)
+    logbuf[n] = alaw_compress1 (linbuf[n]);
+}
+
+/* ................... End of alaw_compress_fast() ..................... */
+
+
+/* ................... Begin of alaw_expand_fast() ..................... */
+/*
+  ==========================================================================
+
+   FUNCTION NAME: alaw_expand_fast
+
+   DESCRIPTION: ALaw decoding rule according ITU-T Rec. G.711; bit-exact
+                with alaw_expand(), by table look-up.
+
+   PROTOTYPE: void alaw_expand_fast(long lseg, short *logbuf, short *linbuf)
+
+   PARAMETERS:
+     lseg:	(In)  number of samples
+     logbuf:	(In)  buffer with compressed samples (8 bit right justified,
+                      without sign extension)
+     linbuf:	(Out) buffer with linear samples (13 bits left justified)
+
+   RETURN VALUE: none.
+
+   HISTORY:
+   16.Oct.26	1.0	Created
+
+  ============================================================================
+*/
+void alaw_expand_fast (long lseg, short *logbuf, short *linbuf) {
+  long n;
+
+  for (n = 0; n < lseg; n++)
+    linbuf[n] = alaw_exp_tab[G711_EXP_INDEX (logbuf[n])];
+}
+
+/* ................... End of alaw_expand_fast() ..................... */
+
+
+/* ................... Begin of ulaw_compress_fast() ..................... */
+/*
+  ==========================================================================
+
+   FUNCTION NAME: ulaw_compress_fast
+
+   DESCRIPTION: Mu law encoding rule according ITU-T Rec. G.711;
+                bit-exact with ulaw_compress(), without a data-dependent
+                loop.
+
+   PROTOTYPE: void ulaw_compress_fast(long lseg, short *linbuf, short *logbuf)
+
+   PARAMETERS:
+     lseg:	(In)  number of samples
+     linbuf:	(In)  buffer with linear samples (only 12 MSBits are taken
+                      into account)
+     logbuf:	(Out) buffer with compressed samples (8 bit right justified,
+                      without sign extension)
+
+   RETURN VALUE: none.
+
+   HISTORY:
+   16.Oct.26	1.0	Created
+
+  ==========================================================================
+*/
+void ulaw_compress_fast (long lseg, short *linbuf, short *logbuf) {
+  long n = 0;
+
+#if defined(G711_SIMD_SSE2)
+  for (; n + 8 <= lseg; n += 8)
+    ulaw_compress8 (linbuf + n, logbuf + n);
+#endif
+  for (; n < lseg; n++)
+    logbuf[n] = ulaw_compress1 (linbuf[n]);
+}
+
+/* ................... End of ulaw_compress_fast() ..................... */
+
+
+/* ................... Begin of ulaw_expand_fast() ..................... */
+/*
+  ==========================================================================
+
+   FUNCTION NAME: ulaw_expand_fast
+
+   DESCRIPTION: Mu law decoding rule according ITU-T Rec. G.711;
+                bit-exact with ulaw_expand(), by table look-up.
+
+   PROTOTYPE: void ulaw_expand_fast(long lseg, short *logbuf, short *linbuf)
+
+   PARAMETERS:
+     lseg:	(In)  number of samples
+     logbuf:	(In)  buffer with compressed samples (8 bit right justified,
+                      without sign extension)
+     linbuf:	(Out) buffer with linear samples (14 bits left justified)
+
+   RETURN VALUE: none.
+
+   HISTORY:
+   16.Oct.26	1.0	Created
+
+  ============================================================================
+*/
+void ulaw_expand_fast (long lseg, short *logbuf, short *linbuf) {
+  long n;
+
+  for (n = 0; n < lseg; n++)
+    linbuf[n] = ulaw_exp_tab[G711_EXP_INDEX (logbuf[n])];
+}
+
+/* ................... End of ulaw_expand_fast() ..................... */
+
+
+/* ................... Begin of g711_compress_multi() ..................... */
+/*
+  ==========================================================================
+
+   FUNCTION NAME: g711_compress_multi
+
+   DESCRIPTION: Compresses nch interleaved channels in one call; channel
+                c uses the law given by law[c] ('A' or 'u'). When all
+                the channels use the same law, the whole buffer is
+                processed as a single vector.
+
+   PROTOTYPE: void g711_compress_multi(long nch, long lseg, char *law,
+                                       short *linbuf, short *logbuf)
+
+   PARAMETERS:
+     nch:	(In)  number of channels
+     lseg:	(In)  number of samples per channel
+     law:	(In)  law of each channel, 'A' (A-law) or 'u' (u-law)
+     linbuf:	(In)  interleaved linear samples, nch*lseg
+     logbuf:	(Out) interleaved compressed samples, nch*lseg
+
+   RETURN VALUE: none.
+
+   HISTORY:
+   16.Oct.26	1.0	Created
+
+  ==========================================================================
+*/
+void g711_compress_multi (long nch, long lseg, char *law, short *linbuf, short *logbuf) {
+  long c, n;
+  int alaw;
+
+  for (c = 1; c < nch && (law[c] | 0x20) == (law[0] | 0x20); c++);
+  if (c >= nch) {
+    if ((law[0] | 0x20) == 'a')
+      alaw_compress_fast (nch * lseg, linbuf, logbuf);
+    else
+      ulaw_compress_fast (nch * lseg, linbuf, logbuf);
+    return;
+  }
+
+  for (c = 0; c < nch; c++) {
+    alaw = (law[c] | 0x20) == 'a';
+    for (n = c; n < nch * lseg; n += nch)
+      logbuf[n] = alaw ? alaw_compress1 (linbuf[n]) : ulaw_compress1 (linbuf[n]);
+  }
+}
+
+/* ................... End of g711_compress_multi() ..................... */
+
+
+/* ................... Begin of g711_expand_multi() ..................... */
+/*
+  ==========================================================================
+
+   FUNCTION NAME: g711_expand_multi
+
+   DESCRIPTION: Expands nch interleaved channels in one call; channel c
+                uses the law given by law[c] ('A' or 'u').
+
+   PROTOTYPE: void g711_expand_multi(long nch, long lseg, char *law,
+                                     short *logbuf, short *linbuf)
+
+   PARAMETERS:
+     nch:	(In)  number of channels
+     lseg:	(In)  number of samples per channel
+     law:	(In)  law of each channel, 'A' (A-law) or 'u' (u-law)
+     logbuf:	(In)  interleaved compressed samples, nch*lseg
+     linbuf:	(Out) interleaved linear samples, nch*lseg
+
+   RETURN VALUE: none.
+
+   HISTORY:
+   16.Oct.26	1.0	Created
+
+  ============================================================================
+*/
+void g711_expand_multi (long nch, long lseg, char *law, short *logbuf, short *linbuf) {
+  long c, n;
+  const short *tab;
+
+  for (c = 0; c < nch; c++) {
+    tab = (law[c] | 0x20) == 'a' ? alaw_exp_tab : ulaw_exp_tab;
+    for (n = c; n < nch * lseg; n += nch)
+      linbuf[n] = tab[G711_EXP_INDEX (logbuf[n])];
+  }
+}
+
+/* ................... End of g711_expand_multi() ..................... */
@@ -16,10 +16,12 @@
 			and <Volker.Springer@eedn.ericsson.se>
    31.Jan.2000  v3.01   [version no.aligned with g711.c] Updated list of 
                         compilers for smart prototypes
+   16.Oct.2026  v3.10   Added fast (table-driven) routines and the
+                        multichannel batch functions
   ============================================================================
 */
 #ifndef G711_defined
-#define G711_defined 301
+#define G711_defined 310
 
 /* Smart function prototypes: for [ag]cc, VaxC, and [tb]cc */
 #if !defined(ARGS)
@@ -37,6 +39,16 @@ void alaw_expand ARGS ((long lseg, short *logbuf, short *linbuf));
 void ulaw_compress ARGS ((long lseg, short *linbuf, short *logbuf));
 void ulaw_expand ARGS ((long lseg, short *logbuf, short *linbuf));
 
+/* Fast versions, bit-exact with the functions above */
+void alaw_compress_fast ARGS ((long lseg, short *linbuf, short *logbuf));
+void alaw_expand_fast ARGS ((long lseg, short *logbuf, short *linbuf));
+void ulaw_compress_fast ARGS ((long lseg, short *linbuf, short *logbuf));
+void ulaw_expand_fast ARGS ((long lseg, short *logbuf, short *linbuf));
+
+/* Batch conversion of nch interleaved channels; law[c] is 'A' or 'u' */
+void g711_compress_multi ARGS ((long nch, long lseg, char *law, short *linbuf, short *logbuf));
+void g711_expand_multi ARGS ((long nch, long lseg, char *law, short *logbuf, short *linbuf));
+
 /* Definitions for better user interface (?!) */
 #define IS_LIN 1
 #define IS_LOG 0
@@ -1,4 +1,4 @@
-/*                                                        02.Feb.2010 v3.3
+/*                                                        16.Oct.2026 v3.5
   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
   G711DEMO.C
@@ -14,7 +14,9 @@
              [BlockSize [1stBlock [NoOfBlocks]]]
 
   where:
-  Law	      is the law desired (either A or u)
+  Law	      is the law desired (either A or u); a string of several
+              laws (e.g. AuA) selects a file of as many interleaved
+              channels, each converted with its own law
   Transf      is the desired convertion on the input file:
               [lili], linear to linear: lin -> (A/u)log -> lin
               [lilo], linear to (A/u)-log
@@ -22,7 +24,7 @@
   InpFile     is the name of the file to be processed;
   OutFile     is the name with the compressed/expanded data;
   BlockSize   is the block size, in number of samples (16 -bit words)
-              (default is 256);
+              per channel (default is 256);
   1stBlock    is the number of the first block of the input file
               to be processed. (Default: 1)
   NoOfBlocks  is the number of blocks to be processed, starting on
@@ -39,6 +41,10 @@
                 read from a file.
   -skip         is the number of samples to skip before the beginning
                 of the 1st block.
+  -ref          use the reference (per-sample loop) G.711 routines
+                instead of the table-driven ones; both give the same
+                result. Multi-channel files always use
+                g711_compress_multi() and g711_expand_multi().
 
   Example:
   $ G711 u lili voice.ref voice.rel 256 3 45
@@ -146,6 +152,10 @@
                    size is not a multiple of the file
                    size. <simao.campos@labs.comsat.com>
   02.Feb.2010 v3.3 Modified maximum string length (y.hiwasaki)
+  16.Oct.2026 v3.4 Use the table-driven (fast) G.711 routines by default;
+                   added option -ref to use the original ones.
+  16.Oct.2026 v3.5 Multi-channel files with a law per channel, with
+                   g711_compress_multi()/g711_expand_multi().
   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ugstdemo.h"           /* UGST defines for demo programs */
 
@@ -179,7 +189,7 @@
   --------------------------------------------------------------------------
 */
 void display_usage () {
-  fprintf (stderr, "\n  G711DEMO.C   --- Version v3.3 of 02.Feb.2010 \n");
+  fprintf (stderr, "\n  G711DEMO.C   --- Version v3.5 of 16.Oct.2026 \n");
   fprintf (stderr, "\n");
   fprintf (stderr, "  Description:\n");
   fprintf (stderr, "  ~~~~~~~~~~~~\n");
@@ -191,14 +201,15 @@ void display_usage () {
   fprintf (stderr, "  $ G711 [-r] Law Transf InpFile OutFile BlkSize 1stBlock NoOfBlocks\n");
   fprintf (stderr, "\n");
   fprintf (stderr, "  where:\n");
-  fprintf (stderr, "  Law	   is the law desired (either A or u)\n");
+  fprintf (stderr, "  Law	   is the law desired (either A or u), or one law per\n");
+  fprintf (stderr, "		   channel for interleaved channels (e.g. AuA)\n");
   fprintf (stderr, "  Transf	   is the desired convertion on the input file:\n");
   fprintf (stderr, "	             [lili], linear to linear: lin -> (A/u)log -> lin\n");
   fprintf (stderr, "               [lilo], linear to (A/u)-log\n");
   fprintf (stderr, "               [loli], (A/u) log to linear\n");
   fprintf (stderr, "  InpFile	   is the name of the file to be processed;\n");
   fprintf (stderr, "  OutFile	   is the name with the compressed/expanded data;\n");
-  fprintf (stderr, "  BlkSize    is number of samples per block [256];\n");
+  fprintf (stderr, "  BlkSize    is number of samples per block and channel [256];\n");
   fprintf (stderr, "  1stBlock   is the number of the first block of the input file\n");
   fprintf (stderr, "		   to be processed [1].\n");
   fprintf (stderr, "  NoOfBlocks is the number of blocks to be processed, starting on\n");
@@ -208,6 +219,7 @@ void display_usage () {
   fprintf (stderr, "  -?         displays this message.\n");
   fprintf (stderr, "  -r         disables even-bit swap by A-law encoding and decoding.\n");
   fprintf (stderr, "  -skip      is the number of samples to skip.\n");
+  fprintf (stderr, "  -ref       use the reference G.711 routines (slower).\n");
   fprintf (stderr, "\n");
 
   /* Quit program */
@@ -217,6 +229,59 @@ void display_usage () {
 /* ..................... End of display_usage() .......................... */
 
 
+/*
+  --------------------------------------------------------------------------
+   long process_multi(...);
+
+   Converts N2 blocks of N frames of nch interleaved channels from Fi to
+   Fo, channel c with law[c], using g711_compress_multi() and
+   g711_expand_multi(). Returns the number of frames processed.
+
+   16.Oct.2026 v1.0 Created.
+  --------------------------------------------------------------------------
+*/
+long process_multi (FILE * Fi, FILE * Fo, char *outfil, char *law, long nch, long N, long N2, short inp_type, short out_type, char revert_even_bits) {
+  short *inp_buff, *log_buff, *out_buff;
+  long i, c, smpno, tot_smpno, cur_blk;
+
+  if ((inp_buff = (short *) calloc (N * nch, sizeof (short))) == NULL || (log_buff = (short *) calloc (N * nch, sizeof (short))) == NULL || (out_buff = (short *) calloc (N * nch, sizeof (short))) == NULL)
+    error_terminate ("Can't allocate memory for the buffers\n", 10);
+
+  for (tot_smpno = cur_blk = 0; cur_blk < N2; cur_blk++, tot_smpno += smpno) {
+    /* Whole frames only */
+    if ((smpno = (long) fread (inp_buff, sizeof (short) * nch, N, Fi)) <= 0)
+      break;
+
+    if (inp_type == IS_LIN)
+      g711_compress_multi (nch, smpno, law, inp_buff, log_buff);
+    else
+      memcpy (log_buff, inp_buff, smpno * nch * sizeof (short));
+
+    /* Even bits of the A-law channels, as stored in the files */
+    if (!revert_even_bits && (inp_type == IS_LOG || out_type == IS_LOG))
+      for (c = 0; c < nch; c++)
+        if (law[c] == 'A')
+          for (i = c; i < smpno * nch; i += nch)
+            log_buff[i] ^= 0x0055;
+
+    if (out_type == IS_LIN)
+      g711_expand_multi (nch, smpno, law, log_buff, out_buff);
+    else
+      memcpy (out_buff, log_buff, smpno * nch * sizeof (short));
+
+    if (fwrite (out_buff, sizeof (short) * nch, smpno, Fo) != (size_t) smpno)
+      KILL (outfil, 6);
+  }
+
+  free (inp_buff);
+  free (log_buff);
+  free (out_buff);
+  return tot_smpno;
+}
+
+/* ...................... End of process_multi() .......................... */
+
+
 /*
    **************************************************************************
    ***                                                                    ***
@@ -236,11 +301,16 @@ int main (int argc, char *argv[]) {
   char law[MAX_STRLEN], lilo[MAX_STRLEN];
   short inp_type, out_type;
   char revert_even_bits = 1;
+  long nch;                     /* number of channels (laws) */
   clock_t t1, t2;               /* aux. for CPU-time measurement */
 #ifdef VMS
   char mrs[15];                 /* for correct mrs in VMS environment */
 #endif
   long start_byte, skip = 0;
+  void (*alaw_c) ARGS ((long lseg, short *linbuf, short *logbuf)) = alaw_compress_fast;
+  void (*alaw_e) ARGS ((long lseg, short *logbuf, short *linbuf)) = alaw_expand_fast;
+  void (*ulaw_c) ARGS ((long lseg, short *linbuf, short *logbuf)) = ulaw_compress_fast;
+  void (*ulaw_e) ARGS ((long lseg, short *logbuf, short *linbuf)) = ulaw_expand_fast;
 
 /*
  * GETTING PARAMETERS
@@ -250,7 +320,19 @@ int main (int argc, char *argv[]) {
     display_usage ();
   else {
     while (argc > 1 && argv[1][0] == '-')
-      if (argv[1][1] == 'r') {
+      if (strcmp (argv[1], "-ref") == 0) {
+        /* Use the reference routines */
+        alaw_c = alaw_compress;
+        alaw_e = alaw_expand;
+        ulaw_c = ulaw_compress;
+        ulaw_e = ulaw_expand;
+
+        /* Move argv over the option to the next argument */
+        argv++;
+
+        /* Update argc */
+        argc--;
+      } else if (argv[1][1] == 'r') {
         /* Disable revertion of even bits */
         revert_even_bits = 0;
 
@@ -303,10 +385,13 @@ int main (int argc, char *argv[]) {
   if ((out_type == IS_LOG) && (inp_type == IS_LOG))
     error_terminate ("log. to log. makes no sense! Aborted...\n", 8);
 
-  /* Classification of law */
-  law[0] = toupper (law[0]);
-  if ((law[0] != (char) 'A') && (law[0] != (char) 'U'))
-    error_terminate (" Invalid law!\n", 7);
+  /* Classification of law(s), one per channel */
+  nch = (long) strlen (law);
+  for (i = 0; i < nch; i++) {
+    law[i] = toupper (law[i]);
+    if ((law[i] != (char) 'A') && (law[i] != (char) 'U'))
+      error_terminate (" Invalid law!\n", 7);
+  }
 
   /* .......... ALLOCATION OF BUFFERS .......... */
 
@@ -337,10 +422,10 @@ int main (int argc, char *argv[]) {
   out = fileno (Fo);
 
   /* Define starting byte in file */
-  start_byte = (N1 * N + skip) * sizeof (short);
+  start_byte = (N1 * N * nch + skip) * sizeof (short);
 
   /* ... and move file's pointer to 1st desired block */
-  if (fseek (Fi, (N1 * N + skip) * sizeof (short), 0) < 0l)
+  if (fseek (Fi, start_byte, 0) < 0l)
     KILL (inpfil, 4);
 
   /* Check whether is to process til end-of-file */
@@ -348,7 +433,7 @@ int main (int argc, char *argv[]) {
     struct stat st;
     /* ... hey, need to skip the delayed samples! ... */
     stat (inpfil, &st);
-    N2 = ceil ((st.st_size - start_byte) / (double) (N * sizeof (short)));
+    N2 = ceil ((st.st_size - start_byte) / (double) (N * nch * sizeof (short)));
   }
 
 
@@ -358,78 +443,81 @@ int main (int argc, char *argv[]) {
   t1 = clock ();                /* measure CPU-time */
   tot_smpno = 0;
 
-  switch (law[0]) {
-    /* ......... Process A-law rule ......... */
-  case 'A':
-
-    /* Input: LINEAR | Output: LOG */
-    if (inp_type == IS_LIN && out_type == IS_LOG)
-      for (tot_smpno = cur_blk = 0; cur_blk < N2; cur_blk++, tot_smpno += smpno) {
-        if ((smpno = fread (lin_buff, sizeof (short), N, Fi)) < 0)
-          KILL (inpfil, 5);
-        alaw_compress (smpno, lin_buff, log_buff);
-        if (!revert_even_bits)
-          for (i = 0; i < smpno; i++)
-            log_buff[i] ^= 0x0055;
-
-        if ((smpno = fwrite (log_buff, sizeof (short), smpno, Fo)) < 0)
-          KILL (outfil, 6);
-      }
+  if (nch > 1)
+    tot_smpno = process_multi (Fi, Fo, outfil, law, nch, N, N2, inp_type, out_type, revert_even_bits);
+  else
+    switch (law[0]) {
+      /* ......... Process A-law rule ......... */
+    case 'A':
+
+      /* Input: LINEAR | Output: LOG */
+      if (inp_type == IS_LIN && out_type == IS_LOG)
+        for (tot_smpno = cur_blk = 0; cur_blk < N2; cur_blk++, tot_smpno += smpno) {
+          if ((smpno = fread (lin_buff, sizeof (short), N, Fi)) < 0)
+            KILL (inpfil, 5);
+          alaw_c (smpno, lin_buff, log_buff);
+          if (!revert_even_bits)
+            for (i = 0; i < smpno; i++)
+              log_buff[i] ^= 0x0055;
+
+          if ((smpno = fwrite (log_buff, sizeof (short), smpno, Fo)) < 0)
+            KILL (outfil, 6);
+        }
 
-    /* Input: LINEAR | Output: LINEAR */
-    else if (inp_type == IS_LIN && out_type == IS_LIN)
-      for (tot_smpno = cur_blk = 0; cur_blk < N2; cur_blk++, tot_smpno += smpno) {
-        if ((smpno = fread (lin_buff, sizeof (short), N, Fi)) < 0)
-          KILL (inpfil, 5);
-        alaw_compress (smpno, lin_buff, log_buff);
-        alaw_expand (smpno, log_buff, lon_buff);
-        if ((smpno = fwrite (lon_buff, sizeof (short), smpno, Fo)) < 0)
-          KILL (outfil, 6);
-      }
+      /* Input: LINEAR | Output: LINEAR */
+      else if (inp_type == IS_LIN && out_type == IS_LIN)
+        for (tot_smpno = cur_blk = 0; cur_blk < N2; cur_blk++, tot_smpno += smpno) {
+          if ((smpno = fread (lin_buff, sizeof (short), N, Fi)) < 0)
+            KILL (inpfil, 5);
+          alaw_c (smpno, lin_buff, log_buff);
+          alaw_e (smpno, log_buff, lon_buff);
+          if ((smpno = fwrite (lon_buff, sizeof (short), smpno, Fo)) < 0)
+            KILL (outfil, 6);
+        }
 
-    /* Input: LOG | Output: LINEAR */
-    else if (inp_type == IS_LOG)
-      for (tot_smpno = cur_blk = 0; cur_blk < N2; cur_blk++, tot_smpno += smpno) {
-        if ((smpno = fread (log_buff, sizeof (short), N, Fi)) < 0)
-          KILL (inpfil, 5);
-        if (!revert_even_bits)
-          for (i = 0; i < smpno; i++)
-            log_buff[i] ^= 0x0055;
-        alaw_expand (smpno, log_buff, lon_buff);
-        if ((smpno = fwrite (lon_buff, sizeof (short), smpno, Fo)) < 0)
-          KILL (outfil, 6);
-      }
-    break;
+      /* Input: LOG | Output: LINEAR */
+      else if (inp_type == IS_LOG)
+        for (tot_smpno = cur_blk = 0; cur_blk < N2; cur_blk++, tot_smpno += smpno) {
+          if ((smpno = fread (log_buff, sizeof (short), N, Fi)) < 0)
+            KILL (inpfil, 5);
+          if (!revert_even_bits)
+            for (i = 0; i < smpno; i++)
+              log_buff[i] ^= 0x0055;
+          alaw_e (smpno, log_buff, lon_buff);
+          if ((smpno = fwrite (lon_buff, sizeof (short), smpno, Fo)) < 0)
+            KILL (outfil, 6);
+        }
+      break;
 
-    /* ......... Process u-law rule ......... */
+      /* ......... Process u-law rule ......... */
 
-  case 'U':
-    /* Input: LINEAR | Output: LOG */
-    if (inp_type == IS_LIN && out_type == IS_LOG)
-      for (tot_smpno = cur_blk = 0; cur_blk < N2; cur_blk++, tot_smpno += smpno) {
-        smpno = fread (lin_buff, sizeof (short), N, Fi);
-        ulaw_compress (smpno, lin_buff, log_buff);
-        smpno = fwrite (log_buff, sizeof (short), smpno, Fo);
-      }
+    case 'U':
+      /* Input: LINEAR | Output: LOG */
+      if (inp_type == IS_LIN && out_type == IS_LOG)
+        for (tot_smpno = cur_blk = 0; cur_blk < N2; cur_blk++, tot_smpno += smpno) {
+          smpno = fread (lin_buff, sizeof (short), N, Fi);
+          ulaw_c (smpno, lin_buff, log_buff);
+          smpno = fwrite (log_buff, sizeof (short), smpno, Fo);
+        }
 
-    /* Input: LINEAR | Output: LINEAR */
-    else if (inp_type == IS_LIN && out_type == IS_LIN)
-      for (tot_smpno = cur_blk = 0; cur_blk < N2; cur_blk++, tot_smpno += smpno) {
-        smpno = fread (lin_buff, sizeof (short), N, Fi);
-        ulaw_compress (smpno, lin_buff, log_buff);
-        ulaw_expand (smpno, log_buff, lon_buff);
-        smpno = fwrite (lon_buff, sizeof (short), smpno, Fo);
-      }
+      /* Input: LINEAR | Output: LINEAR */
+      else if (inp_type == IS_LIN && out_type == IS_LIN)
+        for (tot_smpno = cur_blk = 0; cur_blk < N2; cur_blk++, tot_smpno += smpno) {
+          smpno = fread (lin_buff, sizeof (short), N, Fi);
+          ulaw_c (smpno, lin_buff, log_buff);
+          ulaw_e (smpno, log_buff, lon_buff);
+          smpno = fwrite (lon_buff, sizeof (short), smpno, Fo);
+        }
 
-    /* Input: LOG | Output: LINEAR */
-    else if (inp_type == IS_LOG)
-      for (tot_smpno = cur_blk = 0; cur_blk < N2; cur_blk++, tot_smpno += smpno) {
-        smpno = fread (log_buff, sizeof (short), N, Fi);
-        ulaw_expand (smpno, log_buff, lon_buff);
-        smpno = fwrite (lon_buff, sizeof (short), smpno, Fo);
-      }
-    break;
-  }
+      /* Input: LOG | Output: LINEAR */
+      else if (inp_type == IS_LOG)
+        for (tot_smpno = cur_blk = 0; cur_blk < N2; cur_blk++, tot_smpno += smpno) {
+          smpno = fread (log_buff, sizeof (short), N, Fi);
+          ulaw_e (smpno, log_buff, lon_buff);
+          smpno = fwrite (lon_buff, sizeof (short), smpno, Fo);
+        }
+      break;
+    }
 
 
   /* ......... FINALIZATIONS ......... */
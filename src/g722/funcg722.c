@@ -1,4 +1,4 @@
-/*                     v3.0 - 10/Jan/2007
+/*                     v3.1 - 16/Oct/2026
   ============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -42,6 +42,8 @@ History:
                       reformated <simao@ctd.comsat.com>
 10.Jan.07  v3.0       Updated with STL2005 v2.2 basic operators
                       <{balazs.kovesi,stephane.ragot}@orange-ftgroup.com>
+16.Oct.26  v3.1       Added block QMF functions qmf_tx_block() and
+                      qmf_rx_block()
   ============================================================================
 */
 
@@ -50,6 +52,12 @@ History:
 /* Include state variable definition, function and operator prototypes */
 #include "g722.h"
 
+/* SIMD QMF dot-products */
+#if defined(__SSE2__) || defined(_M_X64)
+#define G722_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
 /*___________________________________________________________________________
 
     Function Name : lsbcod
@@ -1538,4 +1546,200 @@ void qmf_rx (Word16 rl, Word16 rh, Word16 * xout1, Word16 * xout2, g722_state *
 #undef delayx
 /* ..................... End of qmf_rx() ..................... */
 
+
+#ifndef WMOPS
+/* **** Even and odd taps of coef_qmf[], the others set to zero **** */
+static const Word16 coef_qmf_even[24] = {
+  3 * 2, 0, -11 * 2, 0, 12 * 2, 0,
+  32 * 2, 0, -210 * 2, 0, 951 * 2, 0,
+  3876 * 2, 0, -805 * 2, 0, 362 * 2, 0,
+  -156 * 2, 0, 53 * 2, 0, -11 * 2, 0
+};
+static const Word16 coef_qmf_odd[24] = {
+  0, -11 * 2, 0, 53 * 2, 0, -156 * 2,
+  0, 362 * 2, 0, -805 * 2, 0, 3876 * 2,
+  0, 951 * 2, 0, -210 * 2, 0, 32 * 2,
+  0, 12 * 2, 0, -11 * 2, 0, 3 * 2
+};
+
+
+/*___________________________________________________________________________
+
+    Function Name : qmf_dot
+
+     The two 12-tap dot-products of the QMF filters, over the even
+     (accuma) and the odd (accumb) taps of a 24-sample delay line.
+
+     The sum of the absolute values of coef_qmf[] is 25928, so that the
+     L_mac0() sums of qmf_tx()/qmf_rx() can never saturate: plain 32-bit
+     sums, in any order, give the same result. With SSE2, the products
+     are computed with pmaddwd against the zero-padded even and odd taps.
+ ___________________________________________________________________________
+*/
+static void qmf_dot (const Word16 * d, Word32 * accuma, Word32 * accumb) {
+#if defined(G722_SIMD_SSE2)
+  __m128i d0 = _mm_loadu_si128 ((const __m128i *) d);
+  __m128i d1 = _mm_loadu_si128 ((const __m128i *) (d + 8));
+  __m128i d2 = _mm_loadu_si128 ((const __m128i *) (d + 16));
+  __m128i a, b;
+
+  a = _mm_add_epi32 (_mm_add_epi32 (_mm_madd_epi16 (d0, _mm_loadu_si128 ((const __m128i *) coef_qmf_even)),
+                                    _mm_madd_epi16 (d1, _mm_loadu_si128 ((const __m128i *) (coef_qmf_even + 8)))),
+                     _mm_madd_epi16 (d2, _mm_loadu_si128 ((const __m128i *) (coef_qmf_even + 16))));
+  b = _mm_add_epi32 (_mm_add_epi32 (_mm_madd_epi16 (d0, _mm_loadu_si128 ((const __m128i *) coef_qmf_odd)),
+                                    _mm_madd_epi16 (d1, _mm_loadu_si128 ((const __m128i *) (coef_qmf_odd + 8)))),
+                     _mm_madd_epi16 (d2, _mm_loadu_si128 ((const __m128i *) (coef_qmf_odd + 16))));
+
+  /* Horizontal sums: a0+a1+a2+a3 and b0+b1+b2+b3 */
+  a = _mm_add_epi32 (_mm_unpacklo_epi64 (a, b), _mm_unpackhi_epi64 (a, b));
+  a = _mm_add_epi32 (a, _mm_shuffle_epi32 (a, _MM_SHUFFLE (2, 3, 0, 1)));
+  *accuma = _mm_cvtsi128_si32 (a);
+  *accumb = _mm_cvtsi128_si32 (_mm_unpackhi_epi64 (a, a));
+#else
+  Word32 a = 0, b = 0;
+  Word16 i;
+
+  for (i = 0; i < 24; i += 2) {
+    a += (Word32) coef_qmf[i] * d[i];
+    b += (Word32) coef_qmf[i + 1] * d[i + 1];
+  }
+  *accuma = a;
+  *accumb = b;
+#endif
+}
+#endif /* !WMOPS */
+
+
+/*___________________________________________________________________________
+
+    Function Name : qmf_tx_block
+
+     G722 QMF analysis (encoder) filter for a block of n sample pairs;
+     bit-exact with n calls of qmf_tx().
+
+     The samples are written backwards into a local delay line of
+     2*G722_QMF_BLK+22 samples, so that the 24 samples for each output
+     are always contiguous, and the delay line is not shifted for each
+     sample pair; the last 24 samples are copied back to the state at
+     the end of the block. Under WMOPS, qmf_tx() is called for each pair
+     to keep the complexity count.
+
+    Inputs :
+     xin - 2n input samples, in time order (read-only)
+     xl  - n lower band samples (write-only)
+     xh  - n higher band samples (write-only)
+     n   - number of sample pairs
+     s   - pointer to state variable structure (read/write)
+
+    Return Value :
+     None.
+ ___________________________________________________________________________
+*/
+#define delayx s->qmf_tx_delayx
+void qmf_tx_block (Word16 * xin, Word16 * xl, Word16 * xh, Word16 n, g722_state * s) {
+#ifdef WMOPS
+  Word16 j;
+
+  for (j = 0; j < n; j++)
+    qmf_tx (xin[2 * j + 1], xin[2 * j], &xl[j], &xh[j], s);
+#else
+  Word16 line[2 * G722_QMF_BLK + 22];
+  Word16 i, j, m, w;
+  Word32 accuma, accumb;
+  Word32 comp_low, comp_high;
+
+  for (; n > 0; n -= m, xin += 2 * m, xl += m, xh += m) {
+    m = n < G722_QMF_BLK ? n : G722_QMF_BLK;
+
+    /* Past samples behind the block */
+    for (i = 0; i < 22; i++)
+      line[2 * m + i] = delayx[2 + i];
+
+    for (j = 0, w = 2 * (m - 1); j < m; j++, w -= 2) {
+      line[w + 1] = xin[2 * j];
+      line[w] = xin[2 * j + 1];
+
+      qmf_dot (line + w, &accuma, &accumb);
+
+      comp_low = L_add (accuma, accumb);
+      comp_low = L_add (comp_low, comp_low);
+      comp_high = L_sub (accuma, accumb);
+      comp_high = L_add (comp_high, comp_high);
+      xl[j] = limit ((Word16) L_shr (comp_low, (Word16) 16));
+      xh[j] = limit ((Word16) L_shr (comp_high, (Word16) 16));
+    }
+
+    /* Delay line as left by qmf_tx() */
+    delayx[0] = line[0];
+    delayx[1] = line[1];
+    for (i = 0; i < 22; i++)
+      delayx[2 + i] = line[i];
+  }
+#endif
+}
+
+#undef delayx
+/* ..................... End of qmf_tx_block() ..................... */
+
+
+/*___________________________________________________________________________
+
+    Function Name : qmf_rx_block
+
+     G722 QMF synthesis (decoder) filter for a block of n sample pairs;
+     bit-exact with n calls of qmf_rx(). Same delay line arrangement as
+     qmf_tx_block().
+
+    Inputs :
+     rl   - n lower band samples (read-only)
+     rh   - n higher band samples (read-only)
+     xout - 2n output samples, in time order (write-only)
+     n    - number of sample pairs
+     s    - pointer to state variable structure (read/write)
+
+    Return Value :
+     None.
+ ___________________________________________________________________________
+*/
+#define delayx s->qmf_rx_delayx
+void qmf_rx_block (Word16 * rl, Word16 * rh, Word16 * xout, Word16 n, g722_state * s) {
+#ifdef WMOPS
+  Word16 j;
+
+  for (j = 0; j < n; j++)
+    qmf_rx (rl[j], rh[j], &xout[2 * j], &xout[2 * j + 1], s);
+#else
+  Word16 line[2 * G722_QMF_BLK + 22];
+  Word16 i, j, m, w;
+  Word32 accuma, accumb;
+
+  for (; n > 0; n -= m, rl += m, rh += m, xout += 2 * m) {
+    m = n < G722_QMF_BLK ? n : G722_QMF_BLK;
+
+    /* Past samples behind the block */
+    for (i = 0; i < 22; i++)
+      line[2 * m + i] = delayx[2 + i];
+
+    for (j = 0, w = 2 * (m - 1); j < m; j++, w -= 2) {
+      line[w + 1] = add (rl[j], rh[j]);
+      line[w] = sub (rl[j], rh[j]);
+
+      qmf_dot (line + w, &accuma, &accumb);
+
+      xout[2 * j] = extract_h (L_shl (accuma, 4));
+      xout[2 * j + 1] = extract_h (L_shl (accumb, 4));
+    }
+
+    /* Delay line as left by qmf_rx() */
+    delayx[0] = line[0];
+    delayx[1] = line[1];
+    for (i = 0; i < 22; i++)
+      delayx[2 + i] = line[i];
+  }
+#endif
+}
+
+#undef delayx
+/* ..................... End of qmf_rx_block() ..................... */
+
 /* ******************** End of funcg722.c ***************************** */
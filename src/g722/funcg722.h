@@ -1,6 +1,6 @@
 /*
   ============================================================================
-   File: FUNCG722.H                                  v3.0 - 10/Jan/2007
+   File: FUNCG722.H                                  v3.1 - 16/Oct/2026
   ============================================================================
 
 			UGST/ITU-T G722 MODULE
@@ -25,6 +25,7 @@
                         based on the CNET's 07/01/90 version 2.00
    01.Jul.95    v2.0    Smart prototypes that work with many compilers; 
                         reformated; state variable structure added. 
+   16.Oct.26    v3.1    Added qmf_tx_block() and qmf_rx_block()
   ============================================================================
 */
 #ifndef FUNCG722_H
@@ -106,5 +107,10 @@ void upzero ARGS ((Word16 dlt[], Word16 bl[]));
 void qmf_tx ARGS ((Word16 xin0, Word16 xin1, Word16 * xl, Word16 * xh, g722_state * s));
 void qmf_rx ARGS ((Word16 rl, Word16 rh, Word16 * xout1, Word16 * xout2, g722_state * s));
 
+/* Block QMF: n sample pairs per call, processed G722_QMF_BLK at a time */
+#define G722_QMF_BLK 160        /* 20 ms at 16 kHz */
+void qmf_tx_block ARGS ((Word16 * xin, Word16 * xl, Word16 * xh, Word16 n, g722_state * s));
+void qmf_rx_block ARGS ((Word16 * rl, Word16 * rh, Word16 * xout, Word16 n, g722_state * s));
+
 #endif /* FUNCG722_H */
 /* ........................ End of file funcg722.h ......................... */
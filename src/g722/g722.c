@@ -1,4 +1,4 @@
-/*                     v3.0 - 10/Jan/2007
+/*                     v3.1 - 16/Oct/2026
   ============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -39,10 +39,23 @@ History:
                       reformated <simao@ctd.comsat.com>
 10.Jan.07  v3.0       Updated with STL2005 v2.2 basic operators
                       <{balazs.kovesi,stephane.ragot}@orange-ftgroup.com>
+16.Oct.26  v3.1       Added g722_encode_multi() and g722_decode_multi(),
+                      running independent channels on a pool of worker
+                      threads; QMF filters run on blocks of G722_QMF_BLK
+                      samples
   ============================================================================
 */
 #include "g722.h"
 #include "stl.h"
+#include "ugst-thread.h"
+
+/* Channels may only run in parallel when the basic operators do not
+   update global flags or complexity counters */
+#if defined(BASOP_THREADSAFE) && !defined(WMOPS)
+#define G722_POOL(p) (p)
+#else
+#define G722_POOL(p) ((void) (p), (ugst_pool *) 0)
+#endif
 
 void g722_reset_encoder (g722_state * encoder) {
   Word16 xl, il;
@@ -68,42 +81,44 @@ void g722_reset_encoder (g722_state * encoder) {
 
 Word32 g722_encode (short *incode, short *code, Word32 read1, g722_state * encoder) {
   /* Encoder variables */
-  Word16 xl, il;
-  Word16 xh, ih;
-  Word16 xin0, xin1;
+  Word16 xl[G722_QMF_BLK], il;
+  Word16 xh[G722_QMF_BLK], ih;
 
   /* Auxiliary variables */
   Word32 i;
-  Word16 *p_incode;
+  Word16 j, n;
 
   /* Divide sample counter by 2 to account for QMF operation */
   read1 = L_shr (read1, 1);
 
   /* Main loop - never reset */
-  p_incode = incode;
 #ifdef WMOPS
-  move16 ();
+  move16 ();                    /* incode pointer */
 #endif
-  for (i = 0; i < read1; i++) {
-    xin1 = *incode++;
-    xin0 = *incode++;
+  for (i = 0; i < read1; i += n) {
+    n = (Word16) (read1 - i < G722_QMF_BLK ? read1 - i : G722_QMF_BLK);
+
+    /* Calculation of the synthesis QMF samples for the block */
+    qmf_tx_block (incode, xl, xh, n, encoder);
+    incode += 2 * n;
 #ifdef WMOPS
-    move16 ();
-    move16 ();
+    for (j = 0; j < n; j++) {
+      move16 ();                /* xin1 */
+      move16 ();                /* xin0 */
+    }
 #endif
 
-    /* Calculation of the synthesis QMF samples */
-    qmf_tx (xin0, xin1, &xl, &xh, encoder);
-
-    /* Call the upper and lower band ADPCM encoders */
-    il = lsbcod (xl, 0, encoder);
-    ih = hsbcod (xh, 0, encoder);
+    for (j = 0; j < n; j++) {
+      /* Call the upper and lower band ADPCM encoders */
+      il = lsbcod (xl[j], 0, encoder);
+      ih = hsbcod (xh[j], 0, encoder);
 
-    /* Mount the output G722 codeword: bits 0 to 5 are the lower-band portion of the encoding, and bits 6 and 7 are the upper-band portion of the encoding */
-    code[i] = s_and (add (shl (ih, 6), il), 0xFF);
+      /* Mount the output G722 codeword: bits 0 to 5 are the lower-band portion of the encoding, and bits 6 and 7 are the upper-band portion of the encoding */
+      code[i + j] = s_and (add (shl (ih, 6), il), 0xFF);
 #ifdef WMOPS
-    move16 ();
+      move16 ();
 #endif
+    }
   }
 
   /* Return number of samples read */
@@ -139,31 +154,34 @@ void g722_reset_decoder (g722_state * decoder) {
 short g722_decode (short *code, short *outcode, short mode, short read1, g722_state * decoder) {
   /* Decoder variables */
   Word16 il, ih;
-  Word16 rl, rh;
-  Word16 xout1, xout2;
+  Word16 rl[G722_QMF_BLK], rh[G722_QMF_BLK];
 
   /* Auxiliary variables */
   short i;
+  Word16 j, n;
 
   /* Decode - reset is never applied here */
-  for (i = 0; i < read1; i++) {
-    /* Separate the input G722 codeword: bits 0 to 5 are the lower-band portion of the encoding, and bits 6 and 7 are the upper-band portion of the encoding */
-    il = s_and (code[i], 0x3F); /* 6 bits of low SB */
-    ih = s_and (lshr (code[i], 6), 0x03);       /* 2 bits of high SB */
-
-    /* Call the upper and lower band ADPCM decoders */
-    rl = lsbdec (il, mode, 0, decoder);
-    rh = hsbdec (ih, 0, decoder);
-
-    /* Calculation of output samples from QMF filter */
-    qmf_rx (rl, rh, &xout1, &xout2, decoder);
-
-    /* Save samples in output vector */
-    *outcode++ = xout1;
-    *outcode++ = xout2;
+  for (i = 0; i < read1; i += n) {
+    n = read1 - i < G722_QMF_BLK ? read1 - i : G722_QMF_BLK;
+
+    for (j = 0; j < n; j++) {
+      /* Separate the input G722 codeword: bits 0 to 5 are the lower-band portion of the encoding, and bits 6 and 7 are the upper-band portion of the encoding */
+      il = s_and (code[i + j], 0x3F);   /* 6 bits of low SB */
+      ih = s_and (lshr (code[i + j], 6), 0x03); /* 2 bits of high SB */
+
+      /* Call the upper and lower band ADPCM decoders */
+      rl[j] = lsbdec (il, mode, 0, decoder);
+      rh[j] = hsbdec (ih, 0, decoder);
+    }
+
+    /* Calculation of output samples from QMF filter, saved in output vector */
+    qmf_rx_block (rl, rh, outcode, n, decoder);
+    outcode += 2 * n;
 #ifdef WMOPS
-    move16 ();
-    move16 ();
+    for (j = 0; j < n; j++) {
+      move16 ();                /* xout1 */
+      move16 ();                /* xout2 */
+    }
 #endif
   }
 
@@ -172,3 +190,59 @@ short g722_decode (short *code, short *outcode, short mode, short read1, g722_st
 }
 
 /* .................... end of g722_decode() .......................... */
+
+
+/* Arguments of the multi-channel jobs */
+typedef struct {
+  short **in;
+  short **out;
+  Word32 nsmp;
+  short mode;
+  g722_state *state;
+} g722_multi_job;
+
+static void g722_encode_job (void *ctx, long k) {
+  g722_multi_job *job = (g722_multi_job *) ctx;
+
+  g722_encode (job->in[k], job->out[k], job->nsmp, &job->state[k]);
+}
+
+static void g722_decode_job (void *ctx, long k) {
+  g722_multi_job *job = (g722_multi_job *) ctx;
+
+  g722_decode (job->in[k], job->out[k], job->mode, (short) job->nsmp, &job->state[k]);
+}
+
+
+Word32 g722_encode_multi (long nch, short **incode, short **code, Word32 read1, g722_state * encoder, ugst_pool * pool) {
+  g722_multi_job job;
+
+  job.in = incode;
+  job.out = code;
+  job.nsmp = read1;
+  job.mode = 0;
+  job.state = encoder;
+  ugst_pool_run (G722_POOL (pool), nch, g722_encode_job, &job);
+
+  /* Return number of samples read, per channel */
+  return (L_shr (read1, 1));
+}
+
+/* .................... end of g722_encode_multi() .......................... */
+
+
+short g722_decode_multi (long nch, short **code, short **outcode, short mode, short read1, g722_state * decoder, ugst_pool * pool) {
+  g722_multi_job job;
+
+  job.in = code;
+  job.out = outcode;
+  job.nsmp = read1;
+  job.mode = mode;
+  job.state = decoder;
+  ugst_pool_run (G722_POOL (pool), nch, g722_decode_job, &job);
+
+  /* Return number of samples decoded, per channel */
+  return (shl (read1, 1));
+}
+
+/* .................... end of g722_decode_multi() .......................... */
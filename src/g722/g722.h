@@ -1,6 +1,6 @@
 /*
   ============================================================================
-   File: G722.H                                  v3.0 - 10/Jan/2007
+   File: G722.H                                  v3.1 - 16/Oct/2026
   ============================================================================
 
                             UGST/ITU-T G722 MODULE
@@ -14,6 +14,7 @@
                       reformated <simao@ctd.comsat.com>
 10.Jan.07  v3.0       Updated with STL2005 v2.1 basic operators
                       <{balazs.kovesi,stephane.ragot}@orange-ftgroup.com>
+16.Oct.26  v3.1       Added g722_encode_multi() and g722_decode_multi()
   ============================================================================
 */
 #ifndef G722_H
@@ -60,6 +61,7 @@ typedef struct {
 
 /* Include function prototypes for G722 functions */
 #include "funcg722.h"
+#include "ugst-thread.h"
 
 /* High-level (UGST) function prototypes for G722 functions */
 void g722_reset_encoder ARGS ((g722_state * encoder));
@@ -67,5 +69,13 @@ Word32 g722_encode ARGS ((short *incode, short *code, Word32 nsmp, g722_state *
 void g722_reset_decoder ARGS ((g722_state * decoder));
 short g722_decode ARGS ((short *code, short *outcode, short mode, short nsmp, g722_state * decoder));
 
+/* Encode/decode nch independent channels, each with its own state, on the
+   threads of pool (see ugst_pool_open(); NULL: in turn on the calling
+   thread). Channels are only processed in parallel in a build with
+   thread-safe basic operators (BASOP_THREADSAFE) and without WMOPS counting;
+   otherwise they are processed in turn. */
+Word32 g722_encode_multi ARGS ((long nch, short **incode, short **code, Word32 nsmp, g722_state * encoder, ugst_pool * pool));
+short g722_decode_multi ARGS ((long nch, short **code, short **outcode, short mode, short nsmp, g722_state * decoder, ugst_pool * pool));
+
 #endif /* G722_H */
 /* ................. End of file g722.h .................................. */
@@ -1,4 +1,4 @@
-/*                     v3.0 - 10/Jan/2007
+/*                     v3.1 - 16/Oct/2026
   ============================================================================
 
   G722DEMO.C
@@ -40,6 +40,12 @@
   -enc        run only the encoder [default: encoder and decoder]
   -dec        run only the decoder [default: encoder and decoder]
   -noreset    don't apply reset to the encoder/decoder
+  -nch #      number of interleaved channels in the input file; each
+              channel is encoded/decoded independently and BlockSize
+              is counted in samples per channel [default: 1]
+  -threads #  number of threads for the channels (0: number of CPUs);
+              used only in a build with thread-safe basic operators
+              [default: 0]
   -q          quiet operation (don't print progress flag)
   -?/-help    print help message
 
@@ -63,6 +69,8 @@
                        size was not a multiple of the block size
                        N. <simao>
   10.Jan.07    v3.0    Added some castings to avoid warnings
+  16.Oct.26    v3.1    Added options -nch and -threads for multi-channel
+                       files, using g722_encode_multi()/g722_decode_multi()
   ============================================================================
 */
 
@@ -99,7 +107,7 @@
  -------------------------------------------------------------------------
 */
 void display_usage () {
-  printf ("G722DEMO Version 2.2 of 04/Jan/1999 \n");
+  printf ("G722DEMO Version 3.1 of 16/Oct/2026 \n");
   printf ("  UGST/ITU-T G.722 wideband (50-7000Hz) encode/decode module.\n");
   printf ("  (*) G.722 Module: COPYRIGHT CNET LANNION A TSS/CMC, 24/Aug/90\n");
 
@@ -122,6 +130,8 @@ void display_usage () {
   printf ("  -enc        run only the encoder [default: encoder and decoder]\n");
   printf ("  -dec        run only the decoder [default: encoder and decoder]\n");
   printf ("  -noreset    don't apply reset to the encoder/decoder\n");
+  printf ("  -nch #      number of interleaved channels in input file [default: 1]\n");
+  printf ("  -threads #  number of threads for the channels [default: no. of CPUs]\n");
   printf ("  -?/-help    print help message\n");
   printf ("  -q          quiet operation (don't print progress flag)\n");
 
@@ -131,6 +141,112 @@ void display_usage () {
 /* .................... End of display_usage() ........................... */
 
 
+/*
+ -------------------------------------------------------------------------
+ void process_multi(...);
+ ~~~~~~~~~~~~~~~~~~~~~~~~
+ Encode and/or decode N2 blocks of N samples per channel of a file of nch
+ interleaved channels, starting at the current position of inp. Each
+ channel has its own encoder and decoder state; the channels of a block
+ are processed on a pool of nthreads threads, started once for the whole
+ file.
+
+ History:
+ ~~~~~~~~
+ 16.Oct.26 v1.0 Created.
+ -------------------------------------------------------------------------
+*/
+void process_multi (FILE * inp, FILE * out, char *FileOut, long nch, int nthreads, long N, long N2, char encode, char decode, Word16 mode, char quiet) {
+  g722_state *encoder, *decoder;
+  Word16 *inp_buf, *out_buf;    /* Interleaved input and output buffers */
+  Word16 **chn_in, **chn_cod, **chn_out, **src;
+  ugst_pool *pool;
+  long read1, c, i, cur_blk, iter = 0;
+  static char funny[9] = "|/-\\|/-\\";
+
+  /* Allocate states and per-channel buffers */
+  encoder = (g722_state *) calloc (nch, sizeof (g722_state));
+  decoder = (g722_state *) calloc (nch, sizeof (g722_state));
+  inp_buf = (Word16 *) calloc (N * nch, sizeof (Word16));
+  out_buf = (Word16 *) calloc (2 * N * nch, sizeof (Word16));
+  chn_in = (Word16 **) calloc (nch, sizeof (Word16 *));
+  chn_cod = (Word16 **) calloc (nch, sizeof (Word16 *));
+  chn_out = (Word16 **) calloc (nch, sizeof (Word16 *));
+  if (encoder == NULL || decoder == NULL || inp_buf == NULL || out_buf == NULL || chn_in == NULL || chn_cod == NULL || chn_out == NULL)
+    error_terminate ("Error alocating buffers\n", 3);
+  for (c = 0; c < nch; c++) {
+    chn_in[c] = (Word16 *) calloc (N, sizeof (Word16));
+    chn_cod[c] = (Word16 *) calloc (N, sizeof (Word16));
+    chn_out[c] = (Word16 *) calloc (2 * N, sizeof (Word16));
+    if (chn_in[c] == NULL || chn_cod[c] == NULL || chn_out[c] == NULL)
+      error_terminate ("Error alocating channel buffers\n", 3);
+    if (encode)
+      g722_reset_encoder (&encoder[c]);
+    if (decode)
+      g722_reset_decoder (&decoder[c]);
+  }
+
+  /* Start the worker threads, reused for all blocks */
+  if ((pool = ugst_pool_open (nthreads)) == NULL)
+    error_terminate ("Error starting worker threads\n", 3);
+
+  /* Process whole frames of nch samples */
+  for (cur_blk = 0; cur_blk < N2; cur_blk++) {
+    if ((read1 = (long) fread (inp_buf, sizeof (short), N * nch, inp) / nch) == 0)
+      break;
+
+    /* print progress flag */
+    if (!quiet)
+      fprintf (stderr, "%c\r", funny[(iter / read1) % 8]);
+
+    /* De-interleave */
+    for (c = 0; c < nch; c++)
+      for (i = 0; i < read1; i++)
+        chn_in[c][i] = inp_buf[i * nch + c];
+    src = chn_in;
+
+    if (encode) {
+      if (g722_encode_multi (nch, src, chn_cod, read1, encoder, pool) != read1 / 2)
+        error_terminate ("Error encoding!\n", 10);
+      read1 /= 2;
+      src = chn_cod;
+    }
+
+    if (decode) {
+      if (g722_decode_multi (nch, src, chn_out, mode, (short) read1, decoder, pool) != read1 * 2)
+        error_terminate ("Error decoding!\n", 10);
+      read1 *= 2;
+      src = chn_out;
+    }
+    iter += read1;
+
+    /* Interleave and save bitstream or decoded samples */
+    for (c = 0; c < nch; c++)
+      for (i = 0; i < read1; i++)
+        out_buf[i * nch + c] = src[c][i];
+    if (fwrite (out_buf, sizeof (Word16), read1 * nch, out) != (size_t) (read1 * nch))
+      KILL (FileOut, -4);
+  }
+
+  /* Stop the worker threads and free memory */
+  ugst_pool_close (pool);
+  for (c = 0; c < nch; c++) {
+    free (chn_in[c]);
+    free (chn_cod[c]);
+    free (chn_out[c]);
+  }
+  free (chn_in);
+  free (chn_cod);
+  free (chn_out);
+  free (inp_buf);
+  free (out_buf);
+  free (encoder);
+  free (decoder);
+}
+
+/* .................... End of process_multi() ........................... */
+
+
 /*
    **************************************************************************
    ***                                                                    ***
@@ -166,6 +282,8 @@ int main (int argc, char *argv[]) {
   long iter = 0;
   long N = DFT_BLK, N1 = 1, N2 = 0, smpno = 0;
   long start_byte;
+  long nch = 1;                 /* Number of interleaved channels */
+  int nthreads = 0;             /* Number of threads for the channels */
 #ifdef VMS
   char mrs[15];
 #endif
@@ -220,6 +338,22 @@ int main (int argc, char *argv[]) {
         /* Define Frame size for rate change during operation */
         N = atoi (argv[2]);
 
+        /* Move argv over the option to the next argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-nch") == 0) {
+        /* Number of interleaved channels */
+        nch = atol (argv[2]);
+        if (nch < 1)
+          error_terminate ("Bad number of channels; aborting\n", 2);
+
+        /* Move argv over the option to the next argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-threads") == 0) {
+        /* Number of threads */
+        nthreads = atoi (argv[2]);
+
         /* Move argv over the option to the next argument */
         argv += 2;
         argc -= 2;
@@ -248,7 +382,7 @@ int main (int argc, char *argv[]) {
   FIND_PAR_L (6, "_No. of Blocks: ............... ", N2, N2);
 
   /* Find starting byte in file */
-  start_byte = sizeof (short) * (long) (--N1) * (long) N;
+  start_byte = sizeof (short) * (long) (--N1) * (long) N * nch;
 
   /* Check if is to process the whole file */
   if (N2 == 0) {
@@ -256,7 +390,7 @@ int main (int argc, char *argv[]) {
 
     /* ... find the input file size ... */
     stat (FileIn, &st);
-    N2 = (long) ceil ((st.st_size - start_byte) / (double) (N * sizeof (short)));
+    N2 = (long) ceil ((st.st_size - start_byte) / (double) (N * nch * sizeof (short)));
   }
 
   /* Protect mode, if misgiven */
@@ -271,6 +405,16 @@ int main (int argc, char *argv[]) {
   if ((out = fopen (FileOut, WB)) == NULL)
     KILL (FileOut, -2);
 
+  /* Multi-channel files */
+  if (nch > 1) {
+    if (fseek (inp, start_byte, 0) < 0l)
+      KILL (FileIn, 4);
+    process_multi (inp, out, FileOut, nch, nthreads, N, N2, encode, decode, mode, quiet);
+    fclose (out);
+    fclose (inp);
+    return (0);
+  }
+
 #ifndef STATIC_ALLOCATION
   /* Allocate necessary memory and initialize pointers */
   if (encode && decode) {
@@ -1,4 +1,4 @@
-/*                                                           v2.0 24.Jan.2000
+/*                                                           v2.2 16.Oct.2026
 =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -39,6 +39,8 @@ HISTORY:
                   processing of test vector ri40fa. Corrected code
                   provided by Jayesh Patel <jayesh@dspse.com>.
 		  Verified by <simao.campos@labs.comsat.com>
+16.Oct.2026 v2.1  Added G726_encode_fast() and G726_decode_fast()
+16.Oct.2026 v2.2  Added G726_encode_multi() and G726_decode_multi()
 
 FUNCTIONS:
 Public:
@@ -46,6 +48,19 @@ Public:
 
   G726_decode ..... G726 decoder function;
 
+  G726_encode_fast  G726 encoder, fused per-sample processing; bit-exact
+                    with G726_encode(), does not modify the input buffer;
+
+  G726_decode_fast  G726 decoder, fused per-sample processing; bit-exact
+                    with G726_decode();
+
+  G726_encode_multi G726 encoder for many channels, one channel per SIMD
+                    lane, each with its own rate and law; bit-exact with
+                    G726_encode() on each channel;
+
+  G726_decode_multi G726 decoder for many channels, one channel per SIMD
+                    lane; bit-exact with G726_decode() on each channel;
+
 Private:
   G726_accum ...... addition of predictor outputs to form the partial
                     signal estimate (from the sixth order predictor) and
@@ -156,8 +171,15 @@ Private:
 /*
  *  .................. INCLUDES ..................
  */
+#include <string.h>
 #include "g726.h"
 
+/* SIMD kernels of the multi-channel routines */
+#if defined(__SSE2__) || defined(_M_X64)
+#define G726_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
 
 /*
  *  .................. FUNCTIONS ..................
@@ -3224,4 +3246,1073 @@ void G726_sync (short rate, short *i, short *sp, short *dlnx, short *dsx, char *
 
 /* ........................ end of G726_sync() ........................  */
 
+/*
+ *	.......... F A S T   R O U T I N E S ..........
+ */
+
+/*
+  ---------------------------------------------------------------------------
+  Number of significant bits of 0..255. Gives the exponent of the floating
+  point conversions (G726_log, G726_floata, G726_floatb and the predictor
+  coefficient in G726_fmult) without their chains of comparisons.
+  ---------------------------------------------------------------------------
+*/
+static const char g726_nbits[256] = {
+  0, 1, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4,
+  5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+  8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+  8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+  8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+  8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+  8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+  8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+  8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8
+};
+
+/* Number of significant bits of a 15-bit magnitude */
+#define G726_NBITS(x) ((x) >= 256 ? 8 + g726_nbits[(x) >> 8] : g726_nbits[x])
+
+/*
+  ---------------------------------------------------------------------------
+  Outputs of G726_reconst (dqln), G726_functw (wi) and G726_functf (fi)
+  for each ADPCM code i, per rate 2 (16 kbit/s) to 5 (40 kbit/s).
+  ---------------------------------------------------------------------------
+*/
+static const short g726_dqln_tab[4][32] = {
+  {116, 365, 365, 116},
+  {2048, 135, 273, 373, 373, 273, 135, 2048},
+  {2048, 4, 135, 213, 273, 323, 373, 425, 425, 373, 323, 273, 213, 135, 4, 2048},
+  {2048, 4030, 28, 104, 169, 224, 274, 318, 358, 395, 429, 459, 488, 514, 539, 566,
+   566, 539, 514, 488, 459, 429, 395, 358, 318, 274, 224, 169, 104, 28, 4030, 2048}
+};
+static const short g726_wi_tab[4][32] = {
+  {4074, 439, 439, 4074},
+  {4092, 30, 137, 582, 582, 137, 30, 4092},
+  {4084, 18, 41, 64, 112, 198, 355, 1122, 1122, 355, 198, 112, 64, 41, 18, 4084},
+  {14, 14, 24, 39, 40, 41, 58, 100, 141, 179, 219, 280, 358, 440, 529, 696,
+   696, 529, 440, 358, 280, 219, 179, 141, 100, 58, 41, 40, 39, 24, 14, 14}
+};
+static const short g726_fi_tab[4][32] = {
+  {0, 7, 7, 0},
+  {0, 1, 2, 7, 7, 2, 1, 0},
+  {0, 0, 0, 1, 1, 1, 3, 7, 7, 3, 1, 1, 1, 0, 0, 0},
+  {0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 2, 3, 4, 5, 6, 6,
+   6, 6, 5, 4, 3, 2, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0}
+};
+
+
+/*
+  ---------------------------------------------------------------------------
+  Value versions of G726_fmult, G726_floata/G726_floatb, G726_subta,
+  G726_log and G726_upb, for the fused encoder/decoder below. Same
+  arithmetic as the reference functions, which remain the specification.
+  ---------------------------------------------------------------------------
+*/
+static short g726_fmult1 (short An, short SRn) {
+  long anmag, anexp, wanmag, anmant;
+  long wanexp, srnexp, an, ans, wanmant, srnmant;
+  long wan, wans, srns, srn1;
+
+  an = An & 65535;
+  srn1 = SRn & 65535;
+  ans = (an >> 15);
+  anmag = (ans == 0) ? (an >> 2) : ((16384 - (an >> 2)) & 8191);
+  anexp = G726_NBITS (anmag);
+  anmant = (anmag == 0) ? (1 << 5) : ((anmag << 6) >> anexp);
+
+  srns = (srn1 >> 10);
+  srnexp = (srn1 >> 6) & 15;
+  srnmant = srn1 & 63;
+
+  wans = srns ^ ans;
+  wanexp = srnexp + anexp;
+  wanmant = ((srnmant * anmant) + 48) >> 4;
+  wanmag = (wanexp <= 26) ? (wanmant << 7) >> (26 - wanexp) : ((wanmant << 7) << (wanexp - 26)) & 32767;
+  wan = (wans == 0) ? wanmag : ((65536 - wanmag) & 65535);
+  return (short) wan;
+}
+
+static short g726_float1 (long s, long mag) {
+  long exp_ = G726_NBITS (mag);
+  long mant = (mag == 0) ? (1 << 5) : ((mag << 6) >> exp_);
+
+  return (short) ((s << 10) + (exp_ << 6) + mant);
+}
+
+static short g726_subta1 (short sl, short se) {
+  long sli, sei;
+
+  sli = ((sl >> 13) == 0) ? (long) sl : (sl + 49152);
+  sei = ((se >> 14) == 0) ? (long) se : (se + 32768);
+  return (short) ((sli + 65536 - sei) & 65535);
+}
+
+static short g726_log1 (short d, short *ds) {
+  long dqm, exp_;
+
+  *ds = (d >> 15);
+  dqm = (*ds) ? ((65536 - (long) d) & 32767) : d;
+  exp_ = (dqm == 0) ? 0 : G726_NBITS (dqm) - 1;
+  return (short) ((exp_ << 7) + (((dqm << 7) >> exp_) & 127));
+}
+
+static short g726_upb1 (short u, short b, short dq, short leak, short param) {
+  long bb, ub, ugb, ulb;
+
+  bb = b & 65535;
+  ugb = ((dq & 32767) == 0) ? 0 : ((u == 0) ? 128 : 65408);
+  ulb = ((bb >> 15) == 0) ? ((65536 - (bb >> leak)) & 65535) : ((65536 - ((bb >> leak) + param)) & 65535);
+  ub = (ugb + ulb) & 65535;
+  return (short) ((bb + ub) & 65535);
+}
+
+
+/*
+  ---------------------------------------------------------------------------
+  Fused G.726 encoder (dec==0) or decoder (dec!=0). The state is loaded
+  into local variables for the whole call, and the blocks of the
+  reference encoder/decoder are computed in the same order, without the
+  pointer arguments that keep the compiler from holding the predictor
+  in registers. A reset (r==1) sets the state to the values the delay
+  blocks substitute on the first sample.
+  ---------------------------------------------------------------------------
+*/
+static void g726_fused (short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state, int dec) {
+  short sr0, sr1, sr2, a1, a2, b[6], dq1, dq2, dq3, dq4, dq5, dq6, dq0;
+  short dms, dml, ap, yu, td, pk0, pk1, pk2;
+  long yl;
+  short s, sl, d, dl, ds, dln, i, y, al, se, sez;
+  short dqln, dqs, dql, dq, fi, wi, yut, tr, sigpk, sr, tdp, ax, app;
+  short a1t, a1p, a2t, a2p, wb, k;
+  short sp, slx, dx, dlx, dsx, dlnx, sd;
+  short leak, param, xmask;
+  const short *dqln_tab, *wi_tab, *fi_tab;
+  unsigned long sezi, sei;
+  long dif, difs, difm, difsx, prod, dqmag, dqthr, thr2;
+  long a11, a21, fa, fa1, uga2, uga2b, ula2, ula1, uga1;
+  long j;
+
+  if (smpno <= 0)
+    return;
+
+  /* Per-rate tables and constants */
+  dqln_tab = g726_dqln_tab[rate - 2];
+  wi_tab = g726_wi_tab[rate - 2];
+  fi_tab = g726_fi_tab[rate - 2];
+  leak = (rate != 5) ? 8 : 9;
+  param = (rate != 5) ? (short) 65280 : (short) 65408;
+  xmask = (*law == '1') ? 85 : 0;
+
+  /* Load state */
+  if (r) {
+    sr0 = sr1 = 32;
+    a1 = a2 = 0;
+    dq0 = dq1 = dq2 = dq3 = dq4 = dq5 = 32;
+    for (k = 0; k < 6; k++)
+      b[k] = 0;
+    dms = dml = ap = 0;
+    yu = 544;
+    yl = 34816;
+    td = pk0 = pk1 = 0;
+  } else {
+    sr0 = state->sr0;
+    sr1 = state->sr1;
+    a1 = state->a1r;
+    a2 = state->a2r;
+    dq0 = state->dq0;
+    dq1 = state->dq1;
+    dq2 = state->dq2;
+    dq3 = state->dq3;
+    dq4 = state->dq4;
+    dq5 = state->dq5;
+    b[0] = state->b1r;
+    b[1] = state->b2r;
+    b[2] = state->b3r;
+    b[3] = state->b4r;
+    b[4] = state->b5r;
+    b[5] = state->b6r;
+    dms = state->dmsp;
+    dml = state->dmlp;
+    ap = state->apr;
+    yu = state->yup;
+    yl = state->ylp;
+    td = state->tdr;
+    pk0 = state->pk0;
+    pk1 = state->pk1;
+  }
+
+  for (j = 0; j < smpno; j++) {
+    /* 4.2.6: delays and signal estimate */
+    sr2 = sr1;
+    sr1 = sr0;
+    dq6 = dq5;
+    dq5 = dq4;
+    dq4 = dq3;
+    dq3 = dq2;
+    dq2 = dq1;
+    dq1 = dq0;
+
+    sezi = (unsigned short) g726_fmult1 (b[0], dq1);
+    sezi += (unsigned short) g726_fmult1 (b[1], dq2);
+    sezi += (unsigned short) g726_fmult1 (b[2], dq3);
+    sezi += (unsigned short) g726_fmult1 (b[3], dq4);
+    sezi += (unsigned short) g726_fmult1 (b[4], dq5);
+    sezi += (unsigned short) g726_fmult1 (b[5], dq6);
+    sezi &= 65535;
+    sei = (sezi + (unsigned short) g726_fmult1 (a2, sr2) + (unsigned short) g726_fmult1 (a1, sr1)) & 65535;
+    sez = (short) (sezi >> 1);
+    se = (short) (sei >> 1);
+
+    /* 4.2.5, 4.2.4: speed control and scale factor (`known-state' parts) */
+    al = (ap >= 256) ? 64 : (ap >> 2);
+    dif = (yu + 16384 - (yl >> 6)) & 16383;
+    difs = (dif >> 13);
+    difm = (difs == 0) ? dif : ((16384 - dif) & 8191);
+    prod = ((difm * al) >> 6);
+    prod = (difs == 0) ? prod : ((16384 - prod) & 16383);
+    y = (short) (((yl >> 6) + prod) & 8191);
+
+    if (dec) {
+      i = inp_buf[j];
+    } else {
+      /* 4.2.1, 4.2.2: difference signal and adaptive quantizer */
+      s = inp_buf[j] ^ xmask;
+      G726_expand (&s, law, &sl);
+      d = g726_subta1 (sl, se);
+      dl = g726_log1 (d, &ds);
+      dln = (dl + 4096 - (y >> 2)) & 4095;
+      G726_quan (rate, &dln, &ds, &i);
+      out_buf[j] = i;
+    }
+
+    /* 4.2.3: inverse adaptive quantizer */
+    dqs = (i >> (rate - 1));
+    dqln = dqln_tab[i];
+    dql = (dqln + (y >> 2)) & 4095;
+    {
+      long dex, dqt;
+
+      dex = (dql >> 7) & 15;
+      dqt = (dql & 127) + 128;
+      dqmag = (dql >> 11) ? 0 : ((dqt << 7) >> (14 - dex));
+      dq = (short) (dqs << 15) + dqmag;
+    }
+
+    /* 4.2.5: short and long term averages of F(I) */
+    fi = fi_tab[i];
+    dif = ((fi << 9) + 8192 - dms) & 8191;
+    difsx = ((dif >> 12) == 0) ? (dif >> 5) : ((dif >> 5) + 3840);
+    dms = (difsx + dms) & 4095;
+    dif = ((fi << 11) + 32768 - dml) & 32767;
+    difsx = ((dif >> 14) == 0) ? (dif >> 7) : ((dif >> 7) + 16128);
+    dml = (short) ((difsx + dml) & 16383);
+
+    /* 4.2.4: quantizer scale factor adaptation */
+    wi = wi_tab[i];
+    dif = (((long) wi << 5) + 131072 - y) & 131071;
+    difsx = ((dif >> 16) == 0) ? (dif >> 5) : ((dif >> 5) + 4096);
+    yut = (short) ((y + difsx) & 8191);
+    if ((((yut + 15840) & 16383) >> 13) == 1)
+      yu = 544;
+    else if ((((yut + 11264) & 16383) >> 13) == 0)
+      yu = 5120;
+    else
+      yu = yut;
+
+    /* 4.2.7: transition detector, with the previous yl */
+    dqmag = dq & 32767;
+    thr2 = ((yl >> 15) > 9) ? 31744 : ((((yl >> 10) & 31) + 32) << (yl >> 15));
+    dqthr = (thr2 + (thr2 >> 1)) >> 1;
+    tr = (dqmag > dqthr && td == 1) ? 1 : 0;
+
+    dif = (yu + ((1048576 - yl) >> 6)) & 16383;
+    difsx = ((dif >> 13) == 0) ? dif : (dif + 507904);
+    yl = (yl + difsx) & 524287;
+
+    /* 4.2.6: signs, reconstructed signal, floating point conversions */
+    pk2 = pk1;
+    pk1 = pk0;
+    {
+      unsigned long dqi, sezx, sex, dqsez;
+
+      dqi = ((dq >> 15) & 1) == 0 ? (unsigned long) (dq & 65535) : ((65536 - (dq & 32767)) & 65535);
+      sezx = ((sez >> 14) == 0) ? (unsigned long) sez : (unsigned long) (sez + 32768);
+      dqsez = (dqi + sezx) & 65535;
+      pk0 = (short) (dqsez >> 15);
+      sigpk = (dqsez == 0) ? 1 : 0;
+      sex = ((se >> 14) == 0) ? (unsigned long) se : (unsigned long) ((1 << 15) + se);
+      sr = (short) ((dqi + sex) & 65535);
+    }
+    sr0 = g726_float1 (((sr & 65535) >> 15), ((sr & 65535) >> 15) ? ((65536 - (sr & 65535)) & 32767) : (sr & 65535));
+    dq0 = g726_float1 (((dq >> 15) & 1), (dq & 32767));
+
+    if (dec) {
+      /* 4.2.8: output PCM format conversion and synchronous coding adjustment */
+      G726_compress (&sr, law, &sp);
+      G726_expand (&sp, law, &slx);
+      dx = g726_subta1 (slx, se);
+      dlx = g726_log1 (dx, &dsx);
+      dlnx = (dlx + 4096 - (y >> 2)) & 4095;
+      G726_sync (rate, &i, &sp, &dlnx, &dsx, law, &sd);
+      out_buf[j] = sd ^ xmask;
+    }
+
+    /* 4.2.6: update of a2 */
+    a11 = a1 & 65535;
+    a21 = a2 & 65535;
+    if ((a1 >> 15) == 0)
+      fa1 = (a11 <= 8191) ? (a11 << 2) : (8191 << 2);
+    else
+      fa1 = (a11 >= 57345) ? ((a11 << 2) & 131071) : (24577 << 2);
+    fa = (pk0 ^ pk1) ? fa1 : ((131072 - fa1) & 131071);
+    uga2b = ((((pk0 ^ pk2) == 0) ? 16384 : 114688) + fa) & 131071;
+    uga2 = (sigpk == 1) ? 0 : ((uga2b >> 16) ? ((uga2b >> 7) + 64512) : (uga2b >> 7));
+    ula2 = ((a2 >> 15) == 0) ? (65536 - (a21 >> 7)) & 65535 : (65536 - ((a21 >> 7) + 65024)) & 65535;
+    a2t = (short) ((a21 + ((uga2 + ula2) & 65535)) & 65535);
+    a21 = a2t & 65535;
+    if (a21 >= 32768 && a21 <= 53248)
+      a2p = (short) 53248;
+    else if (a21 >= 12288 && a21 <= 32767)
+      a2p = 12288;
+    else
+      a2p = a2t;
+
+    /* 4.2.6: update of a1 */
+    uga1 = (sigpk == 1) ? 0 : (((pk0 ^ pk1) == 0) ? 192 : 65344);
+    ula1 = (((a11 >> 15) == 0) ? (65536 - (a11 >> 8)) : (65536 - ((a11 >> 8) + 65280))) & 65535;
+    a1t = (short) ((a11 + ((uga1 + ula1) & 65535)) & 65535);
+    {
+      long a1t1, a1ll, a1ul;
+
+      a1t1 = a1t & 65535;
+      a1ul = (15360 + 65536 - (a2p & 65535)) & 65535;
+      a1ll = ((a2p & 65535) + 65536 - 15360) & 65535;
+      if (a1t1 >= 32768 && a1t1 <= a1ll)
+        a1p = (short) a1ll;
+      else if (a1t1 >= a1ul && a1t1 <= 32767)
+        a1p = (short) a1ul;
+      else
+        a1p = (short) a1t1;
+    }
+
+    /* 4.2.7: tone detector; 4.2.5: speed control */
+    tdp = ((a2p & 65535) >= 32768 && (a2p & 65535) < 53760) ? 1 : 0;
+    dif = (((long) dms << 2) + 32768 - dml) & 32767;
+    difm = ((dif >> 14) == 0) ? dif : ((32768 - dif) & 16383);
+    ax = (y >= 1536 && difm < (dml >> 3) && tdp == 0) ? 0 : 1;
+    dif = ((ax << 9) + 2048 - ap) & 2047;
+    difsx = ((dif >> 10) == 0) ? (dif >> 4) : ((dif >> 4) + 896);
+    app = (difsx + ap) & 1023;
+
+    /* 4.2.6: update of the b's */
+    wb = (dq >> 15) & 1;
+    b[0] = g726_upb1 (wb ^ (dq1 >> 10), b[0], dq, leak, param);
+    b[1] = g726_upb1 (wb ^ (dq2 >> 10), b[1], dq, leak, param);
+    b[2] = g726_upb1 (wb ^ (dq3 >> 10), b[2], dq, leak, param);
+    b[3] = g726_upb1 (wb ^ (dq4 >> 10), b[3], dq, leak, param);
+    b[4] = g726_upb1 (wb ^ (dq5 >> 10), b[4], dq, leak, param);
+    b[5] = g726_upb1 (wb ^ (dq6 >> 10), b[5], dq, leak, param);
+
+    /* Trigger blocks */
+    if (tr == 0) {
+      a2 = a2p;
+      a1 = a1p;
+      td = tdp;
+      ap = app;
+    } else {
+      a2 = a1 = td = 0;
+      ap = 256;
+      for (k = 0; k < 6; k++)
+        b[k] = 0;
+    }
+  }
+
+  /* Save state */
+  state->sr0 = sr0;
+  state->sr1 = sr1;
+  state->a1r = a1;
+  state->a2r = a2;
+  state->dq0 = dq0;
+  state->dq1 = dq1;
+  state->dq2 = dq2;
+  state->dq3 = dq3;
+  state->dq4 = dq4;
+  state->dq5 = dq5;
+  state->b1r = b[0];
+  state->b2r = b[1];
+  state->b3r = b[2];
+  state->b4r = b[3];
+  state->b5r = b[4];
+  state->b6r = b[5];
+  state->dmsp = dms;
+  state->dmlp = dml;
+  state->apr = ap;
+  state->yup = yu;
+  state->ylp = yl;
+  state->tdr = td;
+  state->pk0 = pk0;
+  state->pk1 = pk1;
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+        void G726_encode_fast (short *inp_buf, short *out_buf, long smpno,
+        ~~~~~~~~~~~~~~~~~~~~~  char *law, short rate, short r,
+                               G726_state *state);
+
+        Description:
+        ~~~~~~~~~~~~
+        Same as G726_encode(), with the per-sample blocks fused in one
+        loop on a local copy of the state. Unlike G726_encode(), the
+        A-law input `inp_buf' is not modified.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        Prototype:      in file g726.h
+        ~~~~~~~~~~
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+ ----------------------------------------------------------------------------
+*/
+void G726_encode_fast (short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state) {
+  g726_fused (inp_buf, out_buf, smpno, law, rate, r, state, 0);
+}
+
+/* ...................... end of G726_encode_fast() ...................... */
+
+
+/*
+  ----------------------------------------------------------------------------
+        void G726_decode_fast (short *inp_buf, short *out_buf, long smpno,
+        ~~~~~~~~~~~~~~~~~~~~~  char *law, short rate, short r,
+                               G726_state *state);
+
+        Description:
+        ~~~~~~~~~~~~
+        Same as G726_decode(), with the per-sample blocks fused in one
+        loop on a local copy of the state.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        Prototype:      in file g726.h
+        ~~~~~~~~~~
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+ ----------------------------------------------------------------------------
+*/
+void G726_decode_fast (short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state) {
+  g726_fused (inp_buf, out_buf, smpno, law, rate, r, state, 1);
+}
+
+/* ...................... end of G726_decode_fast() ...................... */
+
+/*
+ *	.......... M U L T I - C H A N N E L   R O U T I N E S ..........
+ */
+
+/* Number of channels advanced together, one per 16-bit SIMD lane */
+#define G726_LANES 8
+
+/*
+  ---------------------------------------------------------------------------
+  State of G726_LANES channels in structure-of-arrays layout: entry [c]
+  of each array belongs to lane c. The blocks that do not depend on the
+  rate or law (predictor, floating point conversions, update of the b's)
+  run on all the lanes with the same instructions; the quantizer, scale
+  factor, a1/a2 update and tone/transition detector run lane by lane
+  with the rate and law of each channel.
+  ---------------------------------------------------------------------------
+*/
+typedef struct {
+  short sr[3][G726_LANES];      /* sr0..sr2, floating point */
+  short dq[7][G726_LANES];      /* dq0..dq6, floating point */
+  short b[6][G726_LANES];
+  short a1[G726_LANES], a2[G726_LANES];
+  short dms[G726_LANES], dml[G726_LANES], ap[G726_LANES];
+  short yu[G726_LANES], td[G726_LANES];
+  short pk0[G726_LANES], pk1[G726_LANES];
+  long yl[G726_LANES];
+  short se[G726_LANES], sez[G726_LANES];        /* estimates of the sample */
+  short dqu[G726_LANES], sru[G726_LANES];       /* dq and sr of the sample */
+  short tr[G726_LANES];
+  short rate[G726_LANES];
+  short leak9[G726_LANES];      /* -1 at 40 kbit/s (leak factor 2^-9) */
+  char law[G726_LANES];
+} g726_lanes;
+
+
+#if defined(G726_SIMD_SSE2)
+#define G726_SEL(m, a, b) _mm_or_si128 (_mm_and_si128 (m, a), _mm_andnot_si128 (m, b))
+#define G726_LOAD(p) _mm_loadu_si128 ((const __m128i *) (p))
+#define G726_STORE(p, x) _mm_storeu_si128 ((__m128i *) (p), x)
+
+/*
+  ---------------------------------------------------------------------------
+  Exponent (number of significant bits) and mantissa of 8 magnitudes
+  below 32768: the magnitude is normalized in 4 conditional shifts.
+  ---------------------------------------------------------------------------
+*/
+static __m128i g726_norm8 (__m128i x, __m128i * mant) {
+  __m128i e = _mm_set1_epi16 (15), m, z;
+
+  m = _mm_cmplt_epi16 (x, _mm_set1_epi16 (1 << 7));
+  x = G726_SEL (m, _mm_slli_epi16 (x, 8), x);
+  e = _mm_sub_epi16 (e, _mm_and_si128 (m, _mm_set1_epi16 (8)));
+  m = _mm_cmplt_epi16 (x, _mm_set1_epi16 (1 << 11));
+  x = G726_SEL (m, _mm_slli_epi16 (x, 4), x);
+  e = _mm_sub_epi16 (e, _mm_and_si128 (m, _mm_set1_epi16 (4)));
+  m = _mm_cmplt_epi16 (x, _mm_set1_epi16 (1 << 13));
+  x = G726_SEL (m, _mm_slli_epi16 (x, 2), x);
+  e = _mm_sub_epi16 (e, _mm_and_si128 (m, _mm_set1_epi16 (2)));
+  m = _mm_cmplt_epi16 (x, _mm_set1_epi16 (1 << 14));
+  x = G726_SEL (m, _mm_slli_epi16 (x, 1), x);
+  e = _mm_sub_epi16 (e, _mm_and_si128 (m, _mm_set1_epi16 (1)));
+
+  z = _mm_cmpeq_epi16 (x, _mm_setzero_si128 ());
+  *mant = G726_SEL (z, _mm_set1_epi16 (1 << 5), _mm_srli_epi16 (x, 9));
+  return _mm_andnot_si128 (z, e);
+}
+
+/* G726_floata/G726_floatb of 8 lanes, from sign (0/1) and magnitude */
+static __m128i g726_float8 (__m128i s, __m128i mag) {
+  __m128i mant, exp_ = g726_norm8 (mag, &mant);
+
+  return _mm_add_epi16 (_mm_add_epi16 (_mm_slli_epi16 (s, 10), _mm_slli_epi16 (exp_, 6)), mant);
+}
+
+/* G726_fmult of 8 lanes */
+static __m128i g726_fmult8 (__m128i an, __m128i srn) {
+  __m128i ans, t, anmag, anexp, anmant, wpos, wanexp, wanmant, w7, rs, x, m;
+
+  ans = _mm_srai_epi16 (an, 15);
+  t = _mm_srli_epi16 (an, 2);
+  anmag = G726_SEL (ans, _mm_and_si128 (_mm_sub_epi16 (_mm_set1_epi16 (16384), t), _mm_set1_epi16 (8191)), t);
+  anexp = g726_norm8 (anmag, &anmant);
+
+  wpos = _mm_cmpeq_epi16 (_mm_srli_epi16 (srn, 10), _mm_srli_epi16 (an, 15));
+  wanexp = _mm_add_epi16 (_mm_and_si128 (_mm_srli_epi16 (srn, 6), _mm_set1_epi16 (15)), anexp);
+  wanmant = _mm_mullo_epi16 (_mm_and_si128 (srn, _mm_set1_epi16 (63)), anmant);
+  wanmant = _mm_srli_epi16 (_mm_add_epi16 (wanmant, _mm_set1_epi16 (48)), 4);
+  w7 = _mm_slli_epi16 (wanmant, 7);
+
+  /* Right shift by 26-wanexp, one bit of the shift count at a time */
+  rs = _mm_sub_epi16 (_mm_set1_epi16 (26), wanexp);
+  x = w7;
+  m = _mm_cmpeq_epi16 (_mm_and_si128 (rs, _mm_set1_epi16 (16)), _mm_set1_epi16 (16));
+  x = _mm_andnot_si128 (m, x);
+  m = _mm_cmpeq_epi16 (_mm_and_si128 (rs, _mm_set1_epi16 (8)), _mm_set1_epi16 (8));
+  x = G726_SEL (m, _mm_srli_epi16 (x, 8), x);
+  m = _mm_cmpeq_epi16 (_mm_and_si128 (rs, _mm_set1_epi16 (4)), _mm_set1_epi16 (4));
+  x = G726_SEL (m, _mm_srli_epi16 (x, 4), x);
+  m = _mm_cmpeq_epi16 (_mm_and_si128 (rs, _mm_set1_epi16 (2)), _mm_set1_epi16 (2));
+  x = G726_SEL (m, _mm_srli_epi16 (x, 2), x);
+  m = _mm_cmpeq_epi16 (_mm_and_si128 (rs, _mm_set1_epi16 (1)), _mm_set1_epi16 (1));
+  x = G726_SEL (m, _mm_srli_epi16 (x, 1), x);
+
+  /* Left shift for wanexp 27 and 28 */
+  m = _mm_cmpeq_epi16 (wanexp, _mm_set1_epi16 (27));
+  x = G726_SEL (m, _mm_and_si128 (_mm_slli_epi16 (w7, 1), _mm_set1_epi16 (32767)), x);
+  m = _mm_cmpeq_epi16 (wanexp, _mm_set1_epi16 (28));
+  x = G726_SEL (m, _mm_and_si128 (_mm_slli_epi16 (w7, 2), _mm_set1_epi16 (32767)), x);
+
+  return G726_SEL (wpos, x, _mm_sub_epi16 (_mm_setzero_si128 (), x));
+}
+#endif
+
+
+/*
+  ---------------------------------------------------------------------------
+  4.2.6: delays and signal estimate of all the lanes.
+  ---------------------------------------------------------------------------
+*/
+static void g726_lanes_predict (g726_lanes * L) {
+  memmove (L->sr[1], L->sr[0], 2 * sizeof (L->sr[0]));
+  memmove (L->dq[1], L->dq[0], 6 * sizeof (L->dq[0]));
+
+#if defined(G726_SIMD_SSE2)
+  {
+    __m128i sezi, sei;
+
+    sezi = g726_fmult8 (G726_LOAD (L->b[0]), G726_LOAD (L->dq[1]));
+    sezi = _mm_add_epi16 (sezi, g726_fmult8 (G726_LOAD (L->b[1]), G726_LOAD (L->dq[2])));
+    sezi = _mm_add_epi16 (sezi, g726_fmult8 (G726_LOAD (L->b[2]), G726_LOAD (L->dq[3])));
+    sezi = _mm_add_epi16 (sezi, g726_fmult8 (G726_LOAD (L->b[3]), G726_LOAD (L->dq[4])));
+    sezi = _mm_add_epi16 (sezi, g726_fmult8 (G726_LOAD (L->b[4]), G726_LOAD (L->dq[5])));
+    sezi = _mm_add_epi16 (sezi, g726_fmult8 (G726_LOAD (L->b[5]), G726_LOAD (L->dq[6])));
+    sei = _mm_add_epi16 (sezi, g726_fmult8 (G726_LOAD (L->a2), G726_LOAD (L->sr[2])));
+    sei = _mm_add_epi16 (sei, g726_fmult8 (G726_LOAD (L->a1), G726_LOAD (L->sr[1])));
+    G726_STORE (L->sez, _mm_srli_epi16 (sezi, 1));
+    G726_STORE (L->se, _mm_srli_epi16 (sei, 1));
+  }
+#else
+  {
+    unsigned long sezi, sei;
+    int c, k;
+
+    for (c = 0; c < G726_LANES; c++) {
+      sezi = 0;
+      for (k = 0; k < 6; k++)
+        sezi += (unsigned short) g726_fmult1 (L->b[k][c], L->dq[k + 1][c]);
+      sezi &= 65535;
+      sei = (sezi + (unsigned short) g726_fmult1 (L->a2[c], L->sr[2][c]) + (unsigned short) g726_fmult1 (L->a1[c], L->sr[1][c])) & 65535;
+      L->sez[c] = (short) (sezi >> 1);
+      L->se[c] = (short) (sei >> 1);
+    }
+  }
+#endif
+}
+
+
+/*
+  ---------------------------------------------------------------------------
+  Blocks of the sample that depend on the rate and law, lane by lane:
+  same arithmetic as g726_fused(). Leaves dq, sr and tr of each lane in
+  dqu[], sru[] and tr[] for g726_lanes_update().
+  ---------------------------------------------------------------------------
+*/
+static void g726_lanes_step (g726_lanes * L, short *inp, short *out, int dec) {
+  short s, sl, d, dl, ds, dln, i, y, al, se, sez, rate;
+  short dqln, dqs, dql, dq, fi, wi, yut, tr, sigpk, sr, tdp, ax, app;
+  short a1, a2, a1t, a1p, a2t, a2p, pk0, pk1, pk2, dms, dml, ap, yu;
+  short sp, slx, dx, dlx, dsx, dlnx, sd, xmask;
+  long yl, dif, difs, difm, difsx, prod, dqmag, dqthr, thr2;
+  long a11, a21, fa, fa1, uga2, uga2b, ula2, ula1, uga1;
+  int c;
+
+  for (c = 0; c < G726_LANES; c++) {
+    rate = L->rate[c];
+    xmask = (L->law[c] == '1') ? 85 : 0;
+    se = L->se[c];
+    sez = L->sez[c];
+    a1 = L->a1[c];
+    a2 = L->a2[c];
+    dms = L->dms[c];
+    dml = L->dml[c];
+    ap = L->ap[c];
+    yu = L->yu[c];
+    yl = L->yl[c];
+
+    /* 4.2.5, 4.2.4: speed control and scale factor (`known-state' parts) */
+    al = (ap >= 256) ? 64 : (ap >> 2);
+    dif = (yu + 16384 - (yl >> 6)) & 16383;
+    difs = (dif >> 13);
+    difm = (difs == 0) ? dif : ((16384 - dif) & 8191);
+    prod = ((difm * al) >> 6);
+    prod = (difs == 0) ? prod : ((16384 - prod) & 16383);
+    y = (short) (((yl >> 6) + prod) & 8191);
+
+    if (dec) {
+      i = inp[c];
+    } else {
+      /* 4.2.1, 4.2.2: difference signal and adaptive quantizer */
+      s = inp[c] ^ xmask;
+      G726_expand (&s, &L->law[c], &sl);
+      d = g726_subta1 (sl, se);
+      dl = g726_log1 (d, &ds);
+      dln = (dl + 4096 - (y >> 2)) & 4095;
+      G726_quan (rate, &dln, &ds, &i);
+      out[c] = i;
+    }
+
+    /* 4.2.3: inverse adaptive quantizer */
+    dqs = (i >> (rate - 1));
+    dqln = g726_dqln_tab[rate - 2][i];
+    dql = (dqln + (y >> 2)) & 4095;
+    {
+      long dex, dqt;
+
+      dex = (dql >> 7) & 15;
+      dqt = (dql & 127) + 128;
+      dqmag = (dql >> 11) ? 0 : ((dqt << 7) >> (14 - dex));
+      dq = (short) (dqs << 15) + dqmag;
+    }
+
+    /* 4.2.5: short and long term averages of F(I) */
+    fi = g726_fi_tab[rate - 2][i];
+    dif = ((fi << 9) + 8192 - dms) & 8191;
+    difsx = ((dif >> 12) == 0) ? (dif >> 5) : ((dif >> 5) + 3840);
+    dms = (difsx + dms) & 4095;
+    dif = ((fi << 11) + 32768 - dml) & 32767;
+    difsx = ((dif >> 14) == 0) ? (dif >> 7) : ((dif >> 7) + 16128);
+    dml = (short) ((difsx + dml) & 16383);
+
+    /* 4.2.4: quantizer scale factor adaptation */
+    wi = g726_wi_tab[rate - 2][i];
+    dif = (((long) wi << 5) + 131072 - y) & 131071;
+    difsx = ((dif >> 16) == 0) ? (dif >> 5) : ((dif >> 5) + 4096);
+    yut = (short) ((y + difsx) & 8191);
+    if ((((yut + 15840) & 16383) >> 13) == 1)
+      yu = 544;
+    else if ((((yut + 11264) & 16383) >> 13) == 0)
+      yu = 5120;
+    else
+      yu = yut;
+
+    /* 4.2.7: transition detector, with the previous yl */
+    dqmag = dq & 32767;
+    thr2 = ((yl >> 15) > 9) ? 31744 : ((((yl >> 10) & 31) + 32) << (yl >> 15));
+    dqthr = (thr2 + (thr2 >> 1)) >> 1;
+    tr = (dqmag > dqthr && L->td[c] == 1) ? 1 : 0;
+
+    dif = (yu + ((1048576 - yl) >> 6)) & 16383;
+    difsx = ((dif >> 13) == 0) ? dif : (dif + 507904);
+    yl = (yl + difsx) & 524287;
+
+    /* 4.2.6: signs and reconstructed signal */
+    pk2 = L->pk1[c];
+    pk1 = L->pk0[c];
+    {
+      unsigned long dqi, sezx, sex, dqsez;
+
+      dqi = ((dq >> 15) & 1) == 0 ? (unsigned long) (dq & 65535) : ((65536 - (dq & 32767)) & 65535);
+      sezx = ((sez >> 14) == 0) ? (unsigned long) sez : (unsigned long) (sez + 32768);
+      dqsez = (dqi + sezx) & 65535;
+      pk0 = (short) (dqsez >> 15);
+      sigpk = (dqsez == 0) ? 1 : 0;
+      sex = ((se >> 14) == 0) ? (unsigned long) se : (unsigned long) ((1 << 15) + se);
+      sr = (short) ((dqi + sex) & 65535);
+    }
+
+    if (dec) {
+      /* 4.2.8: output PCM format conversion and synchronous coding adjustment */
+      G726_compress (&sr, &L->law[c], &sp);
+      G726_expand (&sp, &L->law[c], &slx);
+      dx = g726_subta1 (slx, se);
+      dlx = g726_log1 (dx, &dsx);
+      dlnx = (dlx + 4096 - (y >> 2)) & 4095;
+      G726_sync (rate, &i, &sp, &dlnx, &dsx, &L->law[c], &sd);
+      out[c] = sd ^ xmask;
+    }
+
+    /* 4.2.6: update of a2 */
+    a11 = a1 & 65535;
+    a21 = a2 & 65535;
+    if ((a1 >> 15) == 0)
+      fa1 = (a11 <= 8191) ? (a11 << 2) : (8191 << 2);
+    else
+      fa1 = (a11 >= 57345) ? ((a11 << 2) & 131071) : (24577 << 2);
+    fa = (pk0 ^ pk1) ? fa1 : ((131072 - fa1) & 131071);
+    uga2b = ((((pk0 ^ pk2) == 0) ? 16384 : 114688) + fa) & 131071;
+    uga2 = (sigpk == 1) ? 0 : ((uga2b >> 16) ? ((uga2b >> 7) + 64512) : (uga2b >> 7));
+    ula2 = ((a2 >> 15) == 0) ? (65536 - (a21 >> 7)) & 65535 : (65536 - ((a21 >> 7) + 65024)) & 65535;
+    a2t = (short) ((a21 + ((uga2 + ula2) & 65535)) & 65535);
+    a21 = a2t & 65535;
+    if (a21 >= 32768 && a21 <= 53248)
+      a2p = (short) 53248;
+    else if (a21 >= 12288 && a21 <= 32767)
+      a2p = 12288;
+    else
+      a2p = a2t;
+
+    /* 4.2.6: update of a1 */
+    uga1 = (sigpk == 1) ? 0 : (((pk0 ^ pk1) == 0) ? 192 : 65344);
+    ula1 = (((a11 >> 15) == 0) ? (65536 - (a11 >> 8)) : (65536 - ((a11 >> 8) + 65280))) & 65535;
+    a1t = (short) ((a11 + ((uga1 + ula1) & 65535)) & 65535);
+    {
+      long a1t1, a1ll, a1ul;
+
+      a1t1 = a1t & 65535;
+      a1ul = (15360 + 65536 - (a2p & 65535)) & 65535;
+      a1ll = ((a2p & 65535) + 65536 - 15360) & 65535;
+      if (a1t1 >= 32768 && a1t1 <= a1ll)
+        a1p = (short) a1ll;
+      else if (a1t1 >= a1ul && a1t1 <= 32767)
+        a1p = (short) a1ul;
+      else
+        a1p = (short) a1t1;
+    }
+
+    /* 4.2.7: tone detector; 4.2.5: speed control */
+    tdp = ((a2p & 65535) >= 32768 && (a2p & 65535) < 53760) ? 1 : 0;
+    dif = (((long) dms << 2) + 32768 - dml) & 32767;
+    difm = ((dif >> 14) == 0) ? dif : ((32768 - dif) & 16383);
+    ax = (y >= 1536 && difm < (dml >> 3) && tdp == 0) ? 0 : 1;
+    dif = ((ax << 9) + 2048 - ap) & 2047;
+    difsx = ((dif >> 10) == 0) ? (dif >> 4) : ((dif >> 4) + 896);
+    app = (difsx + ap) & 1023;
+
+    /* Trigger blocks; the b's are triggered by g726_lanes_update() */
+    if (tr == 0) {
+      L->a2[c] = a2p;
+      L->a1[c] = a1p;
+      L->td[c] = tdp;
+      L->ap[c] = app;
+    } else {
+      L->a2[c] = L->a1[c] = L->td[c] = 0;
+      L->ap[c] = 256;
+    }
+
+    L->dms[c] = dms;
+    L->dml[c] = dml;
+    L->yu[c] = yu;
+    L->yl[c] = yl;
+    L->pk1[c] = pk1;
+    L->pk0[c] = pk0;
+    L->dqu[c] = dq;
+    L->sru[c] = sr;
+    L->tr[c] = tr;
+  }
+}
+
+
+/*
+  ---------------------------------------------------------------------------
+  4.2.6: floating point conversions and update of the b's of all the
+  lanes, with the trigger of the transition detector.
+  ---------------------------------------------------------------------------
+*/
+static void g726_lanes_update (g726_lanes * L) {
+#if defined(G726_SIMD_SSE2)
+  __m128i dq, sr, s, mag, wb, zero, trm, leak9, ugb, b, bp, umask;
+  int k;
+
+  zero = _mm_setzero_si128 ();
+  dq = G726_LOAD (L->dqu);
+  sr = G726_LOAD (L->sru);
+
+  s = _mm_srli_epi16 (sr, 15);
+  mag = G726_SEL (_mm_srai_epi16 (sr, 15), _mm_and_si128 (_mm_sub_epi16 (zero, sr), _mm_set1_epi16 (32767)), sr);
+  G726_STORE (L->sr[0], g726_float8 (s, mag));
+  wb = _mm_srli_epi16 (dq, 15);
+  mag = _mm_and_si128 (dq, _mm_set1_epi16 (32767));
+  G726_STORE (L->dq[0], g726_float8 (wb, mag));
+
+  /* G726_upb: bb + ugb - (bb >> leak), with the sign of bb extended */
+  trm = _mm_cmpgt_epi16 (G726_LOAD (L->tr), zero);
+  leak9 = G726_LOAD (L->leak9);
+  for (k = 0; k < 6; k++) {
+    b = G726_LOAD (L->b[k]);
+    umask = _mm_cmpeq_epi16 (_mm_xor_si128 (wb, _mm_srai_epi16 (G726_LOAD (L->dq[k + 1]), 10)), zero);
+    ugb = _mm_andnot_si128 (_mm_cmpeq_epi16 (mag, zero), G726_SEL (umask, _mm_set1_epi16 (128), _mm_set1_epi16 (-128)));
+    bp = _mm_sub_epi16 (b, G726_SEL (leak9, _mm_srai_epi16 (b, 9), _mm_srai_epi16 (b, 8)));
+    bp = _mm_add_epi16 (bp, ugb);
+    G726_STORE (L->b[k], _mm_andnot_si128 (trm, bp));
+  }
+#else
+  short dq, sr, wb, leak, param;
+  int c, k;
+
+  for (c = 0; c < G726_LANES; c++) {
+    dq = L->dqu[c];
+    sr = L->sru[c];
+    L->sr[0][c] = g726_float1 (((sr & 65535) >> 15), ((sr & 65535) >> 15) ? ((65536 - (sr & 65535)) & 32767) : (sr & 65535));
+    L->dq[0][c] = g726_float1 (((dq >> 15) & 1), (dq & 32767));
+
+    wb = (dq >> 15) & 1;
+    leak = L->leak9[c] ? 9 : 8;
+    param = L->leak9[c] ? (short) 65408 : (short) 65280;
+    for (k = 0; k < 6; k++)
+      L->b[k][c] = L->tr[c] ? 0 : g726_upb1 (wb ^ (L->dq[k + 1][c] >> 10), L->b[k][c], dq, leak, param);
+  }
+#endif
+}
+
+
+/*
+  ---------------------------------------------------------------------------
+  Loads nl channels into the lanes (with the reset values if r==1), and
+  sets the unused lanes to a reset 32 kbit/s u-law channel.
+  ---------------------------------------------------------------------------
+*/
+static void g726_lanes_load (g726_lanes * L, long nl, char *law, short *rate, short r, G726_state * state) {
+  int c, k;
+
+  for (c = 0; c < G726_LANES; c++) {
+    L->rate[c] = (c < nl) ? rate[c] : 4;
+    L->law[c] = (c < nl) ? law[c] : '0';
+    L->leak9[c] = (L->rate[c] == 5) ? -1 : 0;
+    L->pk0[c] = L->pk1[c] = 0;
+    L->tr[c] = 0;
+
+    if (r || c >= nl) {
+      L->sr[0][c] = L->sr[1][c] = L->sr[2][c] = 32;
+      L->a1[c] = L->a2[c] = 0;
+      for (k = 0; k < 7; k++)
+        L->dq[k][c] = 32;
+      for (k = 0; k < 6; k++)
+        L->b[k][c] = 0;
+      L->dms[c] = L->dml[c] = L->ap[c] = 0;
+      L->yu[c] = 544;
+      L->yl[c] = 34816;
+      L->td[c] = 0;
+    } else {
+      L->sr[0][c] = state[c].sr0;
+      L->sr[1][c] = state[c].sr1;
+      L->a1[c] = state[c].a1r;
+      L->a2[c] = state[c].a2r;
+      L->dq[0][c] = state[c].dq0;
+      L->dq[1][c] = state[c].dq1;
+      L->dq[2][c] = state[c].dq2;
+      L->dq[3][c] = state[c].dq3;
+      L->dq[4][c] = state[c].dq4;
+      L->dq[5][c] = state[c].dq5;
+      L->b[0][c] = state[c].b1r;
+      L->b[1][c] = state[c].b2r;
+      L->b[2][c] = state[c].b3r;
+      L->b[3][c] = state[c].b4r;
+      L->b[4][c] = state[c].b5r;
+      L->b[5][c] = state[c].b6r;
+      L->dms[c] = state[c].dmsp;
+      L->dml[c] = state[c].dmlp;
+      L->ap[c] = state[c].apr;
+      L->yu[c] = state[c].yup;
+      L->yl[c] = state[c].ylp;
+      L->td[c] = state[c].tdr;
+      L->pk0[c] = state[c].pk0;
+      L->pk1[c] = state[c].pk1;
+    }
+  }
+}
+
+/* Saves the lanes of nl channels */
+static void g726_lanes_save (g726_lanes * L, long nl, G726_state * state) {
+  int c;
+
+  for (c = 0; c < nl; c++) {
+    state[c].sr0 = L->sr[0][c];
+    state[c].sr1 = L->sr[1][c];
+    state[c].a1r = L->a1[c];
+    state[c].a2r = L->a2[c];
+    state[c].dq0 = L->dq[0][c];
+    state[c].dq1 = L->dq[1][c];
+    state[c].dq2 = L->dq[2][c];
+    state[c].dq3 = L->dq[3][c];
+    state[c].dq4 = L->dq[4][c];
+    state[c].dq5 = L->dq[5][c];
+    state[c].b1r = L->b[0][c];
+    state[c].b2r = L->b[1][c];
+    state[c].b3r = L->b[2][c];
+    state[c].b4r = L->b[3][c];
+    state[c].b5r = L->b[4][c];
+    state[c].b6r = L->b[5][c];
+    state[c].dmsp = L->dms[c];
+    state[c].dmlp = L->dml[c];
+    state[c].apr = L->ap[c];
+    state[c].yup = L->yu[c];
+    state[c].ylp = L->yl[c];
+    state[c].tdr = L->td[c];
+    state[c].pk0 = L->pk0[c];
+    state[c].pk1 = L->pk1[c];
+  }
+}
+
+
+/*
+  ---------------------------------------------------------------------------
+  Multi-channel encoder (dec==0) or decoder (dec!=0): the channels are
+  processed in groups of G726_LANES, all the samples of a group at once.
+  ---------------------------------------------------------------------------
+*/
+static void g726_multi (long nch, short **inp_buf, short **out_buf, long smpno, char *law, short *rate, short r, G726_state * state, int dec) {
+  g726_lanes L;
+  short inp[G726_LANES], out[G726_LANES];
+  long c0, nl, j;
+  int c;
+
+  if (smpno <= 0)
+    return;
+
+  for (c0 = 0; c0 < nch; c0 += G726_LANES) {
+    nl = (nch - c0 < G726_LANES) ? nch - c0 : G726_LANES;
+    g726_lanes_load (&L, nl, law + c0, rate + c0, r, state + c0);
+
+    for (c = 0; c < G726_LANES; c++)
+      inp[c] = 0;
+    for (j = 0; j < smpno; j++) {
+      for (c = 0; c < nl; c++)
+        inp[c] = inp_buf[c0 + c][j];
+      g726_lanes_predict (&L);
+      g726_lanes_step (&L, inp, out, dec);
+      g726_lanes_update (&L);
+      for (c = 0; c < nl; c++)
+        out_buf[c0 + c][j] = out[c];
+    }
+
+    g726_lanes_save (&L, nl, state + c0);
+  }
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+        void G726_encode_multi (long nch, short **inp_buf, short **out_buf,
+        ~~~~~~~~~~~~~~~~~~~~~~  long smpno, char *law, short *rate,
+                                short r, G726_state *state);
+
+        Description:
+        ~~~~~~~~~~~~
+        Encodes `smpno' samples of each of `nch' channels. Channel c
+        reads inp_buf[c], writes out_buf[c], and uses the law law[c]
+        ('1' for A, '0' for mu law), the rate rate[c] (2..5) and the
+        state state[c]; the reset r applies to all the channels. The
+        output of each channel is the same as G726_encode() with these
+        arguments, but the input buffers are not modified. The channels
+        are advanced G726_LANES at a time, one per SIMD lane.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        Prototype:      in file g726.h
+        ~~~~~~~~~~
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+ ----------------------------------------------------------------------------
+*/
+void G726_encode_multi (long nch, short **inp_buf, short **out_buf, long smpno, char *law, short *rate, short r, G726_state * state) {
+  g726_multi (nch, inp_buf, out_buf, smpno, law, rate, r, state, 0);
+}
+
+/* ...................... end of G726_encode_multi() ...................... */
+
+
+/*
+  ----------------------------------------------------------------------------
+        void G726_decode_multi (long nch, short **inp_buf, short **out_buf,
+        ~~~~~~~~~~~~~~~~~~~~~~  long smpno, char *law, short *rate,
+                                short r, G726_state *state);
+
+        Description:
+        ~~~~~~~~~~~~
+        Decodes `smpno' samples of each of `nch' channels, with the law,
+        rate and state of each channel as in G726_encode_multi(). The
+        output of each channel is the same as G726_decode().
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        Prototype:      in file g726.h
+        ~~~~~~~~~~
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+ ----------------------------------------------------------------------------
+*/
+void G726_decode_multi (long nch, short **inp_buf, short **out_buf, long smpno, char *law, short *rate, short r, G726_state * state) {
+  g726_multi (nch, inp_buf, out_buf, smpno, law, rate, r, state, 1);
+}
+
+/* ...................... end of G726_decode_multi() ...................... */
+
+
 /* ************************* END OF G726.C ************************* */
@@ -10,6 +10,8 @@
    History:
    28.Feb.92	v1.0	First version <simao@cpqd.br>
    06.May.94    v2.0    Smart prototypes that work with many compilers <simao>
+   16.Oct.26    v2.1    Added G726_encode_fast() and G726_decode_fast()
+   16.Oct.26    v2.2    Added G726_encode_multi() and G726_decode_multi()
   ============================================================================
 */
 #ifndef G726_defined
@@ -53,6 +55,10 @@ typedef struct {
 /* Function prototypes */
 void G726_encode ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state));
 void G726_decode ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state));
+void G726_encode_fast ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state));
+void G726_decode_fast ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state));
+void G726_encode_multi ARGS ((long nch, short **inp_buf, short **out_buf, long smpno, char *law, short *rate, short r, G726_state * state));
+void G726_decode_multi ARGS ((long nch, short **inp_buf, short **out_buf, long smpno, char *law, short *rate, short r, G726_state * state));
 void G726_expand ARGS ((short *s, char *law, short *sl));
 void G726_subta ARGS ((short *sl, short *se, short *d));
 void G726_log ARGS ((short *d, short *dl, short *ds));
@@ -1,4 +1,4 @@
-/*                                                           03.Feb.2010 v1.4
+/*                                                           16.Oct.2026 v1.5
   ============================================================================
 
   G726DEMO.C
@@ -53,6 +53,10 @@
 	      (reset ON).
   Options:
   -noreset    don't apply reset to the encoder/decoder
+  -ref        use the reference (per-block function) G.726 routines
+  -nch N      process a file of N interleaved channels, all with the
+              given law and rate, using G726_encode_multi() and
+              G726_decode_multi(); BlockSize is per channel
   -?/-help    print help message
 
 
@@ -98,6 +102,10 @@
   03/Feb/2010 v1.4 Modified maximum string length, removed implicit
                    casting of toupper(), and type of "rate" is int
                    (y.hiwasaki)
+  16/Oct/2026 v1.5 Use the fused (fast) G.726 routines by default;
+                   added option -ref to use the original ones.
+  16/Oct/2026 v1.6 Added option -nch for multi-channel files, using
+                   G726_encode_multi()/G726_decode_multi()
 ============================================================================
 */
 
@@ -134,7 +142,7 @@
  -------------------------------------------------------------------------
 */
 void display_usage () {
-  printf ("G726DEMO - Version 1.4 of 03.Feb.2010 \n\n");
+  printf ("G726DEMO - Version 1.6 of 16.Oct.2026 \n\n");
 
   printf ("> Description:\n");
   printf ("   Demonstration program for UGST/ITU-T G.726 module. Takes the\n");
@@ -183,6 +191,9 @@ void display_usage () {
   printf ("             unknown state. It defaults to 1 (reset ON). \n");
   printf (" Options: \n");
   printf (" -noreset    don't apply reset to the encoder/decoder\n");
+  printf (" -ref        use the reference G.726 routines (slower)\n");
+  printf (" -nch N      process a file of N interleaved channels, all with\n");
+  printf ("             the given law and rate; BlockSize is per channel\n");
   printf (" -? or -help print this help message\n\n");
 
   /* Quit program */
@@ -192,6 +203,106 @@ void display_usage () {
 /* .................... End of display_usage() ........................... */
 
 
+/*
+ -------------------------------------------------------------------------
+ void process_multi(...);
+ ~~~~~~~~~~~~~~~~~~~~~~~~
+ Carry out the operation on N2 blocks of N samples per channel of a file
+ of nch interleaved channels. Each channel has its own encoder and
+ decoder state; the channels are processed together by the
+ multi-channel G.726 routines.
+
+ History:
+ ~~~~~~~~
+ 16.Oct.26 v1.0 Created.
+ -------------------------------------------------------------------------
+*/
+void process_multi (FILE * Fi, FILE * Fo, char *FileOut, long nch, long N, long N2, char *law, short rate, short reset, short inp_type, short out_type, char quiet) {
+  G726_state *encoder_state, *decoder_state;
+  short *inp_buf, *out_buf;     /* Interleaved input and output buffers */
+  short **chn_in, **chn_tmp, **chn_out;
+  short *rates;
+  char *laws;
+  long cur_blk, smpno, c, i;
+  static char funny[9] = "|/-\\|/-\\";
+
+  /* Allocate states and per-channel buffers */
+  encoder_state = (G726_state *) calloc (nch, sizeof (G726_state));
+  decoder_state = (G726_state *) calloc (nch, sizeof (G726_state));
+  inp_buf = (short *) calloc (N * nch, sizeof (short));
+  out_buf = (short *) calloc (N * nch, sizeof (short));
+  chn_in = (short **) calloc (nch, sizeof (short *));
+  chn_tmp = (short **) calloc (nch, sizeof (short *));
+  chn_out = (short **) calloc (nch, sizeof (short *));
+  rates = (short *) calloc (nch, sizeof (short));
+  laws = (char *) calloc (nch, sizeof (char));
+  if (encoder_state == NULL || decoder_state == NULL || inp_buf == NULL || out_buf == NULL || chn_in == NULL || chn_tmp == NULL || chn_out == NULL || rates == NULL || laws == NULL)
+    error_terminate ("Error in memory allocation!\n", 1);
+  for (c = 0; c < nch; c++) {
+    chn_in[c] = (short *) calloc (N, sizeof (short));
+    chn_tmp[c] = (short *) calloc (N, sizeof (short));
+    chn_out[c] = (short *) calloc (N, sizeof (short));
+    if (chn_in[c] == NULL || chn_tmp[c] == NULL || chn_out[c] == NULL)
+      error_terminate ("Error in memory allocation!\n", 1);
+    rates[c] = rate;
+    laws[c] = law[0];
+  }
+
+  for (cur_blk = 0; cur_blk < N2; cur_blk++) {
+    /* Print progress flag */
+    if (!quiet)
+      fprintf (stderr, "%c\r", funny[cur_blk % 8]);
+
+    /* Read a block of samples of all the channels */
+    if ((smpno = fread (inp_buf, sizeof (short), N * nch, Fi) / nch) <= 0)
+      break;
+
+    /* De-interleave */
+    for (c = 0; c < nch; c++)
+      for (i = 0; i < smpno; i++)
+        chn_in[c][i] = inp_buf[i * nch + c];
+
+    /* Check if reset is needed */
+    reset = (reset == 1 && cur_blk == 0) ? 1 : 0;
+
+    /* Carry out the desired operation */
+    if (inp_type == IS_LOG && out_type == IS_ADPCM) {
+      G726_encode_multi (nch, chn_in, chn_out, smpno, laws, rates, reset, encoder_state);
+    } else if (inp_type == IS_ADPCM && out_type == IS_LOG) {
+      G726_decode_multi (nch, chn_in, chn_out, smpno, laws, rates, reset, decoder_state);
+    } else if (inp_type == IS_LOG && out_type == IS_LOG) {
+      G726_encode_multi (nch, chn_in, chn_tmp, smpno, laws, rates, reset, encoder_state);
+      G726_decode_multi (nch, chn_tmp, chn_out, smpno, laws, rates, reset, decoder_state);
+    }
+
+    /* Interleave and write output words */
+    for (c = 0; c < nch; c++)
+      for (i = 0; i < smpno; i++)
+        out_buf[i * nch + c] = chn_out[c][i];
+    if (fwrite (out_buf, sizeof (short), smpno * nch, Fo) != (size_t) (smpno * nch))
+      KILL (FileOut, 6);
+  }
+
+  /* Free memory */
+  for (c = 0; c < nch; c++) {
+    free (chn_in[c]);
+    free (chn_tmp[c]);
+    free (chn_out[c]);
+  }
+  free (chn_in);
+  free (chn_tmp);
+  free (chn_out);
+  free (rates);
+  free (laws);
+  free (inp_buf);
+  free (out_buf);
+  free (encoder_state);
+  free (decoder_state);
+}
+
+/* .................... End of process_multi() ........................... */
+
+
 /*
    **************************************************************************
    ***                                                                    ***
@@ -202,10 +313,12 @@ void display_usage () {
 */
 int main (int argc, char *argv[]) {
   G726_state encoder_state, decoder_state;
-  long N = 256, N1 = 1, N2 = 0, cur_blk, smpno;
+  long N = 256, N1 = 1, N2 = 0, cur_blk, smpno, nch = 0;
   short *tmp_buf, *inp_buf, *out_buf, reset = 1;
   short inp_type, out_type;
   int rate;
+  void (*enc) ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state)) = G726_encode_fast;
+  void (*dec) ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state)) = G726_decode_fast;
 
   /* Progress indication */
   static char quiet = 0, funny[9] = "|/-\\|/-\\";
@@ -236,6 +349,23 @@ int main (int argc, char *argv[]) {
         /* Update argc/argv to next valid option/argument */
         argv++;
         argc--;
+      } else if (strcmp (argv[1], "-ref") == 0) {
+        /* Use the reference G.726 routines */
+        enc = G726_encode;
+        dec = G726_decode;
+
+        /* Move argv over the option to the next argument */
+        argv++;
+        argc--;
+      } else if (strcmp (argv[1], "-nch") == 0) {
+        /* Number of interleaved channels */
+        nch = atol (argv[2]);
+        if (nch < 1)
+          error_terminate ("Invalid number of channels! Aborted...\n", 10);
+
+        /* Move argv over the option to the next argument */
+        argv += 2;
+        argc -= 2;
       } else if (strcmp (argv[1], "-q") == 0) {
         /* Don't print progress indicator */
         quiet = 1;
@@ -264,7 +394,7 @@ int main (int argc, char *argv[]) {
   FIND_PAR_I (9, "_Reset (YES=1, NO=0): ......... ", reset, 1);
 
   /* Find starting byte in file */
-  start_byte = sizeof (short) * (long) (--N1) * (long) N;
+  start_byte = sizeof (short) * (long) (--N1) * (long) N * (nch > 0 ? nch : 1);
 
   /* Check if is to process the whole file */
   if (N2 == 0) {
@@ -272,7 +402,7 @@ int main (int argc, char *argv[]) {
 
     /* ... find the input file size ... */
     stat (FileIn, &st);
-    N2 = ceil ((st.st_size - start_byte) / (double) (N * sizeof (short)));
+    N2 = ceil ((st.st_size - start_byte) / (double) (N * sizeof (short) * (nch > 0 ? nch : 1)));
   }
 
   /* Classification of the conversion desired */
@@ -338,33 +468,36 @@ int main (int argc, char *argv[]) {
  * ......... PROCESSING ACCORDING TO ITU-T G.726 .........
  */
 
-  for (cur_blk = 0; cur_blk < N2; cur_blk++) {
-    /* Print progress flag */
-    if (!quiet)
-      fprintf (stderr, "%c\r", funny[cur_blk % 8]);
-
-    /* Read a block of samples */
-    if ((smpno = fread (inp_buf, sizeof (short), N, Fi)) < 0)
-      KILL (FileIn, 5);
-
-    /* Check if reset is needed */
-    reset = (reset == 1 && cur_blk == 0) ? 1 : 0;
+  if (nch > 0)
+    process_multi (Fi, Fo, FileOut, nch, N, N2, law, (short) rate, reset, inp_type, out_type, quiet);
+  else
+    for (cur_blk = 0; cur_blk < N2; cur_blk++) {
+      /* Print progress flag */
+      if (!quiet)
+        fprintf (stderr, "%c\r", funny[cur_blk % 8]);
+
+      /* Read a block of samples */
+      if ((smpno = fread (inp_buf, sizeof (short), N, Fi)) < 0)
+        KILL (FileIn, 5);
+
+      /* Check if reset is needed */
+      reset = (reset == 1 && cur_blk == 0) ? 1 : 0;
+
+      /* Carry out the desired operation */
+      if (inp_type == IS_LOG && out_type == IS_ADPCM) {
+        enc (inp_buf, out_buf, smpno, law, (short) rate, reset, &encoder_state);
+      } else if (inp_type == IS_ADPCM && out_type == IS_LOG) {
+        dec (inp_buf, out_buf, smpno, law, (short) rate, reset, &decoder_state);
+      } else if (inp_type == IS_LOG && out_type == IS_LOG) {
+        enc (inp_buf, tmp_buf, smpno, law, (short) rate, reset, &encoder_state);
+        dec (tmp_buf, out_buf, smpno, law, (short) rate, reset, &decoder_state);
+      }
 
-    /* Carry out the desired operation */
-    if (inp_type == IS_LOG && out_type == IS_ADPCM) {
-      G726_encode (inp_buf, out_buf, smpno, law, (short) rate, reset, &encoder_state);
-    } else if (inp_type == IS_ADPCM && out_type == IS_LOG) {
-      G726_decode (inp_buf, out_buf, smpno, law, (short) rate, reset, &decoder_state);
-    } else if (inp_type == IS_LOG && out_type == IS_LOG) {
-      G726_encode (inp_buf, tmp_buf, smpno, law, (short) rate, reset, &encoder_state);
-      G726_decode (tmp_buf, out_buf, smpno, law, (short) rate, reset, &decoder_state);
+      /* Write ADPCM output word */
+      if ((smpno = fwrite (out_buf, sizeof (short), smpno, Fo)) < 0)
+        KILL (FileOut, 6);
     }
 
-    /* Write ADPCM output word */
-    if ((smpno = fwrite (out_buf, sizeof (short), smpno, Fo)) < 0)
-      KILL (FileOut, 6);
-  }
-
 /*
  * ......... FINALIZATIONS .........
  */
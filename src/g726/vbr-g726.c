@@ -1,4 +1,4 @@
-/*                                                           03.Feb.2010 v1.4
+/*                                                           16.Oct.2026 v1.5
   ============================================================================
 
   VBR-G726.C
@@ -59,6 +59,7 @@
   -dec        run only the G.726 decoder on the samples
               [default: run encoder and decoder]
   -noreset    don't apply reset to the encoder/decoder
+  -ref        use the reference (per-block function) G.726 routines
   -?/-help    print help message
 
   Example:
@@ -116,6 +117,8 @@
                     when the block size is not a multiple of the file
                     size. <simao.campos@labs.comsat.com>
   02.Feb.2010 v1.4  Modified maximum string length (y.hiwasaki)
+  16.Oct.2026 v1.5  Use the fused (fast) G.726 routines by default;
+                    added option -ref to use the original ones.
   ============================================================================
 */
 
@@ -223,7 +226,7 @@ int parse_rate (char *str, short **rate) {
  -------------------------------------------------------------------------
 */
 void display_usage () {
-  printf ("Version 1.3 of 21/Mar/2000 \n\n");
+  printf ("Version 1.5 of 16/Oct/2026 \n\n");
 
   printf ("  VBR-G726.C \n");
   printf ("  Demonstration program for UGST/ITU-T G.726 module using the variable\n");
@@ -272,6 +275,7 @@ void display_usage () {
   printf ("  -dec        run only the G.726 decoder on the samples \n");
   printf ("              [default: run encoder and decoder]\n");
   printf ("  -noreset    don't apply reset to the encoder/decoder\n");
+  printf ("  -ref        use the reference G.726 routines (slower)\n");
   printf ("  -?/-help    print help message\n\n");
 
   /* Quit program */
@@ -296,6 +300,8 @@ int main (int argc, char *argv[]) {
   short inp_type, out_type, *rate = 0;
   char encode = 1, decode = 1, law[4] = "A", def_rate[] = "32";
   int rateno = 1, rate_idx;
+  void (*enc) ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state)) = G726_encode_fast;
+  void (*dec) ARGS ((short *inp_buf, short *out_buf, long smpno, char *law, short rate, short r, G726_state * state)) = G726_decode_fast;
 
   /* General-purpose, progress indication */
   static char quiet = 0, funny[9] = "|/-\\|/-\\";
@@ -378,6 +384,14 @@ int main (int argc, char *argv[]) {
         /* Move argv over the option to the next argument */
         argv += 2;
         argc -= 2;
+      } else if (strcmp (argv[1], "-ref") == 0) {
+        /* Use the reference G.726 routines */
+        enc = G726_encode;
+        dec = G726_decode;
+
+        /* Move argv over the option to the next argument */
+        argv++;
+        argc--;
       } else if (strcmp (argv[1], "-q") == 0) {
         /* Don't print progress indicator */
         quiet = 1;
@@ -503,12 +517,12 @@ int main (int argc, char *argv[]) {
 
     /* Carry out the desired operation */
     if (encode && !decode)
-      G726_encode (inp_buf, out_buf, smpno, law, rate[rate_idx], reset, &encoder_state);
+      enc (inp_buf, out_buf, smpno, law, rate[rate_idx], reset, &encoder_state);
     else if (decode && !encode)
-      G726_decode (inp_buf, out_buf, smpno, law, rate[rate_idx], reset, &decoder_state);
+      dec (inp_buf, out_buf, smpno, law, rate[rate_idx], reset, &decoder_state);
     else if (encode && decode) {
-      G726_encode (inp_buf, tmp_buf, smpno, law, rate[rate_idx], reset, &encoder_state);
-      G726_decode (tmp_buf, out_buf, smpno, law, rate[rate_idx], reset, &decoder_state);
+      enc (inp_buf, tmp_buf, smpno, law, rate[rate_idx], reset, &encoder_state);
+      dec (tmp_buf, out_buf, smpno, law, rate[rate_idx], reset, &decoder_state);
     }
 
     /* Expand linear input samples */
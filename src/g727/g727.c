@@ -1,4 +1,4 @@
-/*                                                          19.May.2000 v1.02
+/*                                                          16.Oct.2026 v1.03
 =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -44,6 +44,9 @@ FUNCTIONS:
   G727_reset ...... G727 reset function;
   G727_encode ..... G727 encoder function;
   G727_decode ..... G727 decoder function;
+  g727_encode_block_multi, g727_decode_block_multi: G727 encoder and
+                    decoder for many channels, one channel per SIMD lane,
+                    each with its own law and bit allocation;
 
 HISTORY:
   01.Apr.1995  0.98  Version of the G727 module in C++ code
@@ -52,12 +55,21 @@ HISTORY:
   04.Aug.1997  1.01  Eliminated compilation warning about unused variables
                      as per revision from <Morgan.Lindqvist@era-t.ericsson.se>
   19.May.2000  v1.02 Corrected self-documentation of functions. <simao>
+  16.Oct.2026  v1.03 Added g727_encode_block_multi() and
+                     g727_decode_block_multi()
 =============================================================================
 */
 
 #include <assert.h>
+#include <string.h>
 #include "g727.h"
 
+/* SIMD kernels of the multi-channel routines */
+#if defined(__SSE2__) || defined(_M_X64)
+#define G727_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
 /* Local function prototypes */
 Int16 g727_get_d ARGS ((Int8 s, Int16 se, short law));
 Int16 g727_expand ARGS ((Int8 sp, short law));
@@ -515,6 +527,434 @@ short g727_decode_sample (short code, short law, short cbits, short ebits, g727_
 /* ..................... End of G727_decode_sample() ..................... */
 
 
+/* ********************************************************************** *
+ * ************* MULTI-CHANNEL ENCODER & DECODER ROUTINES *************** *
+ * ********************************************************************** */
+
+/* Number of channels advanced together, one per 16-bit SIMD lane */
+#define G727_LANES 8
+
+/*
+  ----------------------------------------------------------------------------
+  G727_LANES channels: a copy of the state of each channel, plus the
+  sixth and second order predictors (b's, dq's, a's, sr's) in
+  structure-of-arrays layout, entry [c] of each array being lane c. The
+  predictor, floating point conversions and update of the b's run on
+  all the lanes with the same instructions; the other blocks run lane by
+  lane on st[c], with the law and bit allocation of each channel. The
+  a's are kept in st[c].aprsc and copied to a1[] and a2[]; the b's,
+  dq's and sr's of st[c].aprsc are only updated when the lanes are saved.
+  ----------------------------------------------------------------------------
+*/
+typedef struct {
+  g727_state st[G727_LANES];
+  Int16 sr[2][G727_LANES];      /* sr1, sr2 */
+  Int16 dq[6][G727_LANES];      /* dq1..dq6 */
+  Int16 b[6][G727_LANES];
+  Int16 a1[G727_LANES], a2[G727_LANES];
+  Int16 se[G727_LANES], sez[G727_LANES];        /* estimates of the sample */
+  Int16 dqu[G727_LANES], sru[G727_LANES];       /* dq and sr of the sample */
+  Int16 tr[G727_LANES];
+  short law[G727_LANES], cbits[G727_LANES], ebits[G727_LANES];
+} g727_lanes;
+
+
+#if defined(G727_SIMD_SSE2)
+#define G727_SEL(m, a, b) _mm_or_si128 (_mm_and_si128 (m, a), _mm_andnot_si128 (m, b))
+#define G727_LOAD(p) _mm_loadu_si128 ((const __m128i *) (p))
+#define G727_STORE(p, x) _mm_storeu_si128 ((__m128i *) (p), x)
+
+/*
+  ----------------------------------------------------------------------------
+  g727_makexp() and mantissa of 8 magnitudes below 32768: the magnitude
+  is normalized in 4 conditional shifts.
+  ----------------------------------------------------------------------------
+*/
+static __m128i g727_norm8 (__m128i x, __m128i * mant) {
+  __m128i e = _mm_set1_epi16 (15), m, z;
+
+  m = _mm_cmplt_epi16 (x, _mm_set1_epi16 (1 << 7));
+  x = G727_SEL (m, _mm_slli_epi16 (x, 8), x);
+  e = _mm_sub_epi16 (e, _mm_and_si128 (m, _mm_set1_epi16 (8)));
+  m = _mm_cmplt_epi16 (x, _mm_set1_epi16 (1 << 11));
+  x = G727_SEL (m, _mm_slli_epi16 (x, 4), x);
+  e = _mm_sub_epi16 (e, _mm_and_si128 (m, _mm_set1_epi16 (4)));
+  m = _mm_cmplt_epi16 (x, _mm_set1_epi16 (1 << 13));
+  x = G727_SEL (m, _mm_slli_epi16 (x, 2), x);
+  e = _mm_sub_epi16 (e, _mm_and_si128 (m, _mm_set1_epi16 (2)));
+  m = _mm_cmplt_epi16 (x, _mm_set1_epi16 (1 << 14));
+  x = G727_SEL (m, _mm_slli_epi16 (x, 1), x);
+  e = _mm_sub_epi16 (e, _mm_and_si128 (m, _mm_set1_epi16 (1)));
+
+  z = _mm_cmpeq_epi16 (x, _mm_setzero_si128 ());
+  *mant = G727_SEL (z, _mm_set1_epi16 (1 << 5), _mm_srli_epi16 (x, 9));
+  return _mm_andnot_si128 (z, e);
+}
+
+/* g727_floata()/g727_floatb() of 8 lanes, from sign (0/1) and magnitude */
+static __m128i g727_float8 (__m128i s, __m128i mag) {
+  __m128i mant, exp = g727_norm8 (mag, &mant);
+
+  return _mm_add_epi16 (_mm_add_epi16 (_mm_slli_epi16 (s, 10), _mm_slli_epi16 (exp, 6)), mant);
+}
+
+/* g727_fmult() of 8 lanes */
+static __m128i g727_fmult8 (__m128i an, __m128i srn) {
+  __m128i ans, t, anmag, anexp, anmant, wpos, wanexp, wanmant, w7, rs, x, m;
+
+  ans = _mm_srai_epi16 (an, 15);
+  t = _mm_srli_epi16 (an, 2);
+  anmag = G727_SEL (ans, _mm_and_si128 (_mm_sub_epi16 (_mm_set1_epi16 (16384), t), _mm_set1_epi16 (8191)), t);
+  anexp = g727_norm8 (anmag, &anmant);
+
+  wpos = _mm_cmpeq_epi16 (_mm_srli_epi16 (srn, 10), _mm_srli_epi16 (an, 15));
+  wanexp = _mm_add_epi16 (_mm_and_si128 (_mm_srli_epi16 (srn, 6), _mm_set1_epi16 (15)), anexp);
+  wanmant = _mm_mullo_epi16 (_mm_and_si128 (srn, _mm_set1_epi16 (63)), anmant);
+  wanmant = _mm_srli_epi16 (_mm_add_epi16 (wanmant, _mm_set1_epi16 (48)), 4);
+  w7 = _mm_slli_epi16 (wanmant, 7);
+
+  /* Right shift by 26-wanexp, one bit of the shift count at a time */
+  rs = _mm_sub_epi16 (_mm_set1_epi16 (26), wanexp);
+  x = w7;
+  m = _mm_cmpeq_epi16 (_mm_and_si128 (rs, _mm_set1_epi16 (16)), _mm_set1_epi16 (16));
+  x = _mm_andnot_si128 (m, x);
+  m = _mm_cmpeq_epi16 (_mm_and_si128 (rs, _mm_set1_epi16 (8)), _mm_set1_epi16 (8));
+  x = G727_SEL (m, _mm_srli_epi16 (x, 8), x);
+  m = _mm_cmpeq_epi16 (_mm_and_si128 (rs, _mm_set1_epi16 (4)), _mm_set1_epi16 (4));
+  x = G727_SEL (m, _mm_srli_epi16 (x, 4), x);
+  m = _mm_cmpeq_epi16 (_mm_and_si128 (rs, _mm_set1_epi16 (2)), _mm_set1_epi16 (2));
+  x = G727_SEL (m, _mm_srli_epi16 (x, 2), x);
+  m = _mm_cmpeq_epi16 (_mm_and_si128 (rs, _mm_set1_epi16 (1)), _mm_set1_epi16 (1));
+  x = G727_SEL (m, _mm_srli_epi16 (x, 1), x);
+
+  /* Left shift for wanexp 27 and 28 */
+  m = _mm_cmpeq_epi16 (wanexp, _mm_set1_epi16 (27));
+  x = G727_SEL (m, _mm_and_si128 (_mm_slli_epi16 (w7, 1), _mm_set1_epi16 (32767)), x);
+  m = _mm_cmpeq_epi16 (wanexp, _mm_set1_epi16 (28));
+  x = G727_SEL (m, _mm_and_si128 (_mm_slli_epi16 (w7, 2), _mm_set1_epi16 (32767)), x);
+
+  return G727_SEL (wpos, x, _mm_sub_epi16 (_mm_setzero_si128 (), x));
+}
+#endif
+
+
+/* g727_get_se_sez() of all the lanes */
+static void g727_lanes_predict (g727_lanes * L) {
+#if defined(G727_SIMD_SSE2)
+  __m128i sezi, sei;
+
+  sezi = g727_fmult8 (G727_LOAD (L->b[0]), G727_LOAD (L->dq[0]));
+  sezi = _mm_add_epi16 (sezi, g727_fmult8 (G727_LOAD (L->b[1]), G727_LOAD (L->dq[1])));
+  sezi = _mm_add_epi16 (sezi, g727_fmult8 (G727_LOAD (L->b[2]), G727_LOAD (L->dq[2])));
+  sezi = _mm_add_epi16 (sezi, g727_fmult8 (G727_LOAD (L->b[3]), G727_LOAD (L->dq[3])));
+  sezi = _mm_add_epi16 (sezi, g727_fmult8 (G727_LOAD (L->b[4]), G727_LOAD (L->dq[4])));
+  sezi = _mm_add_epi16 (sezi, g727_fmult8 (G727_LOAD (L->b[5]), G727_LOAD (L->dq[5])));
+  sei = _mm_add_epi16 (sezi, g727_fmult8 (G727_LOAD (L->a2), G727_LOAD (L->sr[1])));
+  sei = _mm_add_epi16 (sei, g727_fmult8 (G727_LOAD (L->a1), G727_LOAD (L->sr[0])));
+  G727_STORE (L->sez, _mm_srli_epi16 (sezi, 1));
+  G727_STORE (L->se, _mm_srli_epi16 (sei, 1));
+#else
+  int c;
+
+  for (c = 0; c < G727_LANES; c++)
+    g727_accum (&L->se[c], &L->sez[c], g727_fmult (L->a1[c], L->sr[0][c]), g727_fmult (L->a2[c], L->sr[1][c]), g727_fmult (L->b[0][c], L->dq[0][c]), g727_fmult (L->b[1][c], L->dq[1][c]), g727_fmult (L->b[2][c], L->dq[2][c]), g727_fmult (L->b[3][c], L->dq[3][c]), g727_fmult (L->b[4][c], L->dq[4][c]), g727_fmult (L->b[5][c], L->dq[5][c]));
+#endif
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+  Blocks of the sample that depend on the law and bit allocation, lane
+  by lane, as in g727_encode_sample() and g727_decode_sample(). Leaves
+  dq, sr and tr of each lane in dqu[], sru[] and tr[] for
+  g727_lanes_update().
+  ----------------------------------------------------------------------------
+*/
+static void g727_lanes_step (g727_lanes * L, short *inp, short *out, int dec) {
+  g727_state *st;
+  Int8 al, in, ic, pk0, sigpk, tr, tdp;
+  Int16 y, d, dq, dqff, sr, a2p, se, sez;
+  Int32 yl;
+  short law, cbits, ebits;
+  int c;
+
+  for (c = 0; c < G727_LANES; c++) {
+    st = &L->st[c];
+    law = L->law[c];
+    cbits = L->cbits[c];
+    ebits = L->ebits[c];
+    se = L->se[c];
+    sez = L->sez[c];
+
+    al = g727_get_al (&st->asc);
+    y = g727_get_y (&st->qsfa, al);
+    yl = g727_get_yl (&st->qsfa);
+
+    if (dec) {
+      ic = g727_get_ic ((Int8) inp[c], ebits);
+      dq = g727_get_dq (y, ic, cbits);
+      dqff = g727_get_dq (y, (Int8) inp[c], cbits + ebits);
+    } else {
+      d = g727_get_d ((Int8) inp[c], se, law);
+      in = g727_get_in (d, y, cbits + ebits);
+      ic = g727_get_ic (in, ebits);
+      dq = g727_get_dq (y, ic, cbits);
+      out[c] = in;
+    }
+
+    sr = g727_get_sr (dq, se);
+    a2p = g727_get_a2p (&st->aprsc, dq, sez, &pk0, &sigpk);
+
+    tr = g727_get_tr (&st->ttd, yl, dq);
+    tdp = g727_get_tdp (a2p);
+
+    if (dec)
+      out[c] = g727_get_sd (g727_get_srff (dqff, se), se, (Int8) inp[c], y, law, cbits + ebits);
+
+    g727_qsfa_transit (&st->qsfa, ic, y, cbits);
+    g727_asc_transit (&st->asc, ic, y, tr, tdp, cbits);
+
+    /* g727_aprsc_transit() without the b's and delays */
+    st->aprsc.a1 = g727_aprsc_trigb (tr, g727_limd (g727_upa1 (&st->aprsc, pk0, sigpk), a2p));
+    st->aprsc.a2 = g727_aprsc_trigb (tr, a2p);
+    st->aprsc.pk2 = st->aprsc.pk1;
+    st->aprsc.pk1 = pk0;
+
+    g727_ttd_transit (&st->ttd, tr, tdp);
+
+    L->a1[c] = st->aprsc.a1;
+    L->a2[c] = st->aprsc.a2;
+    L->dqu[c] = dq;
+    L->sru[c] = sr;
+    L->tr[c] = tr;
+  }
+}
+
+
+/* Update of the b's and delays of g727_aprsc_transit(), all the lanes */
+static void g727_lanes_update (g727_lanes * L) {
+#if defined(G727_SIMD_SSE2)
+  __m128i dq, sr, s, mag, dqs, zero, trm, ugb, b, bp, umask, dq0, sr0;
+  int k;
+
+  zero = _mm_setzero_si128 ();
+  dq = G727_LOAD (L->dqu);
+  sr = G727_LOAD (L->sru);
+
+  s = _mm_srli_epi16 (sr, 15);
+  mag = G727_SEL (_mm_srai_epi16 (sr, 15), _mm_and_si128 (_mm_sub_epi16 (zero, sr), _mm_set1_epi16 (32767)), sr);
+  sr0 = g727_float8 (s, mag);
+  dqs = _mm_srli_epi16 (dq, 14);
+  mag = _mm_and_si128 (dq, _mm_set1_epi16 (16383));
+  dq0 = g727_float8 (dqs, mag);
+
+  /* g727_upb(): bn + ugbn - (bn >> 8), with the sign of bn extended */
+  trm = _mm_cmpgt_epi16 (G727_LOAD (L->tr), zero);
+  for (k = 0; k < 6; k++) {
+    b = G727_LOAD (L->b[k]);
+    umask = _mm_cmpeq_epi16 (_mm_xor_si128 (dqs, _mm_srli_epi16 (G727_LOAD (L->dq[k]), 10)), zero);
+    ugb = _mm_andnot_si128 (_mm_cmpeq_epi16 (mag, zero), G727_SEL (umask, _mm_set1_epi16 (128), _mm_set1_epi16 (-128)));
+    bp = _mm_add_epi16 (_mm_sub_epi16 (b, _mm_srai_epi16 (b, 8)), ugb);
+    G727_STORE (L->b[k], _mm_andnot_si128 (trm, bp));
+  }
+
+  memmove (L->dq[1], L->dq[0], 5 * sizeof (L->dq[0]));
+  G727_STORE (L->dq[0], dq0);
+  memmove (L->sr[1], L->sr[0], sizeof (L->sr[0]));
+  G727_STORE (L->sr[0], sr0);
+#else
+  int c, k;
+
+  for (c = 0; c < G727_LANES; c++) {
+    for (k = 0; k < 6; k++)
+      L->b[k][c] = g727_aprsc_trigb ((Int8) L->tr[c], g727_upb (g727_xor (L->dq[k][c], L->dqu[c]), L->b[k][c], L->dqu[c]));
+    for (k = 5; k > 0; k--)
+      L->dq[k][c] = L->dq[k - 1][c];
+    L->dq[0][c] = g727_floata (L->dqu[c]);
+    L->sr[1][c] = L->sr[0][c];
+    L->sr[0][c] = g727_floatb (L->sru[c]);
+  }
+#endif
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+  Loads nl channels into the lanes; the unused lanes get a reset 32 kbit/s
+  A-law channel.
+  ----------------------------------------------------------------------------
+*/
+static void g727_lanes_load (g727_lanes * L, long nl, short *law, short *cbits, short *ebits, g727_state * st) {
+  int c;
+
+  for (c = 0; c < G727_LANES; c++) {
+    if (c < nl) {
+      L->st[c] = st[c];
+      L->law[c] = (law[c] == '1') ? 1 : ((law[c] == '0') ? 0 : law[c]);
+      L->cbits[c] = cbits[c];
+      L->ebits[c] = ebits[c];
+      assert (2 <= cbits[c] && cbits[c] <= 4 && ebits[c] >= 0 && cbits[c] + ebits[c] <= 5);
+    } else {
+      g727_reset (&L->st[c]);
+      L->law[c] = 1;
+      L->cbits[c] = 4;
+      L->ebits[c] = 0;
+    }
+    L->sr[0][c] = L->st[c].aprsc.sr1;
+    L->sr[1][c] = L->st[c].aprsc.sr2;
+    L->dq[0][c] = L->st[c].aprsc.dq1;
+    L->dq[1][c] = L->st[c].aprsc.dq2;
+    L->dq[2][c] = L->st[c].aprsc.dq3;
+    L->dq[3][c] = L->st[c].aprsc.dq4;
+    L->dq[4][c] = L->st[c].aprsc.dq5;
+    L->dq[5][c] = L->st[c].aprsc.dq6;
+    L->b[0][c] = L->st[c].aprsc.b1;
+    L->b[1][c] = L->st[c].aprsc.b2;
+    L->b[2][c] = L->st[c].aprsc.b3;
+    L->b[3][c] = L->st[c].aprsc.b4;
+    L->b[4][c] = L->st[c].aprsc.b5;
+    L->b[5][c] = L->st[c].aprsc.b6;
+    L->a1[c] = L->st[c].aprsc.a1;
+    L->a2[c] = L->st[c].aprsc.a2;
+  }
+}
+
+/* Saves the lanes of nl channels */
+static void g727_lanes_save (g727_lanes * L, long nl, g727_state * st) {
+  int c;
+
+  for (c = 0; c < nl; c++) {
+    L->st[c].aprsc.sr1 = L->sr[0][c];
+    L->st[c].aprsc.sr2 = L->sr[1][c];
+    L->st[c].aprsc.dq1 = L->dq[0][c];
+    L->st[c].aprsc.dq2 = L->dq[1][c];
+    L->st[c].aprsc.dq3 = L->dq[2][c];
+    L->st[c].aprsc.dq4 = L->dq[3][c];
+    L->st[c].aprsc.dq5 = L->dq[4][c];
+    L->st[c].aprsc.dq6 = L->dq[5][c];
+    L->st[c].aprsc.b1 = L->b[0][c];
+    L->st[c].aprsc.b2 = L->b[1][c];
+    L->st[c].aprsc.b3 = L->b[2][c];
+    L->st[c].aprsc.b4 = L->b[3][c];
+    L->st[c].aprsc.b5 = L->b[4][c];
+    L->st[c].aprsc.b6 = L->b[5][c];
+    st[c] = L->st[c];
+  }
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+  Multi-channel encoder (dec==0) or decoder (dec!=0): the channels are
+  processed in groups of G727_LANES, all the samples of a group at once.
+  ----------------------------------------------------------------------------
+*/
+static void g727_multi (long nch, short **src, short **dst, short n, short *law, short *cbits, short *ebits, g727_state * st, int dec) {
+  g727_lanes L;
+  short inp[G727_LANES], out[G727_LANES];
+  long c0, nl, j;
+  int c;
+
+  for (c0 = 0; c0 < nch; c0 += G727_LANES) {
+    nl = (nch - c0 < G727_LANES) ? nch - c0 : G727_LANES;
+    g727_lanes_load (&L, nl, law + c0, cbits + c0, ebits + c0, st + c0);
+
+    for (c = 0; c < G727_LANES; c++)
+      inp[c] = 0;
+    for (j = 0; j < n; j++) {
+      for (c = 0; c < nl; c++)
+        inp[c] = src[c0 + c][j];
+      g727_lanes_predict (&L);
+      g727_lanes_step (&L, inp, out, dec);
+      g727_lanes_update (&L);
+      for (c = 0; c < nl; c++)
+        dst[c0 + c][j] = out[c];
+    }
+
+    g727_lanes_save (&L, nl, st + c0);
+  }
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+
+  void g727_encode_block_multi (long nch, short **src, short **dst,
+  ~~~~~~~~~~~~~~~~~~~~~~~~~~~~  short n, short *law, short *cbits,
+                                short *ebits, g727_state *st);
+
+  Description:
+  ~~~~~~~~~~~~
+
+  Simulation of the ITU-T G.727 embedded ADPCM encoder for `nch'
+  channels. Channel c is encoded as by g727_encode_block() with the
+  arguments src[c], dst[c], n, law[c], cbits[c], ebits[c] and &st[c],
+  and gives the same output. The channels are advanced G727_LANES at a
+  time, one per SIMD lane.
+
+  Parameters:
+  ~~~~~~~~~~~
+  nch .......... number of channels
+  src .......... A- or u-law input samples of each channel
+  dst .......... ADPCM-encoded samples of each channel
+  n ............ Number of samples to encode, per channel.
+  law .......... encoding law of each channel ('1'=A-law, '0'=u-law).
+  cbits ........ number of core bits of each channel
+  ebits ........ number of enhancement bits of each channel
+  st ........... G.727 state variable of each channel
+
+  Return value:
+  ~~~~~~~~~~~~~
+  None.
+
+  Prototype:      in file g727.h
+  ~~~~~~~~~~
+
+  History:
+  ~~~~~~~~
+  16.Oct.26  1.00  Created
+ ----------------------------------------------------------------------------
+*/
+void g727_encode_block_multi (long nch, short **src, short **dst, short n, short *law, short *cbits, short *ebits, g727_state * st) {
+  g727_multi (nch, src, dst, n, law, cbits, ebits, st, 0);
+}
+
+/* .................. End of G727_encode_block_multi() .................. */
+
+
+/*
+  ----------------------------------------------------------------------------
+
+  void g727_decode_block_multi (long nch, short **src, short **dst,
+  ~~~~~~~~~~~~~~~~~~~~~~~~~~~~  short n, short *law, short *cbits,
+                                short *ebits, g727_state *st);
+
+  Description:
+  ~~~~~~~~~~~~
+
+  Simulation of the ITU-T G.727 embedded ADPCM decoder for `nch'
+  channels, with the same parameters as g727_encode_block_multi().
+  Channel c gives the same output as g727_decode_block().
+
+  Return value:
+  ~~~~~~~~~~~~~
+  None.
+
+  Prototype:      in file g727.h
+  ~~~~~~~~~~
+
+  History:
+  ~~~~~~~~
+  16.Oct.26  1.00  Created
+ ----------------------------------------------------------------------------
+*/
+void g727_decode_block_multi (long nch, short **src, short **dst, short n, short *law, short *cbits, short *ebits, g727_state * st) {
+  g727_multi (nch, src, dst, n, law, cbits, ebits, st, 1);
+}
+
+/* .................. End of G727_decode_block_multi() .................. */
+
+
 
 
 /* ********************************************************************** *
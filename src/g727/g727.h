@@ -26,11 +26,13 @@
 		    cc compiler in a DEC Alpha Unix machine.
     02.Feb.2010 1.11  Modified maximum string length, and implicit
                       casting of toupper() argument removed. (y.hiwasaki)
+    16.Oct.2026 1.12  Added g727_encode_block_multi() and
+                      g727_decode_block_multi()
  *
  *******************************************************************/
 
 #ifndef G727_H
-#define G727_H 111
+#define G727_H 112
 
 /* Smart function prototypes: for [ag]cc, VaxC, and [tb]cc */
 #if !defined(ARGS)
@@ -87,6 +89,8 @@ short g727_encode (short code, short law, short cbits, short ebits, g727_state *
 short g727_decode (short code, short law, short cbits, short ebits, g727_state * st);
 void g727_encode_block (short *src, short *dst, short n, short law, short cbits, short ebits, g727_state * st);
 void g727_decode_block (short *src, short *dst, short n, short law, short cbits, short ebits, g727_state * st);
+void g727_encode_block_multi (long nch, short **src, short **dst, short n, short *law, short *cbits, short *ebits, g727_state * st);
+void g727_decode_block_multi (long nch, short **src, short **dst, short n, short *law, short *cbits, short *ebits, g727_state * st);
 
 Int16 g727_get_d (Int8 s, Int16 se, short law);
 Int16 g727_expand (Int8 sp, short law);
@@ -170,6 +174,8 @@ void g727_encode_block ARGS ((short *src, short *dst, short n, short law, short
 void g727_decode_block ARGS ((short *src, short *dst, short n, short law, short cbits, short ebits, g727_state * st));
 short g727_encode_sample ARGS ((short code, short law, short cbits, short ebits, g727_state * st));
 short g727_decode_sample ARGS ((short code, short law, short cbits, short ebits, g727_state * st));
+void g727_encode_block_multi ARGS ((long nch, short **src, short **dst, short n, short *law, short *cbits, short *ebits, g727_state * st));
+void g727_decode_block_multi ARGS ((long nch, short **src, short **dst, short n, short *law, short *cbits, short *ebits, g727_state * st));
 #endif /* Smart prototypes */
 
 /* Definitions for better user interface (?!) */
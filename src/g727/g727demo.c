@@ -80,6 +80,8 @@
                      <simao.campos@labs.comsat.com>
   02.Feb.2010  1.11  Modified maximum string length, and implicit
                      casting of toupper() argument removed. (y.hiwasaki)
+  16.Oct.2026  1.12  Added option -nch for multi-channel files, using
+                     g727_encode_block_multi()/g727_decode_block_multi()
   ============================================================================
 */
 
@@ -162,6 +164,8 @@ void display_usage () {
   printf ("  -start # ..  starting block to measure [default: first]\n");
   printf ("  -n # ......  number of blocks to be measured [default: all]\n");
   printf ("  -end # ....  last block to be measured [default: last]\n");
+  printf ("  -nch # .... Number of interleaved channels in the files, all\n");
+  printf ("              with the same law and bits; block size is per channel\n");
   printf ("  -q ........ Quiet operation (don't print progress flag)\n");
   printf ("  -?/-help .. Display program usage\n");
 
@@ -173,6 +177,121 @@ void display_usage () {
 /* .................... End of display_usage() ........................... */
 
 
+/*
+  --------------------------------------------------------------------------
+  process_multi()
+
+  Carry out the operation on N2 blocks of N samples per channel of a
+  file of nch interleaved channels. Each channel has its own encoder and
+  decoder state; the channels are processed together by the
+  multi-channel G.727 routines.
+
+  History:
+  ~~~~~~~~
+  16/Oct/2026  v1.0 Created
+  --------------------------------------------------------------------------
+*/
+void process_multi (FILE * Fi, FILE * Fo, char *FileOut, long nch, long N, long N2, short law, short nc, short ne, char encode, char decode, short inp_type, short out_type, char quiet) {
+  g727_state *enc_state, *dec_state;
+  short *inp_buf, *out_buf;     /* Interleaved input and output buffers */
+  short **chn_in, **chn_tmp, **chn_out;
+  short *laws, *ncs, *nes;
+  long cur_blk, smpno, c, i;
+  static char funny[9] = "|/-\\|/-\\";
+
+  /* Allocate states and per-channel buffers */
+  enc_state = (g727_state *) calloc (nch, sizeof (g727_state));
+  dec_state = (g727_state *) calloc (nch, sizeof (g727_state));
+  inp_buf = (short *) calloc (N * nch, sizeof (short));
+  out_buf = (short *) calloc (N * nch, sizeof (short));
+  chn_in = (short **) calloc (nch, sizeof (short *));
+  chn_tmp = (short **) calloc (nch, sizeof (short *));
+  chn_out = (short **) calloc (nch, sizeof (short *));
+  laws = (short *) calloc (nch, sizeof (short));
+  ncs = (short *) calloc (nch, sizeof (short));
+  nes = (short *) calloc (nch, sizeof (short));
+  if (enc_state == NULL || dec_state == NULL || inp_buf == NULL || out_buf == NULL || chn_in == NULL || chn_tmp == NULL || chn_out == NULL || laws == NULL || ncs == NULL || nes == NULL)
+    error_terminate ("Error in memory allocation!\n", 1);
+  for (c = 0; c < nch; c++) {
+    chn_in[c] = (short *) calloc (N, sizeof (short));
+    chn_tmp[c] = (short *) calloc (N, sizeof (short));
+    chn_out[c] = (short *) calloc (N, sizeof (short));
+    if (chn_in[c] == NULL || chn_tmp[c] == NULL || chn_out[c] == NULL)
+      error_terminate ("Error in memory allocation!\n", 1);
+    laws[c] = law;
+    ncs[c] = nc;
+    nes[c] = ne;
+    g727_reset (&enc_state[c]);
+    g727_reset (&dec_state[c]);
+  }
+
+  for (cur_blk = 0; cur_blk < N2; cur_blk++) {
+    /* Print progress flag */
+    if (!quiet)
+      fprintf (stderr, "%c\r", funny[cur_blk % 8]);
+
+    /* Read a block of samples of all the channels */
+    if ((smpno = fread (inp_buf, sizeof (short), N * nch, Fi) / nch) <= 0)
+      break;
+
+    /* Compress linear input samples using A-law */
+    if (inp_type == IS_LIN) {
+      alaw_compress (smpno * nch, inp_buf, out_buf);
+      memcpy (inp_buf, out_buf, sizeof (short) * smpno * nch);
+    }
+
+    /* De-interleave */
+    for (c = 0; c < nch; c++)
+      for (i = 0; i < smpno; i++)
+        chn_in[c][i] = inp_buf[i * nch + c];
+
+    /* Carry out the desired operation */
+    if (encode && !decode)
+      g727_encode_block_multi (nch, chn_in, chn_out, smpno, laws, ncs, nes, enc_state);
+    else if (decode && !encode)
+      g727_decode_block_multi (nch, chn_in, chn_out, smpno, laws, ncs, nes, dec_state);
+    else if (encode && decode) {
+      g727_encode_block_multi (nch, chn_in, chn_tmp, smpno, laws, ncs, nes, enc_state);
+      g727_decode_block_multi (nch, chn_tmp, chn_out, smpno, laws, ncs, nes, dec_state);
+    }
+
+    /* Interleave */
+    for (c = 0; c < nch; c++)
+      for (i = 0; i < smpno; i++)
+        out_buf[i * nch + c] = chn_out[c][i];
+
+    /* Expand to linear output samples */
+    if (out_type == IS_LIN) {
+      alaw_expand (smpno * nch, out_buf, inp_buf);
+      memcpy (out_buf, inp_buf, sizeof (short) * smpno * nch);
+    }
+
+    /* Write output words */
+    if (fwrite (out_buf, sizeof (short), smpno * nch, Fo) != (size_t) (smpno * nch))
+      KILL (FileOut, 6);
+  }
+
+  /* Free memory */
+  for (c = 0; c < nch; c++) {
+    free (chn_in[c]);
+    free (chn_tmp[c]);
+    free (chn_out[c]);
+  }
+  free (chn_in);
+  free (chn_tmp);
+  free (chn_out);
+  free (laws);
+  free (ncs);
+  free (nes);
+  free (inp_buf);
+  free (out_buf);
+  free (enc_state);
+  free (dec_state);
+}
+
+/* .................... End of process_multi() ........................... */
+
+
 /*
    **************************************************************************
    ***                                                                    ***
@@ -192,7 +311,7 @@ int main (int argc, char **argv) {
 #endif
   short inp_type, out_type;
   g727_state enc_state, dec_state;
-  long N = 256, N1 = 1, N2 = 0, cur_blk, smpno;
+  long N = 256, N1 = 1, N2 = 0, cur_blk, smpno, nch = 0;
 
   /* General-purpose, progress indication */
   static char quiet = 0, funny[9] = "|/-\\|/-\\";
@@ -317,6 +436,15 @@ int main (int argc, char **argv) {
         /* Define number of enhancement bits for operation */
         ne = atoi (argv[2]);
 
+        /* Move argv over the option to the next argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-nch") == 0) {
+        /* Define number of interleaved channels */
+        nch = atol (argv[2]);
+        if (nch < 1)
+          error_terminate (" Invalid number of channels! Aborted...\n", 10);
+
         /* Move argv over the option to the next argument */
         argv += 2;
         argc -= 2;
@@ -358,7 +486,7 @@ int main (int argc, char **argv) {
   wordLen = nc + ne;
 
   /* Find starting byte in file */
-  start_byte = sizeof (short) * (long) (--N1) * (long) N;
+  start_byte = sizeof (short) * (long) (--N1) * (long) N * (nch > 0 ? nch : 1);
 
   /* Check if is to process the whole file */
   if (N2 == 0) {
@@ -366,7 +494,7 @@ int main (int argc, char **argv) {
 
     /* ... find the input file size ... */
     stat (FileIn, &st);
-    N2 = (st.st_size - start_byte) / (N * sizeof (short));
+    N2 = (st.st_size - start_byte) / (N * sizeof (short) * (nch > 0 ? nch : 1));
   }
 
 
@@ -447,51 +575,54 @@ int main (int argc, char **argv) {
   g727_reset (&dec_state);
 
   /* Process all blocks defined by user */
-  for (cur_blk = 0; cur_blk < N2; cur_blk++) {
-    /* Print progress flag */
-    if (!quiet)
+  if (nch > 0)
+    process_multi (Fi, Fo, FileOut, nch, N, N2, law, nc, ne, encode, decode, inp_type, out_type, quiet);
+  else
+    for (cur_blk = 0; cur_blk < N2; cur_blk++) {
+      /* Print progress flag */
+      if (!quiet)
 #ifdef DISPLAY_CURRENT_RATE
-      fprintf (stderr, "%d-", 8 * rate[rate_idx]);
+        fprintf (stderr, "%d-", 8 * rate[rate_idx]);
 #else
-      fprintf (stderr, "%c\r", funny[cur_blk % 8]);
+        fprintf (stderr, "%c\r", funny[cur_blk % 8]);
 #endif
 
-    /* Read a block of samples */
-    if ((smpno = fread (inp_buf, sizeof (short), N, Fi)) < 0)
-      KILL (FileIn, 5);
+      /* Read a block of samples */
+      if ((smpno = fread (inp_buf, sizeof (short), N, Fi)) < 0)
+        KILL (FileIn, 5);
 
-    /* Compress linear input samples */
-    if (inp_type == IS_LIN) {
-      /* Compress using A-law */
-      alaw_compress (smpno, inp_buf, tmp_buf);
+      /* Compress linear input samples */
+      if (inp_type == IS_LIN) {
+        /* Compress using A-law */
+        alaw_compress (smpno, inp_buf, tmp_buf);
 
-      /* copy temporary buffer over input buffer */
-      memcpy (inp_buf, tmp_buf, sizeof (short) * smpno);
-    }
+        /* copy temporary buffer over input buffer */
+        memcpy (inp_buf, tmp_buf, sizeof (short) * smpno);
+      }
 
-    /* Carry out the desired operation */
-    if (encode && !decode)
-      g727_encode (inp_buf, out_buf, smpno, law, nc, ne, &enc_state);
-    else if (decode && !encode)
-      g727_decode (inp_buf, out_buf, smpno, law, nc, ne, &dec_state);
-    else if (encode && decode) {
-      g727_encode (inp_buf, tmp_buf, smpno, law, nc, ne, &enc_state);
-      g727_decode (tmp_buf, out_buf, smpno, law, nc, ne, &dec_state);
-    }
+      /* Carry out the desired operation */
+      if (encode && !decode)
+        g727_encode (inp_buf, out_buf, smpno, law, nc, ne, &enc_state);
+      else if (decode && !encode)
+        g727_decode (inp_buf, out_buf, smpno, law, nc, ne, &dec_state);
+      else if (encode && decode) {
+        g727_encode (inp_buf, tmp_buf, smpno, law, nc, ne, &enc_state);
+        g727_decode (tmp_buf, out_buf, smpno, law, nc, ne, &dec_state);
+      }
 
-    /* Expand linear input samples */
-    if (out_type == IS_LIN) {
-      /* Compress using A-law */
-      alaw_expand (smpno, out_buf, tmp_buf);
+      /* Expand linear input samples */
+      if (out_type == IS_LIN) {
+        /* Compress using A-law */
+        alaw_expand (smpno, out_buf, tmp_buf);
 
-      /* copy temporary buffer over input buffer */
-      memcpy (out_buf, tmp_buf, sizeof (short) * smpno);
-    }
+        /* copy temporary buffer over input buffer */
+        memcpy (out_buf, tmp_buf, sizeof (short) * smpno);
+      }
 
-    /* Write ADPCM output word */
-    if ((smpno = fwrite (out_buf, sizeof (short), smpno, Fo)) < 0)
-      KILL (FileOut, 6);
-  }
+      /* Write ADPCM output word */
+      if ((smpno = fwrite (out_buf, sizeof (short), smpno, Fo)) < 0)
+        KILL (FileOut, 6);
+    }
 
 
 /*
@@ -1,4 +1,4 @@
-/*                                                           v3.1 - 22/Feb/1996
+/*                                                           v3.3 - 16/Oct/2026
   =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -48,6 +48,8 @@ FUNCTIONS    : - stdpcm_kernel(...)   =  parallel-form IIR filter (kernel)
 	       - cascade_iir_kernel(...) = cascade-form IIR filter (kernel)
 	       - cascade_iir_free(...) = deallocate cascade filter memory
 	       - cascade_iir_reset(...) = clear cascade state variables
+	       - cascade_iir_set_channels(...) = set number of interleaved
+	                                   channels of a cascade filter
 	       - direct_iir_kernel(...) = direct-form IIR filter (kernel)
 	       - direct_iir_free(...) = deallocate direct filter memory
 	       - direct_iir_reset(...) = clear direct state variables
@@ -61,6 +63,13 @@ HISTORY:
     22.Feb.96 v3.1 Changed inclusion of stdlib.h to inconditional, as
                    suggested by Kirchherr (FI/DBP Telekom) to run under
 		   OpenVMS/AXP <simao@ctd.comsat.com>
+    16.Oct.26 v3.2 Parallel-form kernels run 4 sections at once in SIMD
+                   lanes (SSE2/NEON), with the coefficients repacked at
+                   init time; bit-exact with the scalar kernels, which
+                   are used with -DIIR_LEGACY_KERNEL or without SIMD.
+    16.Oct.26 v3.3 Cascade-form kernel for interleaved multi-channel
+                   signals, 4 channels per SIMD group; bit-exact with
+                   the mono kernels.
 
   =============================================================================
 */
@@ -76,6 +85,21 @@ HISTORY:
 /* Definitions for IIR filters */
 #include "iirflt.h"
 
+/* SIMD kernel for the parallel-form filters */
+#if !defined(IIR_LEGACY_KERNEL)
+#if defined(__SSE2__) || defined(_M_X64)
+#define IIR_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define IIR_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+#define SCD_LANES 4             /* sections per SIMD group */
+#define SCD_GROUP (7*SCD_LANES) /* c0,c1,b0,b1,b2,T0,T1 of a group */
+#define CASC_LANES 4            /* channels per cascade state row */
+
 
 
 /*
@@ -84,6 +108,9 @@ HISTORY:
 /* Parallel-form filtering basic function prototypes */
 static long scd_parallel_form_iir_down_kernel ARGS ((long lenx, float *x, float *y, long *k0, long idown, long nblocks, double direct_cof, double gain, float (*b)[3], float (*c)[2], float (*T)[2]));
 static long scd_parallel_form_iir_up_kernel ARGS ((long lenx, float *x, float *y, long iup, long nblocks, double direct_cof, double gain, float (*b)[3], float (*c)[2], float (*T)[2]));
+#if defined(IIR_SIMD_SSE2) || defined(IIR_SIMD_NEON)
+static long scd_parallel_form_iir_simd_kernel ARGS ((long lenx, float *x, float *y, long *k0, long idown, char hswitch, long nblocks, double direct_cof, double gain, float (*T)[2], float *soa));
+#endif
 
 SCD_IIR *scd_stdpcm_init ARGS ((long nblocks, float (*b)[3], float (*c)[2], double direct_cof, double gain, long idown, char hswitch));
 
@@ -93,6 +120,7 @@ long cascade_iir_kernel ARGS ((long lseg, float *x_ptr, CASCADE_IIR * iir_ptr, f
 static long cascade_form_iir_down_kernel ARGS ((long lenx, float *x, float *y, long *k0, long idown, long nblocks, double gain, float (*a)[2], float (*b)[2], float (*T)[4]));
 
 static long cascade_form_iir_up_kernel ARGS ((long lenx, float *x, float *y, long iup, long nblocks, double gain, float (*a)[2], float (*b)[2], float (*T)[4]));
+static long cascade_form_iir_multi_kernel ARGS ((long lenx, float *x, float *y, long *k0, long idown, char hswitch, long nch, long nblocks, double gain, float (*a)[2], float (*b)[2], float (*T)[4]));
 
 CASCADE_IIR *cascade_iir_init ARGS ((long nblocks, float (*a)[2], float (*b)[2], double gain, long idown, char hswitch));
 
@@ -144,6 +172,7 @@ DIRECT_IIR *direct_iir_init ARGS ((long zno, long pno, float *a, float *b, doubl
  ============================================================================
 */
 void stdpcm_free (SCD_IIR * iir_ptr) {
+  free (iir_ptr->soa);          /* free repacked coefficients */
   free (iir_ptr->T);            /* free state variables */
   free (iir_ptr);               /* free allocated struct */
 }
@@ -285,6 +314,25 @@ SCD_IIR *scd_stdpcm_init (long nblocks, float (*b)[3], float (*c)[2], double dir
   ptrIIR->k0 = idown;           /* modulo counter for down-sampling */
 
 
+  /* Repack the coefficients for the SIMD kernel: groups of SCD_LANES
+   * sections, one array per coefficient; padding lanes are zero */
+  ptrIIR->soa = (float *) 0;
+#if defined(IIR_SIMD_SSE2) || defined(IIR_SIMD_NEON)
+  if ((ptrIIR->soa = (float *) calloc (((nblocks + SCD_LANES - 1) / SCD_LANES) * SCD_GROUP, sizeof (float))) != (float *) 0) {
+    float *g;
+
+    for (n = 0; n < nblocks; n++) {
+      g = ptrIIR->soa + (n / SCD_LANES) * SCD_GROUP + n % SCD_LANES;
+      g[0 * SCD_LANES] = c[n][0];
+      g[1 * SCD_LANES] = c[n][1];
+      g[2 * SCD_LANES] = b[n][0];
+      g[3 * SCD_LANES] = b[n][1];
+      g[4 * SCD_LANES] = b[n][2];
+    }
+  }
+#endif
+
+
   /* Exit returning pointer to struct */
   return (ptrIIR);
 }
@@ -320,10 +368,15 @@ SCD_IIR *scd_stdpcm_init (long nblocks, float (*b)[3], float (*c)[2], double dir
         History:
         ~~~~~~~~
         28.Feb.92 v1.0 Release of 1st version <hf@pkinbg.uucp>
+        16.Oct.26 v1.1 Uses the SIMD kernel when available.
 
  ============================================================================
 */
 long stdpcm_kernel (long lseg, float *x_ptr, SCD_IIR * iir_ptr, float *y_ptr) {
+#if defined(IIR_SIMD_SSE2) || defined(IIR_SIMD_NEON)
+  if (iir_ptr->soa != (float *) 0)
+    return scd_parallel_form_iir_simd_kernel (lseg, x_ptr, y_ptr, &(iir_ptr->k0), iir_ptr->idown, iir_ptr->hswitch, iir_ptr->nblocks, iir_ptr->direct_cof, iir_ptr->gain, iir_ptr->T, iir_ptr->soa);
+#endif
   if (iir_ptr->hswitch == 'U')
     return scd_parallel_form_iir_up_kernel (    /* returns number of output samples */
                                              lseg,      /* In : length of input signal */
@@ -511,6 +564,160 @@ static long scd_parallel_form_iir_up_kernel (long lenx, float *x, float *y, long
 
 
 
+#if defined(IIR_SIMD_SSE2) || defined(IIR_SIMD_NEON)
+/*
+  ----------------------------------------------------------------------------
+  void scd_soa_sample (float x, int zero, long nblocks, float *soa,
+                       float *y);
+
+  Run one input sample x through all the second-order sections of the
+  repacked filter `soa', SCD_LANES sections at a time. If y is not NULL,
+  the section outputs are added to *y in section order. The arithmetic is
+  that of the scalar kernels, with the same types and order of operations:
+  floats, except for the zero-valued samples of the up-sampling kernel
+  (zero != 0), whose recursion is computed in double precision there.
+  ----------------------------------------------------------------------------
+*/
+static void scd_soa_sample (float x, int zero, long nblocks, float *soa, float *y) {
+  float s[SCD_LANES];
+  long n, j;
+
+  for (n = 0; n < nblocks; n += SCD_LANES, soa += SCD_GROUP) {
+#if defined(IIR_SIMD_SSE2)
+    __m128 c0 = _mm_loadu_ps (soa), c1 = _mm_loadu_ps (soa + 4);
+    __m128 T0 = _mm_loadu_ps (soa + 20), T1 = _mm_loadu_ps (soa + 24), t;
+
+    if (zero) {
+      __m128 p0 = _mm_mul_ps (c0, T0), p1 = _mm_mul_ps (c1, T1);
+      __m128d two = _mm_set1_pd (2.0), lo, hi;
+
+      lo = _mm_sub_pd (_mm_sub_pd (_mm_setzero_pd (), _mm_cvtps_pd (p0)), _mm_cvtps_pd (p1));
+      hi = _mm_sub_pd (_mm_sub_pd (_mm_setzero_pd (), _mm_cvtps_pd (_mm_movehl_ps (p0, p0))), _mm_cvtps_pd (_mm_movehl_ps (p1, p1)));
+      t = _mm_movelh_ps (_mm_cvtpd_ps (_mm_mul_pd (two, lo)), _mm_cvtpd_ps (_mm_mul_pd (two, hi)));
+    } else {
+      t = _mm_sub_ps (_mm_sub_ps (_mm_set1_ps (x), _mm_mul_ps (c0, T0)), _mm_mul_ps (c1, T1));
+      t = _mm_add_ps (t, t);    /* 2*t is exact */
+    }
+    if (y != (float *) 0)
+      _mm_storeu_ps (s, _mm_add_ps (_mm_add_ps (_mm_mul_ps (_mm_loadu_ps (soa + 16), t), _mm_mul_ps (_mm_loadu_ps (soa + 12), T1)), _mm_mul_ps (_mm_loadu_ps (soa + 8), T0)));
+    _mm_storeu_ps (soa + 20, T1);
+    _mm_storeu_ps (soa + 24, t);
+#else
+    float32x4_t c0 = vld1q_f32 (soa), c1 = vld1q_f32 (soa + 4);
+    float32x4_t T0 = vld1q_f32 (soa + 20), T1 = vld1q_f32 (soa + 24), t;
+
+    if (zero) {
+      float32x4_t p0 = vmulq_f32 (c0, T0), p1 = vmulq_f32 (c1, T1);
+      float64x2_t two = vdupq_n_f64 (2.0), z = vdupq_n_f64 (0.0), lo, hi;
+
+      lo = vsubq_f64 (vsubq_f64 (z, vcvt_f64_f32 (vget_low_f32 (p0))), vcvt_f64_f32 (vget_low_f32 (p1)));
+      hi = vsubq_f64 (vsubq_f64 (z, vcvt_high_f64_f32 (p0)), vcvt_high_f64_f32 (p1));
+      t = vcombine_f32 (vcvt_f32_f64 (vmulq_f64 (two, lo)), vcvt_f32_f64 (vmulq_f64 (two, hi)));
+    } else {
+      t = vsubq_f32 (vsubq_f32 (vdupq_n_f32 (x), vmulq_f32 (c0, T0)), vmulq_f32 (c1, T1));
+      t = vaddq_f32 (t, t);     /* 2*t is exact */
+    }
+    if (y != (float *) 0)
+      vst1q_f32 (s, vaddq_f32 (vaddq_f32 (vmulq_f32 (vld1q_f32 (soa + 16), t), vmulq_f32 (vld1q_f32 (soa + 12), T1)), vmulq_f32 (vld1q_f32 (soa + 8), T0)));
+    vst1q_f32 (soa + 20, T1);
+    vst1q_f32 (soa + 24, t);
+#endif
+    if (y != (float *) 0)
+      for (j = 0; j < SCD_LANES && n + j < nblocks; j++)
+        *y += s[j];
+  }
+}
+
+
+/*
+  ============================================================================
+
+        long scd_parallel_form_iir_simd_kernel(long lenx, float *x,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ float *y, long *k0,
+                                               long idown, char hswitch,
+                                               long nblocks,
+                                               double direct_cof,
+                                               double gain, float (*T)[2],
+                                               float *soa);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Parallel-form IIR-filter with down-sampling (or up-sampling, if
+        hswitch is 'U') running SCD_LANES sections at once in SIMD lanes,
+        with the coefficients repacked by scd_stdpcm_init(). Output is
+        identical to that of scd_parallel_form_iir_down_kernel() and
+        scd_parallel_form_iir_up_kernel(). The state variables are kept in
+        `soa' during the call and saved back to T[][] at its end.
+
+        Parameters:
+        ~~~~~~~~~~~
+        As for the scalar kernels; idown is the up-sampling factor when
+        hswitch is 'U' (k0 is then not used).
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of samples filtered.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static long scd_parallel_form_iir_simd_kernel (long lenx, float *x, float *y, long *k0, long idown, char hswitch, long nblocks, double direct_cof, double gain, float (*T)[2], float *soa) {
+  long kx, ky, n, i;
+  float *g;
+
+  /* Load state variables into the SIMD groups */
+  for (n = 0; n < nblocks; n++) {
+    g = soa + (n / SCD_LANES) * SCD_GROUP + n % SCD_LANES;
+    g[5 * SCD_LANES] = T[n][0];
+    g[6 * SCD_LANES] = T[n][1];
+  }
+
+  ky = 0;
+  if (hswitch == 'U') {
+    for (kx = 0; kx < lenx; kx++) {
+      for (i = 0; i < idown; i++, ky++) {
+        if (i == 0) {           /* input sample */
+          y[ky] = direct_cof * x[kx];
+          scd_soa_sample (x[kx], 0, nblocks, soa, &y[ky]);
+        } else {                /* zero-valued samples */
+          y[ky] = 0.0;
+          scd_soa_sample (0.0, 1, nblocks, soa, &y[ky]);
+        }
+        y[ky] *= gain;
+      }
+    }
+  } else {
+    for (kx = 0; kx < lenx; kx++) {
+      if (*k0 % idown == 0) {   /* compute output only every "idown" samples */
+        y[ky] = direct_cof * x[kx];
+        scd_soa_sample (x[kx], 0, nblocks, soa, &y[ky]);
+        y[ky] *= gain;
+        ky++;
+      } else
+        scd_soa_sample (x[kx], 0, nblocks, soa, (float *) 0);
+      (*k0)++;
+    }
+    *k0 %= idown;
+  }
+
+  /* Save state variables */
+  for (n = 0; n < nblocks; n++) {
+    g = soa + (n / SCD_LANES) * SCD_GROUP + n % SCD_LANES;
+    T[n][0] = g[5 * SCD_LANES];
+    T[n][1] = g[6 * SCD_LANES];
+  }
+  return ky;
+}
+
+/* .............. End of scd_parallel_form_iir_simd_kernel() .............. */
+#endif
+
+
+
 /* *************************************************************************
    ******** THE ROUTINES TO FOLLOW HAVE BEEN ADDED AFTER THE STL92 *********
  * ************************************************************************* */
@@ -543,16 +750,22 @@ static long scd_parallel_form_iir_up_kernel (long lenx, float *x, float *y, long
   History:
   ~~~~~~~~
   30.Oct.94 v1.0 Release of 1st version <simao@ctd.comsat.com>
+  16.Oct.26 v1.1 Also clears multi-channel state rows.
 
  ============================================================================
 */
 void cascade_iir_reset (CASCADE_IIR * iir_ptr) {
-  long n;
+  long n, nrows;
   float (*T_ptr)[4];
 
 
+  /* Number of state rows: 1 per stage, or 4 per stage & channel group */
+  nrows = iir_ptr->nblocks;
+  if (iir_ptr->nch > 1)
+    nrows *= 4 * ((iir_ptr->nch + CASC_LANES - 1) / CASC_LANES);
+
   T_ptr = iir_ptr->T;
-  for (n = 0; n < iir_ptr->nblocks; n++) {
+  for (n = 0; n < nrows; n++) {
     T_ptr[n][0] = 0.0;
     T_ptr[n][1] = 0.0;
     T_ptr[n][2] = 0.0;
@@ -575,18 +788,20 @@ void cascade_iir_reset (CASCADE_IIR * iir_ptr) {
   ~~~~~~~~~~~~
 
   Basic cascade-form IIR filtering routine, for both up- and
-  down-sampling.
+  down-sampling. If cascade_iir_set_channels() has set more than one
+  channel, x_ptr and y_ptr hold interleaved samples and all channels
+  are filtered at once.
 
   Parameters:
   ~~~~~~~~~~~
-  lseg: ...... number of input samples
+  lseg: ...... number of input samples (per channel)
   x_ptr: ..... array with input samples
   iir_ptr: ... pointer to IIR-struct (CASCADE_IIR *)
   y_ptr: ..... output samples
 
   Return value:
   ~~~~~~~~~~~~~
-  Returns the number of output samples.
+  Returns the number of output samples (per channel).
 
   Author: <simao@ctd.comsat.com>
   ~~~~~~~
@@ -594,10 +809,13 @@ void cascade_iir_reset (CASCADE_IIR * iir_ptr) {
   History:
   ~~~~~~~~
   30.Oct.94 v1.0 Release of 1st version <simao@ctd.comsat.com>
+  16.Oct.26 v1.1 Interleaved multi-channel operation.
 
  ============================================================================
 */
 long cascade_iir_kernel (long lseg, float *x_ptr, CASCADE_IIR * iir_ptr, float *y_ptr) {
+  if (iir_ptr->nch > 1)
+    return cascade_form_iir_multi_kernel (lseg, x_ptr, y_ptr, &(iir_ptr->k0), iir_ptr->idown, iir_ptr->hswitch, iir_ptr->nch, iir_ptr->nblocks, iir_ptr->gain, iir_ptr->a, iir_ptr->b, iir_ptr->T);
   if (iir_ptr->hswitch == 'U')
     return cascade_form_iir_up_kernel ( /* returns number of output samples */
                                         lseg,   /* In : input signal leng. */
@@ -783,6 +1001,184 @@ static long cascade_form_iir_up_kernel (long lenx, float *x, float *y, long iup,
 /* ............... End of cascade_form_iir_up_kernel() ............... */
 
 
+/*
+  ----------------------------------------------------------------------------
+  void cascade_lanes_sample (double *xj, long nblocks, float (*a)[2],
+                             float (*b)[2], float (*T)[4]);
+
+  Run one input sample of each of CASC_LANES channels, xj[0..3], through
+  all the stages of the cascade, leaving the last stage outputs in xj[].
+  T holds 4 rows per stage (T[n][0..3] of the mono kernels), each row
+  with the value of the CASC_LANES channels. The arithmetic is that of
+  the mono kernels, with the same types and order of operations.
+  ----------------------------------------------------------------------------
+*/
+static void cascade_lanes_sample (double *xj, long nblocks, float (*a)[2], float (*b)[2], float (*T)[4]) {
+  long n;
+
+#if defined(IIR_SIMD_SSE2)
+  __m128d lo = _mm_loadu_pd (xj), hi = _mm_loadu_pd (xj + 2), ylo, yhi;
+
+  for (n = 0; n < nblocks; n++, T += 4) {
+    __m128 T0 = _mm_loadu_ps (T[0]), T1 = _mm_loadu_ps (T[1]);
+    __m128 T2 = _mm_loadu_ps (T[2]), T3 = _mm_loadu_ps (T[3]);
+    __m128 p0 = _mm_mul_ps (_mm_set1_ps (a[n][0]), T0);
+    __m128 p1 = _mm_mul_ps (_mm_set1_ps (a[n][1]), T1);
+    __m128 q = _mm_add_ps (_mm_mul_ps (_mm_set1_ps (b[n][0]), T2), _mm_mul_ps (_mm_set1_ps (b[n][1]), T3));
+
+    ylo = _mm_sub_pd (_mm_add_pd (_mm_add_pd (lo, _mm_cvtps_pd (p0)), _mm_cvtps_pd (p1)), _mm_cvtps_pd (q));
+    yhi = _mm_sub_pd (_mm_add_pd (_mm_add_pd (hi, _mm_cvtps_pd (_mm_movehl_ps (p0, p0))), _mm_cvtps_pd (_mm_movehl_ps (p1, p1))), _mm_cvtps_pd (_mm_movehl_ps (q, q)));
+
+    /* Save samples in memory */
+    _mm_storeu_ps (T[1], T0);
+    _mm_storeu_ps (T[0], _mm_movelh_ps (_mm_cvtpd_ps (lo), _mm_cvtpd_ps (hi)));
+    _mm_storeu_ps (T[3], T2);
+    _mm_storeu_ps (T[2], _mm_movelh_ps (_mm_cvtpd_ps (ylo), _mm_cvtpd_ps (yhi)));
+
+    /* The yj of this stage is the xj of the next */
+    lo = ylo;
+    hi = yhi;
+  }
+  _mm_storeu_pd (xj, lo);
+  _mm_storeu_pd (xj + 2, hi);
+#elif defined(IIR_SIMD_NEON)
+  float64x2_t lo = vld1q_f64 (xj), hi = vld1q_f64 (xj + 2), ylo, yhi;
+
+  for (n = 0; n < nblocks; n++, T += 4) {
+    float32x4_t T0 = vld1q_f32 (T[0]), T1 = vld1q_f32 (T[1]);
+    float32x4_t T2 = vld1q_f32 (T[2]), T3 = vld1q_f32 (T[3]);
+    float32x4_t p0 = vmulq_n_f32 (T0, a[n][0]);
+    float32x4_t p1 = vmulq_n_f32 (T1, a[n][1]);
+    float32x4_t q = vaddq_f32 (vmulq_n_f32 (T2, b[n][0]), vmulq_n_f32 (T3, b[n][1]));
+
+    ylo = vsubq_f64 (vaddq_f64 (vaddq_f64 (lo, vcvt_f64_f32 (vget_low_f32 (p0))), vcvt_f64_f32 (vget_low_f32 (p1))), vcvt_f64_f32 (vget_low_f32 (q)));
+    yhi = vsubq_f64 (vaddq_f64 (vaddq_f64 (hi, vcvt_high_f64_f32 (p0)), vcvt_high_f64_f32 (p1)), vcvt_high_f64_f32 (q));
+
+    /* Save samples in memory */
+    vst1q_f32 (T[1], T0);
+    vst1q_f32 (T[0], vcombine_f32 (vcvt_f32_f64 (lo), vcvt_f32_f64 (hi)));
+    vst1q_f32 (T[3], T2);
+    vst1q_f32 (T[2], vcombine_f32 (vcvt_f32_f64 (ylo), vcvt_f32_f64 (yhi)));
+
+    /* The yj of this stage is the xj of the next */
+    lo = ylo;
+    hi = yhi;
+  }
+  vst1q_f64 (xj, lo);
+  vst1q_f64 (xj + 2, hi);
+#else
+  long l;
+  double yj;
+
+  for (l = 0; l < CASC_LANES; l++)
+    for (n = 0; n < nblocks; n++) {
+      yj = xj[l] + a[n][0] * T[4 * n][l] + a[n][1] * T[4 * n + 1][l];
+      yj -= (b[n][0] * T[4 * n + 2][l] + b[n][1] * T[4 * n + 3][l]);
+
+      /* Save samples in memory */
+      T[4 * n + 1][l] = T[4 * n][l];
+      T[4 * n][l] = xj[l];
+      T[4 * n + 3][l] = T[4 * n + 2][l];
+      T[4 * n + 2][l] = yj;
+
+      /* The yj of this stage is the xj of the next */
+      xj[l] = yj;
+    }
+#endif
+}
+
+
+/*
+  ============================================================================
+
+  long cascade_form_iir_multi_kernel(long lenx, float *x,
+  ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ float *y, long *k0,
+                                     long idown, char hswitch,
+                                     long nch, long nblocks,
+                                     double gain, float (*a)[2],
+                                     float (*b)[2], float (*T)[4]);
+
+  Description:
+  ~~~~~~~~~~~~
+
+  Function for filtering a sequence of interleaved samples of nch
+  channels by a cascade-form IIR-filter with down-sampling (or
+  up-sampling, if hswitch is 'U'). The recursion is serial in time but
+  independent across channels, so the channels are processed in groups
+  of CASC_LANES, one channel per SIMD lane. The output of each channel
+  is identical to that of cascade_form_iir_down_kernel() or
+  cascade_form_iir_up_kernel() run on that channel alone.
+
+  Parameters:
+  ~~~~~~~~~~~
+  lenx: ........ (In) number of input samples per channel
+  x: ........... (In) array with lenx*nch interleaved input samples
+  y: ........... (Out) array with interleaved output samples
+  k0: .......... (In/Out) pointer to modulo counter (down-sampling)
+  idown: ....... (In) down-sampling (or up-sampling) factor
+  hswitch: ..... (In) 'U' for up-sampling, else down-sampling
+  nch: ......... (In) number of interleaved channels
+  nblocks: ..... (In) number of coeff. sets
+  gain: ........ (In) gain factor
+  a: ........... (In) numerator coefficients
+  b: ........... (In) denominator coefficients
+  T: ........... (In/Out) state variables, 4*nblocks rows per group of
+                 CASC_LANES channels (see cascade_iir_set_channels())
+
+  Return value:
+  ~~~~~~~~~~~~~
+  Returns the number of samples filtered per channel.
+
+  History:
+  ~~~~~~~~
+  16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static long cascade_form_iir_multi_kernel (long lenx, float *x, float *y, long *k0, long idown, char hswitch, long nch, long nblocks, double gain, float (*a)[2], float (*b)[2], float (*T)[4]) {
+  double xj[CASC_LANES];
+  long kx, ky, k, c, i, l, lanes;
+
+  k = ky = 0;
+  for (c = 0; c < nch; c += CASC_LANES, T += 4 * nblocks) {
+    lanes = nch - c < CASC_LANES ? nch - c : CASC_LANES;
+    for (l = lanes; l < CASC_LANES; l++)        /* unused lanes stay null */
+      xj[l] = 0.0;
+
+    ky = 0;
+    if (hswitch == 'U') {
+      for (kx = 0; kx < lenx; kx++) {
+        for (i = 0; i < idown; i++, ky++) {
+          /* Input sample OR zero-valued sample */
+          for (l = 0; l < lanes; l++)
+            xj[l] = i == 0 ? x[kx * nch + c + l] : 0.0;
+          cascade_lanes_sample (xj, nblocks, a, b, T);
+          for (l = 0; l < lanes; l++)
+            y[ky * nch + c + l] = xj[l] * gain;
+        }
+      }
+    } else {
+      for (k = *k0, kx = 0; kx < lenx; kx++, k++) {
+        for (l = 0; l < lanes; l++)
+          xj[l] = x[kx * nch + c + l];
+        cascade_lanes_sample (xj, nblocks, a, b, T);
+
+        if (k % idown == 0) {   /* compute output only every "idown" samples */
+          for (l = 0; l < lanes; l++)
+            y[ky * nch + c + l] = xj[l] * gain;
+          ky++;
+        }
+      }
+    }
+  }
+  if (hswitch != 'U')
+    *k0 = k % idown;            /* all groups end on the same count */
+  return ky;
+}
+
+/* ............. End of cascade_form_iir_multi_kernel() ............. */
+
+
 /*
   ============================================================================
 
@@ -862,6 +1258,7 @@ CASCADE_IIR *cascade_iir_init (long nblocks, float (*a)[2], float (*b)[2], doubl
   }
 
   ptrIIR->k0 = idown;           /* modulo counter for down-sampling */
+  ptrIIR->nch = 1;              /* mono, unless set otherwise */
 
 
   /* Exit returning pointer to struct */
@@ -871,6 +1268,65 @@ CASCADE_IIR *cascade_iir_init (long nblocks, float (*a)[2], float (*b)[2], doubl
 /* ....................... End of cascade_iir_init() ....................... */
 
 
+/*
+  ============================================================================
+
+  int cascade_iir_set_channels (CASCADE_IIR *iir_ptr, long nch);
+  ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+  Description:
+  ~~~~~~~~~~~~
+  Set the number of interleaved channels to be filtered by
+  cascade_iir_kernel(). The state variables are reallocated and
+  cleared. For nch>1 they are kept as 4*nblocks rows per group of
+  CASC_LANES channels: T[(g*nblocks + n)*4 + k][l] is the state
+  variable k of stage n for channel g*CASC_LANES+l; unused lanes of the
+  last group stay null.
+
+  Parameters:
+  ~~~~~~~~~~~
+  CASCADE_IIR *iir_ptr: ... pointer to struct CASCADE_IIR previously
+                            initialized by a call to one of the
+                            initialization routines.
+  long nch: ............... number of interleaved channels (>= 1)
+
+  Return value:
+  ~~~~~~~~~~~~~
+  Returns 0 on success, -1 on invalid nch or lack of memory (the filter
+  is then left unchanged).
+
+  History:
+  ~~~~~~~~
+  16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+int cascade_iir_set_channels (CASCADE_IIR * iir_ptr, long nch) {
+  float (*T_ptr)[4];
+  long nrows;
+
+  if (nch < 1)
+    return -1;
+
+  /* Number of state rows: 1 per stage, or 4 per stage & channel group */
+  nrows = iir_ptr->nblocks;
+  if (nch > 1)
+    nrows *= 4 * ((nch + CASC_LANES - 1) / CASC_LANES);
+
+  if ((T_ptr = (float (*)[4]) malloc (nrows * 4 * sizeof (float))) == (float (*)[4]) 0)
+    return -1;
+  free (iir_ptr->T);
+  iir_ptr->T = T_ptr;
+  iir_ptr->nch = nch;
+
+  /* Start from cleared state variables */
+  cascade_iir_reset (iir_ptr);
+  return 0;
+}
+
+/* ................... End of cascade_iir_set_channels() ................... */
+
+
 /*
   ============================================================================
 
@@ -1,6 +1,6 @@
 /*
   ============================================================================
-   File: IIRFLT.H                                     Version: 3.0 - 31.JUL.95
+   File: IIRFLT.H                                     Version: 3.2 - 16.OCT.26
   ============================================================================
 
                             UGST/ITU-T IIR FILTERS
@@ -12,6 +12,10 @@
    30.Oct.94	v2.0	Name changed to iirflt.h/included cascade-form 
                         IIR filters <simao@ctd.comsat.com>
    31.Jul.95	v3.0	Added direct-form IIR filters <simao@ctd.comsat.com>
+   16.Oct.26	v3.1	Parallel-form coefficients repacked for the SIMD
+                        kernel (field soa of SCD_IIR)
+   16.Oct.26	v3.2	Interleaved multi-channel cascade-form filtering
+                        (field nch of CASCADE_IIR)
 
   ============================================================================
 */
@@ -42,6 +46,8 @@ typedef struct {
   float (*b)[3];                /* In : numerator coefficients */
   float (*c)[2];                /* In : denominator coefficients */
   float (*T)[2];                /* In/Out : state variables */
+  float *soa;                   /* In : coefficients & work state, 4
+                                 * sections per SIMD group (NULL: none) */
   char hswitch;                 /* "U": upsampling; else downsampling */
 } SCD_IIR;
 
@@ -56,7 +62,9 @@ typedef struct {
   double gain;                  /* gain factor */
   float (*a)[2];                /* In : numerator coefficients */
   float (*b)[2];                /* In : denominator coefficients */
-  float (*T)[4];                /* In/Out : state variables, 1 for each stage */
+  float (*T)[4];                /* In/Out : state variables, 1 for each stage;
+                                 * for nch>1, rows of 4 channels (lanes) */
+  long nch;                     /* number of interleaved channels */
   char hswitch;                 /* "U": upsampling; else downsampling */
 } CASCADE_IIR;
 
@@ -97,6 +105,7 @@ SCD_IIR *stdpcm_1_to_2_init ARGS ((void));
 long cascade_iir_kernel ARGS ((long lseg, float *x_ptr, CASCADE_IIR * iir_ptr, float *y_ptr));
 void cascade_iir_reset ARGS ((CASCADE_IIR * iir_ptr));
 void cascade_iir_free ARGS ((CASCADE_IIR * iir_ptr));
+int cascade_iir_set_channels ARGS ((CASCADE_IIR * iir_ptr, long nch));
 
 /* Additions to the STL92: cascade IIR filter initialization */
 CASCADE_IIR *iir_G712_8khz_init ARGS ((void));
@@ -1,22 +1,54 @@
 #include <assert.h>
+#include <string.h>
 #include "filtering_routines.h"
 
+#if defined(__SSE2__) || defined(_M_X64)
+#define FILTER_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define FILTER_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 void filterFunc_IIR(const double *input, double *output, int length, const double *coeffs, int order, double *delay)
 {
-    /* NOTE: Limitation of the implementation below */
-    assert(order == 2);
+    /* NOTE: even orders only, as cascaded second-order sections */
+    assert(order % 2 == 0);
 
-    while (length-- > 0) {
-        double in, out;
+    filterFunc_SOS(input, output, length, coeffs, order / 2, delay);
+}
 
-        in = *input++;
+/*
+ * Cascade of nsec second-order sections, in transposed direct form II.
+ * Section k has the coefficients b0 b1 b2 a0 a1 a2 in coeffs[6*k..6*k+5]
+ * (a0 = 1 is not used) and the delay elements delay[2*k], delay[2*k+1].
+ * The whole block is run through each section in turn, which gives the
+ * same results as running each sample through the cascade.
+ */
+void filterFunc_SOS(const double *input, double *output, int length, const double *coeffs, int nsec, double *delay)
+{
+    int k, n;
 
-        out = in * coeffs[0] + delay[1];
-        delay[1] = in * coeffs[1] - out * coeffs[4] + delay[0];
-        delay[0] = in * coeffs[2] - out * coeffs[5];
+    for (k = 0; k < nsec; k++, coeffs += 6, delay += 2) {
+        const double b0 = coeffs[0], b1 = coeffs[1], b2 = coeffs[2];
+        const double a1 = coeffs[4], a2 = coeffs[5];
+        double d0 = delay[0], d1 = delay[1];
+        const double *in = (k == 0) ? input : output;
 
-        *output++ = out;
+        for (n = 0; n < length; n++) {
+            double x = in[n], y;
+
+            y = x * b0 + d1;
+            d1 = x * b1 - y * a1 + d0;
+            d0 = x * b2 - y * a2;
+
+            output[n] = y;
+        }
+        delay[0] = d0;
+        delay[1] = d1;
     }
+    if (nsec == 0 && output != input)
+        memmove(output, input, length * sizeof(double));
 }
 
 void filterFunc_FIR(const double *input, double *output, int length, const double *coeffs, int order, double *delay)
@@ -39,3 +71,72 @@ void filterFunc_FIR(const double *input, double *output, int length, const doubl
         *output++ = out;
     }
 }
+
+/*
+ * out[n] = sum of coeffs[i] * x[n-i], i=0..order-1, for m outputs from the
+ * contiguous samples x[-(order-1)]..x[m-1]. The SIMD paths compute several
+ * outputs at once, each one summed in the same order as filterFunc_FIR(),
+ * hence the results are identical.
+ */
+static void fir_dot_block(const double *x, double *out, int m, const double *coeffs, int order)
+{
+    int n = 0, i;
+
+#if defined(FILTER_SIMD_SSE2)
+    for (; n + 4 <= m; n += 4) {
+        __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+
+        for (i = 0; i < order; i++) {
+            __m128d c = _mm_set1_pd(coeffs[i]);
+            acc0 = _mm_add_pd(acc0, _mm_mul_pd(c, _mm_loadu_pd(&x[n - i])));
+            acc1 = _mm_add_pd(acc1, _mm_mul_pd(c, _mm_loadu_pd(&x[n - i + 2])));
+        }
+        _mm_storeu_pd(&out[n], acc0);
+        _mm_storeu_pd(&out[n + 2], acc1);
+    }
+#elif defined(FILTER_SIMD_NEON)
+    for (; n + 4 <= m; n += 4) {
+        float64x2_t acc0 = vdupq_n_f64(0), acc1 = vdupq_n_f64(0);
+
+        for (i = 0; i < order; i++) {
+            float64x2_t c = vdupq_n_f64(coeffs[i]);
+            acc0 = vaddq_f64(acc0, vmulq_f64(c, vld1q_f64(&x[n - i])));
+            acc1 = vaddq_f64(acc1, vmulq_f64(c, vld1q_f64(&x[n - i + 2])));
+        }
+        vst1q_f64(&out[n], acc0);
+        vst1q_f64(&out[n + 2], acc1);
+    }
+#endif
+    for (; n < m; n++) {
+        double acc = 0;
+
+        for (i = 0; i < order; i++)
+            acc += coeffs[i] * x[n - i];
+        out[n] = acc;
+    }
+}
+
+/*
+ * Block FIR with a double buffer: delay (2*order doubles, zeroed before
+ * the first call) holds the last order-1 input samples, followed by room
+ * for up to order+1 new ones, so the samples of a dot product are always
+ * contiguous and the history is moved once per order+1 samples instead of
+ * once per sample. Same results as filterFunc_FIR().
+ */
+void filterFunc_FIR_block(const double *input, double *output, int length, const double *coeffs, int order, double *delay)
+{
+    const int hist = order - 1, room = order + 1;
+    int m;
+
+    while (length > 0) {
+        m = (length < room) ? length : room;
+
+        memcpy(&delay[hist], input, m * sizeof(double));
+        fir_dot_block(&delay[hist], output, m, coeffs, order);
+        memmove(delay, &delay[m], hist * sizeof(double));
+
+        input += m;
+        output += m;
+        length -= m;
+    }
+}
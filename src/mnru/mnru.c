@@ -43,6 +43,10 @@ MNRU_process: ......	Processes the `input' buffer of `n' samples (in
                         model (input data is sampled at 8 kHz). Its prototype
                         is in mnru.h.
 
+random_MNRU_block: .... Fills a buffer with noise samples for the MNRU, either
+                        bit-exact with random_MNRU() or with a faster
+                        counter-based generator. Its prototype is in mnru.h.
+
 random_MNRU: .......... Generates gaussian-like noise samples for use by the
                         MNRU_process function. Depends on a seed when `*mode'
                         is 1 (RANDOM_RESET), causing the initialization of
@@ -67,6 +71,12 @@ HISTORY:
                         To increase speed, a new random number generator
                         has been included. Works for both narrow-band and
                         wideband speech.
+  16.Oct.26  v2.1       Block noise generation (random_MNRU_block()): the
+                        compatible mode is bit-exact with new_random_MNRU(),
+                        the fast mode (MNRU_START_FAST) uses a counter-based
+                        RNG and a Ziggurat gaussian generator.
+  16.Oct.26  v2.2       P.50 noise shaping with the block filters
+                        filterFunc_SOS() and filterFunc_FIR_block().
 =============================================================================
 */
 
@@ -83,6 +93,8 @@ HISTORY:
 #include <string.h>             /* for memset() */
 #include "ugst-utl.h"           /* for ran16_32c */
 
+#define DNULL (double *)0
+
 #ifndef STL92_RNG               /* Uses the new Random Number Generator */
 #define random_MNRU new_random_MNRU
 
@@ -245,6 +257,293 @@ float ran_vax () {
 
 /*  ......................... End of ran_vax() ............................ */
 
+
+/*
+  ----------------------------------------------------------------------------
+  Fast noise mode: a counter-based RNG feeding a Ziggurat gaussian generator.
+
+  Sample number c of the stream is derived from a 32-bit integer hash of the
+  counter c and of the stream key; rejected Ziggurat candidates draw further
+  numbers from a sub-stream of the same hash. Hence every sample depends only
+  on (key,c), independent of the block size, and the hashes of a block are
+  computed with SIMD instructions. The Ziggurat has 128 layers [Marsaglia &
+  Tsang, "The Ziggurat Method for Generating Random Variables", J. Stat.
+  Software 5(8), 2000]. The unit-variance output is scaled by MNRU_FAST_SIGMA,
+  the standard deviation of the compatible (table-based) noise: a sum of 8
+  gaussian samples of sigma 2 truncated at +-8, divided by 2.
+  ----------------------------------------------------------------------------
+*/
+#define MNRU_ZIG_LAYERS 128
+#define MNRU_ZIG_R      3.442619855899  /* start of the tail */
+#define MNRU_ZIG_V      9.91256303526217e-3     /* area of each layer */
+#define MNRU_FAST_SIGMA 2.826912
+#define MNRU_FAST_CHUNK 256             /* samples hashed per pass */
+
+struct MNRU_ziggurat {
+  unsigned int k[MNRU_ZIG_LAYERS];      /* acceptance thresholds for |hz| */
+  double w[MNRU_ZIG_LAYERS];            /* layer width / 2^31 */
+  double f[MNRU_ZIG_LAYERS];            /* gaussian at the layer edges */
+};
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define MNRU_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define MNRU_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+/* 32-bit integer hash (bijective) */
+static unsigned int mnru_hash32 (unsigned int x) {
+  x ^= x >> 16;
+  x *= 0x7feb352dU;
+  x ^= x >> 15;
+  x *= 0x846ca68bU;
+  x ^= x >> 16;
+  return x;
+}
+
+/* Set up the Ziggurat tables */
+static void mnru_zig_init (struct MNRU_ziggurat *z) {
+  double m1 = 2147483648.0, dn = MNRU_ZIG_R, tn = dn, q;
+  int i;
+
+  q = MNRU_ZIG_V / exp (-0.5 * dn * dn);
+  z->k[0] = (unsigned int) ((dn / q) * m1);
+  z->k[1] = 0;
+  z->w[0] = q / m1;
+  z->w[MNRU_ZIG_LAYERS - 1] = dn / m1;
+  z->f[0] = 1.0;
+  z->f[MNRU_ZIG_LAYERS - 1] = exp (-0.5 * dn * dn);
+  for (i = MNRU_ZIG_LAYERS - 2; i >= 1; i--) {
+    dn = sqrt (-2.0 * log (MNRU_ZIG_V / dn + exp (-0.5 * dn * dn)));
+    z->k[i + 1] = (unsigned int) ((dn / tn) * m1);
+    tn = dn;
+    z->f[i] = exp (-0.5 * dn * dn);
+    z->w[i] = dn / m1;
+  }
+}
+
+/* Extra number j of the sub-stream of sample hash h */
+static unsigned int mnru_sub (unsigned int h, int *j) {
+  return mnru_hash32 (h ^ (0x85ebca6bU * (unsigned int) ++(*j)));
+}
+
+/* Uniform number in ]0,1[ from the sub-stream of sample hash h */
+static double mnru_uni (unsigned int h, int *j) {
+  return ((double) (mnru_sub (h, j) >> 8) + 0.5) / 16777216.0;
+}
+
+/* Unit-variance gaussian sample for the sample hash h */
+static double mnru_zig_normal (const struct MNRU_ziggurat *z, unsigned int h) {
+  unsigned int u = h, iz, au;
+  double x, y;
+  int j = 0;
+
+  for (;;) {
+    iz = u & (MNRU_ZIG_LAYERS - 1);
+    au = (u & 0x80000000U) ? 0U - u : u;
+    x = (double) (int) u * z->w[iz];
+    if (au < z->k[iz])
+      return x;                 /* inside the layer's rectangle: ~99% */
+    if (iz == 0) {              /* base layer: sample from the tail */
+      do {
+        x = -log (mnru_uni (h, &j)) / MNRU_ZIG_R;
+        y = -log (mnru_uni (h, &j));
+      } while (y + y < x * x);
+      return (u & 0x80000000U) ? -MNRU_ZIG_R - x : MNRU_ZIG_R + x;
+    }
+    if (z->f[iz] + mnru_uni (h, &j) * (z->f[iz - 1] - z->f[iz]) < exp (-0.5 * x * x))
+      return x;
+    u = mnru_sub (h, &j);
+  }
+}
+
+#if defined(MNRU_SIMD_SSE2)
+/* Low 32 bits of the 4 lane products (SSE2 lacks pmulld) */
+static __m128i mnru_mullo (__m128i a, __m128i b) {
+  __m128i even = _mm_mul_epu32 (a, b);
+  __m128i odd = _mm_mul_epu32 (_mm_srli_epi64 (a, 32), _mm_srli_epi64 (b, 32));
+  return _mm_unpacklo_epi32 (_mm_shuffle_epi32 (even, _MM_SHUFFLE (0, 0, 2, 0)), _mm_shuffle_epi32 (odd, _MM_SHUFFLE (0, 0, 2, 0)));
+}
+#endif
+
+/* h[k] = hash of counter c+k with the key base, k=0..m-1 */
+static void mnru_hash_block (unsigned int *h, unsigned int c, unsigned int base, long m) {
+  long k = 0;
+
+#if defined(MNRU_SIMD_SSE2)
+  __m128i cv = _mm_setr_epi32 ((int) c, (int) (c + 1), (int) (c + 2), (int) (c + 3));
+  __m128i four = _mm_set1_epi32 (4), g = _mm_set1_epi32 ((int) 0x9e3779b9U);
+  __m128i bv = _mm_set1_epi32 ((int) base);
+  __m128i m1 = _mm_set1_epi32 (0x7feb352d), m2 = _mm_set1_epi32 ((int) 0x846ca68bU);
+  __m128i x;
+
+  for (; k + 4 <= m; k += 4) {
+    x = _mm_xor_si128 (mnru_mullo (cv, g), bv);
+    x = _mm_xor_si128 (x, _mm_srli_epi32 (x, 16));
+    x = mnru_mullo (x, m1);
+    x = _mm_xor_si128 (x, _mm_srli_epi32 (x, 15));
+    x = mnru_mullo (x, m2);
+    x = _mm_xor_si128 (x, _mm_srli_epi32 (x, 16));
+    _mm_storeu_si128 ((__m128i *) & h[k], x);
+    cv = _mm_add_epi32 (cv, four);
+  }
+#elif defined(MNRU_SIMD_NEON)
+  static const uint32_t lane[4] = { 0, 1, 2, 3 };
+  uint32x4_t cv = vaddq_u32 (vdupq_n_u32 (c), vld1q_u32 (lane));
+  uint32x4_t four = vdupq_n_u32 (4), bv = vdupq_n_u32 (base), x;
+
+  for (; k + 4 <= m; k += 4) {
+    x = veorq_u32 (vmulq_n_u32 (cv, 0x9e3779b9U), bv);
+    x = veorq_u32 (x, vshrq_n_u32 (x, 16));
+    x = vmulq_n_u32 (x, 0x7feb352dU);
+    x = veorq_u32 (x, vshrq_n_u32 (x, 15));
+    x = vmulq_n_u32 (x, 0x846ca68bU);
+    x = veorq_u32 (x, vshrq_n_u32 (x, 16));
+    vst1q_u32 (&h[k], x);
+    cv = vaddq_u32 (cv, four);
+  }
+#endif
+  for (; k < m; k++)
+    h[k] = mnru_hash32 (((c + (unsigned int) k) * 0x9e3779b9U) ^ base);
+}
+
+/* Fast mode: n samples of the counter-based stream of r */
+static void mnru_noise_fast (new_RANDOM_state * r, double *noise, long n) {
+  unsigned int h[MNRU_FAST_CHUNK], base;
+  long k, m;
+
+  while (n > 0) {
+    m = (n < MNRU_FAST_CHUNK) ? n : MNRU_FAST_CHUNK;
+
+    /* A pass does not cross a wrap-around of the low counter word */
+    if (r->ctr_lo + (unsigned int) (m - 1) < r->ctr_lo)
+      m = (long) (0U - r->ctr_lo);
+
+    base = mnru_hash32 (r->key ^ mnru_hash32 (r->ctr_hi));
+    mnru_hash_block (h, r->ctr_lo, base, m);
+    for (k = 0; k < m; k++)
+      noise[k] = MNRU_FAST_SIGMA * mnru_zig_normal (r->zig, h[k]);
+
+    if ((r->ctr_lo += (unsigned int) m) == 0)
+      r->ctr_hi++;
+    noise += m;
+    n -= m;
+  }
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+  Compatible mode: n samples of new_random_MNRU(), bit-exact.
+
+  ran16_32c() is a LCG modulo 2^24 computed in double precision; for an
+  integer seed it is exact, so the 8 table indices of a sample are computed
+  directly from the seed with integer arithmetic (seed after i+1 steps is
+  a[i]*seed+c[i] mod 2^24), which removes the dependency chain between them.
+  The table samples are summed in the original order. Non-integer seeds are
+  left to ran16_32c().
+  ----------------------------------------------------------------------------
+*/
+static void mnru_noise_compat (new_RANDOM_state * r, float *fseed, double *noise, long n) {
+  unsigned int a[ITER_NO], c[ITER_NO], seed;
+  char run = RANDOM_RUN;
+  double z1;
+  long k;
+  int i;
+
+  if (!(*fseed >= 0 && *fseed < 16777216.0 && *fseed == (float) floor (*fseed))) {
+    for (k = 0; k < n; k++)
+      noise[k] = (double) new_random_MNRU (&run, r, 0L, fseed);
+    return;
+  }
+
+  a[0] = 253;
+  c[0] = 1;
+  for (i = 1; i < ITER_NO; i++) {
+    a[i] = a[i - 1] * 253;
+    c[i] = c[i - 1] * 253 + 1;
+  }
+
+  seed = (unsigned int) *fseed;
+  for (k = 0; k < n; k++) {
+    for (z1 = 0, i = 0; i < ITER_NO; i++)
+      z1 += r->gauss[(((a[i] * seed + c[i]) & 0xFFFFFF) >> 8) / FACTOR];
+    seed = (a[ITER_NO - 1] * seed + c[ITER_NO - 1]) & 0xFFFFFF;
+    z1 /= 2;
+    noise[k] = (double) (float) z1;
+  }
+  *fseed = (float) seed;
+}
+
+
+/*
+  =============================================================================
+
+	double *random_MNRU_block (char *mode, RANDOM_state *r, long seed,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~  float *fseed, double *noise, long n)
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Fill `noise' with `n' gaussian noise samples for the MNRU.
+
+        If r->fast is 0, the samples are bit-exact with n calls of
+        new_random_MNRU() with the same `fseed', which is updated likewise.
+        Otherwise a counter-based RNG and a Ziggurat gaussian generator
+        are used, keyed by the value of `fseed' at reset time (`fseed' is
+        then left unchanged). The fast noise has the same variance as the
+        compatible noise, but not the same sample values.
+
+	To (re)initialize the sequence, use mode=RANDOM_RESET (the routine
+	will change mode to RANDOM_RUN).
+
+        Returns `noise', or a (double *)NULL if the Ziggurat table of the
+        fast generator could not be allocated.
+
+        Prototype: MNRU.H
+        ~~~~~~~~~~
+
+        History:
+        ~~~~~~~~
+        16.Oct.26  1.0	Created.
+
+=============================================================================
+*/
+double *random_MNRU_block (char *mode, RANDOM_state * r, long seed, float *fseed, double *noise, long n) {
+  if (n <= 0)
+    return (noise);
+
+  if (r->fast) {
+    if (*mode == RANDOM_RESET) {
+      if (r->zig == NULL && (r->zig = (struct MNRU_ziggurat *) calloc (1, sizeof (struct MNRU_ziggurat))) == NULL)
+        return ((double *) DNULL);
+      *mode = RANDOM_RUN;
+      mnru_zig_init (r->zig);
+      r->key = mnru_hash32 ((unsigned int) (long) *fseed);
+      r->ctr_lo = r->ctr_hi = 0;
+    }
+    mnru_noise_fast (r, noise, n);
+    return (noise);
+  }
+
+  /* 1st sample after a reset builds the gaussian table */
+  if (*mode == RANDOM_RESET) {
+    *noise++ = (double) new_random_MNRU (mode, r, seed, fseed);
+    n--;
+  }
+  mnru_noise_compat (r, fseed, noise, n);
+  return (noise);
+}
+
+#undef MNRU_FAST_CHUNK
+#undef MNRU_FAST_SIGMA
+#undef MNRU_ZIG_V
+#undef MNRU_ZIG_R
+#undef MNRU_ZIG_LAYERS
+/*  ................... End of random_MNRU_block() ...................... */
+
 #else /* Use the original MNRU noise generator */
 
 #define random_MNRU ori_random_MNRU
@@ -385,10 +684,63 @@ float ori_random_MNRU (char *mode, RANDOM_state r, long seed) {
 #undef FAC
 /*  .................... End of ori_random_MNRU() ....................... */
 
+
+/* Block version of ori_random_MNRU(), for MNRU_process() */
+double *random_MNRU_block (char *mode, RANDOM_state * r, long seed, float *fseed, double *noise, long n) {
+  long k;
+
+  for (k = 0; k < n; k++)
+    noise[k] = (double) random_MNRU (mode, r, seed);
+  return (noise);
+}
+
 #endif /* *********************** STL92_RNG ****************************** */
 
 
 
+/*
+  ----------------------------------------------------------------------------
+  void mnru_lp_init (MNRU_state *s);
+
+  Reset the memory and load the coefficients of the output low-pass filter.
+  ----------------------------------------------------------------------------
+*/
+static void mnru_lp_init (MNRU_state * s) {
+  /* Cleanup memory */
+  memset (s->DLY, '\0', sizeof (s->DLY));
+
+#ifdef NBMNRU_MASK_ONLY
+  /* Load numerator coefficients */
+  s->A[0][0] = 0.758717518025;
+  s->A[0][1] = 1.50771485802;
+  s->A[0][2] = 0.758717518025;
+  s->A[1][0] = 0.758717518025;
+  s->A[1][1] = 1.46756552150;
+  s->A[1][2] = 0.758717518025;
+
+  /* Load denominator coefficients */
+  s->B[0][0] = 1.16833932919;
+  s->B[0][1] = 0.400250061172;
+  s->B[1][0] = 1.66492368687;
+  s->B[1][1] = 0.850653444434;
+#else
+  /* Load numerator coefficients */
+  s->A[0][0] = 0.775841885724;
+  s->A[0][1] = 1.54552788762;
+  s->A[0][2] = 0.775841885724;
+  s->A[1][0] = 0.775841885724;
+  s->A[1][1] = 1.51915539326;
+  s->A[1][2] = 0.775841885724;
+
+  /* Load denominator coefficients */
+  s->B[0][0] = 1.23307153957;
+  s->B[0][1] = 0.430807372835;
+  s->B[1][0] = 1.71128410940;
+  s->B[1][1] = 0.859087959597;
+#endif
+}
+
+
 /*
   ==========================================================================
 
@@ -473,8 +825,6 @@ float ori_random_MNRU (char *mode, RANDOM_state r, long seed) {
 #define ALPHA_30Hz 0.9961           // dcFilter = 3
 #define ALPHA_15Hz 0.998            // dcFilter = 4
 
-#define DNULL (double *)0
-
 // Noise gain definition for NB and WB MNRU
 #ifdef STL92_RNG
 #define NOISE_GAIN 0.541
@@ -500,7 +850,7 @@ double *MNRU_process (char operation, MNRU_state * s, float *input, float *outpu
    */
 
   /* Check if is START of operation: reset state and allocate memory buffer */
-  if (operation == MNRU_START) {
+  if (operation == MNRU_START || operation == MNRU_START_FAST) {
 
     /* Reset clip counter */
     s->clip = 0;
@@ -528,40 +878,14 @@ double *MNRU_process (char operation, MNRU_state * s, float *input, float *outpu
 
     /* Flag for random sequence initialization */
     s->rnd_mode = RANDOM_RESET;
+#ifndef STL92_RNG
+    s->rnd_state.gauss = NULL;
+    s->rnd_state.zig = NULL;
+    s->rnd_state.fast = (operation == MNRU_START_FAST);
+#endif
 
     /* Initialization of the output low-pass filter */
-    /* Cleanup memory */
-    memset (s->DLY, '\0', sizeof (s->DLY));
-
-#ifdef NBMNRU_MASK_ONLY
-    /* Load numerator coefficients */
-    s->A[0][0] = 0.758717518025;
-    s->A[0][1] = 1.50771485802;
-    s->A[0][2] = 0.758717518025;
-    s->A[1][0] = 0.758717518025;
-    s->A[1][1] = 1.46756552150;
-    s->A[1][2] = 0.758717518025;
-
-    /* Load denominator coefficients */
-    s->B[0][0] = 1.16833932919;
-    s->B[0][1] = 0.400250061172;
-    s->B[1][0] = 1.66492368687;
-    s->B[1][1] = 0.850653444434;
-#else
-    /* Load numerator coefficients */
-    s->A[0][0] = 0.775841885724;
-    s->A[0][1] = 1.54552788762;
-    s->A[0][2] = 0.775841885724;
-    s->A[1][0] = 0.775841885724;
-    s->A[1][1] = 1.51915539326;
-    s->A[1][2] = 0.775841885724;
-
-    /* Load denominator coefficients */
-    s->B[0][0] = 1.23307153957;
-    s->B[0][1] = 0.430807372835;
-    s->B[1][0] = 1.71128410940;
-    s->B[1][1] = 0.859087959597;
-#endif
+    mnru_lp_init (s);
 
     /* Initialization of the input DC-removal filter */
     s->last_xk = s->last_yk = 0;
@@ -571,8 +895,11 @@ double *MNRU_process (char operation, MNRU_state * s, float *input, float *outpu
    *    ..... REAL MNRU WORK .....
    */
 
-  /* Initialize memory */
-  memset (s->vet, '\0', n * sizeof (double));
+  /* Noise samples for the whole block */
+  if (mode == SIGNAL_ONLY)
+    memset (s->vet, '\0', n * sizeof (double));
+  else if (random_MNRU_block (&s->rnd_mode, &s->rnd_state, s->seed, fseed, s->vet, n) == DNULL)
+    return ((double *) DNULL);
 
   for (count = 0; count < n; count++) {
     /* Copy sample to local variable */
@@ -595,7 +922,7 @@ double *MNRU_process (char operation, MNRU_state * s, float *input, float *outpu
     if (mode == SIGNAL_ONLY)
       noise = 0;
     else {
-      noise = (double) random_MNRU (&s->rnd_mode, &s->rnd_state, s->seed, fseed);
+      noise = s->vet[count];
       noise *= s->noise_gain * inp_smp; /* noise modulated by input sample */
       if (noise > 1.00 || noise < -1.00)
         s->clip++;              /* clip counter */
@@ -624,6 +951,9 @@ double *MNRU_process (char operation, MNRU_state * s, float *input, float *outpu
   /* Check if is end of operation THEN release memory buffer */
   if (operation == MNRU_STOP) {
     free (s->rnd_state.gauss);
+#ifndef STL92_RNG
+    free (s->rnd_state.zig);
+#endif
     free (s->vet);
     s->vet = (double *) DNULL;
   }
@@ -634,6 +964,24 @@ double *MNRU_process (char operation, MNRU_state * s, float *input, float *outpu
 /*  .................... End of MNRU_process() ....................... */
 
 
+/* DC-removal filter coefficient for the P.50 FB MNRU dcFilter mode */
+static double p50_dc_alpha(char dcFilter)
+{
+  switch (dcFilter) {
+    case 1:
+        return ALPHA;
+    case 2:
+        return ALPHA_60Hz;
+    case 3:
+        return ALPHA_30Hz;
+    case 4:
+        return ALPHA_15Hz;
+    default:
+        return 0;
+  }
+}
+
+
 /**
 *   double *P50_MNRU_process (char operation, MNRU_state *s, double *input, double *output,
 *        long n,char mode, double Q, float *fseed)
@@ -693,25 +1041,10 @@ double *P50_MNRU_process(char operation, MNRU_state *s, double* input, double* o
   */
 
   /* Set DC filter coefficient */
-  switch (dcFilter) {
-    case 1:
-        alpha = ALPHA;
-        break;
-    case 2:
-        alpha = ALPHA_60Hz;
-        break;
-    case 3:
-        alpha = ALPHA_30Hz;
-        break;
-    case 4:
-        alpha = ALPHA_15Hz;
-        break;
-    default:
-        alpha = 0;
-  }
+  alpha = p50_dc_alpha(dcFilter);
 
   /* Check if is START of operation: reset state and allocate memory buffer */
-  if (operation == MNRU_START)
+  if (operation == MNRU_START || operation == MNRU_START_FAST)
   {
     /* Reset clip counter */
     s->clip = 0;
@@ -741,13 +1074,18 @@ double *P50_MNRU_process(char operation, MNRU_state *s, double* input, double* o
 
     /* Flag for random sequence initialization */
     s->rnd_mode = RANDOM_RESET;
+#ifndef STL92_RNG
+    s->rnd_state.gauss = NULL;
+    s->rnd_state.zig = NULL;
+    s->rnd_state.fast = (operation == MNRU_START_FAST);
+#endif
 
     /* Initialization of the output low-pass filter */
     /* Cleanup memory */
     memset(s->DLY, '\0', sizeof(s->DLY));
 
     //	 Init filter delay lines and state variables
-	 if ((delayLine_FIR = (double *)calloc(iP50FIRcoeffsLen, sizeof(double))) == NULL)
+	 if ((delayLine_FIR = (double *)calloc(2 * iP50FIRcoeffsLen, sizeof(double))) == NULL)
 		 return NULL;
 	 if ((delayLine_IIR = (double *)calloc(iP50IIRorder,     sizeof(double))) == NULL)
 		 return NULL;
@@ -775,16 +1113,8 @@ double *P50_MNRU_process(char operation, MNRU_state *s, double* input, double* o
 	  memset(filteredNoiseTemp, 0, n * sizeof(double));
 
 	  //Fill noise array
-	  for (count = 0; count < n; count++)
-	  {
-		 /* Random number generation */
-		 if (mode == SIGNAL_ONLY)
-			s->vet[count] = 0;
-		 else
-		 {
-			s->vet[count] = (double) random_MNRU(&s->rnd_mode, &s->rnd_state, s->seed, fseed);
-		 }
-	  }
+	  if (random_MNRU_block(&s->rnd_mode, &s->rnd_state, s->seed, fseed, s->vet, n) == DNULL)
+		  return NULL;
 
 	  for (count = 0; count < n; count++)
 		  s->vet[count] *= s->noise_gain;
@@ -792,10 +1122,10 @@ double *P50_MNRU_process(char operation, MNRU_state *s, double* input, double* o
 	  /* Filter the noise according to P.50, two cascaded filters for P.50 filter:
 	  * An IIR highpass filter, followed by a FIR lowpass filter.
       * First, filter the data in s->vet using an IIR filter, and store the result in filteredNoiseTemp */
-	  filterFunc_IIR(s->vet, filteredNoiseTemp, n, dP50IIRcoeffs, iP50IIRorder, delayLine_IIR);
+	  filterFunc_SOS(s->vet, filteredNoiseTemp, n, dP50IIRcoeffs, iP50IIRorder / 2, delayLine_IIR);
 
 	  //Second, filter the data in filteredNoiseTemp using an FIR filter and store the result in s->vet
-	  filterFunc_FIR(filteredNoiseTemp, s->vet, n, dP50FIRcoeffs, iP50FIRcoeffsLen, delayLine_FIR);
+	  filterFunc_FIR_block(filteredNoiseTemp, s->vet, n, dP50FIRcoeffs, iP50FIRcoeffsLen, delayLine_FIR);
 
 
     if ((dcFilter >= 1)  && (dcFilter < 5)) {
@@ -822,6 +1152,10 @@ double *P50_MNRU_process(char operation, MNRU_state *s, double* input, double* o
   else //operation == MNRU_STOP
   {
 	 if (s->rnd_state.gauss != NULL)	free(s->rnd_state.gauss);
+#ifndef STL92_RNG
+	 if (s->rnd_state.zig != NULL)	free(s->rnd_state.zig);
+	 s->rnd_state.zig = NULL;
+#endif
 	 if (s->vet != NULL)				free(s->vet);
 	 s->rnd_state.gauss = NULL;
 	 s->vet = NULL;
@@ -841,6 +1175,270 @@ double *P50_MNRU_process(char operation, MNRU_state *s, double* input, double* o
 
 /*  .................... End of P50_MNRU_process() ....................... */
 
+
+/*
+  ==========================================================================
+
+        double *MNRU_sweep_process (char operation, MNRU_sweep_state *s,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~  float *input, long n, long seed,
+                                    char mode, double *Q, int nq,
+                                    float *fseed)
+
+        void MNRU_sweep_output (MNRU_sweep_state *s, int q, float *output,
+        ~~~~~~~~~~~~~~~~~~~~~~  long n)
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Multi-Q version of MNRU_process(), for generating the same input
+        at the `nq' Q values of `Q' in one pass. MNRU_sweep_process() runs
+        the stages that do not depend on Q: the input DC-removal filter
+        and the noise generation. MNRU_sweep_output() then produces the
+        `n' output samples for Q[q], which are bit-exact with those of
+        MNRU_process() for the same input, Q, seed and `fseed'. Calls of
+        MNRU_sweep_output() for different `q' are independent of each
+        other, and may run in parallel.
+
+        Call MNRU_sweep_process() with MNRU_START (or MNRU_START_FAST) and
+        the largest block length in `n' to reset the state, MNRU_CONTINUE
+        for the following blocks, and MNRU_STOP (no processing) to release
+        the memory. `mode', `Q' and `nq' are used only at start.
+
+        Return Value:
+        ~~~~~~~~~~~~~
+        MNRU_sweep_process() returns a pointer to the noise vector, or NULL
+        if uninitialized or if initialization failed.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026     1.00 Created.
+
+  ==========================================================================
+*/
+double *MNRU_sweep_process (char operation, MNRU_sweep_state * s, float *input, long n, long seed, char mode, double *Q, int nq, float *fseed) {
+  long count;
+  double tmp, inp_smp;
+  int q;
+
+  if (operation == MNRU_START || operation == MNRU_START_FAST) {
+    s->nq = nq;
+    s->mode = mode;
+    s->s.clip = 0;
+    s->s.seed = seed;
+    s->s.signal_gain = (mode == NOISE_ONLY) ? 0.000 : 1.000;
+    s->s.rnd_mode = RANDOM_RESET;
+#ifndef STL92_RNG
+    s->s.rnd_state.gauss = NULL;
+    s->s.rnd_state.zig = NULL;
+    s->s.rnd_state.fast = (operation == MNRU_START_FAST);
+#endif
+    s->dly_iir = s->dly_fir = s->tmp = DNULL;
+
+    /* Allocate memory for the noise, input and per-Q state */
+    s->s.vet = (double *) calloc (n, sizeof (double));
+    s->inp = (double *) calloc (n, sizeof (double));
+    s->noise_gain = (double *) calloc (nq, sizeof (double));
+    s->clip = (long *) calloc (nq, sizeof (long));
+    s->DLY = calloc (nq, sizeof (*s->DLY));
+    if (s->s.vet == DNULL || s->inp == DNULL || s->noise_gain == DNULL || s->clip == NULL || s->DLY == NULL)
+      return ((double *) DNULL);
+
+    /* Gains for the noise path, and output low-pass filters */
+    mnru_lp_init (&s->s);
+    for (q = 0; q < nq; q++)
+      s->noise_gain[q] = (mode == SIGNAL_ONLY) ? 0 : NOISE_GAIN * pow (10.0, (-0.05 * Q[q]));
+
+    /* Initialization of the input DC-removal filter */
+    s->s.last_xk = s->s.last_yk = 0;
+  }
+
+  if (operation == MNRU_STOP) {
+    free (s->s.rnd_state.gauss);
+#ifndef STL92_RNG
+    free (s->s.rnd_state.zig);
+#endif
+    free (s->s.vet);
+    free (s->inp);
+    free (s->noise_gain);
+    free (s->clip);
+    free (s->DLY);
+    s->s.vet = (double *) DNULL;
+    return ((double *) DNULL);
+  }
+
+  /* DC removal of the input */
+  for (count = 0; count < n; count++) {
+    inp_smp = input[count];
+#ifndef NO_DC_REMOVAL
+    tmp = inp_smp - s->s.last_xk;
+    tmp += ALPHA * s->s.last_yk;
+    s->s.last_xk = inp_smp;
+    s->s.last_yk = tmp;
+    inp_smp = tmp;
+#endif
+    s->inp[count] = inp_smp;
+  }
+
+  /* Noise samples for the whole block */
+  if (s->mode == SIGNAL_ONLY)
+    memset (s->s.vet, '\0', n * sizeof (double));
+  else if (random_MNRU_block (&s->s.rnd_mode, &s->s.rnd_state, s->s.seed, fseed, s->s.vet, n) == DNULL)
+    return ((double *) DNULL);
+
+  return ((double *) s->s.vet);
+}
+
+
+void MNRU_sweep_output (MNRU_sweep_state * s, int q, float *output, long n) {
+  double (*DLY)[2] = s->DLY[q];
+  double noise, inp_smp, out_tmp, out_flt;
+  long count;
+  int i;
+
+  for (count = 0; count < n; count++) {
+    inp_smp = s->inp[count];
+
+    /* Modulated noise, as in MNRU_process() */
+    if (s->mode == SIGNAL_ONLY)
+      noise = 0;
+    else {
+      noise = s->s.vet[count];
+      noise *= s->noise_gain[q] * inp_smp;
+      if (noise > 1.00 || noise < -1.00)
+        s->clip[q]++;
+    }
+    out_tmp = noise + inp_smp * s->s.signal_gain;
+
+#ifdef NO_OUT_FILTER
+    out_flt = out_tmp;
+#else
+    for (i = 0; i < MNRU_STAGE_OUT_FLT; i++) {
+      out_flt = out_tmp * s->s.A[i][0] + DLY[i][1];
+      DLY[i][1] = out_tmp * s->s.A[i][1] - out_flt * s->s.B[i][0] + DLY[i][0];
+      DLY[i][0] = out_tmp * s->s.A[i][2] - out_flt * s->s.B[i][1];
+      out_tmp = out_flt;
+    }
+#endif
+    output[count] = out_flt;
+  }
+}
+/*  ................. End of MNRU_sweep_process() ...................... */
+
+
+/**
+*   double *P50_MNRU_sweep_process (char operation, MNRU_sweep_state *s, double *input, long n, char mode,
+*        double *Q, int nq, char dcFilter, float *fseed)
+*
+*   void P50_MNRU_sweep_output (MNRU_sweep_state *s, int q, double *output, long n)
+*
+*   Multi-Q version of P50_MNRU_process(). P50_MNRU_sweep_process() runs the stages that do not depend on Q: the
+*   noise generation and P.50 shaping, and the optional input DC-removal filter (`input' is left unchanged).
+*   P50_MNRU_sweep_output() then produces the `n' output samples for Q[q]; calls for different `q' may run in
+*   parallel. The noise is shaped once at unit gain and then scaled for each Q, hence the outputs equal those of
+*   P50_MNRU_process() up to the double-precision rounding of the noise gain.
+*
+*   Call P50_MNRU_sweep_process() with MNRU_START (or MNRU_START_FAST) and the largest block length in `n' to reset
+*   the state, MNRU_CONTINUE for the following blocks, and MNRU_STOP (no processing) to release the memory.
+*
+*   @return (double *)  pointer to the shaped unit-gain noise vector, NULL if uninitialized or if initialization failed.
+**/
+double *P50_MNRU_sweep_process(char operation, MNRU_sweep_state *s, double *input, long n, char mode,
+                               double *Q, int nq, char dcFilter, float *fseed)
+{
+  double alpha = p50_dc_alpha(dcFilter), tmp;
+  long count;
+  int q;
+
+  if (operation == MNRU_START || operation == MNRU_START_FAST)
+  {
+    s->nq = nq;
+    s->mode = mode;
+    s->s.clip = 0;
+    s->s.seed = 0;
+    s->s.signal_gain = (mode == NOISE_ONLY) ? 0.000 : 1.000;
+    s->s.rnd_mode = RANDOM_RESET;
+#ifndef STL92_RNG
+    s->s.rnd_state.gauss = NULL;
+    s->s.rnd_state.zig = NULL;
+    s->s.rnd_state.fast = (operation == MNRU_START_FAST);
+#endif
+    s->clip = NULL;
+    s->DLY = NULL;
+
+    s->s.vet = (double *) calloc(n, sizeof(double));
+    s->inp = (double *) calloc(n, sizeof(double));
+    s->tmp = (double *) calloc(n, sizeof(double));
+    s->noise_gain = (double *) calloc(nq, sizeof(double));
+    s->dly_fir = (double *) calloc(2 * iP50FIRcoeffsLen, sizeof(double));
+    s->dly_iir = (double *) calloc(iP50IIRorder, sizeof(double));
+    if (s->s.vet == NULL || s->inp == NULL || s->tmp == NULL || s->noise_gain == NULL ||
+        s->dly_fir == NULL || s->dly_iir == NULL)
+      return NULL;
+
+    for (q = 0; q < nq; q++)
+      s->noise_gain[q] = (mode == SIGNAL_ONLY) ? 0 : P50_NOISE_GAIN * pow(10.0, (-0.05 * Q[q]));
+
+    s->s.last_xk = s->s.last_yk = 0;
+  }
+
+  if (operation == MNRU_STOP)
+  {
+    free(s->s.rnd_state.gauss);
+#ifndef STL92_RNG
+    free(s->s.rnd_state.zig);
+#endif
+    free(s->s.vet);
+    free(s->inp);
+    free(s->tmp);
+    free(s->noise_gain);
+    free(s->dly_fir);
+    free(s->dly_iir);
+    s->s.vet = NULL;
+    return NULL;
+  }
+
+  /* Signal only: input copied unfiltered, as in P50_MNRU_process() */
+  if (s->mode == SIGNAL_ONLY)
+  {
+    memcpy(s->inp, input, n * sizeof(double));
+    memset(s->s.vet, 0, n * sizeof(double));
+    return s->s.vet;
+  }
+
+  /* Unit-gain noise, shaped by the P.50 IIR and FIR filters */
+  if (random_MNRU_block(&s->s.rnd_mode, &s->s.rnd_state, s->s.seed, fseed, s->tmp, n) == NULL)
+    return NULL;
+  filterFunc_SOS(s->tmp, s->tmp, n, dP50IIRcoeffs, iP50IIRorder / 2, s->dly_iir);
+  filterFunc_FIR_block(s->tmp, s->s.vet, n, dP50FIRcoeffs, iP50FIRcoeffsLen, s->dly_fir);
+
+  /* DC removal of the input */
+  for (count = 0; count < n; count++)
+  {
+    tmp = input[count];
+    if ((dcFilter >= 1) && (dcFilter < 5))
+    {
+      tmp -= s->s.last_xk;
+      tmp += alpha * s->s.last_yk;
+      s->s.last_xk = input[count];
+      s->s.last_yk = tmp;
+    }
+    s->inp[count] = tmp;
+  }
+
+  return s->s.vet;
+}
+
+
+void P50_MNRU_sweep_output(MNRU_sweep_state *s, int q, double *output, long n)
+{
+  double g = s->noise_gain[q];
+  long count;
+
+  for (count = 0; count < n; count++)
+    output[count] = s->inp[count] * (s->s.signal_gain + g * s->s.vet[count]);
+}
+/*  ............... End of P50_MNRU_sweep_process() .................... */
+
 #undef NOISE_GAIN
 #undef DNULL
 #undef ALPHA
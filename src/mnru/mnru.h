@@ -23,10 +23,16 @@ typedef struct {
   long ma[56];                  /* this is a special value; shall not be changed [1],[2] */
 } ori_RANDOM_state;
 
+/* Tables of the Ziggurat gaussian generator (fast noise mode, in mnru.c) */
+struct MNRU_ziggurat;
+
 /* Definition of type for random_MNRU state variables */
 typedef struct {
-  float *gauss;
-
+  float *gauss;                 /* gaussian table (compatible noise mode) */
+  char fast;                    /* 1: counter-based RNG + Ziggurat noise */
+  unsigned int key;             /* fast mode: key of the noise stream */
+  unsigned int ctr_lo, ctr_hi;  /* fast mode: 64-bit sample counter */
+  struct MNRU_ziggurat *zig;    /* fast mode: Ziggurat tables */
 } new_RANDOM_state;
 
 /* Definitions for the MNRU state variable */
@@ -47,11 +53,30 @@ typedef struct {
   double DLY[MNRU_STAGE_OUT_FLT][2];    /* delay storage elements (z-shifts) */
 } MNRU_state;
 
+/* Definition of type for the multi-Q (sweep) MNRU state variables: the
+   DC-removed input and the noise are computed once for all Q values */
+typedef struct {
+  MNRU_state s;                 /* shared state; s.vet holds the noise */
+  double *inp;                  /* DC-removed input samples */
+  char mode;                    /* MOD_NOISE, NOISE_ONLY or SIGNAL_ONLY */
+  int nq;                       /* number of Q values */
+  double *noise_gain;           /* noise gain for each Q */
+  long *clip;                   /* clip counter for each Q */
+  double (*DLY)[MNRU_STAGE_OUT_FLT][2]; /* output filter memory for each Q */
+  double *dly_iir, *dly_fir, *tmp;      /* P.50 noise-shaping filters */
+} MNRU_sweep_state;
+
 /* Prototype for MNRU and random function(s) */
 double *MNRU_process ARGS ((char operation, MNRU_state * s, float *input, float *output, long n, long seed, char mode, double Q, float *fseed));
 double *P50_MNRU_process ARGS ((char operation, MNRU_state * s, double *input, double *output, long n, char mode, double Q, char dcRemoval, float *fseed));
 
 float random_MNRU ARGS ((char *mode, RANDOM_state * r, long seed));
+double *MNRU_sweep_process ARGS ((char operation, MNRU_sweep_state * s, float *input, long n, long seed, char mode, double *Q, int nq, float *fseed));
+void MNRU_sweep_output ARGS ((MNRU_sweep_state * s, int q, float *output, long n));
+double *P50_MNRU_sweep_process ARGS ((char operation, MNRU_sweep_state * s, double *input, long n, char mode, double *Q, int nq, char dcFilter, float *fseed));
+void P50_MNRU_sweep_output ARGS ((MNRU_sweep_state * s, int q, double *output, long n));
+
+double *random_MNRU_block ARGS ((char *mode, RANDOM_state * r, long seed, float *fseed, double *noise, long n));
 
 /* Definitions for the MNRU algorithm */
 #define MOD_NOISE    1
@@ -61,6 +86,7 @@ float random_MNRU ARGS ((char *mode, RANDOM_state * r, long seed));
 #define MNRU_START     1
 #define MNRU_CONTINUE  0
 #define MNRU_STOP     -1
+#define MNRU_START_FAST 2       /* as MNRU_START, with the fast noise generator */
 
 /* Definitions for Knuth's subtractive Random Number Generator */
 #define RANDOM_RUN 0
@@ -1,4 +1,4 @@
-/*                                                Version: 2.2 - 02.Feb.2010
+/*                                                Version: 2.4 - 16.Oct.2026
   --------------------------------------------------------------------------
 
   MNRUDEMO.C
@@ -38,6 +38,14 @@
   -noise          define MNRU mode as noise-only
   -signal         define MNRU mode as signal-only
   -mod            define MNRU mode as modulated noise (default)
+  -fast           use the fast noise generator (counter-based RNG and
+                  Ziggurat); same noise level, but the output is not
+                  bit-exact with the default generator
+  -sweep Q1,Q2,.. Q sweep: process the input for all Q values in one pass,
+                  sharing the DC-removal filter and the noise; the output
+                  for each Q is saved to fileout.Q<value>, and is the same
+                  as that of a separate run with that Q
+  -threads T      number of threads for the Q sweep outputs [default: 1]
 
   History:
   ~~~~~~~~
@@ -53,6 +61,8 @@
                     are specified. <simao.campos@labs.comsat.com>
   02.Feb.2010  2.2  Modified maximum string length, implicit casting of
                     toupper() argument removed (y.hiwasaki)
+  16.Oct.2026  2.3  Added option -fast for the fast noise generator.
+  16.Oct.2026  2.4  Added options -sweep and -threads for Q sweeps.
   --------------------------------------------------------------------------
 */
 
@@ -75,6 +85,10 @@
 
 /* ... Include of utilities ... */
 #include "ugst-utl.h"
+#include "ugst-thread.h"
+
+/* Blocks per pass in the Q sweep mode */
+#define SWEEP_BLOCKS 64
 
 
 /*
@@ -90,7 +104,7 @@
  -------------------------------------------------------------------------
 */
 void display_usage () {
-  printf ("MNRU.C - Version 2.2 of 02.Feb.2010 \n");
+  printf ("MNRU.C - Version 2.4 of 16.Oct.2026 \n");
   printf ("Demonstration program for generating files with modulated\n");
   printf ("noise added based on UGST's MNRU module, which is based in the\n");
   printf ("Recommendation P.81 (Blue Book).\n");
@@ -116,6 +130,10 @@ void display_usage () {
   printf (" -noise     define MNRU mode as noise-only\n");
   printf (" -signal    define MNRU mode as signal-only\n");
   printf (" -mod       define MNRU mode as modulated noise (default)\n");
+  printf (" -fast      fast noise generator (not bit-exact with the default)\n");
+  printf (" -sweep Q1,Q2,..  process all Q values in one pass; the outputs\n");
+  printf ("            are saved to filout.Q<value>\n");
+  printf (" -threads T number of threads for the Q sweep outputs [default: 1]\n");
 
   /* Quit program */
   exit (-128);
@@ -125,6 +143,109 @@ void display_usage () {
 
 
 
+/*
+ -------------------------------------------------------------------------
+ Q sweep: shared state and per-Q outputs of one pass.
+ -------------------------------------------------------------------------
+*/
+typedef struct {
+  MNRU_sweep_state state;
+  long n;                       /* samples in the pass */
+  long size;                    /* max. samples in a pass */
+  FILE **Fo;                    /* output file for each Q */
+  float *out;                   /* size samples for each Q */
+  short *Buf;                   /* size samples for each Q */
+  long *over;                   /* overflow counter for each Q */
+} MNRU_SWEEP;
+
+/* Job for ugst_parallel_for(): output of one pass for Q number q */
+static void sweep_output (void *ctx, long q) {
+  MNRU_SWEEP *sw = (MNRU_SWEEP *) ctx;
+  float *out = sw->out + q * sw->size;
+  short *Buf = sw->Buf + q * sw->size;
+
+  MNRU_sweep_output (&sw->state, (int) q, out, sw->n);
+  sw->over[q] += fl2sh_16bit (sw->n, out, Buf, 1);
+  fwrite (Buf, sizeof (short), sw->n, sw->Fo[q]);
+}
+
+
+/*
+ -------------------------------------------------------------------------
+ void mnru_sweep (FILE *Fi, char *FileOut, double *Q, int nq, long N,
+                  long N2, char MNRU_mode, char fast, char quiet,
+                  int nthreads);
+
+ Process N2 blocks of N samples of Fi for the nq Q values of Q, in
+ passes of SWEEP_BLOCKS blocks.
+ -------------------------------------------------------------------------
+*/
+static void mnru_sweep (FILE * Fi, char *FileOut, double *Q, int nq, long N, long N2, char MNRU_mode, char fast, char quiet, int nthreads) {
+  MNRU_SWEEP sw;
+  short *Buf;
+  float *inp;
+  char *name;
+  float fseed = 12345.0;
+  char operation;
+  long cur_frame, m;
+  int q;
+
+  sw.size = SWEEP_BLOCKS * N;
+  sw.Fo = (FILE **) calloc (nq, sizeof (FILE *));
+  sw.out = (float *) malloc (nq * sw.size * sizeof (float));
+  sw.Buf = (short *) malloc (nq * sw.size * sizeof (short));
+  sw.over = (long *) calloc (nq, sizeof (long));
+  Buf = (short *) malloc (sw.size * sizeof (short));
+  inp = (float *) malloc (sw.size * sizeof (float));
+  name = (char *) malloc (strlen (FileOut) + 32);
+  if (sw.Fo == NULL || sw.out == NULL || sw.Buf == NULL || sw.over == NULL || Buf == NULL || inp == NULL || name == NULL)
+    KILL ("Error allocating Q sweep buffers\n", 10);
+
+  for (q = 0; q < nq; q++) {
+    sprintf (name, "%s.Q%g", FileOut, Q[q]);
+    if ((sw.Fo[q] = fopen (name, "wb")) == NULL)
+      KILL (name, 3);
+  }
+
+  operation = fast ? MNRU_START_FAST : MNRU_START;
+  for (cur_frame = 0; cur_frame < N2; cur_frame += m) {
+    m = (N2 - cur_frame < SWEEP_BLOCKS) ? N2 - cur_frame : SWEEP_BLOCKS;
+    if ((sw.n = (long) fread (Buf, sizeof (short), m * N, Fi)) <= 0)
+      break;
+
+    if (!quiet)
+      fprintf (stderr, "\rProcessing frame %ld of %ld\t", cur_frame + m, N2);
+
+    /* Shared stages, then the output for each Q */
+    sh2fl_16bit (sw.n, Buf, inp, 1);
+    if (MNRU_sweep_process (operation, &sw.state, inp, sw.n, (long) 314159265, MNRU_mode, Q, nq, &fseed) == NULL)
+      KILL ("Error allocating MNRU buffers\n", 10);
+    operation = MNRU_CONTINUE;
+
+    ugst_parallel_for (nq, nthreads, sweep_output, &sw);
+  }
+
+  fprintf (stderr, "\n");
+  for (q = 0; q < nq; q++) {
+    fprintf (stderr, "Q=%g dB: overflow samples: %ld, clipped noise samples: %ld\n", Q[q], sw.over[q], operation == MNRU_CONTINUE ? sw.state.clip[q] : 0L);
+    fclose (sw.Fo[q]);
+  }
+  if (operation == MNRU_CONTINUE)
+    MNRU_sweep_process (MNRU_STOP, &sw.state, NULL, 0, 0, 0, NULL, 0, NULL);
+
+  free (name);
+  free (inp);
+  free (Buf);
+  free (sw.over);
+  free (sw.Buf);
+  free (sw.out);
+  free (sw.Fo);
+}
+
+/* .................... End of mnru_sweep() ........................... */
+
+
+
 /*
    **************************************************************************
    ***                                                                    ***
@@ -153,7 +274,10 @@ int main (int argc, char *argv[]) {
   long cur_frame, l, N, N1, N2;
   char MNRU_mode = MOD_NOISE, operation;
   long size, over = 0;
-  char quiet = 0;
+  char quiet = 0, fast = 0;
+  double *Qlist = NULL;
+  int nq = 0, nthreads = 1;
+  char *tok;
   long start_byte;
   float fseed;
 
@@ -214,6 +338,29 @@ int main (int argc, char *argv[]) {
         /* Modulated noise, the default mode */
         MNRU_mode = MOD_NOISE;
 
+        /* Move argv over the option to the next argument */
+        argv++;
+        argc--;
+      } else if (strcmp (argv[1], "-sweep") == 0) {
+        /* List of Q values */
+        Qlist = (double *) malloc ((strlen (argv[2]) / 2 + 1) * sizeof (double));
+        for (tok = strtok (argv[2], ","); tok != NULL; tok = strtok (NULL, ","))
+          Qlist[nq++] = atof (tok);
+
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-threads") == 0) {
+        /* Number of threads for the Q sweep */
+        nthreads = atoi (argv[2]);
+
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-fast") == 0) {
+        /* Fast noise generator */
+        fast = 1;
+
         /* Move argv over the option to the next argument */
         argv++;
         argc--;
@@ -284,15 +431,23 @@ int main (int argc, char *argv[]) {
     KILL (FileIn, 2);
   fhi = fileno (Fi);
 
+  /* Move pointer to 1st block of interest */
+  if (fseek (Fi, start_byte, 0) < 0l)
+    KILL (FileIn, 4);
+
+  /* Q sweep: outputs for all Q values in one pass */
+  if (nq > 0) {
+    mnru_sweep (Fi, FileOut, Qlist, nq, N, N2, MNRU_mode, fast, quiet, nthreads);
+    free (Qlist);
+    fclose (Fi);
+    return (0);
+  }
+
   /* Creates output file */
   if ((Fo = fopen (FileOut, WB)) == NULL)
     KILL (FileOut, 3);
   fho = fileno (Fo);
 
-  /* Move pointer to 1st block of interest */
-  if (fseek (Fi, start_byte, 0) < 0l)
-    KILL (FileIn, 4);
-
   /* INSERTION OF MODULATED NOISE ACCORDING TO P.810 */
 
   size = N;
@@ -317,7 +472,7 @@ int main (int argc, char *argv[]) {
 
     /* Choose operation mode: START, CONTINUE, or STOP */
     if (cur_frame == 0)
-      operation = MNRU_START;
+      operation = fast ? MNRU_START_FAST : MNRU_START;
     else if (cur_frame == N2 - 1)
       operation = MNRU_STOP;
     else
@@ -9,6 +9,7 @@
 
 /* ... Include of utilities ... */
 #include "ugst-utl.h"
+#include "ugst-thread.h"
 
 #define RANDOM_state new_RANDOM_state
 #define random_MNRU new_random_MNRU
@@ -17,6 +18,9 @@
 #define SHRT_MIN -32768
 #define SHRT_MAX +32767
 
+/* Samples per pass in the Q sweep mode */
+#define SWEEP_CHUNK 16384
+
 void show_use(void)
 {
      printf("P.50 Fullband MNRU - %s\n", VERSION_STL);
@@ -24,7 +28,10 @@ void show_use(void)
 
      printf("\n  Requires 48kHz sampling rate.\n");
 
-	 printf("\n  Usage: p50fbmnru <inputfile> <outputfile> <Q/dB> <Mode> [dcFilter] [--overflow]\n");
+	 printf("\n  Usage: p50fbmnru <inputfile> <outputfile> <Q/dB> <Mode> [dcFilter] [--overflow] [--fast] [--threads T]\n");
+	 printf("\n      Q/dB:     Q value, or a comma-separated list of Q values (Q sweep):");
+	 printf("\n                input filtering and noise are shared by all Q values, and");
+	 printf("\n                the output for each Q is saved to <outputfile>.Q<value>\n");
 
 	 printf("\n      Mode M:   Modulated Noise");
 	 printf("\n           N:   Noise only");
@@ -38,14 +45,152 @@ void show_use(void)
      printf("\n ");
      printf("\n         --overflow  int16 overflow (legacy, same as P.50 FB MNNU prior 2023)");
      printf("\n                     if undefined, int16 are clamped (default)");
+     printf("\n         --fast      fast noise generator (counter-based RNG + Ziggurat);");
+     printf("\n                     same noise level, but not bit-exact with the default one");
+     printf("\n         --threads T number of threads for the Q sweep outputs (default: 1)");
      printf("\n\n");
 }
 
+/* Round the output to int16, clamping it unless overflowEnabled; return
+   the number of samples out of the int16 range */
+static long double_to_short(double *Out_Buf, short *Buf, long n, char overflowEnabled)
+{
+    long i, lOverflowCnt = 0;
+
+    for( i=0; i<n; i++)
+    {
+
+        if ( Out_Buf[i]>0) {
+            /* Check for potential int16 overflow */
+            if (Out_Buf[i]  + 0.5 > SHRT_MAX) {
+                lOverflowCnt++;
+                if (overflowEnabled == 0) {
+                    Buf[i] = SHRT_MAX;
+                }
+                else {
+                    Buf[i]	= (short) ( Out_Buf[i] + 0.5);
+                }
+            }
+            else {
+                Buf[i]	= (short) ( Out_Buf[i] + 0.5);
+            }
+        }
+        else
+        {
+            if (Out_Buf[i]  - 0.5 < SHRT_MIN) {
+                lOverflowCnt++;
+                if (overflowEnabled == 0) {
+                    Buf[i] = SHRT_MIN;
+                }
+                else {
+                    Buf[i] = (short) ( Out_Buf[i] - 0.5);
+                }
+            }
+            else {
+                Buf[i] = (short) ( Out_Buf[i] - 0.5);
+            }
+        }
+    }
+    return lOverflowCnt;
+}
+
+/* Q sweep: shared state and per-Q outputs of one pass */
+typedef struct {
+    MNRU_sweep_state state;
+    long n;                     /* samples in the pass */
+    char overflowEnabled;
+    FILE **Out;                 /* output file for each Q */
+    double *Out_Buf;            /* SWEEP_CHUNK samples for each Q */
+    short *Buf;                 /* SWEEP_CHUNK samples for each Q */
+    long *lOverflowCnt;         /* overflow counter for each Q */
+} P50_SWEEP;
+
+/* Job for ugst_parallel_for(): output of one pass for Q number q */
+static void sweep_output(void *ctx, long q)
+{
+    P50_SWEEP *sw = (P50_SWEEP *) ctx;
+    double *Out_Buf = sw->Out_Buf + q * SWEEP_CHUNK;
+    short *Buf = sw->Buf + q * SWEEP_CHUNK;
+
+    P50_MNRU_sweep_output(&sw->state, (int) q, Out_Buf, sw->n);
+    sw->lOverflowCnt[q] += double_to_short(Out_Buf, Buf, sw->n, sw->overflowEnabled);
+    fwrite(Buf, sizeof(short), sw->n, sw->Out[q]);
+}
+
+/* Process the whole input for the nq Q values of Q, in one pass */
+static int p50_sweep(FILE *In, char *outname, double *Q, int nq, short MNRU_mode, char dcFilterMode,
+                     char overflowEnabled, char fastNoise, int nthreads)
+{
+    P50_SWEEP sw;
+    static short Buf[SWEEP_CHUNK];
+    static double In_Buf[SWEEP_CHUNK];
+    char *name;
+    float fseed = 12345.0;
+    char operation;
+    long i;
+    int q;
+
+    sw.overflowEnabled = overflowEnabled;
+    sw.Out = (FILE **) calloc(nq, sizeof(FILE *));
+    sw.Out_Buf = (double *) malloc(nq * SWEEP_CHUNK * sizeof(double));
+    sw.Buf = (short *) malloc(nq * SWEEP_CHUNK * sizeof(short));
+    sw.lOverflowCnt = (long *) calloc(nq, sizeof(long));
+    name = (char *) malloc(strlen(outname) + 32);
+    if (sw.Out == NULL || sw.Out_Buf == NULL || sw.Buf == NULL || sw.lOverflowCnt == NULL || name == NULL) {
+        printf(" can't allocate memory for the Q sweep\n");
+        exit(1);
+    }
+
+    for (q = 0; q < nq; q++) {
+        sprintf(name, "%s.Q%g", outname, Q[q]);
+        if ((sw.Out[q] = fopen(name, "wb")) == NULL) {
+            printf(" can't open output file: %s \n", name);
+            exit(1);
+        }
+        printf(" Output file ........... %s\n", name);
+    }
+
+    operation = fastNoise ? MNRU_START_FAST : MNRU_START;
+    while ((sw.n = (long) fread(Buf, sizeof(short), SWEEP_CHUNK, In)) > 0) {
+        for (i = 0; i < sw.n; i++)
+            In_Buf[i] = (double) Buf[i];
+
+        if (P50_MNRU_sweep_process(operation, &sw.state, In_Buf, sw.n, (char) MNRU_mode, Q, nq, dcFilterMode, &fseed) == NULL) {
+            printf(" can't allocate memory for the MNRU\n");
+            exit(1);
+        }
+        operation = MNRU_CONTINUE;
+
+        ugst_parallel_for(nq, nthreads, sweep_output, &sw);
+    }
+    if (operation == MNRU_CONTINUE)
+        P50_MNRU_sweep_process(MNRU_STOP, &sw.state, NULL, 0, 0, NULL, 0, 0, NULL);
+
+    for (q = 0; q < nq; q++) {
+        if (sw.lOverflowCnt[q] > 0) {
+            if (overflowEnabled == 0) {
+                printf("\n!!!! CLIPPING WARNING !!!! Q=%g: %ld samples were CLAMPED", Q[q], sw.lOverflowCnt[q]);
+            }
+            else {
+                printf("\n!!!! CLIPPING WARNING !!!! Q=%g: OVERFLOW for %ld samples", Q[q], sw.lOverflowCnt[q]);
+            }
+        }
+        fclose(sw.Out[q]);
+    }
+
+    free(name);
+    free(sw.lOverflowCnt);
+    free(sw.Buf);
+    free(sw.Out_Buf);
+    free(sw.Out);
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
     MNRU_state      state;
     FILE            *In, *Out;
-    char            dcFilterMode ;
+    char            dcFilterMode = 0;
     short           B_Len, BuffLen;
     long            lFileLen = 0;
     int             i, B_Max;
@@ -59,12 +204,16 @@ int main(int argc, char *argv[])
 
 	long    lOverflowCnt = 0;
 	char    overflowEnabled = 0;
+	char    fastNoise = 0;
+	int     nthreads = 1, nq = 0;
+	double  *Qlist = NULL;
+	char    *tok;
 
 	//Do inits to prevent crashing when option 'S' is selected
 	state.rnd_state.gauss = NULL;
 	state.vet = NULL;
 
-    if ( (argc > 7) || (argc < 5)) {
+    if ( (argc > 10) || (argc < 5)) {
         show_use();
         exit(1);
     }
@@ -73,6 +222,12 @@ int main(int argc, char *argv[])
             if ( strcmp(argv[i], "--overflow") == 0) {
                 overflowEnabled = 1;
             }
+            else if ( strcmp(argv[i], "--fast") == 0) {
+                fastNoise = 1;
+            }
+            else if ( strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+                nthreads = atoi(argv[++i]);
+            }
             else if (strlen(argv[i]) == 1) {
                 dcFilterMode = (char) atoi(argv[i]);
             }
@@ -97,10 +252,20 @@ int main(int argc, char *argv[])
 		  exit(1);
 	 }
 
-	 Out = fopen( argv[2], "wb");
-	 if( Out == NULL )
-	 {   printf(" can't open output file: %s \n", argv[2]);
-		  exit(1);
+	 /* A list of Q values selects the Q sweep */
+	 if( strchr( argv[3], ',') != NULL )
+	 {
+		 Qlist = (double *) malloc( (strlen( argv[3]) / 2 + 1) * sizeof(double));
+		 for( tok = strtok( argv[3], ","); tok != NULL; tok = strtok( NULL, ","))
+			 Qlist[nq++] = (double) (float)atof( tok);
+	 }
+	 else
+	 {
+		 Out = fopen( argv[2], "wb");
+		 if( Out == NULL )
+		 {   printf(" can't open output file: %s \n", argv[2]);
+			  exit(1);
+		 }
 	 }
 
 	 Q 	= 	(float)atof( argv[3]);
@@ -121,8 +286,17 @@ int main(int argc, char *argv[])
 
 	 /* +++++++++++++++++++++++++  initialize  +++++++++++++++++++++++++ */
 	 printf(" Input file ............ %s ", argv[1]);
-	 printf("\n Output file ........... %s ", argv[2]);
-	 printf("\n Q ..................... %g dB", Q);
+	 if( nq > 0 )
+	 {
+		 printf("\n Q ..................... ");
+		 for( i=0; i<nq; i++)
+			 printf("%g%s", Qlist[i], (i < nq - 1) ? ", " : " dB");
+	 }
+	 else
+	 {
+		 printf("\n Output file ........... %s ", argv[2]);
+		 printf("\n Q ..................... %g dB", Q);
+	 }
 	 if( MNRU_mode == MOD_NOISE) printf("\n Mode .................. Mod-Noise");
 	 if( MNRU_mode == NOISE_ONLY) printf("\n Mode .................. Noise only");
 	 if( MNRU_mode == SIGNAL_ONLY) printf("\n Mode .................. Signal only");
@@ -137,7 +311,16 @@ int main(int argc, char *argv[])
 
 	if(  fseek( In, 0, SEEK_SET) == -1)  return( -1);
 
-	operation	=	MNRU_START;
+	if( nq > 0 )
+	{
+		p50_sweep( In, argv[2], Qlist, nq, MNRU_mode, dcFilterMode, overflowEnabled, fastNoise, nthreads);
+		free( Qlist);
+		printf("\n Done\n");
+		fclose(In);
+		return 0;
+	}
+
+	operation	=	fastNoise ? MNRU_START_FAST : MNRU_START;
 
 	do
 	{
@@ -152,44 +335,11 @@ int main(int argc, char *argv[])
 
 		P50_MNRU_process( operation, &state, In_Buf, Out_Buf, (long) BuffLen,  (char) MNRU_mode, Q, dcFilterMode, &fseed);
 
-		for( i=0; i<BuffLen; i++)
-		{
-
-			if ( Out_Buf[i]>0) {
-                /* Check for potential int16 overflow */
-                if (Out_Buf[i]  + 0.5 > SHRT_MAX) {
-                    lOverflowCnt++;
-                    if (overflowEnabled == 0) {
-                        Buf[i] = SHRT_MAX;
-                    }
-                    else {
-                        Buf[i]	= (short) ( Out_Buf[i] + 0.5);
-                    }
-                }
-                else {
-                    Buf[i]	= (short) ( Out_Buf[i] + 0.5);
-                }
-            }
-			else
-			{
-                if (Out_Buf[i]  - 0.5 < SHRT_MIN) {
-                    lOverflowCnt++;
-                    if (overflowEnabled == 0) {
-                        Buf[i] = SHRT_MIN;
-                    }
-                    else {
-                        Buf[i] = (short) ( Out_Buf[i] - 0.5);
-                    }
-                }
-                else {
-                    Buf[i] = (short) ( Out_Buf[i] - 0.5);
-                }
-		    }
-		}
+		lOverflowCnt += double_to_short(Out_Buf, Buf, (long) BuffLen, overflowEnabled);
 
 		fwrite(Buf, sizeof(short), BuffLen, Out);
 
-		if( operation==MNRU_START)	operation	=	MNRU_CONTINUE;
+		if( operation!=MNRU_CONTINUE)	operation	=	MNRU_CONTINUE;
 
 		printf("\b\b\b\b\b%5d", B_Max--);
 
@@ -1,5 +1,5 @@
-/* ..............................................................................................02/Feb/2005*/
-/*																										v1.0*/
+/* ..............................................................................................16/Oct/2026*/
+/*																										v1.02*/
 /*=============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -27,10 +27,17 @@
 	Global (have prototype in reverb-lib.h)
 		shift(...)		:		Shift coefficients of the input buffer for next block filtering
 		conv(...)		:		Convolves the impulse response of a room with the input file
+		ir_fft_init(...)	:		Partitions and transforms an impulse response for conv_fft()
+		ir_fft_free(...)	:		Releases the memory of ir_fft_init()
+		conv_fft_init(...)	:		Allocates the state of a partitioned FFT convolution
+		conv_fft_free(...)	:		Releases the memory of conv_fft_init()
+		conv_fft(...)		:		Partitioned overlap-save FFT convolution of one block
 
   HISTORY :
 	02.Feb.05	v1.0	First Beta version
     10.jul.08   v1.01   Added 16 bit saturation and saturation warning
+    16.Oct.26   v1.02   Added uniformly partitioned overlap-save FFT convolution,
+                        using the real FFT of ../freqresp/fft.c
 
   AUTHORS :
 	v1.0 Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
@@ -38,6 +45,16 @@
 
 */
 
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "reverb-lib.h"
+
+/* real FFT routines of ../freqresp/fft.c */
+void makewt (int nw, int *ip, float *w);
+void makect (int nc, int *ip, float *c);
+void actrdft (int n, int isgn, float *a, int *ip, float *w);
 
 
 /* this routine replaces the first N-1 samples of a buffer by the last N-1 samples */
@@ -97,3 +114,151 @@ void conv_old (float *IR, short *buffIn, short *buffRvb, float alignFact, long N
     buffRvb[k] = (short) (alignFact * tmpRvb + 0.5);    /* +0.5 : rounding during the 'short' truncation */
   }
 }
+
+
+/* this routine splits IR into partitions of P samples (P a power of 2) and pre-computes their spectra */
+/* partition i holds IR[i*P .. i*P+P-1] in the first half of a 2P-point frame, the second half being zero */
+IR_FFT *ir_fft_init (float *IR, long N, long P) {
+  IR_FFT *irf;
+  int *ip;
+  long i, n, nfft;
+
+  if (P < 4 || (P & (P - 1)) != 0)
+    return NULL;
+
+  nfft = 2 * P;
+  if ((irf = (IR_FFT *) malloc (sizeof (IR_FFT))) == NULL)
+    return NULL;
+  irf->N = N;
+  irf->P = P;
+  irf->nparts = (N + P - 1) / P;
+  irf->lenip = 2 + (int) sqrt ((double) P) + 1;
+  irf->H = (float *) calloc (irf->nparts * nfft, sizeof (float));
+  irf->w = (float *) malloc (P * sizeof (float));
+  ip = (int *) calloc (irf->lenip, sizeof (int));
+  if (irf->H == NULL || irf->w == NULL || ip == NULL) {
+    free (ip);
+    ir_fft_free (irf);
+    return NULL;
+  }
+
+  /* cos/sin tables for an nfft-point real FFT; not modified by later transforms of the same size */
+  makewt ((int) (nfft >> 2), ip, irf->w);
+  makect ((int) (nfft >> 2), ip, irf->w + (nfft >> 2));
+
+  for (i = 0; i < irf->nparts; i++) {
+    n = (N - i * P < P) ? N - i * P : P;
+    memcpy (irf->H + i * nfft, IR + i * P, n * sizeof (float));
+    actrdft ((int) nfft, 1, irf->H + i * nfft, ip, irf->w);
+  }
+
+  free (ip);
+  return irf;
+}
+
+
+/* this routine releases the memory allocated by ir_fft_init() */
+void ir_fft_free (IR_FFT * irf) {
+  if (irf == NULL)
+    return;
+  free (irf->H);
+  free (irf->w);
+  free (irf);
+}
+
+
+/* this routine allocates and clears the state of a partitioned FFT convolution with irf */
+CONV_FFT *conv_fft_init (IR_FFT * irf) {
+  CONV_FFT *cf;
+  long nfft = 2 * irf->P;
+
+  if ((cf = (CONV_FFT *) malloc (sizeof (CONV_FFT))) == NULL)
+    return NULL;
+  cf->irf = irf;
+  cf->pos = 0;
+  cf->fdl = (float *) calloc (irf->nparts * nfft, sizeof (float));
+  cf->win = (float *) calloc (nfft, sizeof (float));
+  cf->acc = (float *) calloc (nfft, sizeof (float));
+  cf->ip = (int *) calloc (irf->lenip, sizeof (int));
+  if (cf->fdl == NULL || cf->win == NULL || cf->acc == NULL || cf->ip == NULL) {
+    conv_fft_free (cf);
+    return NULL;
+  }
+
+  /* tables are already in irf->w: mark them as available for size nfft */
+  cf->ip[0] = (int) (nfft >> 2);
+  cf->ip[1] = (int) (nfft >> 2);
+  return cf;
+}
+
+
+/* this routine releases the memory allocated by conv_fft_init() */
+void conv_fft_free (CONV_FFT * cf) {
+  if (cf == NULL)
+    return;
+  free (cf->fdl);
+  free (cf->win);
+  free (cf->acc);
+  free (cf->ip);
+  free (cf);
+}
+
+
+/* this routine convolves a block of L <= P new input samples with the impulse response (uniformly partitioned overlap-save) */
+/* alignFact, rounding and 16 bit saturation are applied as in conv(); the ouput sat_warning is used to provide a warning
+  of there is 16 bit saturation, a positive value indicates position of overflow */
+long conv_fft (CONV_FFT * cf, short *buffIn, short *buffRvb, float alignFact, long L) {
+  IR_FFT *irf = cf->irf;
+  long P = irf->P, nfft = 2 * P, nparts = irf->nparts;
+  float *X, *H, *acc = cf->acc;
+  float tmpRvb;
+  long i, k, slot;
+  long sat_warning;
+
+  /* slide the input window by one block: [previous block | new block] */
+  memmove (cf->win, cf->win + P, P * sizeof (float));
+  for (k = 0; k < L; k++)
+    cf->win[P + k] = buffIn[k];
+  for (; k < P; k++)
+    cf->win[P + k] = 0;
+
+  /* transform the window into the newest slot of the delay line */
+  cf->pos = (cf->pos + 1) % nparts;
+  X = cf->fdl + cf->pos * nfft;
+  memcpy (X, cf->win, nfft * sizeof (float));
+  actrdft ((int) nfft, 1, X, cf->ip, irf->w);
+
+  /* accumulate the products of the past input spectra with the IR partitions */
+  memset (acc, 0, nfft * sizeof (float));
+  for (i = 0, slot = cf->pos; i < nparts; i++, slot = (slot == 0) ? nparts - 1 : slot - 1) {
+    X = cf->fdl + slot * nfft;
+    H = irf->H + i * nfft;
+    acc[0] += X[0] * H[0];      /* DC */
+    acc[1] += X[1] * H[1];      /* Nyquist */
+    for (k = 2; k < nfft; k += 2) {
+      acc[k] += X[k] * H[k] - X[k + 1] * H[k + 1];
+      acc[k + 1] += X[k] * H[k + 1] + X[k + 1] * H[k];
+    }
+  }
+  actrdft ((int) nfft, -1, acc, cf->ip, irf->w);
+
+  /* the second half of the circular convolution is the linear convolution of the new block */
+  sat_warning = -1;
+  for (k = 0; k < L; k++) {
+    tmpRvb = (float) (alignFact * acc[P + k] + 0.5);    /* +0.5 : rounding for the 'short' truncation */
+
+    /* perform 16 bit saturation */
+    if (tmpRvb < -32768.0) {
+      buffRvb[k] = -32768;
+      sat_warning = k;
+    } else {
+      if (tmpRvb > 32767.0) {
+        buffRvb[k] = 32767;
+        sat_warning = k;
+      } else {
+        buffRvb[k] = (short) tmpRvb;
+      }
+    }
+  }
+  return sat_warning;
+}
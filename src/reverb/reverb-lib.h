@@ -1,5 +1,5 @@
-/* ..............................................................................................02/Feb/2005*/
-/*																										v1.0*/
+/* ..............................................................................................16/Oct/2026*/
+/*																										v1.02*/
 
 /*=============================================================================
 
@@ -28,10 +28,16 @@
 	Global (have prototype in reverb-lib.h)
 		shift(...)		:		Shift coefficients of the input buffer for next block filtering
 		conv(...)		:		Convolves the impulse response of a room with the input file
+		ir_fft_init(...)	:		Partitions and transforms an impulse response for conv_fft()
+		ir_fft_free(...)	:		Releases the memory of ir_fft_init()
+		conv_fft_init(...)	:		Allocates the state of a partitioned FFT convolution
+		conv_fft_free(...)	:		Releases the memory of conv_fft_init()
+		conv_fft(...)		:		Partitioned overlap-save FFT convolution of one block
 
   HISTORY :
 	02.Feb.05	v1.0	First Beta version
 	10.jul.08   v1.01   Added 16 bit saturation and saturation warning
+	16.Oct.26   v1.02   Added uniformly partitioned overlap-save FFT convolution
 
 
   AUTHORS :
@@ -39,6 +45,8 @@
     v1.01 Jonas Svedberg jonas.svedberg@ericsson.com
 */
 
+#ifndef REVERB_LIB_H
+#define REVERB_LIB_H
 
 /* this routine replaces the first N-1 samples of a buffer by the last N-1 samples */
 void shift (short *buff, long N);
@@ -54,3 +62,53 @@ long conv (float *IR,           /* impulse response buffer */
            long N,              /* length of the impulse response */
            long L               /* length of the input buffer to process */
   );
+
+
+/* Impulse response split into partitions of P samples, each zero-padded to 2P and transformed */
+/* Read-only after ir_fft_init(): may be shared by several CONV_FFT states */
+typedef struct {
+  long N;                       /* length of the impulse response */
+  long P;                       /* partition length (= block length of conv_fft) */
+  long nparts;                  /* number of partitions */
+  float *H;                     /* spectra of the partitions, 2P values each */
+  float *w;                     /* FFT cos/sin table for size 2P */
+  int lenip;                    /* length of the FFT bit reversal work area */
+} IR_FFT;
+
+/* State of one partitioned convolution */
+typedef struct {
+  IR_FFT *irf;                  /* transformed impulse response */
+  float *fdl;                   /* frequency-domain delay line: spectra of the last nparts input blocks */
+  long pos;                     /* slot in fdl of the newest spectrum */
+  float *win;                   /* last 2P input samples */
+  float *acc;                   /* output spectrum accumulator */
+  int *ip;                      /* FFT bit reversal work area (written by every transform) */
+} CONV_FFT;
+
+
+/* this routine splits IR into partitions of P samples (P a power of 2) and pre-computes their spectra */
+IR_FFT *ir_fft_init (float *IR,  /* impulse response buffer */
+                     long N,    /* length of the impulse response */
+                     long P     /* partition length, power of 2 */
+  );
+
+/* this routine releases the memory allocated by ir_fft_init() */
+void ir_fft_free (IR_FFT * irf);
+
+/* this routine allocates and clears the state of a partitioned FFT convolution with irf */
+CONV_FFT *conv_fft_init (IR_FFT * irf);
+
+/* this routine releases the memory allocated by conv_fft_init() */
+void conv_fft_free (CONV_FFT * cf);
+
+/* this routine convolves a block of L <= P new input samples with the impulse response, same output as conv() */
+/* (L < P is only allowed for the last block of a signal) */
+/* the ouput is an overflow  flag, if non_zero it indicates overflow with saturation at that sample position*/
+long conv_fft (CONV_FFT * cf,    /* convolution state */
+               short *buffIn,   /* input block (L samples, no history) */
+               short *buffRvb,  /* reverberated data */
+               float alignFact, /* energy alignment factor */
+               long L           /* length of the input block to process */
+  );
+
+#endif /* REVERB_LIB_H */
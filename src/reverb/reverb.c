@@ -1,4 +1,4 @@
-/*                                                         02/Feb/2010 v1.02 */
+/*                                                         16/Oct/2026 v1.04 */
 /*=============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -26,6 +26,10 @@
 	02.Feb.05	v1.0	First Beta version
 	10.Jul.08 v1.01 Added 16 bit saturation and saturation warning
 	02.Feb.10 v1.02 Modified maximum string length to avoid buffer overrun
+	16.Oct.26 v1.03 Added option -fft for partitioned FFT convolution
+	16.Oct.26 v1.04 Added batch mode (-batch) for a list of files and a set of
+	                impulse responses (one per output channel), processed by
+	                worker threads sharing the transformed impulse responses
 
   AUTHORS :
 	v1.0  Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
@@ -40,10 +44,15 @@
 /* UGST modules */
 #include "ugstdemo.h"
 
+#include "ugst-thread.h"
+#include "ugst-utl.h"
 #include "reverb-lib.h"
 
+#define DEFAULT_BATCH_P	1024     /* partition length of the batch mode */
+#define MAX_CHANNELS	64       /* maximum number of IR files in batch mode */
+
 static void display_usage () {
-  printf ("REVERB.C - Version 1.02 of 02.Feb.2010 \n\n");
+  printf ("REVERB.C - Version 1.04 of 16.Oct.2026 \n\n");
 
   printf (" Program to add reverberation to a signal\n");
   printf (" This program convolves a signal with the impulse response of a room\n");
@@ -53,37 +62,168 @@ static void display_usage () {
   printf ("\n");
   printf (" Usage:\n");
   printf (" $ reverb   [-options] FileIn FileIR FileOut\n");
+  printf (" $ reverb   [-options] -batch FileList FileIR1 [FileIR2 ...]\n");
   printf (" where:\n");
   printf ("  FileIn       is the file to be processed;\n");
   printf ("  FileIR       is the file containing the impulse response;\n");
   printf ("  FileOut      is the file with the processed data;\n");
+  printf ("  FileList     is a text file with one \"FileIn FileOut\" pair per line;\n");
+  printf ("  FileIRc      is the impulse response for output channel c; the output\n");
+  printf ("               files have as many interleaved channels as IR files;\n");
   printf ("\n");
   printf (" Options:\n");
   printf ("  -align A...... multiplicative factor to apply to the reverberated sound\n");
   printf ("				   in order to align its energy level with a second file\n");
+  printf ("  -fft P ....... use uniformly partitioned FFT convolution with partitions\n");
+  printf ("				   (and blocks) of P samples, P a power of 2 (e.g. 1024);\n");
+  printf ("				   the output may differ by +-1 from the direct convolution\n");
+  printf ("  -batch L ..... process all the files of list L (FFT convolution, with\n");
+  printf ("				   P=%d unless -fft is given); each IR is loaded and\n", DEFAULT_BATCH_P);
+  printf ("				   transformed once for all the files\n");
+  printf ("  -ich n ....... number of interleaved channels in the input files of\n");
+  printf ("				   -batch: 1 (default: the same input for every IR) or\n");
+  printf ("				   the number of IR files (channel c with IR c)\n");
+  printf ("  -threads T ... number of worker threads for -batch [default: no. of CPUs]\n");
   printf ("\n");
 }
 
 #define tmpIRlength	512
 
+
+/* Load a float impulse response from FileIR; returns the (allocated) IR and its length in N, or NULL */
+static float *load_IR (char *FileIR, long *N) {
+  FILE *ptr_fileIR;
+  float tmpIR[tmpIRlength];     /* temporary buffer for the impulse response reading */
+  float *IR;
+
+  ptr_fileIR = fopen (FileIR, "rb");
+  if (ptr_fileIR == NULL)
+    return NULL;
+  /* determine the length of the impulse response */
+  *N = 0;
+  while (!feof (ptr_fileIR)) {
+    *N += fread (tmpIR, sizeof (float), tmpIRlength, ptr_fileIR);
+  }
+  /* allocate memory for the impulse response buffer */
+  IR = (float *) calloc (*N, sizeof (float));
+  if (IR != NULL) {
+    rewind (ptr_fileIR);
+    /* read the impulse response */
+    fread (IR, sizeof (float), *N, ptr_fileIR);
+  }
+  /* close file */
+  fclose (ptr_fileIR);
+  return IR;
+}
+
+
+/* Batch processing: list of files and transformed impulse responses, shared (read-only) by the worker threads */
+typedef struct {
+  char (*FileIn)[MAX_STRLEN];   /* input files */
+  char (*FileOut)[MAX_STRLEN];  /* output files */
+  long nfiles;                  /* number of files in the list */
+  int nch;                      /* number of impulse responses = output channels */
+  int ich;                      /* number of input channels (1 or nch) */
+  IR_FFT *irFFT[MAX_CHANNELS];  /* transformed impulse responses */
+  float alignFact;              /* energy alignment factor */
+  int *status;                  /* per-file result: 0 if OK */
+} RVB_BATCH;
+
+
+/* Worker job: reverberate file number k of the list with all the impulse responses */
+static void reverb_file (void *ctx, long k) {
+  RVB_BATCH *b = (RVB_BATCH *) ctx;
+  long P = b->irFFT[0]->P;
+  CONV_FFT *convFFT[MAX_CHANNELS];
+  FILE *ptr_fileIn, *ptr_fileOut;
+  short *frameIn, *frameOut, *buffIn, *buffRvb;
+  long count, i, global_count = 0, local_sat_pos;
+  int c, ok = 1;
+
+  b->status[k] = -1;
+  ptr_fileIn = fopen (b->FileIn[k], "rb");
+  if (ptr_fileIn == NULL) {
+    fprintf (stderr, "\nUnable to open Input file %s\n", b->FileIn[k]);
+    return;
+  }
+  ptr_fileOut = fopen (b->FileOut[k], "wb");
+  if (ptr_fileOut == NULL) {
+    fprintf (stderr, "\nUnable to open Output file %s\n", b->FileOut[k]);
+    fclose (ptr_fileIn);
+    return;
+  }
+
+  /* per-file convolution states and buffers; the IR spectra are shared */
+  frameIn = (short *) malloc (P * b->ich * sizeof (short));
+  frameOut = (short *) malloc (P * b->nch * sizeof (short));
+  buffIn = (short *) malloc (P * sizeof (short));
+  buffRvb = (short *) malloc (P * sizeof (short));
+  for (c = 0; c < b->nch; c++)
+    if ((convFFT[c] = conv_fft_init (b->irFFT[c])) == NULL)
+      ok = 0;
+  if (!ok || frameIn == NULL || frameOut == NULL || buffIn == NULL || buffRvb == NULL) {
+    fprintf (stderr, "\nUnable to allocate enough memory for %s\n", b->FileIn[k]);
+    ok = 0;
+  }
+
+  while (ok && !feof (ptr_fileIn)) {
+    count = (long) fread (frameIn, sizeof (short) * b->ich, P, ptr_fileIn);    /* read a block of input frames */
+
+    for (c = 0; c < b->nch; c++) {
+      /* de-interleave the input channel used for output channel c */
+      for (i = 0; i < count; i++)
+        buffIn[i] = frameIn[i * b->ich + (b->ich == 1 ? 0 : c)];
+
+      local_sat_pos = conv_fft (convFFT[c], buffIn, buffRvb, b->alignFact, count);
+      if (local_sat_pos >= 0) {
+        fprintf (stderr, "\nWarning warning!! Saturation(s) in output file %s.  In  channel %d, sample %ld\n", b->FileOut[k], c, local_sat_pos + global_count);
+      }
+
+      /* interleave into the output frames */
+      for (i = 0; i < count; i++)
+        frameOut[i * b->nch + c] = buffRvb[i];
+    }
+    global_count += count;
+    fwrite (frameOut, sizeof (short) * b->nch, count, ptr_fileOut);    /* output the processed block */
+  }
+
+  for (c = 0; c < b->nch; c++)
+    conv_fft_free (convFFT[c]);
+  free (frameIn);
+  free (frameOut);
+  free (buffIn);
+  free (buffRvb);
+  fclose (ptr_fileIn);
+  fclose (ptr_fileOut);
+  b->status[k] = ok ? 0 : -1;
+}
+
 int main (int argc, char *argv[]) {
   /* File variables */
   FILE *ptr_fileIn;
   FILE *ptr_fileOut;
-  FILE *ptr_fileIR;
   char FileIn[MAX_STRLEN];
   char FileIR[MAX_STRLEN];
   char FileOut[MAX_STRLEN];
 
+  /* batch mode */
+  char FileList[MAX_STRLEN] = "";
+  RVB_BATCH batch;
+  int nthreads = 0, ich = 1, c;
+  float *IRc;
+  long Nc, k, nfail;
+
   /* buffers */
   float *IR;                    /* buffer for the impulse response */
   short *buffRvb;               /* buffer for the reverberated Sound */
   short *buffIn;                /* buffer for the input sound file */
-  float tmpIR[tmpIRlength];     /* temporary buffer for the impulse response reading */
+  IR_FFT *irFFT = NULL;         /* partitioned spectra of the impulse response (-fft) */
+  CONV_FFT *convFFT = NULL;     /* state of the partitioned FFT convolution (-fft) */
 
   /* Algorithm variables */
   float alignFact = 1.0;        /* multiplicative factor for the reverberated sound (energy alignment with another file to compare) */
   long N;                       /* length of the impulse response */
+  long P = 0;                   /* partition length for FFT convolution, 0 for direct convolution */
   long count, global_count;
   long local_sat_pos;
 
@@ -102,6 +242,38 @@ int main (int argc, char *argv[]) {
         /* Set the energy alignment factor */
         alignFact = (float) atof (argv[2]);
 
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-fft") == 0) {
+        /* Set the partition length for FFT convolution */
+        P = atol (argv[2]);
+        if (P < 4 || (P & (P - 1)) != 0) {
+          fprintf (stderr, "ERROR! Partition length must be a power of 2 (>= 4)\n\n");
+          exit (-1);
+        }
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-batch") == 0) {
+        /* Process a list of files */
+        strncpy (FileList, argv[2], MAX_STRLEN - 1);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-ich") == 0) {
+        /* Number of input channels in batch mode */
+        ich = atoi (argv[2]);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-threads") == 0) {
+        /* Number of worker threads in batch mode */
+        nthreads = atoi (argv[2]);
+
         /* Move arg{c,v} over the option to the next argument */
         argc -= 2;
         argv += 2;
@@ -116,6 +288,59 @@ int main (int argc, char *argv[]) {
       }
   }
 
+  /* ......... BATCH MODE ......... */
+
+  if (FileList[0] != 0) {
+    batch.nch = argc - 1;
+    if (batch.nch < 1 || batch.nch > MAX_CHANNELS || (ich != 1 && ich != batch.nch)) {
+      fprintf (stderr, "ERROR! Batch mode needs 1 to %d IR files, and 1 or as many input channels as IR files\n\n", MAX_CHANNELS);
+      exit (-1);
+    }
+    batch.ich = ich;
+    batch.alignFact = alignFact;
+    if (P == 0)
+      P = DEFAULT_BATCH_P;
+
+    /* load and transform each impulse response once */
+    for (c = 0; c < batch.nch; c++) {
+      if ((IRc = load_IR (argv[c + 1], &Nc)) == NULL || Nc == 0) {
+        fprintf (stderr, "\nUnable to open/read IR file %s\n", argv[c + 1]);
+        exit (-1);
+      }
+      if ((batch.irFFT[c] = ir_fft_init (IRc, Nc, P)) == NULL) {
+        fprintf (stderr, "\nUnable to allocate enough memory\n");
+        exit (-1);
+      }
+      free (IRc);
+    }
+
+    if ((batch.nfiles = read_file_list (FileList, &batch.FileIn, &batch.FileOut)) < 0) {
+      fprintf (stderr, "\nUnable to read file list %s\n", FileList);
+      exit (-1);
+    }
+    batch.status = (int *) calloc (batch.nfiles + 1, sizeof (int));
+    if (batch.status == NULL) {
+      fprintf (stderr, "\nUnable to allocate enough memory\n");
+      exit (-1);
+    }
+
+    /* reverberate the files on the worker threads */
+    ugst_parallel_for (batch.nfiles, nthreads, reverb_file, &batch);
+
+    for (k = 0, nfail = 0; k < batch.nfiles; k++)
+      nfail += (batch.status[k] != 0);
+    if (nfail > 0)
+      fprintf (stderr, "\n%ld of %ld files could not be processed\n", nfail, batch.nfiles);
+
+    for (c = 0; c < batch.nch; c++)
+      ir_fft_free (batch.irFFT[c]);
+    free (batch.status);
+    free (batch.FileIn);
+    free (batch.FileOut);
+    return (nfail > 0 ? -1 : 0);
+  }
+
+
   /* Read parameters for processing */
   GET_PAR_S (1, "_Input File: .................. ", FileIn);
   GET_PAR_S (2, "_Impulse Response File: ....... ", FileIR);
@@ -130,23 +355,11 @@ int main (int argc, char *argv[]) {
   /* ......... PREPARING FILES ......... */
 
   /* Load the Impulse Response */
-  ptr_fileIR = fopen (FileIR, "rb");
-  if (ptr_fileIR == NULL) {
+  IR = load_IR (FileIR, &N);
+  if (IR == NULL) {
     fprintf (stderr, "\nUnable to open Input file\n");
     exit (-1);
   }
-  /* determine the length of the impulse response */
-  N = 0;
-  while (!feof (ptr_fileIR)) {
-    N += fread (tmpIR, sizeof (float), tmpIRlength, ptr_fileIR);
-  }
-  /* allocate memory for the impulse response buffer */
-  IR = (float *) calloc (N, sizeof (float));
-  rewind (ptr_fileIR);
-  /* read the impulse response */
-  fread (IR, sizeof (float), N, ptr_fileIR);
-  /* close file */
-  fclose (ptr_fileIR);
 
   /* open the input file */
   ptr_fileIn = fopen (FileIn, "rb");
@@ -162,8 +375,19 @@ int main (int argc, char *argv[]) {
     exit (-1);
   }
   /* allocate memory for the buffers */
-  buffIn = (short *) calloc (2 * N - 1, sizeof (short));        /* allocate memory for a block of the input file */
-  buffRvb = (short *) malloc (N * sizeof (short));      /* allocate memory for the processed block */
+  if (P > 0) {
+    irFFT = ir_fft_init (IR, N, P);     /* transform the partitions of the impulse response */
+    convFFT = (irFFT != NULL) ? conv_fft_init (irFFT) : NULL;
+    buffIn = (short *) calloc (P, sizeof (short));      /* allocate memory for a block of the input file */
+    buffRvb = (short *) malloc (P * sizeof (short));    /* allocate memory for the processed block */
+    if (convFFT == NULL) {
+      fprintf (stderr, "\nUnable to allocate enough memory\n");
+      exit (-1);
+    }
+  } else {
+    buffIn = (short *) calloc (2 * N - 1, sizeof (short));      /* allocate memory for a block of the input file */
+    buffRvb = (short *) malloc (N * sizeof (short));    /* allocate memory for the processed block */
+  }
 
   /* check consistency */
   if ((buffIn == NULL) || (buffRvb == NULL)) {
@@ -178,7 +402,17 @@ int main (int argc, char *argv[]) {
   /* .......FILTERING OPERATION ........ */
 
   /* Filter the sound File */
-  while (!feof (ptr_fileIn)) {
+  while (P > 0 && !feof (ptr_fileIn)) {
+    count = (long) fread (buffIn, sizeof (short), P, ptr_fileIn);       /* read a block of the input file */
+
+    local_sat_pos = conv_fft (convFFT, buffIn, buffRvb, alignFact, count);      /* convolves a block of the input file with the impulse response */
+    if (local_sat_pos >= 0) {
+      fprintf (stderr, "\nWarning warning!! Saturation(s) in output file.  In  sample %ld\n", local_sat_pos + global_count);
+    }
+    global_count += count;
+    fwrite (buffRvb, sizeof (short), count, ptr_fileOut);       /* output the processed block */
+  }
+  while (P == 0 && !feof (ptr_fileIn)) {
     count = (long) fread (buffIn + N - 1, sizeof (short), N, ptr_fileIn);       /* read a block of the input file */
 
     local_sat_pos = conv (IR, buffIn, buffRvb, alignFact, N, count);    /* convolves a block of the input file with the impulse response */
@@ -197,6 +431,8 @@ int main (int argc, char *argv[]) {
   /* FINALIZATIONS */
 
   /* free allocated memory */
+  conv_fft_free (convFFT);
+  ir_fft_free (irFFT);
   free (buffIn);
   free (buffRvb);
   free (IR);
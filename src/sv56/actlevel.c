@@ -1,4 +1,4 @@
-/*                                                              V2.4 10.Jun.98
+/*                                                              V2.5 16.Oct.26
   ============================================================================
 
   ACTLEVEL.C
@@ -63,6 +63,13 @@
   -log file .. print the statistics log into file rather than stdout
   -q ......... quiet operation; don't print progress flag, results are
                printed all in one line.
+  -threads n . measure each file in chunks on `n' worker threads (see
+               speech_voltmeter_part()); the activity, levels and extremes
+               are those of the single-threaded measurement (the sums may
+               differ in the last bits for very long files)
+               [default: 1, single-threaded]
+  -chunk s ... length of the chunks for -threads, in seconds
+               [default: 60]
 
 
   Modules used:
@@ -75,6 +82,8 @@
 	        (scaling) algorithm of scale() and the data type
 		conversion functions sh2fl() and fl2sh(). Prototypes
 		are in `ugst-utl.h'.
+  > ugst-thread.c: worker threads for option -threads, with
+                ugst_parallel_for(). Prototypes are in `ugst-thread.h'.
 
   Exit values:
   ~~~~~~~~~~~~
@@ -85,6 +94,7 @@
   4      error moving pointer to desired start of conversion;
   5      error reading input file;
   6      error writing to file;
+  7      error allocating memory;
 
   Compilation:
   ~~~~~~~~~~~~
@@ -125,6 +135,9 @@
                            characters and changing strcpy() to
                            strncpy() in the filename copy process.
                            <simao>
+  16.Oct.26     2.5        Added option -threads for the multi-threaded
+                           (chunked) measurement of long files, and
+                           option -chunk for the length of the chunks.
   ============================================================================
 */
 
@@ -155,10 +168,12 @@
 
 /* ... Include of utilities ... */
 #include "ugst-utl.h"
+#include "ugst-thread.h"
 
 /* ... Local definitions ... */
 #define DEF_BLK_LEN 256         /* samples per block */
 #define MIN_LOG_OFFSET 1.0e-20  /* To avoid sigularity with log(0.0) */
+#define CHUNK_LEN 60.0          /* default chunk length for -threads, in [s] */
 
 
 /*
@@ -219,6 +234,9 @@ void display_usage () {
   printf ("               to normalizes to the long term level, instead of the\n");
   printf ("               active speech level. Does NOT change the file(s).\n");
   printf ("  -log file ... log statistics into file rather than stdout\n");
+  printf ("  -threads n . measure in chunks on `n' worker threads [default: 1]\n");
+  printf ("  -chunk s ... length of the chunks for -threads, in seconds\n");
+  printf ("               [default: 60]\n");
   printf ("  -q ......... quiet operation; don't print progress flag, results\n");
   printf ("               are printed all in one line.\n");
 
@@ -402,6 +420,27 @@ void print_act_short_summary (FILE * out, char *file, SVP56_state state, double
 /* ................... End of print_act_short_summary() .................... */
 
 
+/* Chunked measurement: one segment of samples, measured by chunks into
+   partial states on the worker threads */
+typedef struct {
+  float *buf;                   /* samples of the segment */
+  long len;                     /* number of samples in the segment */
+  long chunk;                   /* samples per chunk */
+  SVP56_state *state;           /* state before the segment (read-only) */
+  SVP56_state *part;            /* partial state of each chunk */
+} ACT_SEGMENT;
+
+
+/* Worker job: measure chunk number k of the segment */
+static void measure_chunk (void *ctx, long k) {
+  ACT_SEGMENT *seg = (ACT_SEGMENT *) ctx;
+  long start = k * seg->chunk;
+  long end = (start + seg->chunk < seg->len) ? start + seg->chunk : seg->len;
+
+  speech_voltmeter_part (seg->buf, start, end, seg->state, &seg->part[k]);
+}
+
+
 /*
    **************************************************************************
    ***                                                                    ***
@@ -441,6 +480,12 @@ int main (int argc, char *argv[]) {
 #endif
   char use_active_level = 1;
 
+  /* Multi-threaded measurement */
+  int nthreads = 1;
+  double chunk_len = CHUNK_LEN;
+  long nchunks, seglen = 0, k;
+  ACT_SEGMENT seg;
+
   /* ......... GET PARAMETERS ......... */
 
   /* Getting options */
@@ -511,6 +556,24 @@ int main (int argc, char *argv[]) {
         else
           fprintf (stderr, "Statistics will be logged in %s\n", argv[2]);
 
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-threads") == 0) {
+        /* Number of worker threads */
+        nthreads = atoi (argv[2]);
+
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-chunk") == 0) {
+        /* Length of the chunks for -threads, in seconds */
+        chunk_len = atof (argv[2]);
+        if (chunk_len <= 0) {
+          fprintf (stderr, "Chunk length must be positive. Aborted.\n");
+          exit (5);
+        }
+
         /* Update argc/argv to next valid option/argument */
         argv += 2;
         argc -= 2;
@@ -546,6 +609,20 @@ int main (int argc, char *argv[]) {
   /* Overflow (saturation) point */
   Overflow = pow ((double) 2.0, (double) (bitno - 1));
 
+  /* Segments of whole blocks, with one chunk per thread */
+  if (nthreads > 1) {
+    seg.chunk = (long) (chunk_len * sf);
+    if (seg.chunk < 1)
+      seg.chunk = 1;
+    seglen = (seg.chunk * nthreads + N - 1) / N * N;
+    seg.buf = (float *) malloc (seglen * sizeof (float));
+    seg.part = (SVP56_state *) malloc ((nthreads + 1) * sizeof (SVP56_state));
+    if (seg.buf == NULL || seg.part == NULL) {
+      fprintf (stderr, "Can't allocate memory for the segments. Aborted.\n");
+      exit (7);
+    }
+  }
+
 
   /* REPEAT FOR ALL FILES IN THE COMMAND LINE */
   while (argc > 1) {
@@ -586,7 +663,27 @@ int main (int argc, char *argv[]) {
     /* Read samples ... */
     if (!quiet)
       fprintf (stderr, "  Processing \r");
-    for (i = 0; i < N2; i++) {
+    for (i = 0; nthreads > 1 && i < N2;) {
+      /* Read a segment of blocks ... */
+      for (seg.len = 0; i < N2 && seg.len + N <= seglen; i++) {
+        if ((l = fread (buffer, sizeof (short), N, Fi)) <= 0)
+          KILL (FileIn, 5);
+        sh2fl ((long) l, buffer, seg.buf + seg.len, bitno, 1);
+        seg.len += l;
+        if (!quiet)
+          fprintf (stderr, "%c\r", funny[i % funny_size]);
+      }
+
+      /* ... measure its chunks in parallel and merge them in order */
+      nchunks = (seg.len + seg.chunk - 1) / seg.chunk;
+      seg.state = &state;
+      ugst_parallel_for (nchunks, nthreads, measure_chunk, &seg);
+      for (k = 0; k < nchunks; k++)
+        speech_voltmeter_merge (&state, &seg.part[k]);
+      if (state.n > 0)
+        ActiveLeveldB = speech_voltmeter_level (&state);
+    }
+    for (i = 0; nthreads <= 1 && i < N2; i++) {
       if ((l = fread (buffer, sizeof (short), N, Fi)) > 0) {
         /* ... Convert samples to float */
         sh2fl ((long) l, buffer, Buf, bitno, 1);
@@ -685,6 +782,11 @@ int main (int argc, char *argv[]) {
   }
 
   /* FINALIZATIONS */
+  if (nthreads > 1) {
+    free (seg.buf);
+    free (seg.part);
+  }
+
   /* ... Close log file, if it is the case */
   if (out != stdout)
     fclose (out);
@@ -1,4 +1,4 @@
-/*                                                             v2.3 19.MAY.05
+/*                                                             v2.4 16.OCT.26
 =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -40,6 +40,16 @@ speech_voltmeter .............. measurement of the active speech level of
                                 data in a buffer according to P.56. Other
 				relevant statistics are also available.
 
+speech_voltmeter_part ......... measurement of a chunk of a buffer into a
+                                partial state, for chunked/multi-threaded
+                                measurements.
+
+speech_voltmeter_merge ........ combination of a partial state into the
+                                state of the measurement.
+
+speech_voltmeter_level ........ active speech level and statistics of the
+                                measurement from a (merged) state.
+
 HISTORY:
 
    07.Oct.91 v1.0 Release of 1st version to UGST.
@@ -57,6 +67,14 @@ HISTORY:
 				  suggested by Mr Kabal.
 				  Upper and lower bounds are updated during the interpolation.
 						<Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com>
+   16.Oct.26 v2.4 Block processing in speech_voltmeter(): the envelope of a
+                  block of samples is computed first, then the 15 activity
+                  and hangover counters are updated with branch-free (SIMD,
+                  when available) compares. Results are bit-identical to
+                  v2.3; compile with -DSV56_LEGACY_KERNEL to use the
+                  original per-sample loop.
+                  Added speech_voltmeter_part(), speech_voltmeter_merge()
+                  and speech_voltmeter_level() for chunked measurements.
 
 =============================================================================
 */
@@ -67,6 +85,15 @@ HISTORY:
 
 /* System includes ... */
 #include <math.h>
+#include <float.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define SV56_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define SV56_SIMD_NEON
+#include <arm_neon.h>
+#endif
 
 /* Specific includes ... */
 #ifndef SPEECH_VOLTMETER_defined
@@ -336,6 +363,9 @@ void init_speech_voltmeter (SVP56_state * state, double sampl_freq) {
 				DEC Alpha VMS workstation and extended
                                 to ther platforms as well. Exceptions are
                                 VMS and gcc on PC. <simao@ctd.comsat.com>
+        16.Oct.26     2.4       Processes the data in blocks of SV56_BLOCK
+                                samples using sv56_envelope() and
+                                sv56_thresholds(); same results as v2.2.
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 */
 #define T        0.03           /* in [s] */
@@ -346,11 +376,184 @@ void init_speech_voltmeter (SVP56_state * state, double sampl_freq) {
 /* Hooked to eliminate sigularity with log(0.0) (happens w/all-0 data blocks */
 #define MIN_LOG_OFFSET 1.0e-20
 
+/* Block processing: samples per block, and no.of threshold lanes (THRES_NO
+   rounded up to a multiple of 4; the extra lane is never active) */
+#define SV56_BLOCK 256
+#define SV56_LANES 16
+
+/* Initial pre-roll of speech_voltmeter_part(), in [s] */
+#define SV56_PREROLL 5.0
+
+
+/*
+  ----------------------------------------------------------------------------
+  void sv56_envelope (float *buffer, long smpno, double g,
+                      SVP56_state *state, double *q);
+
+  Process 1 of P.56 (sums, extremes and sample count) and the envelope
+  recursion of Process 2 for smpno samples, saving the envelope q of each
+  sample into q[]. The operations, and their order, are those of the
+  original per-sample loop, hence the results are bit-identical.
+  ----------------------------------------------------------------------------
+*/
+static void sv56_envelope (float *buffer, long smpno, double g, SVP56_state * state, double *q) {
+  double x, ax, p = state->p, e = state->q;
+  double s = state->s, sq = state->sq;
+  double max = state->max, maxP = state->maxP, maxN = state->maxN;
+  long k;
+
+  for (k = 0; k < smpno; k++) {
+    x = (double) buffer[k];
+    ax = fabs (x);
+    max = (ax > max) ? ax : max;
+    maxP = (x > maxP) ? x : maxP;
+    maxN = (x < maxN) ? x : maxN;
+
+    sq += x * x;
+    s += x;
+
+    p = g * p + (1 - g) * ((x > 0) ? x : -x);
+    e = g * e + (1 - g) * p;
+    q[k] = e;
+  }
+
+  state->p = p;
+  state->q = e;
+  state->s = s;
+  state->sq = sq;
+  state->n += smpno;
+  state->max = max;
+  state->maxP = maxP;
+  state->maxN = maxN;
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+  void sv56_thresholds (double *q, long smpno, unsigned int I,
+                        SVP56_state *state);
+
+  Applies the THRES_NO thresholds to the envelope q[] of smpno samples
+  (smpno <= SV56_BLOCK), updating the activity and hangover counters. For
+  each threshold j, the per-sample update
+
+    if (q >= c[j])          { a[j]++; hang[j] = 0; }
+    else if (hang[j] < I)   { a[j]++; hang[j]++; }
+
+  is done without branches, using compare masks:
+
+    ge = (q >= c[j]) ? ~0 : 0;  lt = (hang[j] < I) ? ~0 : 0;
+    a[j] -= ge | lt;  hang[j] = (hang[j] + (lt & 1)) & ~ge;
+
+  all thresholds being processed in parallel (SIMD lanes). The counters are
+  kept in 32 bits within a block and added to the state at its end.
+  ----------------------------------------------------------------------------
+*/
+static void sv56_thresholds (double *q, long smpno, unsigned int I, SVP56_state * state) {
+  double c[SV56_LANES];
+  unsigned int a[SV56_LANES], h[SV56_LANES];
+  long k;
+  int j;
+
+  for (j = 0; j < THRES_NO; j++) {
+    c[j] = state->c[j];
+    h[j] = (unsigned int) state->hang[j];
+    a[j] = 0;
+  }
+  for (; j < SV56_LANES; j++) {
+    c[j] = HUGE_VAL;
+    h[j] = I;
+    a[j] = 0;
+  }
+
+#if defined(SV56_SIMD_SSE2)
+  {
+    __m128d cv[SV56_LANES / 2], qv;
+    __m128i av[SV56_LANES / 4], hv[SV56_LANES / 4], ge, lt;
+    __m128i one = _mm_set1_epi32 (1), Iv = _mm_set1_epi32 ((int) I);
+
+    for (j = 0; j < SV56_LANES / 2; j++)
+      cv[j] = _mm_loadu_pd (&c[2 * j]);
+    for (j = 0; j < SV56_LANES / 4; j++) {
+      av[j] = _mm_setzero_si128 ();
+      hv[j] = _mm_loadu_si128 ((__m128i *) & h[4 * j]);
+    }
+
+    for (k = 0; k < smpno; k++) {
+      qv = _mm_set1_pd (q[k]);
+      for (j = 0; j < SV56_LANES / 4; j++) {
+        /* 2 x 64-bit double masks -> 4 x 32-bit masks */
+        ge = _mm_castps_si128 (_mm_shuffle_ps (_mm_castpd_ps (_mm_cmpge_pd (qv, cv[2 * j])), _mm_castpd_ps (_mm_cmpge_pd (qv, cv[2 * j + 1])), _MM_SHUFFLE (2, 0, 2, 0)));
+        lt = _mm_cmplt_epi32 (hv[j], Iv);
+        av[j] = _mm_sub_epi32 (av[j], _mm_or_si128 (ge, lt));
+        hv[j] = _mm_andnot_si128 (ge, _mm_add_epi32 (hv[j], _mm_and_si128 (lt, one)));
+      }
+    }
+
+    for (j = 0; j < SV56_LANES / 4; j++) {
+      _mm_storeu_si128 ((__m128i *) & a[4 * j], av[j]);
+      _mm_storeu_si128 ((__m128i *) & h[4 * j], hv[j]);
+    }
+  }
+#elif defined(SV56_SIMD_NEON)
+  {
+    float64x2_t cv[SV56_LANES / 2], qv;
+    uint32x4_t av[SV56_LANES / 4], hv[SV56_LANES / 4], ge, lt;
+    uint32x4_t one = vdupq_n_u32 (1), Iv = vdupq_n_u32 (I);
+
+    for (j = 0; j < SV56_LANES / 2; j++)
+      cv[j] = vld1q_f64 (&c[2 * j]);
+    for (j = 0; j < SV56_LANES / 4; j++) {
+      av[j] = vdupq_n_u32 (0);
+      hv[j] = vld1q_u32 (&h[4 * j]);
+    }
+
+    for (k = 0; k < smpno; k++) {
+      qv = vdupq_n_f64 (q[k]);
+      for (j = 0; j < SV56_LANES / 4; j++) {
+        ge = vcombine_u32 (vmovn_u64 (vcgeq_f64 (qv, cv[2 * j])), vmovn_u64 (vcgeq_f64 (qv, cv[2 * j + 1])));
+        lt = vcltq_u32 (hv[j], Iv);
+        av[j] = vsubq_u32 (av[j], vorrq_u32 (ge, lt));
+        hv[j] = vbicq_u32 (vaddq_u32 (hv[j], vandq_u32 (lt, one)), ge);
+      }
+    }
+
+    for (j = 0; j < SV56_LANES / 4; j++) {
+      vst1q_u32 (&a[4 * j], av[j]);
+      vst1q_u32 (&h[4 * j], hv[j]);
+    }
+  }
+#else
+  {
+    unsigned int ge, lt;
+
+    for (k = 0; k < smpno; k++)
+      for (j = 0; j < SV56_LANES; j++) {
+        ge = 0u - (unsigned int) (q[k] >= c[j]);
+        lt = 0u - (unsigned int) (h[j] < I);
+        a[j] -= ge | lt;
+        h[j] = (h[j] + (lt & 1u)) & ~ge;
+      }
+  }
+#endif
+
+  for (j = 0; j < THRES_NO; j++) {
+    state->a[j] += a[j];
+    state->hang[j] = h[j];
+  }
+}
+
+
 double speech_voltmeter (float *buffer, long smpno, SVP56_state * state) {
-  int I, j;
+  int I;
   long k;
-  double g, x, AdB, CdB, AmdB, CmdB, ActiveSpeechLevel;
-  double LongTermLevel, Delta[15];
+  double g;
+#ifdef SV56_LEGACY_KERNEL
+  double x;
+  int j;
+#else
+  double q[SV56_BLOCK];
+#endif
 
 
   /* Some initializations */
@@ -358,6 +561,7 @@ double speech_voltmeter (float *buffer, long smpno, SVP56_state * state) {
   g = exp (-1.0 / (state->f * T));
 
   /* Calculates statistics for all given data points */
+#ifdef SV56_LEGACY_KERNEL
   for (k = 0; k < smpno; k++) {
     x = (double) buffer[k];
     /* Compares the sample with the max. already found for the file */
@@ -392,6 +596,58 @@ double speech_voltmeter (float *buffer, long smpno, SVP56_state * state) {
       /* if (((state->q)<state->c[j])&&(state->hang[j]=I)), do nothing */
     }                           /* [j] */
   }                             /* [k] */
+#else
+  for (k = 0; k < smpno; k += SV56_BLOCK) {
+    long nblk = (smpno - k < SV56_BLOCK) ? smpno - k : SV56_BLOCK;
+
+    sv56_envelope (buffer + k, nblk, g, state, q);
+    sv56_thresholds (q, nblk, (unsigned int) I, state);
+  }
+#endif
+
+  /* Computes the statistics */
+  return speech_voltmeter_level (state);
+}
+
+/* .................... End of speech_voltmeter() ........................ */
+
+
+/*
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        double speech_voltmeter_level (SVP56_state *state);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Calculates the statistics (DC level, rms level, activity factor)
+        and the active speech level from the sums and activity counts
+        accumulated in `state' so far. This is the final step of
+        speech_voltmeter(), and is to be called after merging partial
+        states with speech_voltmeter_merge().
+
+        Variables:
+        ~~~~~~~~~~
+        Name:         Type:   Use:
+        state          I/O       state variable of the measurement
+
+        Value returned:
+        ~~~~~~~~~~~~~~~
+        Returns the active speech level, in dBov, as a double.
+
+        Prototype:   in sv-p56.h
+        ~~~~~~~~~~
+
+        Log of changes:
+        ~~~~~~~~~~~~~~~
+        16.Oct.26     1.0       Split from speech_voltmeter().
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+double speech_voltmeter_level (SVP56_state * state) {
+  int j;
+  double AdB, CdB, AmdB, CmdB, ActiveSpeechLevel;
+  double LongTermLevel, Delta[15];
 
   /* Computes the statistics */
   state->DClevel = (state->s) / (state->n);
@@ -435,9 +691,295 @@ double speech_voltmeter (float *buffer, long smpno, SVP56_state * state) {
   return (ActiveSpeechLevel);
 }
 
+/* ................. End of speech_voltmeter_level() ..................... */
+
+
+/*
+  ----------------------------------------------------------------------------
+  int sv56_bounded_preroll (float *buffer, long P, long start, long end,
+                            double g, unsigned int I, double U,
+                            SVP56_state *part);
+
+  Pre-roll of speech_voltmeter_part() over buffer[P..start), when the state
+  of the voltmeter at sample P is unknown. Two envelopes are run from the
+  bounds of the true one: p=q=0 and p=q=U. The envelope recursion is
+  monotone (also with floating-point rounding), hence the true envelope
+  stays between both. Once both are equal, the true envelope is known
+  exactly; before that, the threshold decisions are known as long as no
+  threshold falls between the two bounds. After I samples of known
+  decisions the hangover counters are known as well.
+
+  Returns 1 if the bounds converged before `end', with known decisions
+  over the last I samples before `start' and from there on;
+  then `part' holds the exact envelope and hangover state and the
+  statistics of buffer[start..end). Returns 0 otherwise.
+  ----------------------------------------------------------------------------
+*/
+static int sv56_bounded_preroll (float *buffer, long P, long start, long end, double g, unsigned int I, double U, SVP56_state * part) {
+  double plo = 0, qlo = 0, phi = U, qhi = U, x, ax, q[SV56_BLOCK];
+  unsigned long h[THRES_NO];
+  SVP56_state pre;
+  long t, k, nblk;
+  int j, converged = 0;
+
+  for (j = 0; j < THRES_NO; j++)
+    h[j] = I;
+
+  for (t = P; t < end && !converged; t++) {
+    x = (double) buffer[t];
+    ax = (x > 0) ? x : -x;
+    plo = g * plo + (1 - g) * ax;
+    qlo = g * qlo + (1 - g) * plo;
+    phi = g * phi + (1 - g) * ax;
+    qhi = g * qhi + (1 - g) * phi;
+    converged = (plo == phi && qlo == qhi);
+
+    /* While the decisions differ for both bounds, the hangover counters
+       are unknown; they are known again after I samples of equal ones */
+    for (j = 0; j < THRES_NO; j++)
+      if ((qlo >= part->c[j]) != (qhi >= part->c[j]))
+        break;
+    if (j < THRES_NO) {
+      if (t + (long) I >= start)
+        return 0;
+      for (j = 0; j < THRES_NO; j++)
+        h[j] = I;
+      continue;
+    }
+
+    /* Process 1, same order as in sv56_envelope() */
+    if (t >= start) {
+      part->max = (fabs (x) > part->max) ? fabs (x) : part->max;
+      part->maxP = (x > part->maxP) ? x : part->maxP;
+      part->maxN = (x < part->maxN) ? x : part->maxN;
+      part->sq += x * x;
+      part->s += x;
+      part->n++;
+    }
+
+    /* Thresholds */
+    for (j = 0; j < THRES_NO; j++) {
+      if (qlo >= part->c[j]) {
+        part->a[j] += (t >= start);
+        h[j] = 0;
+      } else if (h[j] < I) {
+        part->a[j] += (t >= start);
+        h[j]++;
+      }
+    }
+  }
+  if (!converged)
+    return 0;
+
+  /* From here on, the state is exact */
+  part->p = plo;
+  part->q = qlo;
+  for (j = 0; j < THRES_NO; j++)
+    part->hang[j] = h[j];
+
+  /* ... remaining pre-roll, if the bounds converged before start */
+  if (t < start) {
+    pre = *part;
+    for (k = t; k < start; k += nblk) {
+      nblk = (start - k < SV56_BLOCK) ? start - k : SV56_BLOCK;
+      sv56_envelope (buffer + k, nblk, g, &pre, q);
+      sv56_thresholds (q, nblk, I, &pre);
+    }
+    part->p = pre.p;
+    part->q = pre.q;
+    for (j = 0; j < THRES_NO; j++)
+      part->hang[j] = pre.hang[j];
+    t = start;
+  }
+
+  /* ... and the rest of the chunk */
+  for (k = t; k < end; k += nblk) {
+    nblk = (end - k < SV56_BLOCK) ? end - k : SV56_BLOCK;
+    sv56_envelope (buffer + k, nblk, g, part, q);
+    sv56_thresholds (q, nblk, I, part);
+  }
+  return 1;
+}
+
+
+/*
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        void speech_voltmeter_part (float *buffer, long start, long end,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~  SVP56_state *state, SVP56_state *part);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Measures the chunk buffer[start..end) of a buffer of samples, for
+        the chunked (e.g., multi-threaded) measurement of a long buffer.
+        `state' is the state of the voltmeter before buffer[0], and is
+        not modified, hence several chunks of the same buffer may be
+        measured at the same time. The statistics of the chunk alone are
+        returned in `part', to be combined (in time order) into the
+        state with speech_voltmeter_merge(); the active level is then
+        given by speech_voltmeter_level().
+
+        The envelope and the hangover counters at `start' depend on the
+        samples before it. They are recovered by a pre-roll over the
+        samples preceding the chunk (about 5 s): the envelopes started
+        from a lower and an upper bound of the unknown state must
+        converge to the same value, and agree in all threshold decisions
+        up to that point. Otherwise the pre-roll is made longer, up to
+        the start of the buffer (from `state'). Hence the activity
+        counts, sample count, extremes, envelope and hangover counters
+        are exactly those of a single speech_voltmeter() call over the
+        buffer. Only the sums `s' and `sq' differ, in the last bits (a
+        relative difference of about 1e-15 per chunk), since they are
+        summed per chunk before being added.
+
+        Variables:
+        ~~~~~~~~~~
+        Name:         Type:   Use:
+        buffer          I        input samples vector
+        start           I        first sample of the chunk
+        end             I        one past the last sample of the chunk
+        state           I        state variable before buffer[0]
+        part            O        partial state of the chunk
+
+        Value returned:
+        ~~~~~~~~~~~~~~~
+        None.
+
+        Prototype:   in sv-p56.h
+        ~~~~~~~~~~
+
+        Log of changes:
+        ~~~~~~~~~~~~~~~
+        16.Oct.26     1.0       Created.
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+void speech_voltmeter_part (float *buffer, long start, long end, SVP56_state * state, SVP56_state * part) {
+  double g, U, q[SV56_BLOCK];
+  SVP56_state pre;
+  unsigned int I;
+  long k, R, nblk;
+  int j;
+
+  I = (unsigned int) floor (H * state->f + 0.5);
+  g = exp (-1.0 / (state->f * T));
+
+  /* Partial state: no statistics yet */
+  *part = *state;
+  for (j = 0; j < THRES_NO; j++)
+    part->a[j] = 0;
+  part->n = 0;
+  part->s = part->sq = 0;
+  part->max = 0;
+  part->maxP = -32768.;
+  part->maxN = 32767.;
+
+  if (start > 0) {
+    /* Pre-roll from an unknown state, longer and longer. The envelope of
+       float samples is always below U; for normalized samples this costs
+       about ln(U) = 89 time constants T (2.7 s) of extra convergence
+       compared to a bound at full scale, which still leaves the first
+       SV56_PREROLL enough for active speech */
+    U = 2.0 * FLT_MAX;
+    for (R = (long) (SV56_PREROLL * state->f) + I; start - R > 0; R *= 2) {
+      if (sv56_bounded_preroll (buffer, start - R, start, end, g, I, U, part))
+        return;
+
+      /* restart the partial statistics */
+      for (j = 0; j < THRES_NO; j++)
+        part->a[j] = 0;
+      part->n = 0;
+      part->s = part->sq = 0;
+      part->max = 0;
+      part->maxP = -32768.;
+      part->maxN = 32767.;
+    }
+  }
+
+  /* Pre-roll from the start of the buffer, where the state is known */
+  pre = *state;
+  for (k = 0; k < start; k += nblk) {
+    nblk = (start - k < SV56_BLOCK) ? start - k : SV56_BLOCK;
+    sv56_envelope (buffer + k, nblk, g, &pre, q);
+    sv56_thresholds (q, nblk, I, &pre);
+  }
+  part->p = pre.p;
+  part->q = pre.q;
+  for (j = 0; j < THRES_NO; j++)
+    part->hang[j] = pre.hang[j];
+
+  /* Measure the chunk */
+  for (k = start; k < end; k += nblk) {
+    nblk = (end - k < SV56_BLOCK) ? end - k : SV56_BLOCK;
+    sv56_envelope (buffer + k, nblk, g, part, q);
+    sv56_thresholds (q, nblk, I, part);
+  }
+}
+
+/* ................... End of speech_voltmeter_part() ..................... */
+
+
+/*
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        void speech_voltmeter_merge (SVP56_state *state, SVP56_state *part);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Adds the statistics of the partial state `part', measured by
+        speech_voltmeter_part() over the samples that follow those
+        already measured in `state', to `state'. The envelope and
+        hangover counters are taken from `part', hence the merged state
+        may continue to be used with speech_voltmeter(). Partial states
+        must be merged in time order.
+
+        Variables:
+        ~~~~~~~~~~
+        Name:         Type:   Use:
+        state          I/O       state variable of the measurement
+        part            I        partial state of the next chunk
+
+        Value returned:
+        ~~~~~~~~~~~~~~~
+        None.
+
+        Prototype:   in sv-p56.h
+        ~~~~~~~~~~
+
+        Log of changes:
+        ~~~~~~~~~~~~~~~
+        16.Oct.26     1.0       Created.
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+void speech_voltmeter_merge (SVP56_state * state, SVP56_state * part) {
+  int j;
+
+  for (j = 0; j < THRES_NO; j++) {
+    state->a[j] += part->a[j];
+    state->hang[j] = part->hang[j];
+  }
+  state->n += part->n;
+  state->s += part->s;
+  state->sq += part->sq;
+  state->p = part->p;
+  state->q = part->q;
+  if (part->max > state->max)
+    state->max = part->max;
+  if (part->maxP > state->maxP)
+    state->maxP = part->maxP;
+  if (part->maxN < state->maxN)
+    state->maxN = part->maxN;
+}
+
+/* ................... End of speech_voltmeter_merge() .................... */
+
+#undef SV56_PREROLL
+#undef SV56_LANES
+#undef SV56_BLOCK
 #undef MIN_LOG_OFFSET
 #undef M
 #undef H
 #undef T
 #undef THRES_NO
-/* .................... End of speech_voltmeter() ........................ */
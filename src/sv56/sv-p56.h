@@ -23,6 +23,8 @@
                         <tdsimao@venus.cpqd.ansp.br>
    01.Sep.95    v2.2    Updated version number to match sv-p56.c and added 
                         smart prototypes <simao@ctd.comsat.com>
+   16.Oct.26    v2.4    Prototypes for the chunked measurement (partial
+                        states and their merging).
 
   ============================================================================
 */
@@ -61,6 +63,12 @@ typedef struct {
 double bin_interp ARGS ((double upcount, double lwcount, double upthr, double lwthr, double Margin, double tol));
 void init_speech_voltmeter ARGS ((SVP56_state * state, double sampl_freq));
 double speech_voltmeter ARGS ((float *buffer, long smpno, SVP56_state * state));
+double speech_voltmeter_level ARGS ((SVP56_state * state));
+
+/* Chunked measurement: measure buffer[start..end) into a partial state, and
+   merge the partial states (in time order) into the state */
+void speech_voltmeter_part ARGS ((float *buffer, long start, long end, SVP56_state * state, SVP56_state * part));
+void speech_voltmeter_merge ARGS ((SVP56_state * state, SVP56_state * part));
 
 
 /* Definitions for getting statistics from a `SVP56_state' variable */
@@ -1,4 +1,4 @@
-/*                                                              v3.5 02.Feb.10
+/*                                                              v3.6 16.Oct.26
   ============================================================================
 
   SV56DEMO.C
@@ -45,9 +45,13 @@
   $ sv56demo [-options] FileIn FileOut
              [BlockSize [1stBlock [NoOfBlocks [DesiredLevel
              [SampleRate [Resolution] ] ] ] ] ]
+  $ sv56demo [-options] -batch FileList
   where:
-  FileIn           is the input file to be analysed and equalized;
-  FileOut          is the output equalized file
+  FileIn           is the input file to be analysed and equalized; "-"
+                   reads from the standard input (implies -stream);
+  FileOut          is the output equalized file; "-" writes to the
+                   standard output (implies -stream and -q, and the
+                   statistics go to stderr unless -log is used)
   BlockSize        is the block size in number of samples;
   1stBlock         the first block to be analysed/equalized
   NoOfBlocks       number of blocks to be analysed/equalized
@@ -81,6 +85,19 @@
   -end eb ........ define `eb' as the last block to be measured
   -n nb .......... define `nb' as the number of blocks to be measured;
                    equivalent to parameter N2 above [default: whole file]
+  -stream ........ single-pass operation: the input samples are kept in
+                   a spool buffer during the measurement, and the gain
+                   is applied from it instead of reading the input twice.
+                   Works with pipes; results are the same as the default
+                   two-pass operation.
+  -spool mb ...... maximum size of the in-memory spool buffer, in MBytes
+                   (0: none); samples beyond it go to a temporary file
+                   [default: 64]
+  -batch L ....... normalize all the "FileIn FileOut" pairs listed in
+                   file L (single-pass), to -26 dBov or the level given
+                   by -lev; the statistics are printed in list order
+  -threads T ..... number of worker threads for -batch [default: no. of
+                   CPUs]
 
   Modules used:
   ~~~~~~~~~~~~~
@@ -92,6 +109,8 @@
               (scaling) algorithm of scale() and the data type
               conversion functions sh2fl() and fl2sh(). Prototypes
               are in `ugst-utl.h'.
+  > ugst-thread.c: worker threads of the -batch mode, ugst_ncpu() and
+              ugst_parallel_for(). Prototypes are in `ugst-thread.h'.
 
   Exit values:
   ~~~~~~~~~~~~
@@ -102,6 +121,8 @@
   4      error moving pointer to desired start of conversion;
   5      error reading input file;
   6      error writing to file;
+  7      error allocating memory or the spool temporary file;
+  8      some files of the -batch list could not be processed;
 
   Compilation:
   ~~~~~~~~~~~~
@@ -155,6 +176,9 @@
                            a multiple of the block size <simao>.
   02.Feb.10     3.5        Modified maximum string length to avoid
                            buffer overruns (y.hiwasaki)
+  16.Oct.26     3.6        Added single-pass operation with a spool buffer
+                           (-stream, -spool), stdin/stdout as "-", and the
+                           multi-threaded batch mode (-batch, -threads).
 
   ============================================================================
 */
@@ -174,7 +198,7 @@
 #include <stat.h>
 #else /* Unix/DOS */
 #include <sys/stat.h>
-#if defined(MSDOS)
+#if defined(MSDOS) || defined(_WIN32)
 #include <fcntl.h>
 #include <io.h>
 #endif /* MSDOS */
@@ -185,9 +209,11 @@
 
 /* ... Include of utilities ... */
 #include "ugst-utl.h"
+#include "ugst-thread.h"
 
 /* Local definitions */
 #define MIN_LOG_OFFSET 1.0e-20  /* To avoid sigularity with log(0.0) */
+#define DEFAULT_SPOOL_MB 64     /* default in-memory spool size, in MBytes */
 
 /*
  -------------------------------------------------------------------------
@@ -202,7 +228,7 @@
  -------------------------------------------------------------------------
 */
 void display_usage () {
-  printf ("SV56DEMO.C: Version 3.5 of 02.Feb.2010 \n\n");
+  printf ("SV56DEMO.C: Version 3.6 of 16.Oct.2026 \n\n");
   printf ("  Program to level-equalize a speech file \"NdB\" dBs below\n");
   printf ("  the overload point for a linear n-bit (default: 16 bit) system.\n");
   printf ("  using the P.56 speech voltmeter algorithm.\n");
@@ -211,8 +237,11 @@ void display_usage () {
   printf ("  $ sv56demo [-options] FileIn FileOut \n");
   printf ("             [BlockSize [1stBlock [NoOfBlocks [DesiredLevel\n");
   printf ("             [SampleRate [Resolution] ] ] ] ] ]\n");
+  printf ("  $ sv56demo [-options] -batch FileList\n");
   printf ("  FileIn: ..... is the input file to be analysed and equalized;\n");
-  printf ("  FileOut: .... is the output equalized file\n");
+  printf ("                \"-\" for stdin (implies -stream)\n");
+  printf ("  FileOut: .... is the output equalized file; \"-\" for stdout\n");
+  printf ("                (implies -stream -q; statistics go to stderr)\n");
   printf ("  BlockSize: .. is the block size [default: 256 samples]\n");
   printf ("  1stBlock: ... the first block to be manipulated [default: 1st]\n");
   printf ("  NoOfBlocks: . number of blocks to be manipulated [default: all]\n");
@@ -239,6 +268,13 @@ void display_usage () {
   printf ("  -end eb ..... define `eb' as the last block to be measured\n");
   printf ("  -n nb ....... define `nb' as the number of blocks to be measured;\n");
   printf ("                equiv. to param.NoOfBlocks above [dft: whole file]\n");
+  printf ("  -stream ..... single pass: the samples are spooled during the\n");
+  printf ("                measurement and the gain is applied from the spool\n");
+  printf ("  -spool mb ... max. in-memory spool size in MBytes; the rest goes\n");
+  printf ("                to a temporary file [default: %d]\n", DEFAULT_SPOOL_MB);
+  printf ("  -batch L .... normalize (single pass) all the \"FileIn FileOut\"\n");
+  printf ("                pairs of list L to -26 dBov, or to the -lev level\n");
+  printf ("  -threads T .. number of worker threads for -batch [dft: no. CPUs]\n");
   printf ("  -log file ... log statistics into file rather than stdout\n");
   printf ("  -q .......... quiet operation - does not print the progress flag.\n");
   printf ("                Saves time and avoids trash in batch processings.\n");
@@ -411,6 +447,256 @@ void print_p56_short_summary (FILE * out, char *file, SVP56_state state, double
 /* ................... End of print_p56_short_summary() .................... */
 
 
+/*
+  ============================================================================
+
+       Spool buffer for the single-pass operation
+
+       The input samples of the measurement pass are kept in memory up to
+       a maximum number of samples, and the remaining ones are stored into
+       a temporary file. The samples are then read back, in the same
+       order, for the equalization. The 16-bit input samples are spooled
+       (rather than their float conversion), since sh2fl() gives the same
+       float values when converting them again, with half the storage.
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+typedef struct {
+  short *mem;                   /* samples kept in memory */
+  long nmem;                    /* number of samples in memory */
+  long size;                    /* allocated size of mem */
+  long max;                     /* maximum number of samples in memory */
+  long pos;                     /* read position in mem */
+  FILE *tmp;                    /* temporary file for the samples beyond max */
+} SV56_SPOOL;
+
+
+static void spool_init (SV56_SPOOL * sp, long max) {
+  sp->mem = NULL;
+  sp->nmem = sp->size = sp->pos = 0;
+  sp->max = max;
+  sp->tmp = NULL;
+}
+
+
+/* Append n samples; returns 0 if OK, -1 on memory or temporary file error */
+static int spool_put (SV56_SPOOL * sp, short *x, long n) {
+  long size;
+  short *mem;
+
+  if (sp->tmp == NULL && sp->nmem + n <= sp->max) {
+    if (sp->nmem + n > sp->size) {
+      for (size = sp->size ? sp->size : 65536; size < sp->nmem + n; size *= 2);
+      if (size > sp->max)
+        size = sp->max;
+      if ((mem = (short *) realloc (sp->mem, size * sizeof (short))) == NULL)
+        return -1;
+      sp->mem = mem;
+      sp->size = size;
+    }
+    memcpy (sp->mem + sp->nmem, x, n * sizeof (short));
+    sp->nmem += n;
+    return 0;
+  }
+
+  /* Memory is full: the rest goes to the temporary file */
+  if (sp->tmp == NULL && (sp->tmp = tmpfile ()) == NULL)
+    return -1;
+  return (fwrite (x, sizeof (short), n, sp->tmp) == (size_t) n) ? 0 : -1;
+}
+
+
+/* Prepare to read the samples back from the beginning */
+static void spool_rewind (SV56_SPOOL * sp) {
+  sp->pos = 0;
+  if (sp->tmp != NULL)
+    rewind (sp->tmp);
+}
+
+
+/* Read back up to n samples; returns the number of samples read */
+static long spool_get (SV56_SPOOL * sp, short *x, long n) {
+  long l = 0;
+
+  if (sp->pos < sp->nmem) {
+    l = (sp->nmem - sp->pos < n) ? sp->nmem - sp->pos : n;
+    memcpy (x, sp->mem + sp->pos, l * sizeof (short));
+    sp->pos += l;
+  }
+  if (l < n && sp->tmp != NULL)
+    l += (long) fread (x + l, sizeof (short), n - l, sp->tmp);
+  return l;
+}
+
+
+static void spool_free (SV56_SPOOL * sp) {
+  free (sp->mem);
+  if (sp->tmp != NULL)
+    fclose (sp->tmp);
+  spool_init (sp, sp->max);
+}
+
+/* ........................ End of spool functions ........................ */
+
+
+/* Parameters and results of the single-pass equalization of one file */
+typedef struct {
+  /* parameters */
+  long N;                       /* block size */
+  long N1;                      /* first block (starting from 0) */
+  long N2;                      /* number of blocks; 0: up to end of file */
+  long bitno;                   /* resolution, in bits */
+  double sf;                    /* sampling frequency */
+  double NdB;                   /* desired level, dBov */
+  char use_active_level;        /* 0: normalize to the RMS level */
+  char quiet;                   /* don't print the progress flag */
+  long spool_max;               /* max. number of samples spooled in memory */
+  /* results */
+  SVP56_state state;            /* speech voltmeter state */
+  double ActiveLeveldB;         /* active speech level */
+  double factor;                /* equalization factor */
+  long nblocks;                 /* number of blocks processed */
+  long NrSat;                   /* number of clipped samples */
+} SV56_JOB;
+
+
+/*
+  ============================================================================
+
+       int sv56_single_pass (FILE *Fi, FILE *Fo, SV56_JOB *job);
+       ~~~~~~~~~~~~~~~~~~~~
+
+       Measures the level of the blocks of interest of Fi and writes them,
+       equalized, into Fo, reading the input only once. The samples are
+       spooled during the measurement pass and the gain is applied from
+       the spool, hence Fi and Fo may be pipes. The results are the same
+       as those of the two-pass operation in main().
+
+       Parameter:
+       ~~~~~~~~~~
+       Fi ....... input file, positioned at its beginning
+       Fo ....... output file
+       job ...... parameters of the operation; the results are returned
+                  in its state, ActiveLeveldB, factor, nblocks and NrSat
+
+       Returns
+       ~~~~~~~
+       0 if OK, or the exit code of the error (4, 5, 6 or 7; see above)
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+int sv56_single_pass (FILE * Fi, FILE * Fo, SV56_JOB * job) {
+  static unsigned mask[5] = { 0xFFFF, 0xFFFE, 0xFFFB, 0xFFF8, 0xFFF0 };
+  static char funny[5] = { '/', '-', '\\', '|', '-' };
+  SV56_SPOOL spool;
+  short *buffer;
+  float *Buf;
+  long i, l, N = job->N;
+  int err = 0;
+
+  init_speech_voltmeter (&job->state, job->sf);
+  job->ActiveLeveldB = -100.0;
+  job->nblocks = job->NrSat = 0;
+
+  buffer = (short *) malloc (N * sizeof (short));
+  Buf = (float *) malloc (N * sizeof (float));
+  if (buffer == NULL || Buf == NULL) {
+    free (buffer);
+    free (Buf);
+    return 7;
+  }
+  spool_init (&spool, job->spool_max);
+
+  /* Move to the 1st block of interest; pipes are read until there */
+  if (job->N1 > 0 && fseek (Fi, job->N1 * N * (long) sizeof (short), SEEK_SET) != 0)
+    for (i = 0; i < job->N1 && err == 0; i++)
+      if (fread (buffer, sizeof (short), N, Fi) != (size_t) N)
+        err = 4;
+
+  /* ... MEASUREMENT OF ACTIVE SPEECH LEVEL ACCORDING P.56 ... */
+  for (i = 0; err == 0 && (job->N2 == 0 || i < job->N2); i++) {
+    if ((l = (long) fread (buffer, sizeof (short), N, Fi)) > 0) {
+      sh2fl (l, buffer, Buf, job->bitno, 1);
+      job->ActiveLeveldB = speech_voltmeter (Buf, l, &job->state);
+      if (spool_put (&spool, buffer, l) < 0)
+        err = 7;
+      if (!job->quiet)
+        fprintf (stderr, "%c\r", funny[i % 5]);
+    } else if (job->N2 == 0 && !ferror (Fi))
+      break;
+    else
+      err = 5;
+  }
+  job->nblocks = i;
+
+  /* ... COMPUTE EQUALIZATION FACTOR ... */
+  if (job->use_active_level)
+    job->factor = pow (10.0, (job->NdB - job->ActiveLeveldB) / 20.0);
+  else
+    job->factor = pow (10.0, (job->NdB - SVP56_get_rms_dB (job->state)) / 20.0);
+
+  /* EQUALIZATION from the spool: hard clipping (with truncation) */
+  spool_rewind (&spool);
+  while (err == 0 && (l = spool_get (&spool, buffer, N)) > 0) {
+    sh2fl (l, buffer, Buf, job->bitno, 1);
+    scale (Buf, l, job->factor);
+    job->NrSat += fl2sh (l, Buf, buffer, (double) 0.0, mask[16 - job->bitno]);
+    if (fwrite (buffer, sizeof (short), l, Fo) != (size_t) l)
+      err = 6;
+  }
+  if (err == 0 && fflush (Fo) != 0)
+    err = 6;
+
+  spool_free (&spool);
+  free (buffer);
+  free (Buf);
+  return err;
+}
+
+/* ....................... End of sv56_single_pass() ....................... */
+
+
+/* Batch processing: list of files and their parameters/results */
+typedef struct {
+  char (*FileIn)[MAX_STRLEN];   /* input files */
+  char (*FileOut)[MAX_STRLEN];  /* output files */
+  long nfiles;                  /* number of files in the list */
+  SV56_JOB *job;                /* per-file parameters and results */
+  int *status;                  /* per-file result: 0 if OK */
+} SV56_BATCH;
+
+
+/* Worker job: equalize file number k of the list */
+static void sv56_file (void *ctx, long k) {
+  SV56_BATCH *b = (SV56_BATCH *) ctx;
+  FILE *Fi, *Fo;
+
+  if ((Fi = fopen (b->FileIn[k], "rb")) == NULL) {
+    perror (b->FileIn[k]);
+    b->status[k] = 2;
+    return;
+  }
+  if ((Fo = fopen (b->FileOut[k], "wb")) == NULL) {
+    perror (b->FileOut[k]);
+    fclose (Fi);
+    b->status[k] = 3;
+    return;
+  }
+  if ((b->status[k] = sv56_single_pass (Fi, Fo, &b->job[k])) != 0)
+    fprintf (stderr, "%s: error %d during the normalization\n", b->FileIn[k], b->status[k]);
+  fclose (Fi);
+  fclose (Fo);
+}
+
+
 /*
    **************************************************************************
    ***                                                                    ***
@@ -448,6 +734,13 @@ int main (int argc, char *argv[]) {
   static char funny[5] = { '/', '-', '\\', '|', '-' };
   static unsigned mask[5] = { 0xFFFF, 0xFFFE, 0xFFFB, 0xFFF8, 0xFFF0 };
 
+  /* Single-pass and batch operation */
+  char stream = 0, FileList[MAX_STRLEN] = "";
+  long spool_mb = DEFAULT_SPOOL_MB, k, nfail;
+  int nthreads = 0, err;
+  SV56_JOB job;
+  SV56_BATCH batch;
+
 
   /* ......... GET PARAMETERS ......... */
 
@@ -455,7 +748,7 @@ int main (int argc, char *argv[]) {
   if (argc < 2)
     display_usage ();
   else {
-    while (argc > 1 && argv[1][0] == '-')
+    while (argc > 1 && argv[1][0] == '-' && argv[1][1] != '\0')
       if (strcmp (argv[1], "-lev") == 0) {
         /* Change default level normalization */
         NdB = atof (argv[2]);
@@ -509,6 +802,34 @@ int main (int argc, char *argv[]) {
         /* Change default number of blocks */
         N2 = atol (argv[2]);
 
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-stream") == 0) {
+        /* Single-pass operation */
+        stream = 1;
+
+        /* Move argv over the option to the next argument */
+        argv++;
+        argc--;
+      } else if (strcmp (argv[1], "-spool") == 0) {
+        /* Size of the in-memory spool buffer, in MBytes */
+        spool_mb = atol (argv[2]);
+
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-batch") == 0) {
+        /* Normalize all the files of a list */
+        strncpy (FileList, argv[2], MAX_STRLEN - 1);
+
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-threads") == 0) {
+        /* Number of worker threads in batch mode */
+        nthreads = atoi (argv[2]);
+
         /* Update argc/argv to next valid option/argument */
         argv += 2;
         argc -= 2;
@@ -547,6 +868,61 @@ int main (int argc, char *argv[]) {
   }
 
 
+  /* Parameters common to the single-pass and batch operations */
+  job.N = N;
+  job.N1 = N1 - 1;
+  job.N2 = N2;
+  job.bitno = bitno;
+  job.sf = sf;
+  job.NdB = NdB;
+  job.use_active_level = use_active_level;
+  job.quiet = 1;
+  job.spool_max = (spool_mb > 0 ? spool_mb : 0) * (1024L * 1024L / sizeof (short));
+
+
+  /* ......... BATCH OPERATION ......... */
+  if (FileList[0]) {
+    if ((batch.nfiles = read_file_list (FileList, &batch.FileIn, &batch.FileOut)) < 0)
+      KILL (FileList, 2);
+    batch.job = (SV56_JOB *) malloc ((batch.nfiles + 1) * sizeof (SV56_JOB));
+    batch.status = (int *) calloc (batch.nfiles + 1, sizeof (int));
+    if (batch.job == NULL || batch.status == NULL)
+      KILL (FileList, 7);
+    for (k = 0; k < batch.nfiles; k++)
+      batch.job[k] = job;
+
+    /* equalize the files on the worker threads */
+    ugst_parallel_for (batch.nfiles, nthreads, sv56_file, &batch);
+
+    /* print the statistics in the order of the list */
+    for (k = 0, nfail = 0; k < batch.nfiles; k++) {
+      if (batch.status[k] != 0) {
+        nfail++;
+        continue;
+      }
+      Overflow = pow ((double) 2.0, (double) (batch.job[k].bitno - 1));
+      if (long_summary)
+        print_p56_long_summary (out, batch.FileIn[k], batch.job[k].state, batch.job[k].ActiveLeveldB, NdB, Overflow, batch.job[k].factor, N, job.N1, batch.job[k].nblocks, bitno);
+      else
+        print_p56_short_summary (out, batch.FileIn[k], batch.job[k].state, batch.job[k].ActiveLeveldB, Overflow, batch.job[k].factor);
+      if (batch.job[k].NrSat != 0)
+        fprintf (out, "\n  Number of clippings: .......... %7ld []\n", batch.job[k].NrSat);
+      else
+        fprintf (out, "\n");
+    }
+    if (nfail)
+      fprintf (stderr, "\n%ld of %ld files could not be processed\n", nfail, batch.nfiles);
+
+    free (batch.job);
+    free (batch.status);
+    free (batch.FileIn);
+    free (batch.FileOut);
+    if (out != stdout)
+      fclose (out);
+    return (nfail ? 8 : 0);
+  }
+
+
   /* Reads parameters for processing */
   GET_PAR_S (1, "_Input File: ........................... ", FileIn);
   GET_PAR_S (2, "_Output File: .......................... ", FileOut);
@@ -558,6 +934,65 @@ int main (int argc, char *argv[]) {
   FIND_PAR_L (8, "_A/D resolution: ....................... ", bitno, bitno);
 
 
+  /* ......... SINGLE-PASS OPERATION ......... */
+  if (strcmp (FileIn, "-") == 0 || strcmp (FileOut, "-") == 0)
+    stream = 1;
+  if (stream) {
+    /* stdin/stdout are used as "-"; then keep stdout for the samples only */
+    if (strcmp (FileOut, "-") == 0) {
+      quiet = 1;
+      if (out == stdout)
+        out = stderr;
+    }
+    Fi = strcmp (FileIn, "-") == 0 ? stdin : fopen (FileIn, "rb");
+    Fo = strcmp (FileOut, "-") == 0 ? stdout : fopen (FileOut, "wb");
+    if (Fi == NULL)
+      KILL (FileIn, 2);
+    if (Fo == NULL)
+      KILL (FileOut, 3);
+#if defined(MSDOS) || defined(_WIN32)
+    setmode (fileno (Fi), O_BINARY);
+    setmode (fileno (Fo), O_BINARY);
+#endif
+
+    /* the block parameters may have been given as positional arguments */
+    job.N = N;
+    job.N1 = N1 - 1;
+    job.N2 = N2;
+    job.NdB = NdB;
+    job.sf = sf;
+    job.bitno = bitno;
+    job.quiet = quiet;
+    if (!quiet)
+      fprintf (stderr, "  Processing \r");
+
+    if ((err = sv56_single_pass (Fi, Fo, &job)) != 0)
+      KILL (err == 6 ? FileOut : FileIn, err);
+    if (!quiet)
+      fprintf (stderr, "\n");
+
+    Overflow = pow ((double) 2.0, (double) (bitno - 1));
+    if (long_summary)
+      print_p56_long_summary (out, FileIn, job.state, job.ActiveLeveldB, NdB, Overflow, job.factor, N, job.N1, job.nblocks, bitno);
+    else
+      print_p56_short_summary (out, FileIn, job.state, job.ActiveLeveldB, Overflow, job.factor);
+    if (job.NrSat != 0)
+      fprintf (out, "\n  Number of clippings: .......... %7ld []\n", job.NrSat);
+    else
+      fprintf (out, "\n");
+
+    if (!quiet)
+      fprintf (stderr, "---> DONE    \n");
+    if (Fi != stdin)
+      fclose (Fi);
+    if (Fo != stdout)
+      fclose (Fo);
+    if (out != stdout && out != stderr)
+      fclose (out);
+    return (0);
+  }
+
+
   /* ......... SOME INITIALIZATIONS ......... */
   start_byte = --N1;
   start_byte *= N * sizeof (short);
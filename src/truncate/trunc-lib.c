@@ -35,6 +35,8 @@
 
 */
 
+#include "trunc-lib.h"
+
 /* Routine to truncate a frame */
 void trunca (short syncWord, short outFrameLgth, short *inpFrame, short *outFrame) {
   int i;
@@ -45,3 +47,19 @@ void trunca (short syncWord, short outFrameLgth, short *inpFrame, short *outFram
     outFrame[i + 2] = inpFrame[i];
   }
 }
+
+/* Routine to truncate a frame of a packed bitstream: only the frame
+   index changes, and the dropped bits are cleared */
+void trunca_packed (short syncWord, short outFrameLgth, PACKED_BS * bs, long frame) {
+  PBS_WORD *bits = packed_bs_frame (bs, frame);
+  long i;
+
+  bs->sync[frame] = syncWord;
+  if (outFrameLgth < bs->len[frame]) {
+    for (i = PBS_WORDS (outFrameLgth); i < PBS_WORDS (bs->len[frame]); i++)
+      bits[i] = 0;
+    if (outFrameLgth % PBS_BITS)
+      bits[outFrameLgth / PBS_BITS] &= ((PBS_WORD) 1 << (outFrameLgth % PBS_BITS)) - 1;
+    bs->len[frame] = outFrameLgth;
+  }
+}
@@ -37,9 +37,18 @@
 */
 
 
+#include "bitpack.h"
+
 /* Routine to truncate a frame */
 void trunca (short syncWord,    /* Synchronisation word */
              short outFrameLgth,        /* Length of the output frame */
              short *inpFrame,   /* input frame */
              short *outFrame    /* output frame */
   );
+
+/* Routine to truncate a frame of a packed bitstream, in place */
+void trunca_packed (short syncWord,     /* Synchronisation word */
+                    short outFrameLgth, /* Length of the output frame */
+                    PACKED_BS * bs,     /* packed bitstream */
+                    long frame  /* index of the frame in bs */
+  );
@@ -1,4 +1,4 @@
-/*                                                          02/Feb/2010 v1.3 */
+/*                                                          16/Oct/2026 v1.4 */
 /*=============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -38,6 +38,12 @@
                   modified maximum string length to avoid buffer overruns
                   (y.hiwasaki)
 
+  16.Oct.26 v1.4  Bitstreams without sync header, byte-oriented and binary
+                  bitstreams are read one frame at a time into a packed
+                  frame and truncated in place, instead of going through a
+                  temporary G.192 file. Frames with soft bits are truncated
+                  as G.192 softbits.
+
   AUTHORS :
 	Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
 
@@ -61,7 +67,7 @@
 #define MAX_BST_LENGTH 2560
 
 static void display_usage () {
-  printf ("TRUNCATE.C - Version 1.3 of 02.Feb.2010 \n\n");
+  printf ("TRUNCATE.C - Version 1.4 of 16.Oct.2026 \n\n");
 
   printf (" Bitstream truncation program\n");
   printf (" This program truncates a bitstream to obtain intermediate bitrates\n");
@@ -89,73 +95,121 @@ static void display_usage () {
 #define N 1024
 
 /*
-	Routine converting bitstreams in the G.192 (with sync header) format.
-	This routine uses the functions in softbit.c
-
-	Authors : Cyril Guillaume & Stephane Ragot -- stephane.ragot@rd.francetelecom.com
+	Routine reading one frame of a bitstream without sync header, of a
+	byte-oriented bitstream or of a binary bitstream, and packing it as
+	the only frame of bs. A frame with soft bits, which can not be
+	packed, is left in patt as G.192 softbits and *packed is set to 0.
+	Returns the number of bits of the frame, or 0 at the end of the
+	input (an incomplete last frame is ignored).
 */
-static int conv_inpBst (char type, int n, char sync_header, FILE * pfile, FILE * pfile_conv) {
-  short *patt;
-  short sync = G192_SYNC;
-  int nbread;
+static long read_inpFrame (char type, int n, char sync_header, FILE * pfile, PACKED_BS * bs, short *patt, char *bytes, short *sync, int *packed) {
+  PBS_WORD *bits;
+  long i, len = n, nbread;
+
+  reset_packed_bs (bs);
+  *sync = G192_SYNC;
+  *packed = 1;
 
-  patt = malloc (sizeof (short) * n);
   switch (type) {
   case byte:
-    if (!sync_header)
-      while (nbread = read_byte (patt, n, pfile)) {
-        fwrite (&sync, sizeof (short), 1, pfile_conv);
-        fwrite (&n, sizeof (short), 1, pfile_conv);
-        save_g192 (patt, nbread, pfile_conv);
-    } else
-      while (nbread = read_byte (patt, n, pfile)) {
-        save_g192 (patt, nbread, pfile_conv);
+    if (!sync_header) {
+      if ((nbread = fread (bytes, 1, n, pfile)) == n) {
+        for (i = 0; i < n; i++)
+          patt[i] = (unsigned char) bytes[i];
+        if ((bits = packed_bs_add_frame (bs, G192_SYNC, n)) == NULL || byte_to_packed (bytes, bits, n) != 0)
+          *packed = 0;
       }
-
+    } else {
+      if ((nbread = fread (bytes, 1, 2, pfile)) != 2)
+        break;
+      *sync = (short) (0x6B00 | (unsigned char) bytes[0]);
+      len = (unsigned char) bytes[1];
+      if ((nbread = fread (bytes + 2, 1, len, pfile)) == len) {
+        for (i = 0; i < len; i++)
+          patt[i] = (unsigned char) bytes[i + 2];
+        if (packed_bs_add_byte (bs, bytes) < 0)
+          *packed = 0;
+      } else
+        nbread += 2;
+    }
     break;
   case compact:
-    while (nbread = read_bit (patt, n, pfile, BER)) {
-      fwrite (&sync, sizeof (short), 1, pfile_conv);
-      fwrite (&n, sizeof (short), 1, pfile_conv);
-      save_g192 (patt, nbread, pfile_conv);
-    }
+    if ((nbread = read_bit (patt, n, pfile, BER)) == n)
+      if ((bits = packed_bs_add_frame (bs, G192_SYNC, n)) == NULL || g192_to_packed (patt, bits, n) != 0)
+        *packed = 0;
     break;
   case g192:
-    if (!sync_header) {
-      while (nbread = read_g192 (patt, n, pfile)) {
-        fwrite (&sync, sizeof (short), 1, pfile_conv);
-        fwrite (&n, sizeof (short), 1, pfile_conv);
-        save_g192 (patt, nbread, pfile_conv);
-      }
-    }
+  default:
+    if ((nbread = read_g192 (patt, n, pfile)) == n)
+      if ((bits = packed_bs_add_frame (bs, G192_SYNC, n)) == NULL || g192_to_packed (patt, bits, n) != 0)
+        *packed = 0;
     break;
   }
-  free(patt);
 
+  if (nbread == len)
+    return len;
+  if (nbread > 0)
+    fprintf (stderr, "Warning: Incomplete last frame, ignored");
   return 0;
 }
 
+/*
+	Routine returning the number of bits of the output frame, from the
+	constant bitrate or the bitrate file.
+*/
+static short out_frame_length (int mode, long rate, FILE * pfilrate, long *prev_bitrate, double framelength, int nbWrd, int nbframe, int quiet) {
+  long framerate;
+  short nbBitsOut;
+
+  if (mode == 0) {
+    /* read bitrate file */
+    if (fread (&framerate, sizeof (framerate), 1, pfilrate) != 1) {
+      printf ("Warning : bitrate file too short, previous bitrate is used for the rest \n");
+      framerate = *prev_bitrate;
+    }
+    *prev_bitrate = framerate;
+    if (!quiet)
+      printf (" frame %d  rate  %d  \n", nbframe, framerate);
+  } else {
+    /* constant bitrate */
+    framerate = rate;
+  }
+
+  /* compute the output framelength */
+  nbBitsOut = (short) (framelength * framerate);
+
+  /* check output framelength consistency */
+  if (nbBitsOut > nbWrd) {
+    nbBitsOut = nbWrd;
+    fprintf (stderr, "Warning: Desired bitrate is greater than input bitrate, input bitrate is chosen;\n");
+  }
+  return nbBitsOut;
+}
+
 int main (int argc, char *argv[]) {
   /* File variables */
   FILE *pfilin;                 /* input bitsream file */
   FILE *pfilout;                /* output bitstream file */
   FILE *pfilrate = NULL;        /* bitrate file */
-  FILE *pfiltmp;                /* temporary bitstream file */
+  PACKED_BS *bs = NULL;         /* packed input frame */
   char filin[MAX_STRLEN];       /* name of the input bitstream file */
   char filout[MAX_STRLEN];      /* name of the output bitstream file */
 
   /* buffers */
   short bstIn[MAX_BST_LENGTH];  /* input frame */
   short *outFrame;              /* output frame */
+  short *patt = NULL;           /* softbits of unpacked input frame */
+  char *bytes = NULL;           /* byte-oriented input frame */
+  int packed;
+  long len;
 
   /* Algorithm variables */
   char type;                    /* type of the input bitstream */
   char type_ER;
   char sync_header = 0;
   short n;
-  int nubread;
   int mode = -1;
-  long rate, inprate = -1, framerate, prev_bitrate;
+  long rate, inprate = -1, prev_bitrate;
   int nbframe = 0;
   int quiet = 0;
   double framelength = 0.02;
@@ -252,24 +306,18 @@ int main (int argc, char *argv[]) {
       exit (-1);
     }
 
-    /* Open temporary bitstream file */
-    if ((pfiltmp = tmpfile ()) == NULL) {
-      fprintf (stderr, "Error creating temporary bitstream file.\n");
-      exit (-1);
-    }
-
     /* set block length for conversion */
     n = (sync_header) ? N : (short) (framelength * inprate);
 
-    /* conversion */
-    conv_inpBst (type, n, sync_header, pfilin, pfiltmp);
-
-    /* close files */
-    fclose (pfilin);
-
-    /* open converted bitstream as input bitstream file */
-    rewind (pfiltmp);
-    pfilin = pfiltmp;
+    /* frames are packed one at a time */
+    bs = open_packed_bs (1, n);
+    patt = malloc (sizeof (short) * (n + 2));
+    bytes = malloc (n + 2);
+    outFrame = malloc (sizeof (short) * (n + 2));
+    if (bs == NULL || patt == NULL || bytes == NULL || outFrame == NULL) {
+      fprintf (stderr, "Error allocating memory for the input frame.\n");
+      exit (-1);
+    }
   }
 
   /* check output bistream file */
@@ -288,8 +336,32 @@ int main (int argc, char *argv[]) {
 
   /* ......... PROCESSING .......... */
 
+  /* loop over input frames: packed frames are truncated in place */
+  while (bs != NULL && (len = read_inpFrame (type, n, sync_header, pfilin, bs, patt, bytes, &sync, &packed)) > 0) {
+
+    /* check sync word */
+    if (!((sync <= SYNC_WORD_MAX) && (sync >= SYNC_WORD_MIN) || (sync == BAD_FRAME))) {
+      fprintf (stderr, "Error: Bad Bitstream format");
+      exit (-1);
+    }
+
+    nbBitsOut = out_frame_length (mode, rate, pfilrate, &prev_bitrate, framelength, len, nbframe, quiet);
+
+    /* truncate the frame according to the desired bitrate */
+    if (packed) {
+      trunca_packed (sync, nbBitsOut, bs, 0);
+      packed_bs_get_g192 (bs, 0, outFrame);
+    } else
+      trunca (sync, nbBitsOut, patt, outFrame);
+
+    /* write output bitstream */
+    fwrite (outFrame, sizeof (outFrame[0]), nbBitsOut + 2, pfilout);
+
+    nbframe++;
+  }
+
   /* loop over bitstream file */
-  while ((fread (&sync, 2, 1, pfilin) != 0) && (fread (&nbWords, 2, 1, pfilin) != 0)) { /* read the sync and framelength words */
+  while (bs == NULL && (fread (&sync, 2, 1, pfilin) != 0) && (fread (&nbWords, 2, 1, pfilin) != 0)) {  /* read the sync and framelength words */
 
     /* check sync word */
     if (!((sync <= SYNC_WORD_MAX) && (sync >= SYNC_WORD_MIN) || (sync == BAD_FRAME))) {
@@ -303,28 +375,8 @@ int main (int argc, char *argv[]) {
     if (((int) fread (bstIn, 2, nbWrd, pfilin)) != nbWrd) {
       fprintf (stderr, "Warning: Incomplete last frame, ignored");
     } else {
-      if (mode == 0) {
-        /* read bitrate file */
-        if ((nubread = fread (&framerate, sizeof (framerate), 1, pfilrate)) != 1) {
-          printf ("Warning : bitrate file too short, previous bitrate is used for the rest \n");
-          framerate = prev_bitrate;
-        }
-        prev_bitrate = framerate;
-        if (!quiet)
-          printf (" frame %d  rate  %d  \n", nbframe, framerate);
-      } else if (mode == 1) {
-        /* constant bitrate */
-        framerate = rate;
-      }
+      nbBitsOut = out_frame_length (mode, rate, pfilrate, &prev_bitrate, framelength, nbWrd, nbframe, quiet);
 
-      /* compute the output framelength */
-      nbBitsOut = (short) (framelength * framerate);
-
-      /* check output framelength consistency */
-      if (nbBitsOut > nbWrd) {
-        nbBitsOut = nbWrd;
-        fprintf (stderr, "Warning: Desired bitrate is greater than input bitrate, input bitrate is chosen;\n");
-      }
       /* allocate memory for the output frame */
       outFrame = malloc (sizeof (outFrame[0]) * (nbBitsOut + 2));
 
@@ -348,6 +400,12 @@ int main (int argc, char *argv[]) {
   /* FINALIZATIONS */
 
   /* close the opened files */
+  if (bs != NULL) {
+    close_packed_bs (bs);
+    free (patt);
+    free (bytes);
+    free (outFrame);
+  }
   fclose (pfilin);
   fclose (pfilout);
   if (pfilrate != NULL)
@@ -0,0 +1,429 @@
+/*                                                            v1.1  16.Oct.2026
+=============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+
+MODULE:         UGST-THREAD.C, UGST WORKER THREAD FUNCTIONS
+
+PROTOTYPE:     in ugst-thread.h
+
+FUNCTIONS:
+
+    ugst_ncpu: ........... number of on-line processors
+    ugst_parallel_for: ... run a set of independent jobs on worker threads
+    ugst_pool_open: ...... start a persistent pool of worker threads
+    ugst_pool_run: ....... run a set of independent jobs on a pool
+    ugst_pool_close: ..... stop the threads of a pool
+
+    POSIX threads are used on Unix-like systems and Win32 threads with
+    MS Visual C. If none is available (or UGST_NO_THREADS is defined at
+    compile time), the jobs are run sequentially by the calling thread.
+
+HISTORY:
+
+    16.Oct.2026 v1.0 Created.
+    16.Oct.2026 v1.1 Added persistent worker pools.
+
+=============================================================================
+*/
+
+#include <stdlib.h>
+
+#include "ugst-thread.h"
+
+#if defined(UGST_NO_THREADS)
+/* sequential processing only */
+#elif defined(_WIN32)
+#define UGST_WIN32_THREADS
+#include <windows.h>
+#include <process.h>
+#else
+#define UGST_POSIX_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+
+/* Job queue shared by the workers of one ugst_parallel_for() call */
+typedef struct {
+  long next;                    /* next job to hand out */
+  long njobs;                   /* number of jobs */
+  ugst_job_fn job;              /* job function */
+  void *ctx;                    /* job context */
+#if defined(UGST_POSIX_THREADS)
+  pthread_mutex_t lock;
+#elif defined(UGST_WIN32_THREADS)
+  CRITICAL_SECTION lock;
+#endif
+} ugst_queue;
+
+
+/*
+  ----------------------------------------------------------------------------
+  long ugst_next_job (ugst_queue *q);
+
+  Hand out the next job number, or -1 when the queue is exhausted.
+  ----------------------------------------------------------------------------
+*/
+static long ugst_next_job (ugst_queue * q) {
+  long k;
+
+#if defined(UGST_POSIX_THREADS)
+  pthread_mutex_lock (&q->lock);
+#elif defined(UGST_WIN32_THREADS)
+  EnterCriticalSection (&q->lock);
+#endif
+  k = (q->next < q->njobs) ? q->next++ : -1;
+#if defined(UGST_POSIX_THREADS)
+  pthread_mutex_unlock (&q->lock);
+#elif defined(UGST_WIN32_THREADS)
+  LeaveCriticalSection (&q->lock);
+#endif
+  return k;
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+  Worker loop: process jobs until the queue is exhausted.
+  ----------------------------------------------------------------------------
+*/
+static void ugst_worker_loop (ugst_queue * q) {
+  long k;
+
+  while ((k = ugst_next_job (q)) >= 0)
+    q->job (q->ctx, k);
+}
+
+#if defined(UGST_POSIX_THREADS)
+static void *ugst_worker (void *arg) {
+  ugst_worker_loop ((ugst_queue *) arg);
+  return NULL;
+}
+#elif defined(UGST_WIN32_THREADS)
+static unsigned __stdcall ugst_worker (void *arg) {
+  ugst_worker_loop ((ugst_queue *) arg);
+  return 0;
+}
+#endif
+
+
+/*
+  ----------------------------------------------------------------------------
+  int ugst_ncpu (void);
+
+  Return the number of on-line processors, or 1 if it cannot be found.
+  ----------------------------------------------------------------------------
+*/
+int ugst_ncpu (void) {
+#if defined(UGST_POSIX_THREADS) && defined(_SC_NPROCESSORS_ONLN)
+  long n = sysconf (_SC_NPROCESSORS_ONLN);
+  return (n > 0) ? (int) n : 1;
+#elif defined(UGST_WIN32_THREADS)
+  SYSTEM_INFO si;
+  GetSystemInfo (&si);
+  return (si.dwNumberOfProcessors > 0) ? (int) si.dwNumberOfProcessors : 1;
+#else
+  return 1;
+#endif
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+  void ugst_parallel_for (long njobs, int nthreads, ugst_job_fn job,
+                          void *ctx);
+
+  Run job(ctx,k) for k=0..njobs-1, on up to nthreads threads. The calling
+  thread takes part in the processing, hence all jobs are done even if no
+  extra thread could be created. Jobs must be independent of each other;
+  any data shared between jobs must be read-only.
+  ----------------------------------------------------------------------------
+*/
+void ugst_parallel_for (long njobs, int nthreads, ugst_job_fn job, void *ctx) {
+  ugst_queue q;
+#if defined(UGST_POSIX_THREADS)
+  pthread_t *tid;
+#elif defined(UGST_WIN32_THREADS)
+  HANDLE *tid;
+#endif
+  int i, n = 0;
+
+  if (nthreads <= 0)
+    nthreads = ugst_ncpu ();
+  if (nthreads > njobs)
+    nthreads = (int) njobs;
+
+  q.next = 0;
+  q.njobs = njobs;
+  q.job = job;
+  q.ctx = ctx;
+
+#if defined(UGST_POSIX_THREADS)
+  pthread_mutex_init (&q.lock, NULL);
+  if (nthreads > 1 && (tid = (pthread_t *) malloc ((nthreads - 1) * sizeof (pthread_t))) != NULL) {
+    for (n = 0; n < nthreads - 1; n++)
+      if (pthread_create (&tid[n], NULL, ugst_worker, &q) != 0)
+        break;
+    ugst_worker_loop (&q);
+    for (i = 0; i < n; i++)
+      pthread_join (tid[i], NULL);
+    free (tid);
+  } else
+    ugst_worker_loop (&q);
+  pthread_mutex_destroy (&q.lock);
+#elif defined(UGST_WIN32_THREADS)
+  InitializeCriticalSection (&q.lock);
+  if (nthreads > 1 && (tid = (HANDLE *) malloc ((nthreads - 1) * sizeof (HANDLE))) != NULL) {
+    for (n = 0; n < nthreads - 1; n++)
+      if ((tid[n] = (HANDLE) _beginthreadex (NULL, 0, ugst_worker, &q, 0, NULL)) == 0)
+        break;
+    ugst_worker_loop (&q);
+    for (i = 0; i < n; i++) {
+      WaitForSingleObject (tid[i], INFINITE);
+      CloseHandle (tid[i]);
+    }
+    free (tid);
+  } else
+    ugst_worker_loop (&q);
+  DeleteCriticalSection (&q.lock);
+#else
+  (void) i;
+  (void) n;
+  ugst_worker_loop (&q);
+#endif
+}
+
+
+/* Persistent pool: the workers wait for a new generation of jobs */
+struct ugst_pool {
+  int nworkers;                 /* worker threads running */
+  long generation;              /* number of ugst_pool_run() calls so far */
+  int busy;                     /* workers still on the current generation */
+  int quit;                     /* set by ugst_pool_close() */
+  ugst_queue q;                 /* jobs of the current generation */
+#if defined(UGST_POSIX_THREADS)
+  pthread_mutex_t lock;
+  pthread_cond_t start;         /* new generation or quit */
+  pthread_cond_t done;          /* busy dropped to 0 */
+  pthread_t *tid;
+#elif defined(UGST_WIN32_THREADS)
+  CRITICAL_SECTION lock;
+  CONDITION_VARIABLE start;
+  CONDITION_VARIABLE done;
+  HANDLE *tid;
+#endif
+};
+
+
+/*
+  ----------------------------------------------------------------------------
+  Pool worker: run the jobs of each new generation until the pool is closed.
+  ----------------------------------------------------------------------------
+*/
+#if defined(UGST_POSIX_THREADS)
+static void *ugst_pool_worker (void *arg) {
+  ugst_pool *pool = (ugst_pool *) arg;
+  long gen = 0;
+
+  pthread_mutex_lock (&pool->lock);
+  for (;;) {
+    while (!pool->quit && pool->generation == gen)
+      pthread_cond_wait (&pool->start, &pool->lock);
+    if (pool->quit)
+      break;
+    gen = pool->generation;
+    pthread_mutex_unlock (&pool->lock);
+
+    ugst_worker_loop (&pool->q);
+
+    pthread_mutex_lock (&pool->lock);
+    if (--pool->busy == 0)
+      pthread_cond_signal (&pool->done);
+  }
+  pthread_mutex_unlock (&pool->lock);
+  return NULL;
+}
+#elif defined(UGST_WIN32_THREADS)
+static unsigned __stdcall ugst_pool_worker (void *arg) {
+  ugst_pool *pool = (ugst_pool *) arg;
+  long gen = 0;
+
+  EnterCriticalSection (&pool->lock);
+  for (;;) {
+    while (!pool->quit && pool->generation == gen)
+      SleepConditionVariableCS (&pool->start, &pool->lock, INFINITE);
+    if (pool->quit)
+      break;
+    gen = pool->generation;
+    LeaveCriticalSection (&pool->lock);
+
+    ugst_worker_loop (&pool->q);
+
+    EnterCriticalSection (&pool->lock);
+    if (--pool->busy == 0)
+      WakeConditionVariable (&pool->done);
+  }
+  LeaveCriticalSection (&pool->lock);
+  return 0;
+}
+#endif
+
+
+/*
+  ----------------------------------------------------------------------------
+  ugst_pool *ugst_pool_open (int nthreads);
+
+  Start nthreads-1 worker threads, which wait for the jobs handed to
+  ugst_pool_run(); the calling thread is the remaining one. If fewer threads
+  could be started, the pool runs with those.
+  ----------------------------------------------------------------------------
+*/
+ugst_pool *ugst_pool_open (int nthreads) {
+  ugst_pool *pool;
+
+  if ((pool = (ugst_pool *) calloc (1, sizeof (ugst_pool))) == NULL)
+    return NULL;
+  if (nthreads <= 0)
+    nthreads = ugst_ncpu ();
+
+#if defined(UGST_POSIX_THREADS)
+  pthread_mutex_init (&pool->lock, NULL);
+  pthread_mutex_init (&pool->q.lock, NULL);
+  pthread_cond_init (&pool->start, NULL);
+  pthread_cond_init (&pool->done, NULL);
+  if (nthreads > 1 && (pool->tid = (pthread_t *) malloc ((nthreads - 1) * sizeof (pthread_t))) != NULL)
+    for (; pool->nworkers < nthreads - 1; pool->nworkers++)
+      if (pthread_create (&pool->tid[pool->nworkers], NULL, ugst_pool_worker, pool) != 0)
+        break;
+#elif defined(UGST_WIN32_THREADS)
+  InitializeCriticalSection (&pool->lock);
+  InitializeCriticalSection (&pool->q.lock);
+  InitializeConditionVariable (&pool->start);
+  InitializeConditionVariable (&pool->done);
+  if (nthreads > 1 && (pool->tid = (HANDLE *) malloc ((nthreads - 1) * sizeof (HANDLE))) != NULL)
+    for (; pool->nworkers < nthreads - 1; pool->nworkers++)
+      if ((pool->tid[pool->nworkers] = (HANDLE) _beginthreadex (NULL, 0, ugst_pool_worker, pool, 0, NULL)) == 0)
+        break;
+#endif
+  return pool;
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+  void ugst_pool_run (ugst_pool *pool, long njobs, ugst_job_fn job,
+                      void *ctx);
+
+  Run job(ctx,k) for k=0..njobs-1 on the threads of the pool, the calling
+  thread included, and return when all jobs are done. Only one thread may
+  call ugst_pool_run() on a given pool at a time.
+  ----------------------------------------------------------------------------
+*/
+void ugst_pool_run (ugst_pool * pool, long njobs, ugst_job_fn job, void *ctx) {
+  long k;
+
+  /* Nothing to share: run the jobs here */
+  if (pool == NULL || pool->nworkers == 0 || njobs <= 1) {
+    for (k = 0; k < njobs; k++)
+      job (ctx, k);
+    return;
+  }
+
+  pool->q.next = 0;
+  pool->q.njobs = njobs;
+  pool->q.job = job;
+  pool->q.ctx = ctx;
+
+#if defined(UGST_POSIX_THREADS)
+  pthread_mutex_lock (&pool->lock);
+  pool->busy = pool->nworkers;
+  pool->generation++;
+  pthread_cond_broadcast (&pool->start);
+  pthread_mutex_unlock (&pool->lock);
+
+  ugst_worker_loop (&pool->q);
+
+  pthread_mutex_lock (&pool->lock);
+  while (pool->busy > 0)
+    pthread_cond_wait (&pool->done, &pool->lock);
+  pthread_mutex_unlock (&pool->lock);
+#elif defined(UGST_WIN32_THREADS)
+  EnterCriticalSection (&pool->lock);
+  pool->busy = pool->nworkers;
+  pool->generation++;
+  WakeAllConditionVariable (&pool->start);
+  LeaveCriticalSection (&pool->lock);
+
+  ugst_worker_loop (&pool->q);
+
+  EnterCriticalSection (&pool->lock);
+  while (pool->busy > 0)
+    SleepConditionVariableCS (&pool->done, &pool->lock, INFINITE);
+  LeaveCriticalSection (&pool->lock);
+#endif
+}
+
+
+/*
+  ----------------------------------------------------------------------------
+  void ugst_pool_close (ugst_pool *pool);
+
+  Wake the workers up to quit, wait for them and free the pool.
+  ----------------------------------------------------------------------------
+*/
+void ugst_pool_close (ugst_pool * pool) {
+  int i;
+
+  if (pool == NULL)
+    return;
+
+#if defined(UGST_POSIX_THREADS)
+  pthread_mutex_lock (&pool->lock);
+  pool->quit = 1;
+  pthread_cond_broadcast (&pool->start);
+  pthread_mutex_unlock (&pool->lock);
+  for (i = 0; i < pool->nworkers; i++)
+    pthread_join (pool->tid[i], NULL);
+  pthread_cond_destroy (&pool->start);
+  pthread_cond_destroy (&pool->done);
+  pthread_mutex_destroy (&pool->q.lock);
+  pthread_mutex_destroy (&pool->lock);
+  free (pool->tid);
+#elif defined(UGST_WIN32_THREADS)
+  EnterCriticalSection (&pool->lock);
+  pool->quit = 1;
+  WakeAllConditionVariable (&pool->start);
+  LeaveCriticalSection (&pool->lock);
+  for (i = 0; i < pool->nworkers; i++) {
+    WaitForSingleObject (pool->tid[i], INFINITE);
+    CloseHandle (pool->tid[i]);
+  }
+  DeleteCriticalSection (&pool->q.lock);
+  DeleteCriticalSection (&pool->lock);
+  free (pool->tid);
+#else
+  (void) i;
+#endif
+  free (pool);
+}
+
+/* ************************* End of ugst-thread.c ************************* */
@@ -0,0 +1,57 @@
+/*
+  ============================================================================
+   File: UGST-THREAD.H                                             16.Oct.2026
+  ============================================================================
+
+                         UGST/ITU-T UTILITIES MODULE
+
+                   WORKER THREADS: GLOBAL FUNCTION PROTOTYPES
+
+   History:
+   16.Oct.2026  v1.0    First version, for the multi-threaded batch modes
+                        of the STL tools.
+   16.Oct.2026  v1.1    Added persistent worker pools (ugst_pool_*).
+  ============================================================================
+*/
+#ifndef UGST_THREAD_defined
+#define UGST_THREAD_defined 110
+
+/* macros for smart prototypes */
+#ifndef ARGS
+#if (defined(__STDC__) || defined(VMS) || defined(__DECC)  || defined(MSDOS) || defined(__MSDOS__))
+#define ARGS(x) x
+#else /* Unix: no parameters in prototype! */
+#define ARGS(x) ()
+#endif
+#endif
+
+/* Job function for ugst_parallel_for(): processes job number k of ctx */
+typedef void (*ugst_job_fn) ARGS ((void *ctx, long k));
+
+/* Number of on-line processors (1 if unknown) */
+int ugst_ncpu ARGS ((void));
+
+/* Run job(ctx,k) for k=0..njobs-1 on up to nthreads threads (the calling
+   thread included); nthreads<=0 uses ugst_ncpu(). Returns when all jobs are
+   done. Jobs are handed out in increasing order of k, but may complete in
+   any order. */
+void ugst_parallel_for ARGS ((long njobs, int nthreads, ugst_job_fn job, void *ctx));
+
+/* Persistent worker pool, for callers that run many small sets of jobs:
+   the threads are created once by ugst_pool_open() and wait for work
+   between calls to ugst_pool_run() */
+typedef struct ugst_pool ugst_pool;
+
+/* Open a pool of nthreads threads, the calling thread included (<=0: number
+   of CPUs). Returns NULL on lack of memory. */
+ugst_pool *ugst_pool_open ARGS ((int nthreads));
+
+/* As ugst_parallel_for(), on the threads of pool. A NULL pool runs the jobs
+   in turn on the calling thread. */
+void ugst_pool_run ARGS ((ugst_pool * pool, long njobs, ugst_job_fn job, void *ctx));
+
+/* Stop the threads and release the pool; NULL is ignored */
+void ugst_pool_close ARGS ((ugst_pool * pool));
+
+#endif /* UGST_THREAD_defined */
+/* ************************* End of ugst-thread.h ************************* */
@@ -51,6 +51,8 @@ FUNCTIONS:
     parallelize_left_justified ..... parallelization for left-justified data
     parallelize_right_justified .... parallelization for right-justified data
 
+    read_file_list: . reads a list of "FileIn FileOut" pairs (batch modes)
+
     There are two families of serialize...() and parallelize_...()
     functions. Ones dates from the STL92 release, and the other was
     generated for the STL96 release. The difference between them is
@@ -89,6 +91,8 @@ HISTORY:
   06.Mar.96 v3.0 Created new parallelize_...() and serialize_...() functions
                  which comply to the bitstream definition given in Annex B
                  of G.192. <simao@ctd.comsat.com>
+  16.Oct.26 v3.1 Added read_file_list(), shared by the batch modes of
+                 sv56demo and reverb.
 =============================================================================
 */
 
@@ -96,6 +100,8 @@ HISTORY:
 /*
  * .................... INCLUDES ....................
  */
+#include <stdio.h>              /* For fopen(), fgets(), sscanf() */
+#include <stdlib.h>             /* For realloc(), free() */
 #include <string.h>             /* For memset() */
 #include "ugst-utl.h"           /* Module Function prototypes */
 
@@ -1876,4 +1882,74 @@ unsigned long ran16_32c( float *seed ) {
 /*  .................... End of ran16_32c() ....................... */
 
 
+/*
+  ===========================================================================
+  long read_file_list (char *FileList, char (**FileIn)[MAX_STRLEN],
+  ~~~~~~~~~~~~~~~~~~~~ char (**FileOut)[MAX_STRLEN]);
+
+  Description:
+  ~~~~~~~~~~~~
+
+  Reads the list of "FileIn FileOut" pairs of a batch mode from the text
+  file FileList; empty lines and lines starting with '#' are skipped. File
+  names longer than MAX_STRLEN-1 characters are truncated.
+
+  Parameters:
+  ~~~~~~~~~~~
+  FileList ..... name of the list
+  FileIn ....... (out) allocated array of the input file names
+  FileOut ...... (out) allocated array of the output file names
+
+  Return value:
+  ~~~~~~~~~~~~~
+  The number of pairs, or -1 if the list can't be opened or there is not
+  enough memory; then *FileIn and *FileOut are NULL. Otherwise they are
+  to be released by the caller with free().
+
+  History:
+  ~~~~~~~~
+  16.Oct.26  v1.00  Created, out of the batch modes of sv56demo and reverb.
+
+  ===========================================================================
+*/
+long read_file_list (char *FileList, char (**FileIn)[MAX_STRLEN], char (**FileOut)[MAX_STRLEN]) {
+  FILE *ptr_list;
+  char line[2 * MAX_STRLEN + 16], fmt[32];
+  char (*in)[MAX_STRLEN] = NULL, (*out)[MAX_STRLEN] = NULL, (*tmp)[MAX_STRLEN];
+  long nfiles = 0, size = 0;
+
+  *FileIn = *FileOut = NULL;
+  if ((ptr_list = fopen (FileList, "r")) == NULL)
+    return -1;
+
+  /* Scan widths from the size of the names */
+  sprintf (fmt, "%%%ds %%%ds", MAX_STRLEN - 1, MAX_STRLEN - 1);
+
+  while (fgets (line, sizeof (line), ptr_list) != NULL) {
+    if (nfiles == size) {
+      size = size ? 2 * size : 64;
+      if ((tmp = (char (*)[MAX_STRLEN]) realloc (in, size * MAX_STRLEN)) != NULL)
+        in = tmp;
+      if (tmp == NULL || (tmp = (char (*)[MAX_STRLEN]) realloc (out, size * MAX_STRLEN)) == NULL) {
+        free (in);
+        free (out);
+        fclose (ptr_list);
+        return -1;
+      }
+      out = tmp;
+    }
+    if (line[0] == '#' || sscanf (line, fmt, in[nfiles], out[nfiles]) != 2)
+      continue;
+    nfiles++;
+  }
+  fclose (ptr_list);
+
+  *FileIn = in;
+  *FileOut = out;
+  return nfiles;
+}
+
+/*  .................. End of read_file_list() ..................... */
+
+
 /* ......................... END OF UGST-UTL.C .......................... */
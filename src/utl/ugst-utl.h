@@ -21,6 +21,7 @@
                         the G.192-compliant functions is made by the
                         the definition of the symbol STL92 at compile
                         time <simao@ctd.comsat.com>
+   16.Oct.2026  v3.1    Added read_file_list()
   ============================================================================
 */
 #ifndef UGST_UTILITIES_defined
@@ -35,6 +36,11 @@
 #endif
 #endif
 
+/* maximum length of file names, as in ugstdemo.h */
+#ifndef MAX_STRLEN
+#define MAX_STRLEN 1024
+#endif
+
 /* macros for UGST utility functions */
 #define fl2sh_16bit(n,x,y,r) fl2sh(n,x,y,r?0.5:0.0,(short)0xFFFF)
 #define fl2sh_15bit(n,x,y,r) fl2sh(n,x,y,r?1.0:0.0,(short)0xFFFE)
@@ -91,6 +97,7 @@ long parallelize_right_justified ARGS ((short *bit_stm, short *par_buf, long bs_
 long serialize_left_justified ARGS ((short *par_buf, short *bit_stm, long n, long resol, char sync));
 long parallelize_left_justified ARGS ((short *bit_stm, short *par_buf, long bs_len, long resol, char sync));
 unsigned long ran16_32c ARGS( (float *seed) );
+long read_file_list ARGS ((char *FileList, char (**FileIn)[MAX_STRLEN], char (**FileOut)[MAX_STRLEN]));
 
 #define IS_SERIAL -1
 #define IS_PARALLEL 1